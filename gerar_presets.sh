@@ -0,0 +1,31 @@
+#!/bin/bash
+# Gera src/presets_gen.c: as curvas de gerar_77_curvas.sh como funções C nativas
+# (multicurvas --emit-presets). Usado por `make presets`.
+
+EXEC="${EXEC:-./build/multicurvas}"
+SAIDA="${1:-src/presets_gen.c}"
+
+# Extrai "<id>\t<entrada>\t<nome>" dos pares "# N) Nome" / $EXEC "entrada"
+awk '
+    /^# [0-9]+[a-z]?\) / {
+        id = $2; sub(/\)$/, "", id)
+        nome = $0; sub(/^# [0-9]+[a-z]?\) /, "", nome)
+        next
+    }
+    /\$EXEC "/ && id != "" {
+        entrada = $0
+        sub(/^[^"]*"/, "", entrada); sub(/".*$/, "", entrada)
+        printf "%s\t%s\t%s\n", id, entrada, nome
+        id = ""
+    }
+' gerar_77_curvas.sh > "$SAIDA.lista" || exit 1
+
+N=$(grep -c . "$SAIDA.lista")
+if "$EXEC" --emit-presets "$SAIDA.lista" > "$SAIDA.tmp"; then
+    mv "$SAIDA.tmp" "$SAIDA"
+    rm -f "$SAIDA.lista"
+    echo "$SAIDA: $N presets"
+else
+    rm -f "$SAIDA.tmp" "$SAIDA.lista"
+    exit 1
+fi
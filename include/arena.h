@@ -0,0 +1,68 @@
+/* Arena (alocador por incremento) para a memória de um pedido.
+ *
+ * Um pedido de curva (parse → compilação → amostragem) faz muitas alocações
+ * pequenas que morrem juntas: as strings do Plot, os buffers de tokens, os
+ * arrays do PlotData. Com uma arena, tudo sai de um bloco contíguo e é
+ * devolvido de uma vez com arena_reset.
+ *
+ * Quando um bloco enche, outro é encadeado. arena_reset junta os blocos em
+ * um só, do tamanho do total usado, então depois do primeiro pedido (o
+ * aquecimento) pedidos do mesmo tamanho não chamam malloc.
+ *
+ * Uma arena não é segura entre threads: use uma por worker/conexão.
+ */
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Tamanho padrão do primeiro bloco */
+#define ARENA_DEFAULT_BLOCK 65536
+
+/* Alinhamento de arena_alloc (suficiente para double e SSE) */
+#define ARENA_ALIGNMENT 16
+
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct {
+    ArenaBlock *block;      /* bloco atual (os anteriores encadeados) */
+    size_t block_size;      /* tamanho mínimo de um bloco novo */
+    void *last;             /* última alocação (arena_realloc cresce no lugar) */
+    size_t used;            /* bytes entregues desde o último reset */
+    uint64_t mallocs;       /* blocos alocados desde arena_create */
+} Arena;
+
+typedef struct {
+    size_t used;            /* bytes em uso (com alinhamento) */
+    size_t capacity;        /* bytes reservados em todos os blocos */
+    int blocks;
+    uint64_t mallocs;       /* chamadas a malloc da arena desde a criação */
+} ArenaStats;
+
+/* Cria uma arena com o primeiro bloco de `block_size` bytes
+ * (0: ARENA_DEFAULT_BLOCK). NULL sem memória. */
+Arena *arena_create(size_t block_size);
+
+/* `size` bytes alinhados a ARENA_ALIGNMENT. NULL sem memória. */
+void *arena_alloc(Arena *arena, size_t size);
+
+/* Como arena_alloc, zerados */
+void *arena_calloc(Arena *arena, size_t count, size_t size);
+
+/* Aumenta uma alocação de `old_size` para `size` bytes. A última alocação
+ * cresce no lugar quando cabe no bloco; senão, os dados são copiados para
+ * um espaço novo (o antigo só volta no reset). ptr NULL: arena_alloc. */
+void *arena_realloc(Arena *arena, void *ptr, size_t old_size, size_t size);
+
+/* Cópia de `s` na arena. NULL sem memória. */
+char *arena_strdup(Arena *arena, const char *s);
+
+/* Devolve toda a memória entregue. Ponteiros anteriores deixam de valer. */
+void arena_reset(Arena *arena);
+
+ArenaStats arena_stats(const Arena *arena);
+
+void arena_destroy(Arena *arena);
+
+#endif /* ARENA_H */
@@ -0,0 +1,72 @@
+/* Modo lote (`multicurvas --batch specs.txt --outdir DIR`): muitas curvas
+ * num só processo, renderizadas em paralelo.
+ *
+ * Uma especificação por linha, campos separados por espaços ou tabs:
+ *
+ *   <expressão> [formato] [largura altura] <arquivo>
+ *
+ * Campos com espaços vão entre aspas duplas. Sem formato, ele vem da extensão
+ * do arquivo (.csv, .bin; o resto é svg). Linhas vazias e iniciadas por '#'
+ * são ignoradas. O arquivo é criado em `outdir`.
+ *
+ * Cada linha é um trabalho independente: uma linha inválida, uma expressão
+ * que não compila ou uma falha de escrita ficam registradas no próprio
+ * trabalho (errmsg) e o lote continua.
+ */
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdio.h>
+
+/* Uma linha do arquivo de especificações e o seu resultado */
+typedef struct {
+    int line;           /* linha no arquivo (1..) */
+    char *expr;
+    char format[4];     /* "csv", "svg" ou "bin" */
+    int canvas_w;
+    int canvas_h;
+    char *output;       /* nome do arquivo, relativo a outdir */
+
+    /* Preenchidos por batch_run */
+    int ok;
+    char *errmsg;       /* linha inválida ou falha ao gerar/gravar */
+    int count;          /* pontos válidos */
+    double ms;          /* tempo de geração + escrita */
+} BatchJob;
+
+typedef struct {
+    BatchJob *jobs;
+    int count;
+    int capacity;
+} Batch;
+
+typedef struct {
+    int workers;        /* curvas em paralelo (0: threadpool_default_threads()) */
+    int samples;        /* amostras por curva (0: padrão de cada Plot) */
+    double adaptive;    /* > 0: plot_set_adaptive com essa tolerância */
+    int float32;        /* SVG com coordenadas PLOT_FLOAT32 */
+} BatchOptions;
+
+/* Lê as especificações de `in`. Linhas inválidas viram trabalhos com errmsg
+ * (não abortam a leitura). Retorna NULL só se faltar memória. */
+Batch *batch_read(FILE *in);
+
+/* Separa a linha em no máximo `max` campos (espaços/tabs; aspas duplas
+ * agrupam; '#' no início comenta a linha). Retorna o número de campos,
+ * alocados em fields[] (caller libera), ou -1 com a mensagem em *err. */
+int batch_split_fields(const char *line, char **fields, int max, const char **err);
+
+/* Interpreta uma linha. Retorna 1 e preenche `job` (expr/output alocados),
+ * 0 para linha vazia ou comentário e -1 se a linha for inválida (errmsg,
+ * se não for NULL, recebe a mensagem; caller deve liberar). */
+int batch_parse_line(const char *line, BatchJob *job, char **errmsg);
+
+/* Gera e grava todos os trabalhos válidos em `outdir` (que precisa existir),
+ * `opts->workers` por vez; a amostragem de cada curva continua usando o pool
+ * compartilhado. Arquivos de trabalhos que falham são removidos.
+ * Retorna o número de trabalhos com falha (incluindo linhas inválidas). */
+int batch_run(Batch *batch, const char *outdir, const BatchOptions *opts);
+
+void batch_free(Batch *batch);
+
+#endif /* BATCH_H */
@@ -0,0 +1,28 @@
+/* Gerador de código C a partir de um Plot (`multicurvas --emit-c`).
+ *
+ * O plot passa pelo mesmo caminho de plot_generate_samples() — tokenização,
+ * RPN, otimizador, conversão polar e máquina de registradores (subexpressões
+ * comuns e sincos) — e cada instrução vira uma linha de C com a verificação de
+ * erro em linha. O resultado é uma função PlotNativeFn sem laço de dispatch,
+ * com os mesmos valores e os mesmos EvalError do avaliador (libm escalar).
+ *
+ * O código gerado só depende de <math.h>, <stddef.h> e <stdint.h>.
+ */
+#ifndef CODEGEN_H
+#define CODEGEN_H
+
+#include <stdio.h>
+#include "multicurvas_plot.h"
+
+/* Escreve uma unidade de tradução autônoma com a função `symbol`
+ * (assinatura de PlotNativeFn). Retorna 1 em caso de sucesso; em caso de
+ * erro retorna 0 e grava a mensagem em errmsg (caller deve liberar). */
+int codegen_emit_plot(FILE *out, const Plot *plot, const char *symbol, char **errmsg);
+
+/* Escreve o catálogo de presets (src/presets_gen.c): uma função nativa por
+ * curva e a tabela plot_presets[]. Cada linha de `list` é
+ * "<id>\t<entrada>\t<nome>"; linhas vazias ou iniciadas por '#' são ignoradas.
+ * Retorna o número de presets ou -1 em caso de erro (mensagem em errmsg). */
+int codegen_emit_catalog(FILE *out, FILE *list, char **errmsg);
+
+#endif /* CODEGEN_H */
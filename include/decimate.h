@@ -0,0 +1,62 @@
+/* Decimação M4 por coluna de pixel para curvas cartesianas.
+ *
+ * Com 10^6..10^8 amostras de Y=f(x), quase todas caem na mesma coluna de
+ * pixel. Para cada coluna basta manter a primeira, a última, a de menor y e a
+ * de maior y: a poligonal desenhada é a mesma (cada coluna continua cobrindo
+ * a mesma faixa vertical e ligando-se às vizinhas pelos mesmos pontos), e a
+ * saída fica limitada a 4 pontos por coluna, independentemente do número de
+ * amostras.
+ *
+ * O decimador é incremental (uma passada O(n), estado constante): amostras
+ * entram uma a uma, em ordem de x, e os pontos saem assim que cada coluna
+ * fecha. Amostras inválidas fecham o grupo atual e viram uma quebra na saída;
+ * pontos fora dos limites de render_svg (não finitos ou |v| > 1e6) passam
+ * direto, como pontos isolados.
+ */
+#ifndef DECIMATE_H
+#define DECIMATE_H
+
+#include "multicurvas_plot.h"
+
+/* Máximo de pontos produzidos por decimator_push (grupo de 4 + 1) */
+#define DECIMATE_MAX_OUT 5
+
+/* Ponto de saída: status 0 = ponto válido, 1 = quebra (amostras inválidas) */
+typedef struct {
+    double x;
+    double y;
+    int status;
+} DecimatedPoint;
+
+/* Estado do decimador (não alocar nada: pode viver na pilha) */
+typedef struct {
+    double x0;          /* x da borda esquerda da coluna 0 */
+    double range;       /* largura em x coberta pelas colunas */
+    double columns;     /* número de colunas */
+    long coluna;        /* coluna do grupo atual */
+    int n;              /* amostras no grupo atual (0: vazio) */
+    int quebra;         /* última saída foi uma quebra */
+    long seq;           /* ordem de chegada (para emitir em ordem) */
+    DecimatedPoint first, last, min, max;
+    long seq_first, seq_last, seq_min, seq_max;
+} Decimator;
+
+/* Prepara o decimador: `columns` colunas cobrindo [x0, x1]. A coluna de x é
+ * floor((x - x0) * columns / (x1 - x0)), a mesma conta de render_svg. */
+void decimator_init(Decimator *d, double x0, double x1, int columns);
+
+/* Consome uma amostra (status 0 = válida). Grava em out[] os pontos que
+ * saem (no máximo DECIMATE_MAX_OUT) e retorna quantos. */
+int decimator_push(Decimator *d, double x, double y, int status, DecimatedPoint *out);
+
+/* Fecha o último grupo. Retorna quantos pontos foram gravados em out[]. */
+int decimator_finish(Decimator *d, DecimatedPoint *out);
+
+/* Decima um PlotData cartesiano para um canvas de largura canvas_w, com a
+ * mesma bounding box e escala de render_svg (uma coluna por pixel da área de
+ * plotagem). O resultado usa as convenções de PlotData, na precisão da
+ * entrada: uma amostra por ponto ou quebra, x/y só os pontos válidos.
+ * Retorna NULL se faltar memória. */
+PlotData *decimate_plot(const PlotData *data, int canvas_w);
+
+#endif /* DECIMATE_H */
@@ -1,8 +1,13 @@
 #ifndef EVALUATOR_H
 #define EVALUATOR_H
 
+#include <stddef.h>
+#include <stdint.h>
 #include "parser.h"
 
+/* Profundidade máxima da pilha de avaliação (todos os motores) */
+#define MAX_EVAL_STACK_SIZE 64
+
 /* Erros de avaliação */
 typedef enum {
     EVAL_OK = 0,
@@ -21,4 +26,98 @@ typedef struct {
 /* Avalia expressão em RPN com valor para a variável */
 EvalResult evaluator_eval_rpn(const TokenBuffer *rpn, double var_value);
 
+/* Avalia expressão em RPN sobre n amostras de uma vez (coluna por coluna).
+ * - in[i]: valor da variável na amostra i
+ * - out[i]: resultado (válido apenas se status[i] == EVAL_OK)
+ * - status[i]: EvalError da amostra i (mesmo código que evaluator_eval_rpn retornaria)
+ * O programa é percorrido token a token sobre blocos de amostras, de modo que o
+ * custo de decodificação/dispatch é pago uma vez por bloco e não por ponto.
+ */
+void evaluator_eval_rpn_batch(const TokenBuffer *rpn, const double *in,
+                              double *out, uint8_t *status, size_t n);
+
+/* Valor de uma constante (TOKEN_CONST_PI, TOKEN_CONST_E) */
+double evaluator_constant(TokenType type);
+
+/* Aplica uma função unária (TOKEN_SIN..TOKEN_FRAC) com as verificações de domínio */
+EvalResult evaluator_apply_function(TokenType type, double arg);
+
+/* Aplica um operador binário (+ - * / ^) com as mesmas verificações do interpretador */
+EvalResult evaluator_apply_operator(TokenType type, double left, double right);
+
+/* Valida a estrutura de um programa RPN simulando a profundidade da pilha.
+ * Retorna o índice do primeiro token que NÃO deve ser executado: o ponto em que
+ * evaluator_eval_rpn abortaria por erro estrutural, ou o fim do programa.
+ * Em *stop_error grava o erro correspondente (EVAL_OK se o programa é válido).
+ * Os motores alternativos usam esta função para eliminar as verificações de
+ * pilha do laço quente, reproduzindo a mesma ordem de erros.
+ */
+int evaluator_validate_rpn(const TokenBuffer *rpn, EvalError *stop_error);
+
+/* ========================================================================
+ * Programas compilados e motores de avaliação
+ * ======================================================================== */
+
+/* Motores de avaliação disponíveis */
+typedef enum {
+    EVAL_ENGINE_SWITCH = 0,     /* Interpretador de referência (switch sobre tokens) */
+    EVAL_ENGINE_THREADED,       /* Código encadeado (computed goto / tabela de handlers) */
+    EVAL_ENGINE_REGISTER,       /* Máquina de registradores (três endereços) */
+    EVAL_ENGINE_JIT             /* Código x86-64 gerado a partir da máquina de registradores */
+} EvalEngine;
+
+/* Motor usado por padrão em evaluator_compile (padrão: EVAL_ENGINE_REGISTER) */
+extern EvalEngine evaluator_engine;
+
+/* Define o motor padrão */
+void evaluator_set_engine(EvalEngine engine);
+
+/* Nome legível do motor */
+const char *evaluator_engine_name(EvalEngine engine);
+
+/* Programa compilado: cópia imutável do RPN + forma traduzida para o motor */
+typedef struct EvalProgram EvalProgram;
+
+/* Máximo de expressões compiladas juntas (X e Y de uma curva paramétrica) */
+#define EVAL_MAX_OUTPUTS 2
+
+/* Compila o RPN para o motor indicado. O programa não referencia `rpn` após
+ * a chamada. Retorna NULL se faltar memória. Se o motor de registradores não
+ * comportar o programa (> REGVM_MAX_REGS), usa o interpretador de referência. */
+EvalProgram *evaluator_compile(const TokenBuffer *rpn, EvalEngine engine);
+
+/* Compila `count` expressões na mesma variável como um único programa com
+ * `count` saídas. No motor de registradores as subexpressões comuns são
+ * avaliadas uma vez; nos demais, cada saída é avaliada separadamente. */
+EvalProgram *evaluator_compile_multi(const TokenBuffer *const *rpns, int count,
+                                     EvalEngine engine);
+
+/* Número de saídas do programa */
+int evaluator_program_outputs(const EvalProgram *prog);
+
+/* Avalia o programa (saída 0) para um valor da variável */
+EvalResult evaluator_program_eval(const EvalProgram *prog, double var_value);
+
+/* Avalia todas as saídas: results[k] é idêntico a avaliar a expressão k isolada */
+void evaluator_program_eval_multi(const EvalProgram *prog, double var_value,
+                                  EvalResult *results);
+
+/* Avalia o programa (saída 0) sobre n amostras (mesma semântica de evaluator_eval_rpn_batch) */
+void evaluator_program_eval_batch(const EvalProgram *prog, const double *in,
+                                  double *out, uint8_t *status, size_t n);
+
+/* Avalia todas as saídas sobre n amostras; out[k]/status[k] NULL são ignorados */
+void evaluator_program_eval_batch_multi(const EvalProgram *prog, const double *in,
+                                        double *const *out, uint8_t *const *status,
+                                        size_t n);
+
+/* Como evaluator_program_eval_batch_multi, sem status: para faixas em que
+ * nenhuma amostra de nenhuma saída pode falhar (ver interval.h). No motor de
+ * registradores os kernels rodam sem verificação; os valores são os mesmos. */
+void evaluator_program_eval_batch_unchecked(const EvalProgram *prog, const double *in,
+                                            double *const *out, size_t n);
+
+/* Libera um programa compilado */
+void evaluator_program_free(EvalProgram *prog);
+
 #endif /* EVALUATOR_H */
@@ -0,0 +1,67 @@
+/* Cache LRU de expressões compiladas.
+ *
+ * Lotes e serviços de longa duração compilam as mesmas expressões muitas
+ * vezes (sin(x), cos(t), os 77 presets). O cache associa uma chave de texto
+ * (a expressão normalizada com exprcache_normalize, mais o que mudar a
+ * compilação: locale, tipo do plot, motor) a um valor imutável, que pode
+ * ser usado por várias threads ao mesmo tempo.
+ *
+ * Os valores são contados por referência: exprcache_get/exprcache_put
+ * devolvem uma entrada adquirida, que vale até exprcache_release. Uma
+ * entrada removida pelo LRU enquanto adquirida só é liberada (free_value)
+ * no último release. Todas as funções são seguras entre threads.
+ */
+#ifndef EXPRCACHE_H
+#define EXPRCACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct ExprCache ExprCache;
+typedef struct ExprCacheEntry ExprCacheEntry;
+
+/* Libera um valor guardado no cache */
+typedef void (*ExprCacheFree)(void *value);
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    int entries;            /* entradas no cache agora */
+    int capacity;
+} ExprCacheStats;
+
+/* Cria um cache com no máximo `capacity` entradas. NULL sem memória. */
+ExprCache *exprcache_create(int capacity, ExprCacheFree free_value);
+
+/* Libera o cache e os valores. Não pode haver entradas adquiridas. */
+void exprcache_destroy(ExprCache *cache);
+
+/* Procura `key`. Em caso de acerto, adquire e retorna a entrada (passa a
+ * ser a mais recente); senão retorna NULL e conta uma falta. */
+ExprCacheEntry *exprcache_get(ExprCache *cache, const char *key);
+
+/* Insere `value` sob `key` e retorna a entrada adquirida. Se outra thread
+ * inseriu a mesma chave antes, `value` é liberado e a entrada existente é
+ * retornada. Se faltar memória, retorna NULL (value continua do caller). */
+ExprCacheEntry *exprcache_put(ExprCache *cache, const char *key, void *value);
+
+/* Valor da entrada (somente leitura enquanto adquirida) */
+const void *exprcache_value(const ExprCacheEntry *entry);
+
+/* Solta uma entrada adquirida por get/put */
+void exprcache_release(ExprCache *cache, ExprCacheEntry *entry);
+
+/* Remove todas as entradas (as adquiridas são liberadas no release).
+ * As estatísticas não mudam. */
+void exprcache_clear(ExprCache *cache);
+
+ExprCacheStats exprcache_stats(ExprCache *cache);
+
+/* Normaliza a expressão para uso na chave: espaços só ficam (um) entre dois
+ * caracteres de palavra ou número, onde separam tokens ("1 2" != "12").
+ * Grava no máximo `size` bytes com o '\0' e retorna o comprimento
+ * normalizado (se >= size, a saída foi truncada). */
+size_t exprcache_normalize(const char *expr, char *out, size_t size);
+
+#endif /* EXPRCACHE_H */
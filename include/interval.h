@@ -0,0 +1,58 @@
+/* Avaliação de programas RPN por aritmética de intervalos.
+ *
+ * Em vez de um valor da variável, o programa recebe uma faixa [lo, hi] e
+ * devolve um intervalo que contém o resultado de TODAS as amostras da faixa,
+ * junto com uma prova sobre os erros de avaliação:
+ *   - INTERVAL_SAFE: nenhuma amostra gera EvalError (nem domínio, nem divisão
+ *     por zero, nem overflow) — os kernels podem rodar sem verificação
+ *   - INTERVAL_FAILS: todas as amostras falham (ex.: sqrt de uma faixa negativa)
+ *     — a faixa nem precisa ser avaliada
+ *   - INTERVAL_MAYBE: nada provado (polo de tan ou 1/x, fronteira de domínio,
+ *     ou superestimação do intervalo)
+ *
+ * Os limites são alargados para fora em cada operação (arredondamento e as
+ * aproximações SIMD de até ~3 ulp dos kernels), então as provas valem para
+ * qualquer motor e qualquer nível de kernels.
+ */
+#ifndef INTERVAL_H
+#define INTERVAL_H
+
+#include "parser.h"
+#include "tokens.h"
+
+/* Intervalo fechado; limites infinitos indicam faixa ilimitada */
+typedef struct {
+    double lo;
+    double hi;
+} Interval;
+
+/* Ordenado: o status de uma expressão é o maior entre os das subexpressões */
+typedef enum {
+    INTERVAL_SAFE = 0,      /* nenhuma amostra da faixa falha */
+    INTERVAL_MAYBE,         /* algumas amostras podem falhar */
+    INTERVAL_FAILS          /* todas as amostras da faixa falham */
+} IntervalStatus;
+
+/* Resultado: `value` contém o valor de toda amostra que não falhou */
+typedef struct {
+    IntervalStatus status;
+    Interval value;
+} IntervalResult;
+
+/* Liga/desliga a análise por intervalos em plot_generate_samples (padrão: ligada) */
+extern int interval_enabled;
+
+/* Imagem de uma função unária (TOKEN_NEG, TOKEN_SIN..TOKEN_FRAC) sobre `arg`,
+ * com as mesmas regras de domínio de evaluator_apply_function */
+IntervalResult interval_apply_function(TokenType type, Interval arg);
+
+/* Operador binário (+ - * / ^) sobre dois intervalos, com as mesmas regras de
+ * evaluator_apply_operator (divisão por zero, base negativa em pow) */
+IntervalResult interval_apply_operator(TokenType type, Interval left, Interval right);
+
+/* Avalia o RPN com a variável percorrendo `var`. Programas estruturalmente
+ * inválidos (ver evaluator_validate_rpn) resultam em INTERVAL_FAILS.
+ * `x*x` (mesma subexpressão dos dois lados) é tratado como quadrado. */
+IntervalResult interval_eval_rpn(const TokenBuffer *rpn, Interval var);
+
+#endif /* INTERVAL_H */
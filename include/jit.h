@@ -0,0 +1,44 @@
+/* Motor JIT x86-64: traduz o programa de registradores (regvm.h) para código
+ * de máquina em um buffer executável obtido com mmap.
+ *
+ * Cada instrução vira aritmética escalar SSE2 sobre o arquivo de registradores
+ * em memória; números e constantes são lidos direto de uma área de dados no
+ * próprio buffer. Funções (sin, log, pow, ...) chamam a libm — a mesma usada
+ * pelo interpretador, então os resultados são bit a bit idênticos.
+ *
+ * O código gerado só distingue "tudo finito" de "alguma instrução falhou":
+ * nesse caso (raro) a amostra é reavaliada pelo interpretador de registradores,
+ * que reporta o EvalError exato de cada saída.
+ *
+ * Sem x86-64 ou sem mmap, jit_compile() retorna NULL e evaluator_compile()
+ * usa o interpretador de registradores.
+ */
+#ifndef JIT_H
+#define JIT_H
+
+#include "regvm.h"
+
+typedef struct JitProgram JitProgram;
+
+/* 1 se o JIT pode gerar código nesta plataforma */
+int jit_available(void);
+
+/* Gera código para o programa. `prog` deve viver enquanto o JitProgram existir
+ * (usado para constantes, saídas e reavaliação em caso de erro).
+ * Retorna NULL se a plataforma não suporta ou faltar memória. */
+JitProgram *jit_compile(const RegProgram *prog);
+
+/* Avalia todas as saídas (mesma semântica de regvm_eval_multi) */
+void jit_eval_multi(const JitProgram *jit, double var_value, EvalResult *results);
+
+/* Avalia sobre n amostras; out[k]/status[k] NULL são ignorados */
+void jit_eval_batch(const JitProgram *jit, const double *in,
+                    double *const *out, uint8_t *const *status, size_t n);
+
+/* Tamanho do código gerado em bytes */
+size_t jit_code_size(const JitProgram *jit);
+
+/* Libera o código */
+void jit_free(JitProgram *jit);
+
+#endif /* JIT_H */
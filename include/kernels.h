@@ -0,0 +1,76 @@
+/* Kernels de avaliação em bloco usados pelo avaliador em lote.
+ *
+ * Cada kernel aplica UMA operação (operador binário ou função unária) a um
+ * vetor de amostras. Erros de domínio/overflow são registrados por amostra em
+ * `status` (códigos EvalError), sem retorno antecipado: a primeira falha de cada
+ * amostra é preservada, exatamente como em evaluator_eval_rpn.
+ *
+ * Com `status` NULL o kernel roda sem verificação: para blocos em que já se
+ * provou que nenhuma amostra falha (interval.h). Os valores são os mesmos.
+ *
+ * Há uma versão escalar (referência) e versões vetorizadas SSE2/AVX2/AVX-512,
+ * escolhidas na inicialização conforme a CPU.
+ */
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <stdint.h>
+#include "tokens.h"
+
+/* Erro máximo das aproximações vetoriais (SSE2/AVX2/AVX-512) em relação à
+ * libm, em ulps do resultado da libm; medido e verificado por test/batch.c.
+ * Em sin, cos e tan soma-se o erro absoluto da redução de argumento,
+ * 2^-100 * |x| (vezes 1 + tan^2 na tan), que domina perto dos zeros e polos.
+ * As demais funções usam a libm e são idênticas ao escalar. */
+#define KERNELS_ULP_EXP     2   /* exp e cosh, |x| <= 700 */
+#define KERNELS_ULP_LOG     1
+#define KERNELS_ULP_SINCOS  2   /* sin e cos, |x| <= 2^30 */
+#define KERNELS_ULP_TAN     4
+
+/* Níveis de vetorização disponíveis */
+typedef enum {
+    KERNELS_SCALAR = 0,
+    KERNELS_SSE2,
+    KERNELS_AVX2,
+    KERNELS_AVX512
+} KernelLevel;
+
+/* Operador binário: out[i] = left[i] (op) right[i]. `out` pode coincidir com `left`. */
+typedef void (*BinaryKernel)(TokenType type, const double *left, const double *right,
+                             double *out, uint8_t *status, int n);
+
+/* Função unária: out[i] = f(arg[i]). `out` pode coincidir com `arg`. */
+typedef void (*UnaryKernel)(TokenType type, const double *arg,
+                            double *out, uint8_t *status, int n);
+
+/* sin e cos do mesmo argumento com uma única redução de argumento.
+ * `sin_out`/`cos_out` podem coincidir com `arg` (mas não entre si). */
+typedef void (*SincosKernel)(const double *arg, double *sin_out, double *cos_out,
+                             uint8_t *status, int n);
+
+typedef struct {
+    KernelLevel level;
+    const char *name;
+    BinaryKernel binary;
+    UnaryKernel unary;
+    SincosKernel sincos;
+} Kernels;
+
+/* Kernels ativos (detectados na inicialização; escalar se não houver SIMD) */
+const Kernels *kernels_active(void);
+
+/* Maior nível suportado pela CPU atual */
+KernelLevel kernels_detect(void);
+
+/* Força um nível (limitado ao suportado pela CPU). Retorna o nível aplicado. */
+KernelLevel kernels_set_level(KernelLevel level);
+
+/* Kernels escalares de referência (também usados para as sobras de cada bloco) */
+void kernels_scalar_binary(TokenType type, const double *left, const double *right,
+                           double *out, uint8_t *status, int n);
+void kernels_scalar_unary(TokenType type, const double *arg,
+                          double *out, uint8_t *status, int n);
+void kernels_scalar_sincos(const double *arg, double *sin_out, double *cos_out,
+                           uint8_t *status, int n);
+
+#endif /* KERNELS_H */
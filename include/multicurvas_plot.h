@@ -12,9 +12,18 @@
 #define MULTICURVAS_PLOT_H
 
 #include <stddef.h>
+#include <stdint.h>
+#include "parser.h"
+#include "exprcache.h"
+#include "arena.h"
 
 #define PLOT_DEFAULT_SAMPLES 500
 
+/* Amostragem adaptativa (padrões de plot_set_adaptive) */
+#define PLOT_ADAPTIVE_TOLERANCE 0.5     /* desvio máximo em pixels */
+#define PLOT_ADAPTIVE_MIN_DEPTH 6       /* grade inicial: 2^6 + 1 = 65 amostras */
+#define PLOT_ADAPTIVE_MAX_DEPTH 16      /* menor intervalo: (D-C) / 2^16 */
+
 typedef enum {
     PLOT_UNKNOWN = 0,
     PLOT_CARTESIAN,   /* Y = f(x) */
@@ -29,6 +38,32 @@ typedef enum {
     PLOT_STATUS_INVALID_INTERVAL
 } PlotStatus;
 
+/* Avaliação nativa de um plot (gerada por `multicurvas --emit-c`): mesma
+ * assinatura de evaluator_program_eval_batch_multi(). Saída 0 = Y (cartesiano),
+ * X (paramétrico) ou r*cos(t) (polar); saída 1 = Y ou r*sin(t). */
+typedef void (*PlotNativeFn)(const double *in, double *const *out,
+                             uint8_t *const *status, size_t n);
+
+/* Amostragem adaptativa: em vez de `samples` pontos uniformes, parte de uma
+ * grade de 2^min_depth intervalos e divide ao meio cada intervalo cujo ponto
+ * médio se afasta da corda mais que `tolerance` pixels (no canvas
+ * width x height, com a mesma escala de render_svg), até max_depth.
+ * Os parâmetros visitados são t = C + k*(D-C)/2^max_depth. */
+typedef struct {
+    int enabled;
+    double tolerance;   /* pixels */
+    int min_depth;      /* 0..30 */
+    int max_depth;      /* min_depth..30 */
+    int width;          /* canvas de referência */
+    int height;
+} PlotAdaptive;
+
+/* Precisão das coordenadas de um PlotData */
+typedef enum {
+    PLOT_FLOAT64 = 0,   /* double (padrão) */
+    PLOT_FLOAT32        /* float: metade da memória; basta para saídas em pixels */
+} PlotPrecision;
+
 typedef struct Plot {
     PlotType type;
     char *expr1;    /* Para cartesiano: Y; polar: R ou R**2; paramétrico: X */
@@ -37,36 +72,167 @@ typedef struct Plot {
     double D;       /* Fim do domínio/parâmetro */
     int has_interval;
     int samples;    /* número de amostras (padrão: PLOT_DEFAULT_SAMPLES) */
+    PlotNativeFn native;    /* Se não NULL, substitui a compilação das expressões (presets) */
+    PlotAdaptive adaptive;  /* Desligada por padrão (amostragem uniforme) */
+    PlotPrecision precision;    /* Coordenadas do PlotData (padrão: PLOT_FLOAT64) */
+    Arena *arena;           /* Não NULL: alocado na arena (plot_free não libera) */
 } Plot;
 
-/* Buffer de dados prontos para plotagem */
+/* Alinhamento das colunas de um PlotData (uma linha de cache) */
+#define PLOT_DATA_ALIGN 64
+
+/* Buffer de dados prontos para plotagem.
+ *
+ * As colunas x e y (só os pontos válidos, compactados, em double ou float)
+ * e o bitset de validade por amostra ficam numa única alocação, cada um
+ * começando em um múltiplo de PLOT_DATA_ALIGN: 16.1 bytes por amostra em
+ * PLOT_FLOAT64 e 8.1 em PLOT_FLOAT32. Leia com os acessores abaixo, que
+ * valem para as duas precisões. */
 typedef struct PlotData {
-    double *x;      /* Coordenadas X dos pontos */
-    double *y;      /* Coordenadas Y dos pontos */
-    int *status;    /* Status de cada ponto (0=OK, 1=erro) */
+    double *x;      /* PLOT_FLOAT64: coordenadas X dos pontos válidos (senão NULL) */
+    double *y;      /* PLOT_FLOAT64: coordenadas Y */
+    float *xf;      /* PLOT_FLOAT32: coordenadas X (senão NULL) */
+    float *yf;      /* PLOT_FLOAT32: coordenadas Y */
+    uint64_t *valid;    /* bit s: amostra s válida (NULL: todas válidas) */
     int count;      /* Número de pontos válidos */
-    int capacity;   /* Tamanho alocado dos arrays */
+    int capacity;   /* Linhas alocadas em cada coluna */
+    int samples;    /* Amostras avaliadas (uniforme: plot->samples) */
+    PlotPrecision precision;
+    Arena *arena;   /* Não NULL: alocado na arena (plot_data_free não libera) */
 } PlotData;
 
+/* Trecho de amostras válidas consecutivas: amostras [sample, sample + len),
+ * pontos [first, first + len) das colunas */
+typedef struct {
+    int sample;
+    int first;
+    int len;
+} PlotSegment;
+
+/* Coordenadas do ponto válido i (0 <= i < count), em qualquer precisão */
+static inline double plot_data_x(const PlotData *data, int i) {
+    return data->x ? data->x[i] : (double)data->xf[i];
+}
+
+static inline double plot_data_y(const PlotData *data, int i) {
+    return data->y ? data->y[i] : (double)data->yf[i];
+}
+
+/* 1 se a amostra s (0 <= s < samples) é válida */
+static inline int plot_data_sample_ok(const PlotData *data, int s) {
+    return !data->valid || (int)((data->valid[s >> 6] >> (s & 63)) & 1);
+}
+
+/* PlotData vazio (count = samples = 0) com espaço para `capacity` amostras
+ * em `arena` (NULL: malloc). NULL sem memória. */
+PlotData *plot_data_create(int capacity, PlotPrecision precision, Arena *arena);
+
+/* Bytes da alocação das colunas de plot_data_create */
+size_t plot_data_size(int capacity, PlotPrecision precision);
+
+/* Acrescenta uma amostra: um ponto (x, y) se `ok`, senão uma amostra
+ * inválida. Retorna 0 se não houver espaço. */
+int plot_data_append(PlotData *data, int ok, double x, double y);
+
+/* Próximo trecho de amostras válidas depois de `seg` (comece com um
+ * PlotSegment zerado). Retorna 0 quando não há mais trechos.
+ *
+ *     PlotSegment seg = {0};
+ *     while (plot_data_next_segment(data, &seg)) {
+ *         for (int i = seg.first; i < seg.first + seg.len; i++) ...
+ *     }
+ */
+int plot_data_next_segment(const PlotData *data, PlotSegment *seg);
+
 /* Analisa a string de entrada e aloca um `Plot`.
  * Retorna Plot alocado ou NULL em caso de erro.
  * Se errmsg não for NULL, grava mensagem de erro (caller deve liberar).
  */
 Plot *plot_parse_text(const char *input, char **errmsg);
 
+/* Como plot_parse_text, com o Plot e as expressões alocados em `arena`
+ * (NULL: malloc). Vale até o próximo arena_reset. */
+Plot *plot_parse_text_arena(const char *input, Arena *arena, char **errmsg);
+
 /* Libera um `Plot` retornado por `plot_parse_text`. */
 void plot_free(Plot *p);
 
+/* Liga a amostragem adaptativa com a tolerância dada (pixels; <= 0 usa
+ * PLOT_ADAPTIVE_TOLERANCE) para um canvas width x height e profundidades
+ * padrão. */
+void plot_set_adaptive(Plot *plot, double tolerance, int width, int height);
+
+/* Prepara os programas RPN avaliados por plot_generate_samples(): a expressão
+ * (cartesiano), X e Y (paramétrico) ou r*cos(t) e r*sin(t) (polar).
+ * Retorna o número de programas (1 ou 2; o chamador libera com
+ * parser_free_buffer) ou 0 em caso de erro, com a mensagem em errmsg. */
+int plot_build_programs(const Plot *plot, TokenBuffer rpn[2], char **errmsg);
+
+/* Cache de programas compilados (exprcache.h), consultado por
+ * plot_generate_samples e plot_sampler_open antes de compilar. A chave é o
+ * tipo do plot, as expressões normalizadas, parser_locale, optimizer_enabled
+ * e evaluator_engine. plot_cache_enabled = 0 compila sempre. */
+#define PLOT_CACHE_CAPACITY 256
+extern int plot_cache_enabled;
+
+/* Cache compartilhado (criado no primeiro uso; NULL sem memória), para
+ * estatísticas e exprcache_clear */
+ExprCache *plot_program_cache(void);
+
 /* Gera dados de plotagem a partir de um Plot.
- * - Compila as expressões usando o parser/avaliador existente
+ * - Compila as expressões (ou reaproveita do cache de programas)
  * - Gera samples pontos no intervalo [C,D]
- * - Avalia as expressões e preenche arrays x,y
+ * - Avalia as expressões e preenche as colunas x,y (na precisão plot->precision)
  * - Marca pontos com erro de avaliação (divisão por zero, domínio, etc.)
  * Retorna PlotData alocado ou NULL em caso de erro.
  */
 PlotData *plot_generate_samples(const Plot *plot, char **errmsg);
 
-/* Libera um PlotData retornado por plot_generate_samples. */
+/* Como plot_generate_samples, com o PlotData e a memória temporária
+ * (chave do cache, RPN antes da otimização) em `arena` (NULL: malloc).
+ * Com o programa no cache, a amostragem uniforme não chama malloc quando a
+ * arena já tem espaço: um pedido custa um arena_reset. A adaptativa ainda
+ * usa o heap enquanto subdivide e copia o resultado para a arena. */
+PlotData *plot_generate_samples_arena(const Plot *plot, Arena *arena, char **errmsg);
+
+/* Amostras por bloco de plot_sampler_next (~2.2 MB de x, y e status) */
+#define PLOT_SAMPLER_CHUNK 131072
+
+/* Bloco de amostras uniformes consecutivas; os ponteiros valem até a próxima
+ * chamada de plot_sampler_next/plot_sampler_close. */
+typedef struct {
+    uint64_t first;         /* índice da primeira amostra do bloco */
+    int n;                  /* amostras no bloco */
+    int count;              /* amostras válidas no bloco */
+    const double *x;        /* linha i = amostra first + i (inválidas: NaN) */
+    const double *y;
+    const uint8_t *status;  /* 0 = ok, 1 = inválida */
+} PlotChunk;
+
+/* Amostragem uniforme sob demanda, com memória constante */
+typedef struct PlotSampler PlotSampler;
+
+/* Prepara a amostragem de `samples` pontos uniformes em [C,D] (0: usa
+ * plot->samples), com contagem de 64 bits: os mesmos valores de
+ * plot_generate_samples, produzidos em blocos de PLOT_SAMPLER_CHUNK.
+ * A amostragem adaptativa não é suportada (ela precisa da curva inteira).
+ * `plot` deve continuar válido até plot_sampler_close.
+ * Retorna NULL em caso de erro, com a mensagem em errmsg. */
+PlotSampler *plot_sampler_open(const Plot *plot, uint64_t samples, char **errmsg);
+
+/* Avalia o próximo bloco. Retorna 1 e preenche `chunk`, ou 0 no fim. */
+int plot_sampler_next(PlotSampler *sampler, PlotChunk *chunk);
+
+/* Total de amostras da amostragem */
+uint64_t plot_sampler_samples(const PlotSampler *sampler);
+
+void plot_sampler_close(PlotSampler *sampler);
+
+/* Intervalo [C,D] usado na amostragem: o da entrada ou, sem ":C,D:", o
+ * padrão do tipo (polar: em múltiplos de pi, como na entrada). */
+void plot_get_interval(const Plot *plot, double *C, double *D);
+
+/* Libera um PlotData retornado por plot_generate_samples ou plot_data_create. */
 void plot_data_free(PlotData *data);
 
 #endif /* MULTICURVAS_PLOT_H */
@@ -0,0 +1,45 @@
+/* Otimizador de programas RPN (entre parser_to_rpn e a compilação para o motor).
+ *
+ * Transformações, todas preservando os códigos de erro de evaluator_eval_rpn:
+ *   - dobra subárvores constantes (números, pi, e, operadores e funções puras);
+ *     uma subárvore que falharia (ex.: log(-1), 1/0) NÃO é dobrada, de modo que o
+ *     erro continua sendo reportado na avaliação
+ *   - x^2 .. x^OPTIMIZER_MAX_POW (expoente inteiro, base variável) → cadeia de
+ *     multiplicações em vez de pow()
+ *   - a/c (c constante, não nula) → a*(1/c)
+ *   - NEG NEG → removido
+ *
+ * As duas reescritas aritméticas podem diferir do original no último ulp
+ * (arredondamentos da cadeia de produtos e do recíproco); dobra de constantes e
+ * remoção de NEG duplo são exatas.
+ */
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include "parser.h"
+
+/* Maior expoente inteiro reescrito como cadeia de multiplicações */
+#define OPTIMIZER_MAX_POW 4
+
+/* Estatísticas de uma execução do otimizador */
+typedef struct {
+    int tokens_before;
+    int tokens_after;
+    int folded;         /* operações dobradas em constantes */
+    int powers;         /* potências inteiras reescritas */
+    int reciprocals;    /* divisões por constante reescritas */
+    int negations;      /* pares de NEG removidos */
+} OptimizerStats;
+
+/* Liga/desliga o otimizador em plot_generate_samples (padrão: ligado) */
+extern int optimizer_enabled;
+
+/* Otimiza `rpn` em `out` (inicializado pela função). Programas estruturalmente
+ * inválidos são copiados sem alteração. `stats` pode ser NULL.
+ * Retorna 0 se faltar memória (out fica liberado). */
+int optimizer_run(const TokenBuffer *rpn, TokenBuffer *out, OptimizerStats *stats);
+
+/* Tokens economizados (negativo se as cadeias de multiplicação aumentaram o programa) */
+int optimizer_saved(const OptimizerStats *stats);
+
+#endif /* OPTIMIZER_H */
@@ -0,0 +1,123 @@
+/* Saída de texto bufferizada para os renderizadores.
+ *
+ * Os renderizadores escrevem um ou dois doubles por ponto; com printf, a
+ * formatação genérica (e sensível a locale) da libc domina o tempo. OutBuf
+ * acumula o texto num buffer grande e descarrega com fwrite, e
+ * outbuf_fixed() formata com casas decimais fixas sem passar pelo printf.
+ *
+ * format_fixed() produz exatamente o texto de printf("%.*f") no locale "C"
+ * (o do programa): arredondamento correto do valor binário exato, empate
+ * para o par, "-0.00" para negativos pequenos, "nan"/"inf" com sinal.
+ *
+ * O destino é um OutSink: um FILE*, um fd (write/writev), um buffer em
+ * memória que cresce (malloc ou arena) ou um arquivo mapeado com mmap. Nos
+ * dois últimos o OutBuf escreve direto na memória do destino, sem passar
+ * pelo buffer próprio: um servidor renderiza no buffer da resposta e o modo
+ * lote no arquivo final, sem cópias.
+ */
+#ifndef OUTBUF_H
+#define OUTBUF_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <sys/uio.h>
+#include "arena.h"
+
+/* Tamanho do buffer de OutBuf */
+#define OUTBUF_SIZE (64 * 1024)
+
+/* Casas decimais aceitas por format_fixed */
+#define FORMAT_FIXED_MAX_DECIMALS 9
+
+/* Espaço que basta para qualquer saída de format_fixed (1e308 com 9 casas) */
+#define FORMAT_FIXED_MAX_LEN 330
+
+/* Tamanho inicial do mapeamento de OUTSINK_MMAP (o arquivo cresce dobrando) */
+#define OUTSINK_MMAP_INITIAL (1024 * 1024)
+
+/* Pedaços por chamada a writev em outsink_writev (mais que isso vai em
+ * várias chamadas) */
+#define OUTSINK_IOV_MAX 16
+
+typedef enum {
+    OUTSINK_FILE,       /* fwrite num FILE* */
+    OUTSINK_FD,         /* write/writev num descritor */
+    OUTSINK_MEMORY,     /* buffer que cresce: data[0..len) */
+    OUTSINK_MMAP        /* arquivo mapeado: data[0..len) */
+} OutSinkKind;
+
+typedef struct {
+    OutSinkKind kind;
+    FILE *file;         /* OUTSINK_FILE */
+    int fd;             /* OUTSINK_FD e OUTSINK_MMAP */
+    char *data;         /* OUTSINK_MEMORY e OUTSINK_MMAP */
+    size_t len;         /* bytes entregues (memória/mmap: válidos em data) */
+    size_t capacity;    /* bytes alocados/mapeados em data */
+    Arena *arena;       /* OUTSINK_MEMORY: buffer na arena (NULL: malloc) */
+    int error;          /* alguma escrita falhou (o resto é descartado) */
+} OutSink;
+
+void outsink_file(OutSink *sink, FILE *file);
+void outsink_fd(OutSink *sink, int fd);
+
+/* Buffer em memória na arena (cresce no lugar enquanto for a última
+ * alocação dela) ou, com arena NULL, no heap (liberar com outsink_free) */
+void outsink_memory(OutSink *sink, Arena *arena);
+
+/* Arquivo regular aberto com O_RDWR (e vazio) escrito por um mapeamento
+ * que cresce com ftruncate; outsink_finish corta no tamanho escrito. Se o
+ * fd não puder ser mapeado (pipe, socket), vira OUTSINK_FD e retorna 0. */
+int outsink_mmap(OutSink *sink, int fd);
+
+/* Escreve n bytes. Retorna 0 se o sink está com erro. */
+int outsink_write(OutSink *sink, const void *data, size_t n);
+
+/* Escreve os `n` pedaços em ordem; num fd, com uma chamada a writev para
+ * cada OUTSINK_IOV_MAX pedaços (repetida em escritas parciais). */
+int outsink_writev(OutSink *sink, const struct iovec *iov, int n);
+
+/* Memória/mmap: garante `n` bytes livres em data + len e retorna esse
+ * endereço (NULL sem memória, com error). Para quem escreve direto no
+ * destino, como o OutBuf; o conteúdo só conta depois de somado a len. */
+char *outsink_reserve(OutSink *sink, size_t n);
+
+/* Termina a saída: fflush (FILE) ou desmapeia e corta o arquivo no tamanho
+ * escrito (mmap). Retorna 0 se alguma escrita falhou. */
+int outsink_finish(OutSink *sink);
+
+/* Libera o buffer de OUTSINK_MEMORY no heap (na arena não faz nada) */
+void outsink_free(OutSink *sink);
+
+typedef struct {
+    OutSink *sink;
+    OutSink arquivo;        /* sink de outbuf_init */
+    char *buf;              /* janela de escrita: `local` ou a memória do sink */
+    size_t len;             /* bytes na janela ainda não entregues */
+    size_t size;            /* tamanho da janela */
+    char local[OUTBUF_SIZE];
+} OutBuf;
+
+/* Escreve v com `decimals` casas (0..FORMAT_FIXED_MAX_DECIMALS) em dst, sem
+ * '\0'. Retorna o número de bytes escritos (no máximo FORMAT_FIXED_MAX_LEN). */
+int format_fixed(char *dst, double v, int decimals);
+
+void outbuf_init(OutBuf *ob, FILE *out);
+
+/* OutBuf sobre um sink. Com memória/mmap a escrita vai direto para o sink. */
+void outbuf_init_sink(OutBuf *ob, OutSink *sink);
+
+/* Entrega o que está na janela ao sink (chamar ao terminar; depois de
+ * escrever no sink por outro caminho, recomece com outbuf_init_sink) */
+void outbuf_flush(OutBuf *ob);
+
+void outbuf_write(OutBuf *ob, const char *s, size_t n);
+void outbuf_puts(OutBuf *ob, const char *s);
+void outbuf_putc(OutBuf *ob, char c);
+
+/* printf para as partes pouco frequentes (cabeçalhos, grade) */
+void outbuf_printf(OutBuf *ob, const char *fmt, ...);
+
+/* Mesmo texto de printf("%.*f", decimals, v) */
+void outbuf_fixed(OutBuf *ob, double v, int decimals);
+
+#endif /* OUTBUF_H */
@@ -2,6 +2,7 @@
 #define PARSER_H
 
 #include "tokens.h"
+#include "arena.h"
 
 /* Define configuração global de locale */
 extern LocaleConfig parser_locale;
@@ -16,6 +17,9 @@ typedef struct {
     double *values;
     int values_size;
     int values_capacity;
+    
+    /* Não NULL: arrays alocados na arena (parser_free_buffer não libera) */
+    Arena *arena;
 } TokenBuffer;
 
 /* Estados de parsing */
@@ -37,9 +41,27 @@ ParserError parser_tokenize(const char *expr, TokenBuffer *output);
 /* Função para converter para RPN */
 ParserError parser_to_rpn(TokenBuffer *tokens, TokenBuffer *rpn);
 
+/* Como parser_tokenize/parser_to_rpn, com a saída alocada em `arena`
+ * (NULL: malloc). O buffer vale até o próximo arena_reset. */
+ParserError parser_tokenize_arena(const char *expr, TokenBuffer *output, Arena *arena);
+ParserError parser_to_rpn_arena(TokenBuffer *tokens, TokenBuffer *rpn, Arena *arena);
+
+/* Tokenização, validação e RPN numa só passada pela string: o mesmo RPN e
+ * os mesmos ParserError de parser_tokenize seguido de parser_to_rpn, sem o
+ * buffer de tokens intermediário. */
+ParserError parser_compile(const char *expr, TokenBuffer *rpn);
+ParserError parser_compile_arena(const char *expr, TokenBuffer *rpn, Arena *arena);
+
 /* Funções auxiliares */
 void parser_init_buffer(TokenBuffer *buf);
+void parser_init_buffer_arena(TokenBuffer *buf, Arena *arena);
 void parser_free_buffer(TokenBuffer *buf);
 int parser_add_token(TokenBuffer *buf, Token token);
 
+/* Adiciona um valor numérico ao buffer. Retorna o índice ou -1 sem memória. */
+int parser_add_value(TokenBuffer *buf, double value);
+
+/* Copia tokens e valores de src para dst (dst é inicializado). Retorna 0 sem memória. */
+int parser_copy_buffer(const TokenBuffer *src, TokenBuffer *dst);
+
 #endif /* PARSER_H */
@@ -0,0 +1,83 @@
+/* Formato binário colunar de PlotData (`multicurvas <expr> bin`).
+ *
+ * Feito para ser mapeado com mmap e usado sem parsing. Tudo little-endian:
+ *
+ *   0   char     magic[8]      "MCURVAS\0"
+ *   8   uint32   version       PLOTBIN_VERSION
+ *   12  uint32   header_size   PLOTBIN_HEADER_SIZE
+ *   16  uint32   type          PlotType
+ *   20  uint32   flags         0 (reservado)
+ *   24  double   C, D          intervalo (plot_get_interval: polar em
+ *                                múltiplos de pi)
+ *   40  uint64   samples       linhas das colunas (amostras avaliadas)
+ *   48  uint64   count         amostras válidas (status 0)
+ *   56  uint64   x_offset      double[samples]
+ *   64  uint64   y_offset      double[samples]
+ *   72  uint64   status_offset uint8[samples] (0 = ok, 1 = inválida)
+ *   80  ...      zeros até header_size
+ *
+ * As colunas começam em múltiplos de PLOTBIN_ALIGN. A linha i de x, y e
+ * status é a amostra i; amostras inválidas têm x = y = NaN.
+ */
+#ifndef PLOTBIN_H
+#define PLOTBIN_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "multicurvas_plot.h"
+#include "outbuf.h"
+
+#define PLOTBIN_MAGIC "MCURVAS"
+#define PLOTBIN_VERSION 1
+#define PLOTBIN_HEADER_SIZE 128
+#define PLOTBIN_ALIGN 64
+
+/* Arquivo aberto por plotbin_open (somente leitura) */
+typedef struct {
+    PlotType type;
+    double C;
+    double D;
+    uint64_t samples;
+    uint64_t count;
+    const double *x;        /* samples valores */
+    const double *y;        /* samples valores */
+    const uint8_t *status;  /* samples valores */
+    void *map;              /* mapeamento (ou cópia convertida) */
+    size_t size;
+    int mapped;             /* 1: munmap ao fechar; 0: free */
+} PlotBinFile;
+
+/* Escreve `data` (gerado de `plot`) no formato binário.
+ * Retorna 1 em caso de sucesso, 0 se a escrita falhar. */
+int plotbin_write(FILE *out, const Plot *plot, const PlotData *data);
+
+/* plotbin_write num sink (outbuf.h). Em memória ou mmap o arquivo inteiro é
+ * reservado de uma vez e as colunas são escritas no lugar. */
+int plotbin_write_sink(OutSink *out, const Plot *plot, const PlotData *data);
+
+/* Grava as amostras de `sampler` bloco a bloco, cada uma direto na sua
+ * posição nas colunas (pwrite), com memória constante; o número de válidas
+ * entra no cabeçalho no fim. `fd` precisa ser um arquivo comum sem O_APPEND:
+ * a gravação começa na posição atual e termina com o fd no fim do arquivo.
+ * Retorna 1 em caso de sucesso, 0 se a escrita falhar e -1 (sem escrever
+ * nada) se fd não permitir gravação posicionada (pipe, terminal). */
+int plotbin_write_stream(int fd, const Plot *plot, PlotSampler *sampler);
+
+/* Mapeia o arquivo e valida cabeçalho e colunas. Em hosts big-endian as
+ * colunas são convertidas numa cópia. Retorna NULL em caso de erro (errmsg,
+ * se não for NULL, recebe a mensagem; caller deve liberar). */
+PlotBinFile *plotbin_open(const char *path, char **errmsg);
+
+void plotbin_close(PlotBinFile *f);
+
+/* Máximo de amostras de plotbin_to_plotdata (contadores int de PlotData).
+ * plotbin_write_stream grava arquivos maiores, que continuam legíveis por
+ * plotbin_open. */
+#define PLOTBIN_MAX_PLOTDATA INT32_MAX
+
+/* PlotData compactado (só os pontos válidos em x/y), pronto para os
+ * renderizadores. Retorna NULL se faltar memória ou se o arquivo tiver mais
+ * de PLOTBIN_MAX_PLOTDATA amostras. */
+PlotData *plotbin_to_plotdata(const PlotBinFile *f);
+
+#endif /* PLOTBIN_H */
@@ -0,0 +1,36 @@
+/* Presets nativos: as curvas de gerar_77_curvas.sh compiladas para C por
+ * `make presets` (multicurvas --emit-presets → src/presets_gen.c).
+ *
+ * Cada preset já traz o tipo, as expressões (para o título), o intervalo
+ * resolvido e a função de avaliação nativa: `multicurvas --preset 49` não
+ * tokeniza nem compila nada na inicialização.
+ */
+#ifndef PRESETS_H
+#define PRESETS_H
+
+#include "multicurvas_plot.h"
+
+typedef struct {
+    const char *id;         /* Número da curva no programa original ("49", "53a") */
+    const char *name;       /* Nome da curva */
+    const char *spec;       /* Entrada equivalente para plot_parse_text() */
+    PlotType type;
+    const char *expr1;
+    const char *expr2;
+    double C;
+    double D;
+    int has_interval;
+    PlotNativeFn eval;      /* Avaliação nativa (mesmos valores e erros do avaliador) */
+} PlotPreset;
+
+/* Catálogo gerado (src/presets_gen.c) */
+extern const PlotPreset plot_presets[];
+extern const int plot_presets_count;
+
+/* Procura um preset pelo número. Retorna NULL se não existe. */
+const PlotPreset *plot_preset_find(const char *id);
+
+/* Cria um Plot a partir do preset (liberar com plot_free). NULL sem memória. */
+Plot *plot_from_preset(const PlotPreset *preset);
+
+#endif /* PRESETS_H */
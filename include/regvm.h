@@ -0,0 +1,85 @@
+/* Máquina virtual de registradores compilada a partir do RPN.
+ *
+ * O compilador percorre o RPN uma vez simulando a pilha e monta um DAG com
+ * numeração de valores: subexpressões repetidas (dentro de uma expressão ou
+ * entre as expressões X e Y de uma curva paramétrica) são calculadas uma
+ * única vez. O DAG vira instruções de três endereços (dst = a op b) sobre um
+ * arquivo de registradores fixo, alocado em tempo de compilação:
+ *
+ *   r0                  variável (x, theta ou t)
+ *   r1 .. rK            constantes (números, pi, e) — sem instrução de carga
+ *   rK+1 ..             temporários (alocação linear pelo tempo de vida)
+ *
+ * Assim números, constantes e a variável não geram instruções nem tráfego de
+ * pilha: `x*x+1` vira 2 instruções (MUL t0,r0,r0; ADD t0,t0,r1), e
+ * `cos(2*t)*cos(2*t)` vira 3 (MUL, COS, MUL).
+ *
+ * sin(u) e cos(u) do mesmo operando (na mesma expressão ou entre X e Y)
+ * viram uma única instrução SINCOS com dois destinos: a redução de argumento,
+ * a parte cara das duas funções, é feita uma vez.
+ */
+#ifndef REGVM_H
+#define REGVM_H
+
+#include "evaluator.h"
+
+/* Limite de registradores (operandos de 8 bits) */
+#define REGVM_MAX_REGS 256
+
+/* Registrador fixo da variável */
+#define REGVM_REG_VAR 0
+
+/* Opcode além dos TokenType: dst = sin(a), b = cos(a) */
+#define REGVM_OP_SINCOS 200
+
+/* Instrução de três endereços. `op` é o TokenType da operação
+ * (operador binário, TOKEN_NEG ou função unária) ou REGVM_OP_SINCOS. */
+typedef struct {
+    uint8_t op;
+    uint8_t dst;
+    uint8_t a;
+    uint8_t b;          /* operadores binários; destino do cos em SINCOS */
+} RegInstr;
+
+typedef struct {
+    RegInstr *code;
+    int size;               /* número de instruções */
+    double *consts;         /* valores de r1..r(nconsts) */
+    int nconsts;
+    int nregs;              /* total de registradores usados */
+    int noutputs;           /* expressões compiladas juntas (1..EVAL_MAX_OUTPUTS) */
+    uint8_t result[EVAL_MAX_OUTPUTS];       /* registrador com o resultado de cada saída */
+    EvalError stop_error[EVAL_MAX_OUTPUTS]; /* erro estrutural de cada saída (EVAL_OK se válida) */
+    /* rank[k * size + i]: posição da instrução i na ordem de avaliação original
+     * da saída k (REGVM_NO_RANK se a saída não depende dela). Usado para
+     * reportar o mesmo EvalError que a avaliação isolada da expressão. */
+    uint16_t *rank;
+} RegProgram;
+
+#define REGVM_NO_RANK 0xFFFF
+
+/* Compila RPN para a forma de registradores.
+ * Retorna NULL sem memória ou se o programa exceder REGVM_MAX_REGS. */
+RegProgram *regvm_compile(const TokenBuffer *rpn);
+
+/* Compila `count` programas (1..EVAL_MAX_OUTPUTS) que compartilham a variável
+ * em um único DAG com subexpressões comuns. */
+RegProgram *regvm_compile_multi(const TokenBuffer *const *rpns, int count);
+
+/* Avalia a saída 0 para um valor da variável */
+EvalResult regvm_eval(const RegProgram *prog, double var_value);
+
+/* Avalia todas as saídas: results[k] é idêntico a avaliar a expressão k isolada */
+void regvm_eval_multi(const RegProgram *prog, double var_value, EvalResult *results);
+
+/* Avalia sobre n amostras (coluna por coluna, usando os kernels SIMD).
+ * out[k]/status[k] recebem a saída k; entradas NULL são ignoradas.
+ * `status` NULL: sem verificação de erros, para faixas em que nenhuma amostra
+ * pode falhar (provado por interval.h); os valores são os mesmos. */
+void regvm_eval_batch(const RegProgram *prog, const double *in,
+                      double *const *out, uint8_t *const *status, size_t n);
+
+/* Libera o programa */
+void regvm_free(RegProgram *prog);
+
+#endif /* REGVM_H */
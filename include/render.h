@@ -3,12 +3,66 @@
 #define RENDER_H
 
 #include "multicurvas_plot.h"
+#include "outbuf.h"
 #include <stdio.h>
 
 /* Renderiza dados em formato CSV para stdout */
 void render_csv(const PlotData *data);
 
+/* render_csv em `out` */
+void render_csv_file(FILE *out, const PlotData *data);
+
+/* render_csv num sink (outbuf.h): em memória ou mmap o texto é formatado
+ * direto no destino */
+void render_csv_sink(OutSink *out, const PlotData *data);
+
+/* Renderiza dados no formato binário colunar (plotbin.h) para stdout, com
+ * tipo e intervalo de `plot` no cabeçalho. Retorna 0 se a escrita falhar. */
+int render_bin(const PlotData *data, const Plot *plot);
+
+/* render_csv consumindo os blocos de uma amostragem sob demanda, à medida
+ * que são avaliados (memória constante). Retorna 0 se a escrita falhar. */
+int render_csv_stream(PlotSampler *sampler);
+
+/* render_bin em streaming (plotbin_write_stream sobre stdout). Retorna 1 em
+ * caso de sucesso, 0 se a escrita falhar e -1 se stdout não for um arquivo
+ * comum (nada é escrito; use render_bin). */
+int render_bin_stream(PlotSampler *sampler, const Plot *plot);
+
+/* Tolerância (pixels) da simplificação da poligonal em render_svg.
+ * 0 (padrão): todos os pontos válidos são emitidos. */
+extern double render_simplify_tolerance;
+
 /* Renderiza dados em formato SVG para stdout com canvas ajustável */
 void render_svg(const PlotData *data, const char *title, int canvas_w, int canvas_h);
 
+/* render_svg em `out` */
+void render_svg_file(FILE *out, const PlotData *data, const char *title,
+                     int canvas_w, int canvas_h);
+
+/* render_svg num sink */
+void render_svg_sink(OutSink *out, const PlotData *data, const char *title,
+                     int canvas_w, int canvas_h);
+
+/* Renderiza `data` (gerado de `plot`) em `out` no formato "csv", "svg" ou
+ * "bin", como a CLI: o SVG de Y=f(x) com mais de 4 pontos por pixel de
+ * largura passa antes pela decimação M4 (decimate.h). Retorna 0 se a
+ * escrita falhar. */
+int render_plot(FILE *out, const Plot *plot, const PlotData *data, const char *title,
+                const char *format, int canvas_w, int canvas_h);
+
+/* render_plot num sink: o servidor renderiza no buffer da resposta e o modo
+ * lote no arquivo de destino mapeado. Retorna 0 se a escrita falhar (o sink
+ * fica com error). Não chama outsink_finish. */
+int render_plot_sink(OutSink *out, const Plot *plot, const PlotData *data, const char *title,
+                     const char *format, int canvas_w, int canvas_h);
+
+/* Ramer-Douglas-Peucker sobre os pontos (px[i], py[i]), i < n, em pixels:
+ * marca keep[i] = 1 nos pontos mantidos, de modo que nenhum ponto removido
+ * fique a mais de `tolerance` da poligonal resultante. O primeiro e o último
+ * pontos são sempre mantidos. Retorna o número de pontos mantidos
+ * (-1 se faltar memória; keep fica todo marcado). */
+int render_simplify(const double *px, const double *py, int n, double tolerance,
+                    unsigned char *keep);
+
 #endif /* RENDER_H */
@@ -0,0 +1,72 @@
+/* Modo servidor (`multicurvas --serve /caminho.sock`): um processo de longa
+ * duração que atende pedidos de curvas por um socket Unix (ou por
+ * stdin/stdout com `--serve -`), mantendo o pool de threads e o cache de
+ * programas compilados quentes entre os pedidos.
+ *
+ * Protocolo em linhas. Cada pedido é uma linha:
+ *
+ *   <expressão> [formato] [largura altura] [samples=N] [interval=C,D] [adaptive=TOL]
+ *
+ * com os campos separados como no modo lote (aspas duplas para espaços). A
+ * resposta é "OK <bytes>\n" seguida de exatamente <bytes> bytes do payload
+ * (CSV, SVG ou o formato binário de plotbin.h), ou "ERR <mensagem>\n".
+ * Comandos:
+ *
+ *   stats      estatísticas em texto ("chave valor" por linha): pedidos,
+ *              erros, latência p50/p99/máxima em ms e acertos/faltas do cache
+ *   quit       encerra a conexão
+ *   shutdown   encerra o servidor (responde "OK 0")
+ *
+ * Linhas vazias e comentários ('#') são ignorados. No socket, cada conexão
+ * é atendida por um worker do servidor, pedido a pedido, então as respostas
+ * saem na ordem dos pedidos; conexões diferentes rodam em paralelo.
+ */
+#ifndef SERVE_H
+#define SERVE_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/* Maior número de amostras aceito por pedido */
+#define SERVE_MAX_SAMPLES 10000000
+
+/* Pedidos considerados nos percentis de latência (os mais recentes) */
+#define SERVE_LATENCY_WINDOW 4096
+
+typedef struct Server Server;
+
+typedef struct {
+    uint64_t requests;      /* pedidos de curva atendidos (com ou sem erro) */
+    uint64_t errors;        /* respondidos com ERR */
+    double p50_ms;          /* latência: mediana da janela */
+    double p99_ms;
+    double max_ms;
+} ServerStats;
+
+/* Cria um servidor com `workers` conexões atendidas em paralelo
+ * (0: threadpool_default_threads()). NULL sem memória. */
+Server *server_create(int workers);
+
+/* Atende um pedido (uma linha) e escreve a resposta completa em `out`.
+ * Retorna 0 se a conexão deve ser encerrada (quit, shutdown), 1 senão. */
+int server_handle_line(Server *server, const char *line, FILE *out);
+
+/* Atende uma conexão: lê pedidos de `in_fd` e responde em `out_fd` até o
+ * fim da entrada, quit ou shutdown. Os fds continuam com o caller. */
+void server_serve_fd(Server *server, int in_fd, int out_fd);
+
+/* Escuta no socket Unix `path` e atende conexões com os workers até
+ * server_stop. O arquivo do socket é criado (um socket antigo no mesmo
+ * caminho é substituído) e removido no fim. Retorna 1 ao encerrar
+ * normalmente e 0 se não conseguir escutar (errmsg recebe a mensagem). */
+int server_listen(Server *server, const char *path, char **errmsg);
+
+/* Pede o encerramento: server_listen para de aceitar, as conexões abertas
+ * terminam o pedido em andamento. Pode ser chamada de um handler de sinal. */
+void server_stop(Server *server);
+
+ServerStats server_stats(Server *server);
+
+void server_destroy(Server *server);
+
+#endif /* SERVE_H */
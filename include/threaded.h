@@ -0,0 +1,29 @@
+/* Motor de código encadeado (direct threading) para expressões RPN.
+ *
+ * O RPN é pré-traduzido para um vetor de (endereço do handler, operando).
+ * Em GCC/Clang cada handler termina com `goto *próximo` (computed goto), de modo
+ * que cada token tem seu próprio desvio indireto — previsível pelo preditor de
+ * desvios — em vez do único `switch` compartilhado de evaluator_eval_rpn.
+ * Nos demais compiladores (ou com -DTHREADED_NO_COMPUTED_GOTO) usa uma tabela
+ * de ponteiros para função.
+ *
+ * As verificações de pilha são resolvidas na tradução (evaluator_validate_rpn);
+ * os erros retornados são idênticos aos do interpretador de referência.
+ */
+#ifndef THREADED_H
+#define THREADED_H
+
+#include "evaluator.h"
+
+typedef struct ThreadedProgram ThreadedProgram;
+
+/* Traduz o RPN para código encadeado. Retorna NULL se faltar memória. */
+ThreadedProgram *threaded_compile(const TokenBuffer *rpn);
+
+/* Executa o código encadeado para um valor da variável */
+EvalResult threaded_eval(const ThreadedProgram *prog, double var_value);
+
+/* Libera o programa traduzido */
+void threaded_free(ThreadedProgram *prog);
+
+#endif /* THREADED_H */
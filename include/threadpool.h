@@ -0,0 +1,45 @@
+/* Pool de threads persistente (pthreads) para laços paralelos.
+ *
+ * As threads são criadas uma vez e dormem entre os trabalhos. threadpool_run()
+ * distribui as tarefas 0..ntasks-1 entre as threads do pool e a própria
+ * thread chamadora e só retorna quando todas terminaram. A ordem de execução
+ * das tarefas não é definida: cada tarefa deve escrever só na sua parte da
+ * saída para que o resultado seja determinístico.
+ */
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+typedef struct ThreadPool ThreadPool;
+
+/* Uma tarefa: `task` é o índice (0..ntasks-1) */
+typedef void (*ThreadTask)(void *ctx, int task);
+
+/* Cria um pool com `nthreads` threads no total (a chamadora conta como uma;
+ * são criadas nthreads-1). Retorna NULL sem memória ou se pthread_create falhar. */
+ThreadPool *threadpool_create(int nthreads);
+
+/* Número total de threads (incluindo a chamadora) */
+int threadpool_threads(const ThreadPool *pool);
+
+/* Executa fn(ctx, 0..ntasks-1) e espera todas. Chamadas concorrentes no
+ * mesmo pool são serializadas. pool NULL executa tudo na thread atual. */
+void threadpool_run(ThreadPool *pool, ThreadTask fn, void *ctx, int ntasks);
+
+/* Encerra as threads e libera o pool */
+void threadpool_destroy(ThreadPool *pool);
+
+/* Número de CPUs disponíveis (1 se desconhecido) */
+int threadpool_cpu_count(void);
+
+/* Threads do pool compartilhado (usado por plot_generate_samples). 0 = uma
+ * thread por CPU (padrão); 1 = sem threads. Mudar o número recria o pool no
+ * próximo uso: não chamar enquanto houver amostragem em andamento. */
+void threadpool_set_default_threads(int nthreads);
+
+/* Número de threads do pool compartilhado */
+int threadpool_default_threads(void);
+
+/* Pool compartilhado, criado no primeiro uso; NULL com uma única thread */
+ThreadPool *threadpool_default(void);
+
+#endif /* THREADPOOL_H */
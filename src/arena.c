@@ -0,0 +1,153 @@
+/* Arena: blocos encadeados, alocação por incremento de um ponteiro */
+#define _POSIX_C_SOURCE 200112L  /* posix_memalign */
+
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+struct ArenaBlock {
+    ArenaBlock *prev;       /* bloco cheio anterior */
+    size_t size;            /* bytes de dados */
+    size_t pos;             /* próximo byte livre */
+};
+
+/* Os dados começam no primeiro endereço alinhado depois do cabeçalho */
+#define CABECALHO ((sizeof(ArenaBlock) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+static unsigned char *dados(ArenaBlock *b) {
+    return (unsigned char *)b + CABECALHO;
+}
+
+static size_t alinhar(size_t n) {
+    return (n + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+static ArenaBlock *novo_bloco(Arena *arena, size_t size) {
+    void *mem;
+    if (posix_memalign(&mem, ARENA_ALIGNMENT, CABECALHO + size) != 0) return NULL;
+    ArenaBlock *b = mem;
+    b->prev = NULL;
+    b->size = size;
+    b->pos = 0;
+    arena->mallocs++;
+    return b;
+}
+
+Arena *arena_create(size_t block_size) {
+    Arena *arena = calloc(1, sizeof(Arena));
+    if (!arena) return NULL;
+    arena->block_size = block_size ? alinhar(block_size) : ARENA_DEFAULT_BLOCK;
+    arena->block = novo_bloco(arena, arena->block_size);
+    if (!arena->block) {
+        free(arena);
+        return NULL;
+    }
+    return arena;
+}
+
+void *arena_alloc(Arena *arena, size_t size) {
+    size = alinhar(size ? size : 1);
+    ArenaBlock *b = arena->block;
+    if (b->size - b->pos < size) {
+        // Bloco novo pelo menos do dobro do atual: poucos blocos até o reset
+        size_t n = b->size * 2;
+        if (n < arena->block_size) n = arena->block_size;
+        if (n < size) n = size;
+        ArenaBlock *novo = novo_bloco(arena, n);
+        if (!novo) return NULL;
+        novo->prev = b;
+        arena->block = b = novo;
+    }
+    void *p = dados(b) + b->pos;
+    b->pos += size;
+    arena->used += size;
+    arena->last = p;
+    return p;
+}
+
+void *arena_calloc(Arena *arena, size_t count, size_t size) {
+    if (size && count > (size_t)-1 / size) return NULL;
+    void *p = arena_alloc(arena, count * size);
+    if (p) memset(p, 0, count * size);
+    return p;
+}
+
+void *arena_realloc(Arena *arena, void *ptr, size_t old_size, size_t size) {
+    if (!ptr) return arena_alloc(arena, size);
+    if (size <= old_size) return ptr;
+
+    // Última alocação do bloco atual: só avança o ponteiro
+    ArenaBlock *b = arena->block;
+    if (ptr == arena->last) {
+        size_t inicio = (unsigned char *)ptr - dados(b);
+        size_t antigo = alinhar(old_size ? old_size : 1);
+        size_t novo = alinhar(size);
+        if (novo <= b->size - inicio) {
+            b->pos = inicio + novo;
+            arena->used += novo - antigo;
+            return ptr;
+        }
+    }
+
+    void *p = arena_alloc(arena, size);
+    if (p) memcpy(p, ptr, old_size);
+    return p;
+}
+
+char *arena_strdup(Arena *arena, const char *s) {
+    size_t n = strlen(s) + 1;
+    char *p = arena_alloc(arena, n);
+    if (p) memcpy(p, s, n);
+    return p;
+}
+
+void arena_reset(Arena *arena) {
+    ArenaBlock *b = arena->block;
+    if (b->prev) {
+        // Vários blocos: troca por um só, com a capacidade total
+        size_t total = 0;
+        for (ArenaBlock *i = b; i; i = i->prev) total += i->size;
+        ArenaBlock *unico = novo_bloco(arena, total);
+        if (unico) {
+            while (b) {
+                ArenaBlock *prev = b->prev;
+                free(b);
+                b = prev;
+            }
+            arena->block = b = unico;
+        } else {
+            // Sem memória para juntar: fica só com o maior (o atual)
+            for (ArenaBlock *i = b->prev; i;) {
+                ArenaBlock *prev = i->prev;
+                free(i);
+                i = prev;
+            }
+            b->prev = NULL;
+        }
+    }
+    b->pos = 0;
+    arena->used = 0;
+    arena->last = NULL;
+}
+
+ArenaStats arena_stats(const Arena *arena) {
+    ArenaStats st = {0};
+    st.used = arena->used;
+    for (ArenaBlock *b = arena->block; b; b = b->prev) {
+        st.capacity += b->size;
+        st.blocks++;
+    }
+    st.mallocs = arena->mallocs;
+    return st;
+}
+
+void arena_destroy(Arena *arena) {
+    if (!arena) return;
+    ArenaBlock *b = arena->block;
+    while (b) {
+        ArenaBlock *prev = b->prev;
+        free(b);
+        b = prev;
+    }
+    free(arena);
+}
@@ -0,0 +1,303 @@
+/* Modo lote: leitura das especificações e geração em paralelo (cada worker
+ * pega o próximo trabalho e usa a sua arena para Plot, PlotData e caminho) */
+#define _POSIX_C_SOURCE 200809L  /* getline, strdup, strerror_r, clock_gettime, open */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "batch.h"
+#include "multicurvas_plot.h"
+#include "render.h"
+#include "threadpool.h"
+
+#define BATCH_MAX_CAMPOS 5
+
+/* Mensagem "prefixo: detalhe" alocada (NULL se faltar memória) */
+static char *mensagem(const char *prefixo, const char *detalhe) {
+    if (!detalhe) detalhe = "desconhecido";
+    size_t n = strlen(prefixo) + strlen(detalhe) + 3;
+    char *msg = malloc(n);
+    if (msg) snprintf(msg, n, "%s: %s", prefixo, detalhe);
+    return msg;
+}
+
+int batch_split_fields(const char *line, char **campos, int max, const char **erro) {
+    int n = 0;
+    const char *p = line;
+    for (;;) {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+        if (*p == '\0') break;
+        if (n == 0 && *p == '#') break;
+        if (n == max) {
+            *erro = "campos demais";
+            goto falha;
+        }
+
+        const char *inicio = p;
+        size_t len;
+        if (*p == '"') {
+            inicio = ++p;
+            while (*p && *p != '"') p++;
+            if (*p != '"') {
+                *erro = "aspas sem fechamento";
+                goto falha;
+            }
+            len = p - inicio;
+            p++;
+        } else {
+            while (*p && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') p++;
+            len = p - inicio;
+        }
+        campos[n] = malloc(len + 1);
+        if (!campos[n]) {
+            *erro = "memória insuficiente";
+            goto falha;
+        }
+        memcpy(campos[n], inicio, len);
+        campos[n][len] = '\0';
+        n++;
+    }
+    return n;
+
+falha:
+    while (n > 0) free(campos[--n]);
+    return -1;
+}
+
+/* Inteiro positivo escrito por inteiro no campo; 0 se inválido */
+static int dimensao(const char *campo) {
+    char *fim;
+    long v = strtol(campo, &fim, 10);
+    if (*fim != '\0' || v <= 0 || v > 100000) return 0;
+    return (int)v;
+}
+
+static int formato_valido(const char *formato) {
+    return strcmp(formato, "csv") == 0 || strcmp(formato, "svg") == 0 ||
+           strcmp(formato, "bin") == 0;
+}
+
+int batch_parse_line(const char *line, BatchJob *job, char **errmsg) {
+    char *campos[BATCH_MAX_CAMPOS];
+    const char *erro = NULL;
+    int n = batch_split_fields(line, campos, BATCH_MAX_CAMPOS, &erro);
+    if (n == 0) return 0;
+
+    job->expr = NULL;
+    job->output = NULL;
+    strcpy(job->format, "svg");
+    job->canvas_w = 800;
+    job->canvas_h = 600;
+
+    // <expressão> [formato] [largura altura] <arquivo>
+    if (n == 1) erro = "falta o arquivo de saída";
+    const char *formato = NULL, *largura = NULL, *altura = NULL;
+    if (n == 3 || n == 5) formato = campos[1];
+    if (n == 4 || n == 5) {
+        largura = campos[n - 3];
+        altura = campos[n - 2];
+    }
+    if (!erro && formato && !formato_valido(formato)) {
+        erro = "formato inválido (use csv, svg ou bin)";
+    }
+    if (!erro && largura) {
+        job->canvas_w = dimensao(largura);
+        job->canvas_h = dimensao(altura);
+        if (!job->canvas_w || !job->canvas_h) erro = "largura/altura inválida";
+    }
+    const char *saida = n >= 2 ? campos[n - 1] : NULL;
+    if (!erro && (saida[0] == '\0' || strchr(saida, '/') || strcmp(saida, "..") == 0)) {
+        erro = "nome do arquivo de saída inválido";
+    }
+
+    if (!erro) {
+        if (!formato) {
+            // Sem formato: vem da extensão do arquivo
+            const char *ext = strrchr(saida, '.');
+            formato = (ext && formato_valido(ext + 1)) ? ext + 1 : "svg";
+        }
+        strcpy(job->format, formato);
+        job->expr = campos[0];
+        job->output = campos[n - 1];
+        campos[0] = campos[n - 1] = NULL;
+    }
+    for (int i = 0; i < n; i++) free(campos[i]);
+    if (erro) {
+        if (errmsg) *errmsg = strdup(erro);
+        return -1;
+    }
+    return 1;
+}
+
+/* Acrescenta um trabalho zerado; NULL se faltar memória */
+static BatchJob *novo_trabalho(Batch *batch) {
+    if (batch->count == batch->capacity) {
+        int cap = batch->capacity ? 2 * batch->capacity : 64;
+        BatchJob *jobs = realloc(batch->jobs, cap * sizeof(BatchJob));
+        if (!jobs) return NULL;
+        batch->jobs = jobs;
+        batch->capacity = cap;
+    }
+    BatchJob *job = &batch->jobs[batch->count];
+    memset(job, 0, sizeof(BatchJob));
+    return job;
+}
+
+Batch *batch_read(FILE *in) {
+    Batch *batch = calloc(1, sizeof(Batch));
+    if (!batch) return NULL;
+
+    char *line = NULL;
+    size_t cap = 0;
+    int lineno = 0;
+    while (getline(&line, &cap, in) != -1) {
+        lineno++;
+        BatchJob *job = novo_trabalho(batch);
+        if (!job) {
+            free(line);
+            batch_free(batch);
+            return NULL;
+        }
+        char *errmsg = NULL;
+        int r = batch_parse_line(line, job, &errmsg);
+        if (r == 0) continue;
+        job->line = lineno;
+        if (r < 0) job->errmsg = mensagem("Linha inválida", errmsg);
+        free(errmsg);
+        batch->count++;
+    }
+    free(line);
+    return batch;
+}
+
+/* Tamanho a partir do qual o formato binário é gravado com mmap (as colunas
+ * vão direto para o arquivo); abaixo disso, e em texto, write é mais rápido
+ * que o custo de mapear e das faltas de página */
+#define LOTE_MMAP_MIN (4u << 20)
+
+/* Gera e grava um trabalho com a memória em `arena` (NULL: malloc); em caso
+ * de falha preenche job->errmsg */
+static void executar(BatchJob *job, const char *outdir, const BatchOptions *opts,
+                     Arena *arena) {
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    char *errmsg = NULL;
+    Plot *plot = plot_parse_text_arena(job->expr, arena, &errmsg);
+    if (!plot) {
+        job->errmsg = mensagem("Erro ao interpretar expressão", errmsg);
+        free(errmsg);
+        return;
+    }
+    if (opts && opts->samples > 0) plot->samples = opts->samples;
+    if (opts && opts->adaptive > 0) {
+        plot_set_adaptive(plot, opts->adaptive, job->canvas_w, job->canvas_h);
+    }
+    if (opts && opts->float32 && strcmp(job->format, "svg") == 0) {
+        plot->precision = PLOT_FLOAT32;
+    }
+    PlotData *data = plot_generate_samples_arena(plot, arena, &errmsg);
+    if (!data) {
+        job->errmsg = mensagem("Erro ao gerar dados", errmsg);
+        free(errmsg);
+        plot_free(plot);
+        return;
+    }
+
+    size_t n = strlen(outdir) + strlen(job->output) + 2;
+    char *caminho = arena ? arena_alloc(arena, n) : malloc(n);
+    int fd = -1;
+    if (caminho) {
+        snprintf(caminho, n, "%s/%s", outdir, job->output);
+        fd = open(caminho, O_RDWR | O_CREAT | O_TRUNC, 0666);
+    }
+    if (fd < 0) {
+        char detalhe[128] = "memória insuficiente";
+        if (caminho) strerror_r(errno, detalhe, sizeof(detalhe));
+        job->errmsg = mensagem("Erro ao criar o arquivo de saída", detalhe);
+    } else {
+        OutSink out;
+        if (strcmp(job->format, "bin") == 0 && 16.0 * data->samples >= LOTE_MMAP_MIN) {
+            outsink_mmap(&out, fd);
+        } else {
+            outsink_fd(&out, fd);
+        }
+        int ok = render_plot_sink(&out, plot, data, job->expr, job->format,
+                                  job->canvas_w, job->canvas_h);
+        if (!outsink_finish(&out)) ok = 0;
+        if (close(fd) != 0) ok = 0;
+        if (ok) {
+            job->ok = 1;
+            job->count = data->count;
+        } else {
+            unlink(caminho);
+            job->errmsg = mensagem("Erro ao escrever", job->output);
+        }
+    }
+    if (!arena) free(caminho);
+    plot_data_free(data);
+    plot_free(plot);
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    job->ms = (t1.tv_sec - t0.tv_sec) * 1e3 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+}
+
+typedef struct {
+    Batch *batch;
+    const char *outdir;
+    const BatchOptions *opts;
+    int proximo;            /* próximo trabalho (__atomic) */
+} Lote;
+
+/* Um worker: trabalhos em sequência, com a arena zerada entre eles */
+static void tarefa_lote(void *ctx, int task) {
+    (void)task;
+    Lote *lote = ctx;
+    Arena *arena = arena_create(0);
+    int i;
+    while ((i = __atomic_fetch_add(&lote->proximo, 1, __ATOMIC_RELAXED)) < lote->batch->count) {
+        BatchJob *job = &lote->batch->jobs[i];
+        if (!job->expr) continue;   /* linha inválida */
+        job->ok = 0;
+        job->count = 0;
+        free(job->errmsg);
+        job->errmsg = NULL;
+        executar(job, lote->outdir, lote->opts, arena);
+        if (arena) arena_reset(arena);
+    }
+    arena_destroy(arena);
+}
+
+int batch_run(Batch *batch, const char *outdir, const BatchOptions *opts) {
+    if (!batch) return 0;
+
+    // Pool próprio: as amostragens grandes usam o pool compartilhado, e
+    // threadpool_run no mesmo pool a partir de uma tarefa não é permitido
+    int workers = (opts && opts->workers > 0) ? opts->workers : threadpool_default_threads();
+    if (workers > batch->count) workers = batch->count;
+    ThreadPool *pool = workers > 1 ? threadpool_create(workers) : NULL;
+    if (workers < 1) workers = 1;
+    Lote lote = { batch, outdir, opts, 0 };
+    threadpool_run(pool, tarefa_lote, &lote, workers);
+    threadpool_destroy(pool);
+
+    int falhas = 0;
+    for (int i = 0; i < batch->count; i++) {
+        if (!batch->jobs[i].ok) falhas++;
+    }
+    return falhas;
+}
+
+void batch_free(Batch *batch) {
+    if (!batch) return;
+    for (int i = 0; i < batch->count; i++) {
+        free(batch->jobs[i].expr);
+        free(batch->jobs[i].output);
+        free(batch->jobs[i].errmsg);
+    }
+    free(batch->jobs);
+    free(batch);
+}
@@ -0,0 +1,438 @@
+/* Gerador de código C: Plot → máquina de registradores → C em linha reta */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "codegen.h"
+#include "regvm.h"
+
+/* Literal C exato para um double (hexadecimal do C99) */
+static void format_double(double value, char *buf, size_t size, int parens) {
+    if (isnan(value)) {
+        snprintf(buf, size, "NAN");
+    } else if (isinf(value)) {
+        snprintf(buf, size, value > 0 ? "HUGE_VAL" : (parens ? "(-HUGE_VAL)" : "-HUGE_VAL"));
+    } else if (signbit(value) && parens) {
+        snprintf(buf, size, "(%a)", value);
+    } else {
+        snprintf(buf, size, "%a", value);
+    }
+}
+
+/* Operando: variável, constante (literal) ou temporário */
+static void format_operand(const RegProgram *prog, int r, char *buf, size_t size) {
+    if (r == REGVM_REG_VAR) {
+        snprintf(buf, size, "v");
+    } else if (r <= prog->nconsts) {
+        format_double(prog->consts[r - 1], buf, size, 1);
+    } else {
+        snprintf(buf, size, "r%d", r);
+    }
+}
+
+/* Nome da função da libm para cada token de função (NULL: tratado à parte) */
+static const char *libm_name(TokenType type) {
+    switch (type) {
+        case TOKEN_SIN:   return "sin";
+        case TOKEN_COS:   return "cos";
+        case TOKEN_TAN:   return "tan";
+        case TOKEN_ABS:   return "fabs";
+        case TOKEN_SQRT:  return "sqrt";
+        case TOKEN_EXP:   return "exp";
+        case TOKEN_LOG:   return "log";
+        case TOKEN_LOG10: return "log10";
+        case TOKEN_SINH:  return "sinh";
+        case TOKEN_COSH:  return "cosh";
+        case TOKEN_TANH:  return "tanh";
+        case TOKEN_ASIN:  return "asin";
+        case TOKEN_ACOS:  return "acos";
+        case TOKEN_ATAN:  return "atan";
+        case TOKEN_ASINH: return "asinh";
+        case TOKEN_ACOSH: return "acosh";
+        case TOKEN_ATANH: return "atanh";
+        case TOKEN_CEIL:  return "ceil";
+        case TOKEN_FLOOR: return "floor";
+        default:          return NULL;
+    }
+}
+
+/* Condição de domínio inválido, como em apply_function (0 se não há) */
+static int format_domain(TokenType type, const char *a, char *buf, size_t size) {
+    switch (type) {
+        case TOKEN_SQRT:
+            snprintf(buf, size, "%s < 0.0", a);
+            return 1;
+        case TOKEN_LOG:
+        case TOKEN_LOG10:
+            snprintf(buf, size, "%s <= 0.0", a);
+            return 1;
+        case TOKEN_ASIN:
+        case TOKEN_ACOS:
+            snprintf(buf, size, "%s < -1.0 || %s > 1.0", a, a);
+            return 1;
+        case TOKEN_ACOSH:
+            snprintf(buf, size, "%s < 1.0", a);
+            return 1;
+        case TOKEN_ATANH:
+            snprintf(buf, size, "%s <= -1.0 || %s >= 1.0", a, a);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Escreve o tratamento de falha da instrução i com o código `code`.
+ * Uma saída: a ordem do código é a ordem original, sai na primeira falha.
+ * Várias: registra o erro de menor posição em cada saída que depende de i
+ * (mesma regra de regvm_eval_multi) e continua. */
+static void emit_fail(FILE *out, const RegProgram *prog, int i, const char *code) {
+    if (prog->noutputs == 1) {
+        fprintf(out, "{ e0 = %s; goto fim; }\n", code);
+        return;
+    }
+    fprintf(out, "{");
+    for (int k = 0; k < prog->noutputs; k++) {
+        int r = prog->rank[k * prog->size + i];
+        if (r == REGVM_NO_RANK) continue;
+        fprintf(out, " if (%d < b%d) { b%d = %d; e%d = %s; }", r, k, k, r, k, code);
+    }
+    fprintf(out, " }\n");
+}
+
+/* Escreve uma instrução com a verificação de erro em linha */
+static void emit_instr(FILE *out, const RegProgram *prog, int i) {
+    const RegInstr *in = &prog->code[i];
+    const char *ind = "        ";
+    char a[48], b[48], d[16], cond[128];
+    format_operand(prog, in->a, a, sizeof(a));
+    format_operand(prog, in->b, b, sizeof(b));
+    format_operand(prog, in->dst, d, sizeof(d));
+
+    switch (in->op) {
+        case TOKEN_PLUS:
+        case TOKEN_MINUS:
+        case TOKEN_MULT: {
+            char sym = (in->op == TOKEN_PLUS) ? '+' : (in->op == TOKEN_MINUS) ? '-' : '*';
+            fprintf(out, "%s%s = %s %c %s;\n", ind, d, a, sym, b);
+            fprintf(out, "%sif (!isfinite(%s)) ", ind, d);
+            emit_fail(out, prog, i, "MC_MATH_ERROR");
+            break;
+        }
+        case TOKEN_DIV: {
+            int divisor_const = (in->b >= 1 && in->b <= prog->nconsts);
+            if (divisor_const && prog->consts[in->b - 1] != 0.0) {
+                fprintf(out, "%s%s = %s / %s;\n", ind, d, a, b);
+                fprintf(out, "%sif (!isfinite(%s)) ", ind, d);
+                emit_fail(out, prog, i, "MC_MATH_ERROR");
+                break;
+            }
+            /* O destino pode ser o próprio divisor: testa a cópia */
+            fprintf(out, "%s{\n%s    const double q = %s;\n", ind, ind, b);
+            fprintf(out, "%s    %s = %s / q;\n", ind, d, a);
+            fprintf(out, "%s    if (q == 0.0) ", ind);
+            emit_fail(out, prog, i, "MC_DIVISION_BY_ZERO");
+            fprintf(out, "%s    else if (!isfinite(%s)) ", ind, d);
+            emit_fail(out, prog, i, "MC_MATH_ERROR");
+            fprintf(out, "%s}\n", ind);
+            break;
+        }
+        case TOKEN_POW:
+            fprintf(out, "%s%s = pow(%s, %s);\n", ind, d, a, b);
+            fprintf(out, "%sif (isnan(%s)) ", ind, d);
+            emit_fail(out, prog, i, "MC_DOMAIN_ERROR");
+            fprintf(out, "%selse if (isinf(%s)) ", ind, d);
+            emit_fail(out, prog, i, "MC_MATH_ERROR");
+            break;
+        case TOKEN_NEG:
+            fprintf(out, "%s%s = -%s;\n", ind, d, a);
+            break;
+        case REGVM_OP_SINCOS: {
+            char c[16];
+            format_operand(prog, in->b, c, sizeof(c));
+            fprintf(out, "%s{ const double u = %s; %s = sin(u); %s = cos(u); }\n", ind, a, d, c);
+            fprintf(out, "%sif (!isfinite(%s)) ", ind, d);
+            emit_fail(out, prog, i, "MC_MATH_ERROR");
+            break;
+        }
+        case TOKEN_FRAC:
+            fprintf(out, "%s%s = %s - floor(%s);\n", ind, d, a, a);
+            fprintf(out, "%sif (!isfinite(%s)) ", ind, d);
+            emit_fail(out, prog, i, "MC_MATH_ERROR");
+            break;
+        default: {
+            const char *fn = libm_name((TokenType)in->op);
+            if (format_domain((TokenType)in->op, a, cond, sizeof(cond))) {
+                fprintf(out, "%sif (%s) ", ind, cond);
+                emit_fail(out, prog, i, "MC_DOMAIN_ERROR");
+                if (prog->noutputs > 1) {
+                    /* Como apply_function: valor 0 após erro de domínio */
+                    fprintf(out, "%s%s = (%s) ? 0.0 : %s(%s);\n", ind, d, cond, fn, a);
+                } else {
+                    fprintf(out, "%s%s = %s(%s);\n", ind, d, fn, a);
+                }
+            } else {
+                fprintf(out, "%s%s = %s(%s);\n", ind, d, fn, a);
+            }
+            fprintf(out, "%sif (!isfinite(%s)) ", ind, d);
+            emit_fail(out, prog, i, "MC_MATH_ERROR");
+            break;
+        }
+    }
+}
+
+/* Cabeçalho comum às unidades geradas */
+static void emit_prelude(FILE *out) {
+    fprintf(out, "#include <math.h>\n#include <stddef.h>\n#include <stdint.h>\n\n");
+    fprintf(out, "#ifndef MC_LINKAGE\n#define MC_LINKAGE\n#endif\n\n");
+    fprintf(out, "/* Códigos de EvalError (evaluator.h) */\n");
+    fprintf(out, "#define MC_STACK_ERROR      %d\n", EVAL_STACK_ERROR);
+    fprintf(out, "#define MC_DIVISION_BY_ZERO %d\n", EVAL_DIVISION_BY_ZERO);
+    fprintf(out, "#define MC_DOMAIN_ERROR     %d\n", EVAL_DOMAIN_ERROR);
+    fprintf(out, "#define MC_MATH_ERROR       %d\n", EVAL_MATH_ERROR);
+}
+
+/* Texto dentro de comentário C (sem fechar o comentário) */
+static void emit_comment_text(FILE *out, const char *text) {
+    for (const char *p = text; *p; p++) {
+        fputc(*p, out);
+        if (*p == '*' && p[1] == '/') fputc(' ', out);
+    }
+}
+
+/* Descrição do plot para o comentário da função (título opcional) */
+static void emit_plot_comment(FILE *out, const Plot *plot, const char *title) {
+    static const char *prefixo[] = { "Y=", "Y=", "R=", "R**2=", "X=" };
+    fprintf(out, "/* ");
+    if (title) {
+        emit_comment_text(out, title);
+        fprintf(out, ": ");
+    }
+    fprintf(out, "%s", prefixo[plot->type]);
+    emit_comment_text(out, plot->expr1);
+    if (plot->type == PLOT_PARAMETRIC && plot->expr2) {
+        fprintf(out, ";Y=");
+        emit_comment_text(out, plot->expr2);
+    }
+    if (plot->type == PLOT_CARTESIAN) {
+        fprintf(out, "\n * saída 0: Y */\n");
+    } else {
+        fprintf(out, "\n * saída 0: X, saída 1: Y */\n");
+    }
+}
+
+/* Escreve a função nativa `symbol` para o plot */
+static int emit_function(FILE *out, const Plot *plot, const char *symbol,
+                         const char *title, char **errmsg) {
+    TokenBuffer rpn[2];
+    int count = plot_build_programs(plot, rpn, errmsg);
+    if (!count) return 0;
+
+    const TokenBuffer *programas[2] = { &rpn[0], &rpn[1] };
+    RegProgram *prog = regvm_compile_multi(programas, count);
+    for (int k = 0; k < count; k++) parser_free_buffer(&rpn[k]);
+    if (!prog) {
+        if (errmsg) *errmsg = strdup("expressão grande demais para gerar código");
+        return 0;
+    }
+
+    /* Saídas com alguma instrução que pode falhar precisam de b<k> */
+    int falha = 0, usa_var = 0, usa_rank[EVAL_MAX_OUTPUTS] = {0};
+    for (int k = 0; k < prog->noutputs; k++) {
+        if (prog->result[k] == REGVM_REG_VAR) usa_var = 1;
+    }
+    for (int i = 0; i < prog->size; i++) {
+        const RegInstr *in = &prog->code[i];
+        int binario = (in->op == TOKEN_PLUS || in->op == TOKEN_MINUS || in->op == TOKEN_MULT ||
+                       in->op == TOKEN_DIV || in->op == TOKEN_POW);
+        if (in->a == REGVM_REG_VAR || (binario && in->b == REGVM_REG_VAR)) usa_var = 1;
+        if (in->op == TOKEN_NEG) continue;
+        falha = 1;
+        for (int k = 0; k < prog->noutputs; k++) {
+            if (prog->rank[k * prog->size + i] != REGVM_NO_RANK) usa_rank[k] = 1;
+        }
+    }
+
+    emit_plot_comment(out, plot, title);
+    fprintf(out, "MC_LINKAGE void %s(const double *in, double *const *out,\n", symbol);
+    fprintf(out, "%*suint8_t *const *status, size_t n) {\n", (int)strlen(symbol) + 17, "");
+    if (!usa_var) fprintf(out, "    (void)in;\n");
+    fprintf(out, "    for (size_t i = 0; i < n; i++) {\n");
+    if (usa_var) fprintf(out, "        const double v = in[i];\n");
+
+    if (prog->nregs > prog->nconsts + 1) {
+        fprintf(out, "        double");
+        for (int r = prog->nconsts + 1; r < prog->nregs; r++) {
+            fprintf(out, "%s r%d = 0.0", r > prog->nconsts + 1 ? "," : "", r);
+        }
+        fprintf(out, ";\n");
+    }
+    fprintf(out, "        int");
+    for (int k = 0; k < prog->noutputs; k++) fprintf(out, "%s e%d = 0", k ? "," : "", k);
+    fprintf(out, ";\n");
+    for (int k = 0; k < prog->noutputs; k++) {
+        if (usa_rank[k] && prog->noutputs > 1) fprintf(out, "        int b%d = 0x7fffffff;\n", k);
+    }
+    fprintf(out, "\n");
+
+    for (int i = 0; i < prog->size; i++) emit_instr(out, prog, i);
+
+    if (falha && prog->noutputs == 1) fprintf(out, "    fim:\n");
+    for (int k = 0; k < prog->noutputs; k++) {
+        char res[48];
+        format_operand(prog, prog->result[k], res, sizeof(res));
+        if (prog->stop_error[k] != EVAL_OK) {
+            fprintf(out, "        if (!e%d) e%d = %d;\n", k, k, prog->stop_error[k]);
+        }
+        fprintf(out, "        if (out[%d]) {\n", k);
+        fprintf(out, "            out[%d][i] = e%d ? 0.0 : %s;\n", k, k, res);
+        fprintf(out, "            status[%d][i] = (uint8_t)e%d;\n", k, k);
+        fprintf(out, "        }\n");
+    }
+    fprintf(out, "    }\n}\n");
+
+    regvm_free(prog);
+    return 1;
+}
+
+int codegen_emit_plot(FILE *out, const Plot *plot, const char *symbol, char **errmsg) {
+    if (errmsg) *errmsg = NULL;
+    fprintf(out, "/* Gerado por multicurvas --emit-c */\n");
+    emit_prelude(out);
+    fprintf(out, "\n");
+    return emit_function(out, plot, symbol, NULL, errmsg);
+}
+
+/* Literal de string C */
+static void emit_string(FILE *out, const char *s) {
+    if (!s) {
+        fprintf(out, "NULL");
+        return;
+    }
+    fputc('"', out);
+    for (const char *p = s; *p; p++) {
+        if (*p == '"' || *p == '\\') fputc('\\', out);
+        fputc(*p, out);
+    }
+    fputc('"', out);
+}
+
+static const char *plot_type_name(PlotType type) {
+    switch (type) {
+        case PLOT_CARTESIAN:  return "PLOT_CARTESIAN";
+        case PLOT_POLAR_R:    return "PLOT_POLAR_R";
+        case PLOT_POLAR_R2:   return "PLOT_POLAR_R2";
+        case PLOT_PARAMETRIC: return "PLOT_PARAMETRIC";
+        default:              return "PLOT_UNKNOWN";
+    }
+}
+
+/* Entrada do catálogo lida da lista */
+typedef struct {
+    char *id;
+    char *spec;
+    char *name;
+    Plot *plot;
+} CatalogEntry;
+
+static void free_entries(CatalogEntry *entries, int count) {
+    for (int i = 0; i < count; i++) {
+        free(entries[i].id);
+        free(entries[i].spec);
+        free(entries[i].name);
+        plot_free(entries[i].plot);
+    }
+    free(entries);
+}
+
+/* Símbolo C do preset: preset_<id> com caracteres fora de [A-Za-z0-9] trocados por '_' */
+static void preset_symbol(const char *id, char *buf, size_t size) {
+    snprintf(buf, size, "preset_%s", id);
+    for (char *p = buf + 7; *p; p++) {
+        int alnum = (*p >= '0' && *p <= '9') || (*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z');
+        if (!alnum) *p = '_';
+    }
+}
+
+int codegen_emit_catalog(FILE *out, FILE *list, char **errmsg) {
+    if (errmsg) *errmsg = NULL;
+    CatalogEntry *entries = NULL;
+    int count = 0, capacity = 0;
+    char line[1024];
+
+    while (fgets(line, sizeof(line), list)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (!line[0] || line[0] == '#') continue;
+
+        char *spec = strchr(line, '\t');
+        char *name = spec ? strchr(spec + 1, '\t') : NULL;
+        if (!name) {
+            if (errmsg) *errmsg = strdup("linha da lista sem <id>\\t<entrada>\\t<nome>");
+            free_entries(entries, count);
+            return -1;
+        }
+        *spec++ = '\0';
+        *name++ = '\0';
+
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            CatalogEntry *grown = realloc(entries, capacity * sizeof(CatalogEntry));
+            if (!grown) {
+                if (errmsg) *errmsg = strdup("memória insuficiente");
+                free_entries(entries, count);
+                return -1;
+            }
+            entries = grown;
+        }
+        CatalogEntry *e = &entries[count++];
+        e->id = strdup(line);
+        e->spec = strdup(spec);
+        e->name = strdup(name);
+        e->plot = plot_parse_text(spec, errmsg);
+        if (!e->id || !e->spec || !e->name || !e->plot) {
+            if (errmsg && !*errmsg) *errmsg = strdup("memória insuficiente");
+            free_entries(entries, count);
+            return -1;
+        }
+    }
+
+    fprintf(out, "/* Catálogo de presets nativos (curvas de gerar_77_curvas.sh).\n");
+    fprintf(out, " * GERADO por `make presets` (multicurvas --emit-presets): não editar. */\n");
+    fprintf(out, "#include \"presets.h\"\n\n#define MC_LINKAGE static\n\n");
+    emit_prelude(out);
+
+    for (int i = 0; i < count; i++) {
+        char symbol[64], title[512];
+        preset_symbol(entries[i].id, symbol, sizeof(symbol));
+        snprintf(title, sizeof(title), "%s) %s", entries[i].id, entries[i].name);
+        fprintf(out, "\n");
+        if (!emit_function(out, entries[i].plot, symbol, title, errmsg)) {
+            free_entries(entries, count);
+            return -1;
+        }
+    }
+
+    fprintf(out, "\nconst PlotPreset plot_presets[] = {\n");
+    for (int i = 0; i < count; i++) {
+        const Plot *p = entries[i].plot;
+        char symbol[64], c[48], d[48];
+        preset_symbol(entries[i].id, symbol, sizeof(symbol));
+        format_double(p->C, c, sizeof(c), 0);
+        format_double(p->D, d, sizeof(d), 0);
+        fprintf(out, "    { ");
+        emit_string(out, entries[i].id);
+        fprintf(out, ", ");
+        emit_string(out, entries[i].name);
+        fprintf(out, ", ");
+        emit_string(out, entries[i].spec);
+        fprintf(out, ",\n      %s, ", plot_type_name(p->type));
+        emit_string(out, p->expr1);
+        fprintf(out, ", ");
+        emit_string(out, p->expr2);
+        fprintf(out, ", %s, %s, %d, %s },\n", c, d, p->has_interval, symbol);
+    }
+    fprintf(out, "};\n\nconst int plot_presets_count = (int)(sizeof(plot_presets) / sizeof(plot_presets[0]));\n");
+
+    free_entries(entries, count);
+    return count;
+}
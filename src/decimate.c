@@ -0,0 +1,151 @@
+/* Decimação M4 por coluna de pixel (ver decimate.h) */
+#include "../include/decimate.h"
+#include <math.h>
+#include <stdlib.h>
+
+/* Mesmo limite de render_svg: pontos além dele ficam fora da bounding box */
+#define DECIMATE_MAX_COORD 1e6
+
+static int fora_dos_limites(double x, double y) {
+    return !isfinite(x) || fabs(x) > DECIMATE_MAX_COORD ||
+           !isfinite(y) || fabs(y) > DECIMATE_MAX_COORD;
+}
+
+void decimator_init(Decimator *d, double x0, double x1, int columns) {
+    double range = fabs(x1 - x0);
+    d->x0 = x0 < x1 ? x0 : x1;
+    d->range = (range > 0 && isfinite(range)) ? range : 1.0;
+    d->columns = columns > 0 ? columns : 1;
+    d->coluna = 0;
+    d->n = 0;
+    d->quebra = 1;      // quebra no início não é emitida
+    d->seq = 0;
+}
+
+/* Emite os pontos distintos do grupo (primeiro, mínimo, máximo, último) na
+ * ordem de chegada e esvazia o grupo */
+static int fechar_grupo(Decimator *d, DecimatedPoint *out) {
+    if (d->n == 0) return 0;
+    const DecimatedPoint *p[4] = { &d->first, &d->min, &d->max, &d->last };
+    long s[4] = { d->seq_first, d->seq_min, d->seq_max, d->seq_last };
+
+    // Ordena os 4 por seq (inserção) e descarta repetidos
+    for (int i = 1; i < 4; i++) {
+        for (int j = i; j > 0 && s[j] < s[j - 1]; j--) {
+            long ts = s[j]; s[j] = s[j - 1]; s[j - 1] = ts;
+            const DecimatedPoint *tp = p[j]; p[j] = p[j - 1]; p[j - 1] = tp;
+        }
+    }
+    int n = 0;
+    for (int i = 0; i < 4; i++) {
+        if (i > 0 && s[i] == s[i - 1]) continue;
+        out[n++] = *p[i];
+    }
+    d->n = 0;
+    d->quebra = 0;
+    return n;
+}
+
+int decimator_push(Decimator *d, double x, double y, int status, DecimatedPoint *out) {
+    long seq = d->seq++;
+
+    // Amostra inválida: fecha o grupo e marca uma quebra (uma por sequência)
+    if (status != 0) {
+        int n = fechar_grupo(d, out);
+        if (!d->quebra) {
+            out[n].x = out[n].y = 0.0;
+            out[n].status = 1;
+            n++;
+            d->quebra = 1;
+        }
+        return n;
+    }
+
+    // Fora dos limites do renderizador: passa direto, sem entrar em coluna
+    if (fora_dos_limites(x, y)) {
+        int n = fechar_grupo(d, out);
+        out[n].x = x;
+        out[n].y = y;
+        out[n].status = 0;
+        d->quebra = 0;
+        return n + 1;
+    }
+
+    long coluna = (long)floor((x - d->x0) * d->columns / d->range);
+    int n = 0;
+    if (d->n > 0 && coluna != d->coluna) n = fechar_grupo(d, out);
+
+    DecimatedPoint p = { x, y, 0 };
+    if (d->n == 0) {
+        d->coluna = coluna;
+        d->first = d->last = d->min = d->max = p;
+        d->seq_first = d->seq_last = d->seq_min = d->seq_max = seq;
+    } else {
+        d->last = p;
+        d->seq_last = seq;
+        if (y < d->min.y) {
+            d->min = p;
+            d->seq_min = seq;
+        }
+        if (y > d->max.y) {
+            d->max = p;
+            d->seq_max = seq;
+        }
+    }
+    d->n++;
+    return n;
+}
+
+int decimator_finish(Decimator *d, DecimatedPoint *out) {
+    return fechar_grupo(d, out);
+}
+
+/* Acrescenta pontos decimados ao PlotData (capacidade já garantida) */
+static void acrescentar(PlotData *r, const DecimatedPoint *p, int n) {
+    for (int i = 0; i < n; i++) plot_data_append(r, p[i].status == 0, p[i].x, p[i].y);
+}
+
+PlotData *decimate_plot(const PlotData *data, int canvas_w) {
+    if (!data) return NULL;
+
+    // Bounding box em x como em render_svg (o primeiro ponto sempre entra)
+    double minx = data->count > 0 ? plot_data_x(data, 0) : 0.0;
+    double maxx = minx;
+    for (int i = 1; i < data->count; i++) {
+        double x = plot_data_x(data, i);
+        if (fora_dos_limites(x, plot_data_y(data, i))) continue;
+        if (x < minx) minx = x;
+        if (x > maxx) maxx = x;
+    }
+
+    // Uma coluna por pixel da área de plotagem (80% do canvas)
+    int columns = (int)(canvas_w * 0.8);
+    if (columns < 1) columns = 1;
+
+    // Cada amostra gera no máximo um ponto ou uma quebra; os pontos de
+    // saída são pontos da entrada, então a precisão é a mesma
+    int total = data->valid ? data->samples : data->count;
+    PlotData *r = plot_data_create(total, data->precision, NULL);
+    if (!r) return NULL;
+
+    Decimator d;
+    DecimatedPoint out[DECIMATE_MAX_OUT];
+    decimator_init(&d, minx, maxx, columns);
+    if (maxx - minx < 0.01) d.range = 1.0;     // como rangex em render_svg
+    // Um trecho por vez; uma lacuna entre trechos vira uma quebra
+    PlotSegment seg = {0};
+    int fim = 0;
+    while (plot_data_next_segment(data, &seg)) {
+        if (seg.sample > fim) acrescentar(r, out, decimator_push(&d, 0.0, 0.0, 1, out));
+        for (int i = seg.first; i < seg.first + seg.len; i++) {
+            acrescentar(r, out, decimator_push(&d, plot_data_x(data, i),
+                                               plot_data_y(data, i), 0, out));
+        }
+        fim = seg.sample + seg.len;
+    }
+    if (data->valid && data->samples > fim) {
+        acrescentar(r, out, decimator_push(&d, 0.0, 0.0, 1, out));
+    }
+    acrescentar(r, out, decimator_finish(&d, out));
+    return r;
+}
@@ -2,14 +2,15 @@
 #include <stdlib.h>
 #include <math.h>
 #include "evaluator.h"
+#include "kernels.h"
+#include "threaded.h"
+#include "regvm.h"
+#include "jit.h"
 
 /* Constantes matemáticas */
 #define M_PI_CUSTOM 3.14159265358979323846
 #define M_E_CUSTOM  2.71828182845904523536
 
-/* Tamanho máximo da pilha de avaliação (otimização de desempenho) */
-#define MAX_EVAL_STACK_SIZE 64
-
 /* Retorna valor de uma constante */
 static inline double get_constant_value(TokenType type) {
     switch (type) {
@@ -22,6 +23,11 @@ static inline double get_constant_value(TokenType type) {
     }
 }
 
+/* Versão pública de get_constant_value (usada pelos motores alternativos) */
+double evaluator_constant(TokenType type) {
+    return get_constant_value(type);
+}
+
 /* Aplica função matemática (token função, argumento) */
 static inline EvalResult apply_function(TokenType type, double arg) {
     EvalResult result = {EVAL_OK, 0.0};
@@ -134,6 +140,11 @@ static inline EvalResult apply_function(TokenType type, double arg) {
     return result;
 }
 
+/* Versão pública de apply_function (usada pelos motores alternativos) */
+EvalResult evaluator_apply_function(TokenType type, double arg) {
+    return apply_function(type, arg);
+}
+
 /* Aplica operador binário (token operador, operando esquerdo, operando direito) */
 static inline EvalResult apply_operator(TokenType type, double left, double right) {
     EvalResult result = {EVAL_OK, 0.0};
@@ -177,6 +188,11 @@ static inline EvalResult apply_operator(TokenType type, double left, double righ
     return result;
 }
 
+/* Versão pública de apply_operator (usada pelo otimizador) */
+EvalResult evaluator_apply_operator(TokenType type, double left, double right) {
+    return apply_operator(type, left, right);
+}
+
 /* Verifica se token é operador binário */
 static int is_binary_operator(TokenType type) {
     return (type == TOKEN_PLUS || type == TOKEN_MINUS || 
@@ -321,3 +337,340 @@ evaluation_end: ;
     
     return result;
 }
+
+/* ========================================================================
+ * Avaliação em lote (coluna por coluna)
+ * ======================================================================== */
+
+/* Número de amostras processadas por bloco no avaliador em lote.
+ * A pilha de colunas ocupa MAX_EVAL_STACK_SIZE * EVAL_BATCH_BLOCK doubles (32 KB). */
+#define EVAL_BATCH_BLOCK 64
+
+/* Marca erro na amostra i apenas se ela ainda não falhou.
+ * Preserva o primeiro erro encontrado, exatamente como o retorno antecipado
+ * de evaluator_eval_rpn. */
+#define MARK_ERROR(status, i, err) \
+    do { if ((status)[i] == EVAL_OK) (status)[i] = (uint8_t)(err); } while (0)
+
+/* Valida a estrutura do programa simulando a profundidade da pilha.
+ * Erros estruturais independem do valor da variável, mas erros numéricos dos
+ * tokens anteriores têm prioridade — por isso devolvemos a posição. */
+int evaluator_validate_rpn(const TokenBuffer *rpn, EvalError *stop_error) {
+    int depth = 0;
+    int i;
+
+    for (i = 0; i < rpn->size; i++) {
+        switch (rpn->tokens[i].type) {
+            case TOKEN_END:
+                goto validation_end;
+
+            case TOKEN_NUMBER:
+            case TOKEN_VARIABLE_X:
+            case TOKEN_VARIABLE_THETA:
+            case TOKEN_VARIABLE_T:
+            case TOKEN_CONST_PI:
+            case TOKEN_CONST_E:
+                if (depth >= MAX_EVAL_STACK_SIZE) {
+                    *stop_error = EVAL_STACK_ERROR;
+                    return i;
+                }
+                depth++;
+                break;
+
+            case TOKEN_PLUS: case TOKEN_MINUS: case TOKEN_MULT:
+            case TOKEN_DIV: case TOKEN_POW:
+                if (depth < 2) {
+                    *stop_error = EVAL_STACK_ERROR;
+                    return i;
+                }
+                depth--;
+                break;
+
+            case TOKEN_NEG:
+            case TOKEN_SIN: case TOKEN_COS: case TOKEN_TAN: case TOKEN_ABS:
+            case TOKEN_SQRT: case TOKEN_EXP: case TOKEN_LOG: case TOKEN_LOG10:
+            case TOKEN_SINH: case TOKEN_COSH: case TOKEN_TANH:
+            case TOKEN_ASIN: case TOKEN_ACOS: case TOKEN_ATAN:
+            case TOKEN_ASINH: case TOKEN_ACOSH: case TOKEN_ATANH:
+            case TOKEN_CEIL: case TOKEN_FLOOR: case TOKEN_FRAC:
+                if (depth < 1) {
+                    *stop_error = EVAL_STACK_ERROR;
+                    return i;
+                }
+                break;
+
+            default:
+                *stop_error = EVAL_MATH_ERROR;
+                return i;
+        }
+    }
+
+validation_end:
+    *stop_error = (depth == 1) ? EVAL_OK : EVAL_STACK_ERROR;
+    return i;
+}
+
+/* Avalia um bloco de até EVAL_BATCH_BLOCK amostras */
+static void eval_block(const TokenBuffer *rpn, int stop, EvalError stop_error,
+                       const double *in, double *out, uint8_t *status, int n) {
+    /* Pilha de colunas: cada nível guarda o valor intermediário de todas as amostras */
+    double stack[MAX_EVAL_STACK_SIZE][EVAL_BATCH_BLOCK];
+    int stack_top = -1;
+    const Kernels *k = kernels_active();
+
+    for (int j = 0; j < n; j++) status[j] = EVAL_OK;
+
+    for (int i = 0; i < stop; i++) {
+        Token token = rpn->tokens[i];
+        TokenType type = token.type;
+
+        switch (type) {
+            case TOKEN_NUMBER: {
+                double v = rpn->values[token.value_index];
+                double *dst = stack[++stack_top];
+                for (int j = 0; j < n; j++) dst[j] = v;
+                break;
+            }
+
+            case TOKEN_VARIABLE_X:
+            case TOKEN_VARIABLE_THETA:
+            case TOKEN_VARIABLE_T: {
+                double *dst = stack[++stack_top];
+                for (int j = 0; j < n; j++) dst[j] = in[j];
+                break;
+            }
+
+            case TOKEN_CONST_PI:
+            case TOKEN_CONST_E: {
+                double v = get_constant_value(type);
+                double *dst = stack[++stack_top];
+                for (int j = 0; j < n; j++) dst[j] = v;
+                break;
+            }
+
+            case TOKEN_PLUS:
+            case TOKEN_MINUS:
+            case TOKEN_MULT:
+            case TOKEN_DIV:
+            case TOKEN_POW:
+                stack_top--;
+                k->binary(type, stack[stack_top], stack[stack_top + 1],
+                          stack[stack_top], status, n);
+                break;
+
+            default:
+                /* NEG e funções unárias (evaluator_validate_rpn garante que são conhecidas) */
+                k->unary(type, stack[stack_top], stack[stack_top], status, n);
+                break;
+        }
+    }
+
+    if (stop_error != EVAL_OK) {
+        for (int j = 0; j < n; j++) {
+            MARK_ERROR(status, j, stop_error);
+            out[j] = 0.0;
+        }
+        return;
+    }
+
+    for (int j = 0; j < n; j++) out[j] = stack[0][j];
+}
+
+/* Avalia expressão em RPN sobre um vetor de amostras */
+void evaluator_eval_rpn_batch(const TokenBuffer *rpn, const double *in,
+                              double *out, uint8_t *status, size_t n) {
+    if (!rpn || !rpn->tokens || rpn->size == 0) {
+        for (size_t j = 0; j < n; j++) {
+            status[j] = EVAL_STACK_ERROR;
+            out[j] = 0.0;
+        }
+        return;
+    }
+
+    /* Validação estrutural feita uma única vez para todas as amostras */
+    EvalError stop_error;
+    int stop = evaluator_validate_rpn(rpn, &stop_error);
+
+    for (size_t base = 0; base < n; base += EVAL_BATCH_BLOCK) {
+        int len = (n - base < EVAL_BATCH_BLOCK) ? (int)(n - base) : EVAL_BATCH_BLOCK;
+        eval_block(rpn, stop, stop_error, in + base, out + base, status + base, len);
+    }
+}
+
+/* ========================================================================
+ * Programas compilados e seleção de motor
+ * ======================================================================== */
+
+EvalEngine evaluator_engine = EVAL_ENGINE_REGISTER;
+
+struct EvalProgram {
+    EvalEngine engine;
+    int noutputs;
+    TokenBuffer rpn[EVAL_MAX_OUTPUTS];                  /* Cópias próprias dos programas RPN */
+    ThreadedProgram *threaded[EVAL_MAX_OUTPUTS];        /* EVAL_ENGINE_THREADED */
+    RegProgram *regvm;              /* EVAL_ENGINE_REGISTER (todas as saídas em um DAG) */
+    JitProgram *jit;                /* EVAL_ENGINE_JIT (código gerado a partir de regvm) */
+};
+
+void evaluator_set_engine(EvalEngine engine) {
+    evaluator_engine = engine;
+}
+
+const char *evaluator_engine_name(EvalEngine engine) {
+    switch (engine) {
+        case EVAL_ENGINE_SWITCH:   return "switch";
+        case EVAL_ENGINE_THREADED: return "threaded";
+        case EVAL_ENGINE_REGISTER: return "register";
+        case EVAL_ENGINE_JIT:      return "jit";
+        default:                   return "?";
+    }
+}
+
+EvalProgram *evaluator_compile(const TokenBuffer *rpn, EvalEngine engine) {
+    return evaluator_compile_multi(&rpn, 1, engine);
+}
+
+EvalProgram *evaluator_compile_multi(const TokenBuffer *const *rpns, int count,
+                                     EvalEngine engine) {
+    if (count < 1 || count > EVAL_MAX_OUTPUTS) return NULL;
+
+    EvalProgram *prog = calloc(1, sizeof(EvalProgram));
+    if (!prog) return NULL;
+
+    prog->engine = engine;
+    for (int k = 0; k < count; k++) {
+        if (!rpns[k] || !parser_copy_buffer(rpns[k], &prog->rpn[k])) {
+            evaluator_program_free(prog);
+            return NULL;
+        }
+        prog->noutputs++;
+    }
+
+    if (engine == EVAL_ENGINE_THREADED) {
+        for (int k = 0; k < count; k++) {
+            prog->threaded[k] = threaded_compile(&prog->rpn[k]);
+            if (!prog->threaded[k]) {
+                evaluator_program_free(prog);
+                return NULL;
+            }
+        }
+    } else if (engine == EVAL_ENGINE_REGISTER || engine == EVAL_ENGINE_JIT) {
+        const TokenBuffer *copies[EVAL_MAX_OUTPUTS];
+        for (int k = 0; k < count; k++) copies[k] = &prog->rpn[k];
+        prog->regvm = regvm_compile_multi(copies, count);
+        if (!prog->regvm) {
+            prog->engine = EVAL_ENGINE_SWITCH;
+        } else if (engine == EVAL_ENGINE_JIT) {
+            /* Sem suporte na plataforma ou sem memória: fica no interpretador */
+            prog->jit = jit_compile(prog->regvm);
+            if (!prog->jit) prog->engine = EVAL_ENGINE_REGISTER;
+        }
+    }
+
+    return prog;
+}
+
+int evaluator_program_outputs(const EvalProgram *prog) {
+    return prog->noutputs;
+}
+
+EvalResult evaluator_program_eval(const EvalProgram *prog, double var_value) {
+    switch (prog->engine) {
+        case EVAL_ENGINE_THREADED:
+            return threaded_eval(prog->threaded[0], var_value);
+        case EVAL_ENGINE_REGISTER:
+            return regvm_eval(prog->regvm, var_value);
+        case EVAL_ENGINE_JIT: {
+            EvalResult results[EVAL_MAX_OUTPUTS];
+            jit_eval_multi(prog->jit, var_value, results);
+            return results[0];
+        }
+        default:
+            return evaluator_eval_rpn(&prog->rpn[0], var_value);
+    }
+}
+
+void evaluator_program_eval_multi(const EvalProgram *prog, double var_value,
+                                  EvalResult *results) {
+    if (prog->engine == EVAL_ENGINE_REGISTER) {
+        regvm_eval_multi(prog->regvm, var_value, results);
+        return;
+    }
+    if (prog->engine == EVAL_ENGINE_JIT) {
+        jit_eval_multi(prog->jit, var_value, results);
+        return;
+    }
+    for (int k = 0; k < prog->noutputs; k++) {
+        results[k] = (prog->engine == EVAL_ENGINE_THREADED)
+                         ? threaded_eval(prog->threaded[k], var_value)
+                         : evaluator_eval_rpn(&prog->rpn[k], var_value);
+    }
+}
+
+void evaluator_program_eval_batch(const EvalProgram *prog, const double *in,
+                                  double *out, uint8_t *status, size_t n) {
+    double *outs[EVAL_MAX_OUTPUTS] = {0};
+    uint8_t *stats[EVAL_MAX_OUTPUTS] = {0};
+    outs[0] = out;
+    stats[0] = status;
+    evaluator_program_eval_batch_multi(prog, in, outs, stats, n);
+}
+
+void evaluator_program_eval_batch_multi(const EvalProgram *prog, const double *in,
+                                        double *const *out, uint8_t *const *status,
+                                        size_t n) {
+    if (prog->engine == EVAL_ENGINE_REGISTER) {
+        regvm_eval_batch(prog->regvm, in, out, status, n);
+        return;
+    }
+    if (prog->engine == EVAL_ENGINE_JIT) {
+        jit_eval_batch(prog->jit, in, out, status, n);
+        return;
+    }
+
+    for (int k = 0; k < prog->noutputs; k++) {
+        if (!out[k]) continue;
+        if (prog->engine == EVAL_ENGINE_THREADED) {
+            /* Motor escalar: uma execução encadeada por amostra */
+            for (size_t i = 0; i < n; i++) {
+                EvalResult r = threaded_eval(prog->threaded[k], in[i]);
+                out[k][i] = (r.error == EVAL_OK) ? r.value : 0.0;
+                status[k][i] = (uint8_t)r.error;
+            }
+        } else {
+            evaluator_eval_rpn_batch(&prog->rpn[k], in, out[k], status[k], n);
+        }
+    }
+}
+
+void evaluator_program_eval_batch_unchecked(const EvalProgram *prog, const double *in,
+                                            double *const *out, size_t n) {
+    if (prog->engine == EVAL_ENGINE_REGISTER) {
+        regvm_eval_batch(prog->regvm, in, out, NULL, n);
+        return;
+    }
+
+    /* Demais motores: avaliação normal com status descartado */
+    uint8_t st[EVAL_MAX_OUTPUTS][256];
+    uint8_t *stats[EVAL_MAX_OUTPUTS];
+    for (int k = 0; k < EVAL_MAX_OUTPUTS; k++) stats[k] = st[k];
+    for (size_t base = 0; base < n; base += 256) {
+        size_t len = (n - base < 256) ? n - base : 256;
+        double *outs[EVAL_MAX_OUTPUTS];
+        for (int k = 0; k < EVAL_MAX_OUTPUTS; k++) {
+            outs[k] = (k < prog->noutputs && out[k]) ? out[k] + base : NULL;
+        }
+        evaluator_program_eval_batch_multi(prog, in + base, outs, stats, len);
+    }
+}
+
+void evaluator_program_free(EvalProgram *prog) {
+    if (!prog) return;
+    for (int k = 0; k < prog->noutputs; k++) {
+        threaded_free(prog->threaded[k]);
+        parser_free_buffer(&prog->rpn[k]);
+    }
+    jit_free(prog->jit);
+    regvm_free(prog->regvm);
+    free(prog);
+}
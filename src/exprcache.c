@@ -0,0 +1,222 @@
+/* Cache LRU de expressões compiladas: tabela hash (FNV-1a, encadeada) e
+ * lista duplamente ligada em ordem de uso, tudo sob um mutex */
+#define _POSIX_C_SOURCE 200809L  /* strdup */
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <pthread.h>
+#include "exprcache.h"
+
+struct ExprCacheEntry {
+    char *key;
+    uint64_t hash;
+    void *value;
+    int refs;                   /* aquisições em aberto */
+    int in_table;               /* 0: removida, liberada no último release */
+    ExprCacheEntry *chain;      /* próxima no mesmo bucket */
+    ExprCacheEntry *prev;       /* LRU: mais recente */
+    ExprCacheEntry *next;       /* LRU: mais antiga */
+};
+
+struct ExprCache {
+    pthread_mutex_t lock;
+    ExprCacheFree free_value;
+    ExprCacheEntry **buckets;
+    size_t mask;                /* número de buckets - 1 */
+    ExprCacheEntry *head;       /* mais recente */
+    ExprCacheEntry *tail;       /* mais antiga (próxima a sair) */
+    int entries;
+    int capacity;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+};
+
+static uint64_t fnv1a(const char *s) {
+    uint64_t h = 1469598103934665603ULL;
+    while (*s) {
+        h ^= (unsigned char)*s++;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+ExprCache *exprcache_create(int capacity, ExprCacheFree free_value) {
+    if (capacity < 1) capacity = 1;
+    ExprCache *cache = calloc(1, sizeof(ExprCache));
+    if (!cache) return NULL;
+
+    size_t nbuckets = 16;
+    while (nbuckets < 2 * (size_t)capacity) nbuckets *= 2;
+    cache->buckets = calloc(nbuckets, sizeof(ExprCacheEntry *));
+    if (!cache->buckets) {
+        free(cache);
+        return NULL;
+    }
+    cache->mask = nbuckets - 1;
+    cache->capacity = capacity;
+    cache->free_value = free_value;
+    pthread_mutex_init(&cache->lock, NULL);
+    return cache;
+}
+
+static void liberar_entrada(ExprCache *cache, ExprCacheEntry *e) {
+    if (cache->free_value) cache->free_value(e->value);
+    free(e->key);
+    free(e);
+}
+
+static void lru_remover(ExprCache *cache, ExprCacheEntry *e) {
+    if (e->prev) e->prev->next = e->next; else cache->head = e->next;
+    if (e->next) e->next->prev = e->prev; else cache->tail = e->prev;
+    e->prev = e->next = NULL;
+}
+
+static void lru_inserir(ExprCache *cache, ExprCacheEntry *e) {
+    e->prev = NULL;
+    e->next = cache->head;
+    if (cache->head) cache->head->prev = e;
+    cache->head = e;
+    if (!cache->tail) cache->tail = e;
+}
+
+/* Tira a entrada da tabela e da lista; libera já se ninguém a usa */
+static void remover(ExprCache *cache, ExprCacheEntry *e) {
+    ExprCacheEntry **p = &cache->buckets[e->hash & cache->mask];
+    while (*p != e) p = &(*p)->chain;
+    *p = e->chain;
+    lru_remover(cache, e);
+    e->in_table = 0;
+    cache->entries--;
+    if (e->refs == 0) liberar_entrada(cache, e);
+}
+
+static ExprCacheEntry *procurar(ExprCache *cache, const char *key, uint64_t hash) {
+    for (ExprCacheEntry *e = cache->buckets[hash & cache->mask]; e; e = e->chain) {
+        if (e->hash == hash && strcmp(e->key, key) == 0) return e;
+    }
+    return NULL;
+}
+
+ExprCacheEntry *exprcache_get(ExprCache *cache, const char *key) {
+    uint64_t hash = fnv1a(key);
+    pthread_mutex_lock(&cache->lock);
+    ExprCacheEntry *e = procurar(cache, key, hash);
+    if (e) {
+        cache->hits++;
+        e->refs++;
+        lru_remover(cache, e);
+        lru_inserir(cache, e);
+    } else {
+        cache->misses++;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return e;
+}
+
+ExprCacheEntry *exprcache_put(ExprCache *cache, const char *key, void *value) {
+    uint64_t hash = fnv1a(key);
+    ExprCacheEntry *novo = calloc(1, sizeof(ExprCacheEntry));
+    char *copia = strdup(key);
+    if (!novo || !copia) {
+        free(novo);
+        free(copia);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    ExprCacheEntry *e = procurar(cache, key, hash);
+    if (e) {
+        // Compilada por outra thread enquanto esta compilava
+        e->refs++;
+        lru_remover(cache, e);
+        lru_inserir(cache, e);
+        pthread_mutex_unlock(&cache->lock);
+        if (cache->free_value) cache->free_value(value);
+        free(novo);
+        free(copia);
+        return e;
+    }
+
+    while (cache->entries >= cache->capacity) {
+        remover(cache, cache->tail);
+        cache->evictions++;
+    }
+    novo->key = copia;
+    novo->hash = hash;
+    novo->value = value;
+    novo->refs = 1;
+    novo->in_table = 1;
+    ExprCacheEntry **bucket = &cache->buckets[hash & cache->mask];
+    novo->chain = *bucket;
+    *bucket = novo;
+    lru_inserir(cache, novo);
+    cache->entries++;
+    pthread_mutex_unlock(&cache->lock);
+    return novo;
+}
+
+const void *exprcache_value(const ExprCacheEntry *entry) {
+    return entry ? entry->value : NULL;
+}
+
+void exprcache_release(ExprCache *cache, ExprCacheEntry *entry) {
+    if (!entry) return;
+    pthread_mutex_lock(&cache->lock);
+    if (--entry->refs == 0 && !entry->in_table) liberar_entrada(cache, entry);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+void exprcache_clear(ExprCache *cache) {
+    pthread_mutex_lock(&cache->lock);
+    while (cache->tail) remover(cache, cache->tail);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+ExprCacheStats exprcache_stats(ExprCache *cache) {
+    ExprCacheStats st;
+    pthread_mutex_lock(&cache->lock);
+    st.hits = cache->hits;
+    st.misses = cache->misses;
+    st.evictions = cache->evictions;
+    st.entries = cache->entries;
+    st.capacity = cache->capacity;
+    pthread_mutex_unlock(&cache->lock);
+    return st;
+}
+
+void exprcache_destroy(ExprCache *cache) {
+    if (!cache) return;
+    exprcache_clear(cache);
+    pthread_mutex_destroy(&cache->lock);
+    free(cache->buckets);
+    free(cache);
+}
+
+/* Letras, dígitos e marcas decimais: um espaço entre dois deles separa tokens */
+static int caractere_de_palavra(char c) {
+    return isalnum((unsigned char)c) || c == '.' || c == ',' || c == '_';
+}
+
+size_t exprcache_normalize(const char *expr, char *out, size_t size) {
+    size_t n = 0;
+    int espaco = 0;
+    char anterior = '\0';
+    for (const char *p = expr; *p; p++) {
+        if (isspace((unsigned char)*p)) {
+            espaco = 1;
+            continue;
+        }
+        if (espaco && caractere_de_palavra(anterior) && caractere_de_palavra(*p)) {
+            if (n + 1 < size) out[n] = ' ';
+            n++;
+        }
+        espaco = 0;
+        if (n + 1 < size) out[n] = *p;
+        n++;
+        anterior = *p;
+    }
+    if (size > 0) out[n < size ? n : size - 1] = '\0';
+    return n;
+}
@@ -0,0 +1,342 @@
+/* Aritmética de intervalos sobre programas RPN (poda de domínio e polos) */
+#include <math.h>
+#include "interval.h"
+#include "evaluator.h"
+
+int interval_enabled = 1;
+
+#define INTERVAL_PI     3.14159265358979323846
+#define INTERVAL_E      2.71828182845904523536
+
+/* Folga relativa de cada limite: cobre o arredondamento da libm e as
+ * aproximações vetoriais dos kernels (até KERNELS_ULP_TAN = 4 ulp, ou
+ * 2^-50 relativo) com ampla margem */
+#define INTERVAL_SLACK  0x1p-40
+
+/* Folga absoluta de sin/cos/tan: perto dos zeros o erro da redução de
+ * argumento é absoluto, não relativo (2^-100 * |x| nos kernels, abaixo de
+ * 2^-73 até INTERVAL_TRIG_MAX) */
+#define INTERVAL_TRIG_SLACK 0x1p-50
+
+/* Acima disso a redução de argumento não distingue os períodos: sin e cos
+ * ficam em [-1, 1] e tan é tratada como tendo polo */
+#define INTERVAL_TRIG_MAX 1e8
+
+static const Interval INTERVAL_ALL = { -INFINITY, INFINITY };
+
+static Interval make(double lo, double hi) {
+    Interval v = { lo, hi };
+    return v;
+}
+
+static IntervalResult result(IntervalStatus status, Interval value) {
+    IntervalResult r = { status, value };
+    return r;
+}
+
+/* Fecha o resultado de uma operação: alarga os limites para fora e rebaixa
+ * para INTERVAL_MAYBE o que pode ter estourado (limite não finito) */
+static IntervalResult finish(IntervalStatus status, Interval v) {
+    if (status == INTERVAL_FAILS) return result(status, INTERVAL_ALL);
+    if (isnan(v.lo) || isnan(v.hi)) return result(INTERVAL_MAYBE, INTERVAL_ALL);
+    if (isfinite(v.lo)) v.lo -= fabs(v.lo) * INTERVAL_SLACK;
+    if (isfinite(v.hi)) v.hi += fabs(v.hi) * INTERVAL_SLACK;
+    if (!isfinite(v.lo) || !isfinite(v.hi)) status = INTERVAL_MAYBE;
+    return result(status, v);
+}
+
+/* Imagem de uma função monótona (crescente ou decrescente) */
+static Interval monotone(double (*f)(double), Interval a) {
+    double lo = f(a.lo), hi = f(a.hi);
+    return (lo <= hi) ? make(lo, hi) : make(hi, lo);
+}
+
+/* Existe p + k*period (k inteiro) em [lo, hi]? Na dúvida, responde que sim. */
+static int contains_period(Interval a, double p, double period) {
+    double k = ceil((a.lo - p) / period - 1e-9);
+    return p + k * period <= a.hi + 1e-9 * (1.0 + fabs(a.hi));
+}
+
+/* sin/cos: máximo em peak + 2kπ, mínimo em peak + π + 2kπ */
+static Interval periodic(double (*f)(double), Interval a, double peak) {
+    if (!(a.hi - a.lo < 2.0 * INTERVAL_PI) ||
+        fabs(a.lo) > INTERVAL_TRIG_MAX || fabs(a.hi) > INTERVAL_TRIG_MAX) {
+        return make(-1.0, 1.0);
+    }
+    Interval v = monotone(f, a);
+    if (contains_period(a, peak, 2.0 * INTERVAL_PI)) v.hi = 1.0;
+    if (contains_period(a, peak + INTERVAL_PI, 2.0 * INTERVAL_PI)) v.lo = -1.0;
+    v.lo -= INTERVAL_TRIG_SLACK;
+    v.hi += INTERVAL_TRIG_SLACK;
+    return v;
+}
+
+/* Restringe `a` ao domínio [dlo, dhi] (extremos abertos conforme open_lo /
+ * open_hi). Retorna INTERVAL_FAILS se nada sobra, INTERVAL_MAYBE se parte da
+ * faixa foi cortada. */
+static IntervalStatus restrict_domain(Interval *a, double dlo, int open_lo,
+                                      double dhi, int open_hi) {
+    if (a->hi < dlo || (open_lo && a->hi <= dlo)) return INTERVAL_FAILS;
+    if (a->lo > dhi || (open_hi && a->lo >= dhi)) return INTERVAL_FAILS;
+
+    IntervalStatus status = INTERVAL_SAFE;
+    if (a->lo < dlo || (open_lo && a->lo <= dlo)) {
+        a->lo = open_lo ? nextafter(dlo, INFINITY) : dlo;
+        status = INTERVAL_MAYBE;
+    }
+    if (a->hi > dhi || (open_hi && a->hi >= dhi)) {
+        a->hi = open_hi ? nextafter(dhi, -INFINITY) : dhi;
+        status = INTERVAL_MAYBE;
+    }
+    return status;
+}
+
+IntervalResult interval_apply_function(TokenType type, Interval a) {
+    IntervalStatus status = INTERVAL_SAFE;
+    Interval v;
+
+    if (isnan(a.lo) || isnan(a.hi)) return result(INTERVAL_MAYBE, INTERVAL_ALL);
+
+    switch (type) {
+        case TOKEN_NEG:
+            /* Exata: sem folga */
+            return result(INTERVAL_SAFE, make(-a.hi, -a.lo));
+        case TOKEN_SIN:
+            v = periodic(sin, a, INTERVAL_PI / 2.0);
+            break;
+        case TOKEN_COS:
+            v = periodic(cos, a, 0.0);
+            break;
+        case TOKEN_TAN:
+            /* Polos em π/2 + kπ */
+            if (!(a.hi - a.lo < INTERVAL_PI) ||
+                fabs(a.lo) > INTERVAL_TRIG_MAX || fabs(a.hi) > INTERVAL_TRIG_MAX ||
+                contains_period(a, INTERVAL_PI / 2.0, INTERVAL_PI)) {
+                return result(INTERVAL_MAYBE, INTERVAL_ALL);
+            }
+            v = monotone(tan, a);
+            v.lo -= INTERVAL_TRIG_SLACK;
+            v.hi += INTERVAL_TRIG_SLACK;
+            break;
+        case TOKEN_ABS:
+            if (a.lo >= 0.0) v = a;
+            else if (a.hi <= 0.0) v = make(-a.hi, -a.lo);
+            else v = make(0.0, fmax(-a.lo, a.hi));
+            break;
+        case TOKEN_SQRT:
+            status = restrict_domain(&a, 0.0, 0, INFINITY, 0);
+            v = monotone(sqrt, a);
+            break;
+        case TOKEN_EXP:
+            v = monotone(exp, a);
+            break;
+        case TOKEN_LOG:
+            status = restrict_domain(&a, 0.0, 1, INFINITY, 0);
+            v = monotone(log, a);
+            break;
+        case TOKEN_LOG10:
+            status = restrict_domain(&a, 0.0, 1, INFINITY, 0);
+            v = monotone(log10, a);
+            break;
+        case TOKEN_SINH:
+            v = monotone(sinh, a);
+            break;
+        case TOKEN_COSH:
+            v = monotone(cosh, make(a.lo > 0.0 ? a.lo : (a.hi < 0.0 ? -a.hi : 0.0),
+                                    fmax(fabs(a.lo), fabs(a.hi))));
+            break;
+        case TOKEN_TANH:
+            v = monotone(tanh, a);
+            break;
+        case TOKEN_ASIN:
+            status = restrict_domain(&a, -1.0, 0, 1.0, 0);
+            v = monotone(asin, a);
+            break;
+        case TOKEN_ACOS:
+            status = restrict_domain(&a, -1.0, 0, 1.0, 0);
+            v = monotone(acos, a);
+            break;
+        case TOKEN_ATAN:
+            v = monotone(atan, a);
+            break;
+        case TOKEN_ASINH:
+            v = monotone(asinh, a);
+            break;
+        case TOKEN_ACOSH:
+            status = restrict_domain(&a, 1.0, 0, INFINITY, 0);
+            v = monotone(acosh, a);
+            break;
+        case TOKEN_ATANH:
+            status = restrict_domain(&a, -1.0, 1, 1.0, 1);
+            v = monotone(atanh, a);
+            break;
+        case TOKEN_CEIL:
+            v = monotone(ceil, a);
+            break;
+        case TOKEN_FLOOR:
+            v = monotone(floor, a);
+            break;
+        case TOKEN_FRAC:
+            /* x - floor(x) pode arredondar para 1 com x negativo minúsculo */
+            if (isfinite(a.lo) && isfinite(a.hi) && floor(a.lo) == floor(a.hi)) {
+                v = make(a.lo - floor(a.lo), a.hi - floor(a.hi));
+            } else {
+                v = make(0.0, 1.0);
+            }
+            break;
+        default:
+            /* Token desconhecido: evaluator_apply_function sempre falha */
+            return result(INTERVAL_FAILS, INTERVAL_ALL);
+    }
+
+    return finish(status, v);
+}
+
+/* Produto em que 0 * inf vale 0 (os valores reais são finitos) */
+static double mul0(double a, double b) {
+    return (a == 0.0 || b == 0.0) ? 0.0 : a * b;
+}
+
+/* Menor e maior de quatro cantos */
+static Interval corners(double a, double b, double c, double d) {
+    return make(fmin(fmin(a, b), fmin(c, d)), fmax(fmax(a, b), fmax(c, d)));
+}
+
+/* x^n com n inteiro e exato (expoente constante) */
+static IntervalResult integer_pow(Interval l, double n) {
+    if (n == 0.0) return result(INTERVAL_SAFE, make(1.0, 1.0));
+
+    int odd = (fmod(n, 2.0) != 0.0);
+    if (l.lo < 0.0 && l.hi > 0.0) {
+        /* Faixa cruza o zero: pólo para n < 0 */
+        if (n < 0.0) return result(INTERVAL_MAYBE, INTERVAL_ALL);
+        if (odd) return finish(INTERVAL_SAFE, make(pow(l.lo, n), pow(l.hi, n)));
+        return finish(INTERVAL_SAFE, make(0.0, fmax(pow(l.lo, n), pow(l.hi, n))));
+    }
+    if (n < 0.0 && l.lo == 0.0 && l.hi == 0.0) return result(INTERVAL_FAILS, INTERVAL_ALL);
+    if (n < 0.0 && (l.lo == 0.0 || l.hi == 0.0)) return result(INTERVAL_MAYBE, INTERVAL_ALL);
+    double a = pow(l.lo, n), b = pow(l.hi, n);
+    return finish(INTERVAL_SAFE, make(fmin(a, b), fmax(a, b)));
+}
+
+static IntervalResult interval_pow(Interval l, Interval r) {
+    if (r.lo == r.hi && r.lo == floor(r.lo) && fabs(r.lo) <= 0x1p53) {
+        return integer_pow(l, r.lo);
+    }
+
+    /* Base não negativa: monótona em cada argumento, extremos nos cantos
+     * (0^y com y > 0 vale 0) */
+    if (l.lo > 0.0 || (l.lo >= 0.0 && r.lo > 0.0)) {
+        return finish(INTERVAL_SAFE, corners(pow(l.lo, r.lo), pow(l.lo, r.hi),
+                                             pow(l.hi, r.lo), pow(l.hi, r.hi)));
+    }
+
+    /* Base negativa com expoente constante não inteiro: sempre NaN */
+    if (l.hi < 0.0 && r.lo == r.hi) return result(INTERVAL_FAILS, INTERVAL_ALL);
+    return result(INTERVAL_MAYBE, INTERVAL_ALL);
+}
+
+IntervalResult interval_apply_operator(TokenType type, Interval l, Interval r) {
+    if (isnan(l.lo) || isnan(l.hi) || isnan(r.lo) || isnan(r.hi)) {
+        return result(INTERVAL_MAYBE, INTERVAL_ALL);
+    }
+
+    switch (type) {
+        case TOKEN_PLUS:
+            return finish(INTERVAL_SAFE, make(l.lo + r.lo, l.hi + r.hi));
+        case TOKEN_MINUS:
+            return finish(INTERVAL_SAFE, make(l.lo - r.hi, l.hi - r.lo));
+        case TOKEN_MULT:
+            return finish(INTERVAL_SAFE, corners(mul0(l.lo, r.lo), mul0(l.lo, r.hi),
+                                                 mul0(l.hi, r.lo), mul0(l.hi, r.hi)));
+        case TOKEN_DIV:
+            /* Divisor só zero: EVAL_DIVISION_BY_ZERO em toda a faixa;
+             * divisor cruzando o zero: polo */
+            if (r.lo == 0.0 && r.hi == 0.0) return result(INTERVAL_FAILS, INTERVAL_ALL);
+            if (r.lo <= 0.0 && r.hi >= 0.0) return result(INTERVAL_MAYBE, INTERVAL_ALL);
+            return finish(INTERVAL_SAFE, corners(l.lo / r.lo, l.lo / r.hi,
+                                                 l.hi / r.lo, l.hi / r.hi));
+        case TOKEN_POW:
+            return interval_pow(l, r);
+        default:
+            return result(INTERVAL_FAILS, INTERVAL_ALL);
+    }
+}
+
+/* Tokens [a, a+len) e [b, b+len) descrevem a mesma subexpressão? */
+static int same_subexpr(const TokenBuffer *rpn, int a, int b, int len) {
+    for (int i = 0; i < len; i++) {
+        const Token *ta = &rpn->tokens[a + i], *tb = &rpn->tokens[b + i];
+        if (ta->type != tb->type) return 0;
+        if (ta->type == TOKEN_NUMBER &&
+            rpn->values[ta->value_index] != rpn->values[tb->value_index]) return 0;
+    }
+    return 1;
+}
+
+IntervalResult interval_eval_rpn(const TokenBuffer *rpn, Interval var) {
+    if (!rpn || !rpn->tokens || rpn->size == 0) return result(INTERVAL_FAILS, INTERVAL_ALL);
+
+    /* Erro estrutural: toda amostra falha (com o erro da posição de parada ou
+     * com um erro numérico anterior) */
+    EvalError stop_error;
+    int stop = evaluator_validate_rpn(rpn, &stop_error);
+    if (stop_error != EVAL_OK) return result(INTERVAL_FAILS, INTERVAL_ALL);
+
+    /* Pilha de intervalos; start[i] é o primeiro token da subexpressão i */
+    IntervalResult stack[MAX_EVAL_STACK_SIZE];
+    int start[MAX_EVAL_STACK_SIZE];
+    int top = -1;
+
+    for (int i = 0; i < stop; i++) {
+        Token token = rpn->tokens[i];
+        TokenType type = (TokenType)token.type;
+        IntervalResult r;
+
+        switch (type) {
+            case TOKEN_NUMBER: {
+                double v = rpn->values[token.value_index];
+                start[++top] = i;
+                stack[top] = result(INTERVAL_SAFE, make(v, v));
+                continue;
+            }
+            case TOKEN_VARIABLE_X:
+            case TOKEN_VARIABLE_THETA:
+            case TOKEN_VARIABLE_T:
+                start[++top] = i;
+                stack[top] = result(INTERVAL_SAFE, var);
+                continue;
+            case TOKEN_CONST_PI:
+            case TOKEN_CONST_E: {
+                double v = (type == TOKEN_CONST_PI) ? INTERVAL_PI : INTERVAL_E;
+                start[++top] = i;
+                stack[top] = result(INTERVAL_SAFE, make(v, v));
+                continue;
+            }
+            case TOKEN_PLUS: case TOKEN_MINUS: case TOKEN_MULT:
+            case TOKEN_DIV: case TOKEN_POW: {
+                IntervalResult right = stack[top--];
+                IntervalResult left = stack[top];
+                int ls = start[top], rs = start[top + 1];
+                if (type == TOKEN_MULT && i - rs == rs - ls && same_subexpr(rpn, ls, rs, i - rs)) {
+                    /* x*x: quadrado, nunca negativo */
+                    r = integer_pow(left.value, 2.0);
+                } else {
+                    r = interval_apply_operator(type, left.value, right.value);
+                }
+                if (left.status > r.status) r.status = left.status;
+                if (right.status > r.status) r.status = right.status;
+                stack[top] = r;
+                continue;
+            }
+            default:
+                /* NEG e funções (validate_rpn já recusou tokens desconhecidos) */
+                r = interval_apply_function(type, stack[top].value);
+                if (stack[top].status > r.status) r.status = stack[top].status;
+                stack[top] = r;
+                continue;
+        }
+    }
+
+    return stack[0];
+}
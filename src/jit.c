@@ -0,0 +1,391 @@
+/* Motor JIT x86-64 (System V): programa de registradores → código de máquina */
+#define _GNU_SOURCE     /* MAP_ANONYMOUS e sincos() */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "jit.h"
+
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__))
+#define JIT_SUPPORTED 1
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define JIT_SUPPORTED 0
+#endif
+
+/* Assinatura do código gerado: regs[0] = variável na entrada; temporários em
+ * regs[nconsts+1 ..]; regs[REGVM_MAX_REGS] é rascunho. Retorna 0 se todas as
+ * instruções produziram valores finitos, 1 caso contrário. */
+typedef int (*JitFn)(double *regs);
+
+struct JitProgram {
+    const RegProgram *prog;
+    unsigned char *mem;         /* buffer mapeado (dados + código) */
+    size_t mem_size;
+    size_t code_size;
+    JitFn fn;
+};
+
+int jit_available(void) {
+    return JIT_SUPPORTED;
+}
+
+#if JIT_SUPPORTED
+
+/* ========================================================================
+ * Emissor
+ * ======================================================================== */
+
+typedef struct {
+    unsigned char *buf;
+    size_t size;
+    size_t cap;
+    int overflow;
+} Emitter;
+
+static void emit_byte(Emitter *e, unsigned char b) {
+    if (e->size < e->cap) e->buf[e->size] = b;
+    else e->overflow = 1;
+    e->size++;
+}
+
+static void emit_bytes(Emitter *e, const unsigned char *b, int n) {
+    for (int i = 0; i < n; i++) emit_byte(e, b[i]);
+}
+
+static void emit_u32(Emitter *e, uint32_t v) {
+    for (int i = 0; i < 4; i++) emit_byte(e, (unsigned char)(v >> (8 * i)));
+}
+
+static void emit_u64(Emitter *e, uint64_t v) {
+    for (int i = 0; i < 8; i++) emit_byte(e, (unsigned char)(v >> (8 * i)));
+}
+
+/* Endereços da área de dados (início do buffer, antes do código) */
+typedef struct {
+    const RegProgram *prog;
+    size_t consts_off;          /* valores de r1..rK */
+} Layout;
+
+#define XMM0 0
+#define XMM1 1
+
+/* Deslocamento de regs[r] a partir de rbx */
+#define REG_DISP(r) ((uint32_t)(8 * (r)))
+
+/* Slot de rascunho (FRAC, sincos sem glibc) */
+#define SCRATCH REGVM_MAX_REGS
+
+/* Instrução SSE com operando de memória: prefixo 0F op, ModRM para regs[r]
+ * ([rbx+disp32]) ou, se r é constante, para a área de dados ([rip+disp32]) */
+static void emit_sse_mem(Emitter *e, const Layout *l, unsigned char prefix,
+                         unsigned char op, int xmm, int r) {
+    emit_byte(e, prefix);
+    emit_byte(e, 0x0F);
+    emit_byte(e, op);
+    if (r >= 1 && r <= l->prog->nconsts) {
+        emit_byte(e, (unsigned char)((xmm << 3) | 0x05));
+        /* rip aponta para o fim desta instrução (após os 4 bytes do deslocamento) */
+        int64_t target = (int64_t)(l->consts_off + 8 * (size_t)(r - 1));
+        int64_t next = (int64_t)e->size + 4;
+        emit_u32(e, (uint32_t)(int32_t)(target - next));
+    } else {
+        emit_byte(e, (unsigned char)(0x80 | (xmm << 3) | 0x03));
+        emit_u32(e, REG_DISP(r));
+    }
+}
+
+/* movsd xmm, regs[r] */
+static void emit_load(Emitter *e, const Layout *l, int xmm, int r) {
+    emit_sse_mem(e, l, 0xF2, 0x10, xmm, r);
+}
+
+/* movsd regs[r], xmm (r nunca é constante) */
+static void emit_store(Emitter *e, const Layout *l, int xmm, int r) {
+    emit_sse_mem(e, l, 0xF2, 0x11, xmm, r);
+}
+
+/* call para uma função C: mov rax, imm64; call rax */
+static void emit_call(Emitter *e, const void *fn) {
+    static const unsigned char mov_rax[] = { 0x48, 0xB8 };
+    static const unsigned char call_rax[] = { 0xFF, 0xD0 };
+    uint64_t addr;
+    memcpy(&addr, &fn, sizeof addr);
+    emit_bytes(e, mov_rax, 2);
+    emit_u64(e, addr);
+    emit_bytes(e, call_rax, 2);
+}
+
+/* lea rdi/rsi, [rbx+disp32] */
+static void emit_lea(Emitter *e, int dst_rsi, int r) {
+    emit_byte(e, 0x48);
+    emit_byte(e, 0x8D);
+    emit_byte(e, dst_rsi ? 0xB3 : 0xBB);
+    emit_u32(e, REG_DISP(r));
+}
+
+/* Se xmm0 não é finito, salta para a saída de erro:
+ *   movapd xmm1, xmm0; subsd xmm1, xmm1; ucomisd xmm1, xmm1; jp erro
+ * (x - x é NaN exatamente quando x é ±Inf ou NaN). Registra a posição do
+ * deslocamento do jp para corrigir depois. */
+static void emit_check(Emitter *e, size_t *fixups, int *nfixups) {
+    static const unsigned char seq[] = {
+        0x66, 0x0F, 0x28, 0xC8,     /* movapd xmm1, xmm0 */
+        0xF2, 0x0F, 0x5C, 0xC9,     /* subsd xmm1, xmm1 */
+        0x66, 0x0F, 0x2E, 0xC9,     /* ucomisd xmm1, xmm1 */
+        0x0F, 0x8A                  /* jp rel32 */
+    };
+    emit_bytes(e, seq, sizeof seq);
+    fixups[(*nfixups)++] = e->size;
+    emit_u32(e, 0);
+}
+
+/* Função da libm para cada token (NULL: tratado em linha) */
+static const void *libm_function(TokenType type) {
+    switch (type) {
+        case TOKEN_SIN:   return (const void *)sin;
+        case TOKEN_COS:   return (const void *)cos;
+        case TOKEN_TAN:   return (const void *)tan;
+        case TOKEN_SQRT:  return (const void *)sqrt;
+        case TOKEN_EXP:   return (const void *)exp;
+        case TOKEN_LOG:   return (const void *)log;
+        case TOKEN_LOG10: return (const void *)log10;
+        case TOKEN_SINH:  return (const void *)sinh;
+        case TOKEN_COSH:  return (const void *)cosh;
+        case TOKEN_TANH:  return (const void *)tanh;
+        case TOKEN_ASIN:  return (const void *)asin;
+        case TOKEN_ACOS:  return (const void *)acos;
+        case TOKEN_ATAN:  return (const void *)atan;
+        case TOKEN_ASINH: return (const void *)asinh;
+        case TOKEN_ACOSH: return (const void *)acosh;
+        case TOKEN_ATANH: return (const void *)atanh;
+        case TOKEN_CEIL:  return (const void *)ceil;
+        case TOKEN_FLOOR: return (const void *)floor;
+        default:          return NULL;
+    }
+}
+
+/* Máscaras para NEG e ABS (na área de dados, após as constantes) */
+static const uint64_t SIGN_MASK = 0x8000000000000000ULL;
+static const uint64_t ABS_MASK  = 0x7FFFFFFFFFFFFFFFULL;
+
+/* Carrega uma máscara de 64 bits da área de dados em xmm1 */
+static void emit_load_mask(Emitter *e, size_t off) {
+    static const unsigned char movsd_rip[] = { 0xF2, 0x0F, 0x10, 0x0D };  /* movsd xmm1, [rip+d] */
+    emit_bytes(e, movsd_rip, 4);
+    int64_t next = (int64_t)e->size + 4;
+    emit_u32(e, (uint32_t)(int32_t)((int64_t)off - next));
+}
+
+/* Gera o programa inteiro. Retorna 0 se alguma instrução não é suportada. */
+static int emit_program(Emitter *e, const RegProgram *prog, size_t *entry) {
+    Layout l = { prog, 0 };
+    size_t *fixups = malloc((prog->size + 1) * sizeof(size_t));
+    int nfixups = 0;
+    if (!fixups) return 0;
+
+    /* Área de dados: constantes e máscaras */
+    l.consts_off = e->size;
+    for (int c = 0; c < prog->nconsts; c++) {
+        uint64_t bits;
+        memcpy(&bits, &prog->consts[c], sizeof bits);
+        emit_u64(e, bits);
+    }
+    size_t sign_off = e->size;
+    emit_u64(e, SIGN_MASK);
+    size_t abs_off = e->size;
+    emit_u64(e, ABS_MASK);
+    while (e->size % 16) emit_byte(e, 0xCC);
+
+    /* Prólogo: push rbx (alinha a pilha em 16 para as chamadas); rbx = regs */
+    *entry = e->size;
+    static const unsigned char prologue[] = { 0x53, 0x48, 0x89, 0xFB };
+    emit_bytes(e, prologue, sizeof prologue);
+
+    int ok = 1;
+    for (int i = 0; i < prog->size && ok; i++) {
+        const RegInstr *in = &prog->code[i];
+
+        emit_load(e, &l, XMM0, in->a);
+        switch (in->op) {
+            case TOKEN_PLUS:  emit_sse_mem(e, &l, 0xF2, 0x58, XMM0, in->b); break;
+            case TOKEN_MULT:  emit_sse_mem(e, &l, 0xF2, 0x59, XMM0, in->b); break;
+            case TOKEN_MINUS: emit_sse_mem(e, &l, 0xF2, 0x5C, XMM0, in->b); break;
+            case TOKEN_DIV:   emit_sse_mem(e, &l, 0xF2, 0x5E, XMM0, in->b); break;
+            case TOKEN_POW:
+                emit_load(e, &l, XMM1, in->b);
+                emit_call(e, (const void *)pow);
+                break;
+            case TOKEN_NEG: {
+                /* xorpd xmm0, xmm1 — NEG nunca falha */
+                static const unsigned char xorpd[] = { 0x66, 0x0F, 0x57, 0xC1 };
+                emit_load_mask(e, sign_off);
+                emit_bytes(e, xorpd, 4);
+                emit_store(e, &l, XMM0, in->dst);
+                continue;
+            }
+            case TOKEN_ABS: {
+                static const unsigned char andpd[] = { 0x66, 0x0F, 0x54, 0xC1 };
+                emit_load_mask(e, abs_off);
+                emit_bytes(e, andpd, 4);
+                break;
+            }
+            case TOKEN_FRAC: {
+                /* frac(a) = a - floor(a): guarda a no rascunho durante a chamada */
+                static const unsigned char subsd[] = { 0xF2, 0x0F, 0x5C, 0xC8 };  /* subsd xmm1, xmm0 */
+                static const unsigned char movapd[] = { 0x66, 0x0F, 0x28, 0xC1 }; /* movapd xmm0, xmm1 */
+                emit_store(e, &l, XMM0, SCRATCH);
+                emit_call(e, (const void *)floor);
+                emit_load(e, &l, XMM1, SCRATCH);
+                emit_bytes(e, subsd, 4);
+                emit_bytes(e, movapd, 4);
+                break;
+            }
+            case REGVM_OP_SINCOS:
+#if defined(__GLIBC__)
+                /* sincos(a, &regs[dst], &regs[b]); confere o seno (falham juntos) */
+                emit_lea(e, 0, in->dst);
+                emit_lea(e, 1, in->b);
+                emit_call(e, (const void *)sincos);
+#else
+                emit_store(e, &l, XMM0, SCRATCH);
+                emit_call(e, (const void *)cos);
+                emit_store(e, &l, XMM0, in->b);
+                emit_load(e, &l, XMM0, SCRATCH);
+                emit_call(e, (const void *)sin);
+                emit_store(e, &l, XMM0, in->dst);
+#endif
+                emit_load(e, &l, XMM0, in->dst);
+                emit_check(e, fixups, &nfixups);
+                continue;
+            default: {
+                const void *fn = libm_function((TokenType)in->op);
+                if (!fn) {
+                    ok = 0;
+                    continue;
+                }
+                emit_call(e, fn);
+                break;
+            }
+        }
+
+        /* Domínio inválido também vira NaN/Inf na libm: a reavaliação pelo
+         * interpretador distingue o código de erro */
+        emit_check(e, fixups, &nfixups);
+        emit_store(e, &l, XMM0, in->dst);
+    }
+
+    /* Sucesso: xor eax, eax; pop rbx; ret */
+    static const unsigned char ok_exit[] = { 0x31, 0xC0, 0x5B, 0xC3 };
+    emit_bytes(e, ok_exit, sizeof ok_exit);
+
+    /* Erro: mov eax, 1; pop rbx; ret */
+    size_t fail = e->size;
+    static const unsigned char fail_exit[] = { 0xB8, 0x01, 0x00, 0x00, 0x00, 0x5B, 0xC3 };
+    emit_bytes(e, fail_exit, sizeof fail_exit);
+
+    for (int f = 0; f < nfixups && !e->overflow; f++) {
+        int32_t rel = (int32_t)((int64_t)fail - (int64_t)(fixups[f] + 4));
+        for (int b = 0; b < 4; b++) e->buf[fixups[f] + b] = (unsigned char)((uint32_t)rel >> (8 * b));
+    }
+
+    free(fixups);
+    return ok;
+}
+
+JitProgram *jit_compile(const RegProgram *prog) {
+    if (!prog) return NULL;
+
+    /* Primeira passada só mede; a segunda escreve no buffer mapeado */
+    Emitter measure = { NULL, 0, 0, 0 };
+    size_t entry;
+    if (!emit_program(&measure, prog, &entry)) return NULL;
+
+    long page = sysconf(_SC_PAGESIZE);
+    if (page <= 0) page = 4096;
+    size_t mem_size = (measure.size + (size_t)page - 1) / (size_t)page * (size_t)page;
+
+    void *mem = mmap(NULL, mem_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) return NULL;
+
+    Emitter e = { mem, 0, mem_size, 0 };
+    if (!emit_program(&e, prog, &entry) || e.overflow ||
+        mprotect(mem, mem_size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(mem, mem_size);
+        return NULL;
+    }
+
+    JitProgram *jit = malloc(sizeof(JitProgram));
+    if (!jit) {
+        munmap(mem, mem_size);
+        return NULL;
+    }
+    jit->prog = prog;
+    jit->mem = mem;
+    jit->mem_size = mem_size;
+    jit->code_size = e.size;
+    /* Conversão de objeto para função: permitida pelo POSIX (dlsym usa o mesmo) */
+    void *entry_ptr = (unsigned char *)mem + entry;
+    memcpy(&jit->fn, &entry_ptr, sizeof jit->fn);
+    return jit;
+}
+
+void jit_free(JitProgram *jit) {
+    if (!jit) return;
+    munmap(jit->mem, jit->mem_size);
+    free(jit);
+}
+
+#else /* !JIT_SUPPORTED */
+
+JitProgram *jit_compile(const RegProgram *prog) {
+    (void)prog;
+    return NULL;
+}
+
+void jit_free(JitProgram *jit) {
+    (void)jit;
+}
+
+#endif
+
+/* Valor de um registrador após a execução (constantes ficam na área de dados) */
+static double register_value(const RegProgram *prog, const double *regs, int r) {
+    if (r >= 1 && r <= prog->nconsts) return prog->consts[r - 1];
+    return regs[r];
+}
+
+void jit_eval_multi(const JitProgram *jit, double var_value, EvalResult *results) {
+    const RegProgram *prog = jit->prog;
+    double regs[REGVM_MAX_REGS + 1];
+    regs[REGVM_REG_VAR] = var_value;
+
+    if (jit->fn(regs) != 0) {
+        /* Alguma instrução falhou: o interpretador separa o erro de cada saída */
+        regvm_eval_multi(prog, var_value, results);
+        return;
+    }
+
+    for (int k = 0; k < prog->noutputs; k++) {
+        results[k].error = prog->stop_error[k];
+        results[k].value = (prog->stop_error[k] == EVAL_OK)
+                               ? register_value(prog, regs, prog->result[k]) : 0.0;
+    }
+}
+
+void jit_eval_batch(const JitProgram *jit, const double *in,
+                    double *const *out, uint8_t *const *status, size_t n) {
+    EvalResult r[EVAL_MAX_OUTPUTS];
+    for (size_t i = 0; i < n; i++) {
+        jit_eval_multi(jit, in[i], r);
+        for (int k = 0; k < jit->prog->noutputs; k++) {
+            if (!out[k]) continue;
+            out[k][i] = (r[k].error == EVAL_OK) ? r[k].value : 0.0;
+            status[k][i] = (uint8_t)r[k].error;
+        }
+    }
+}
+
+size_t jit_code_size(const JitProgram *jit) {
+    return jit->code_size;
+}
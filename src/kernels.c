@@ -0,0 +1,223 @@
+/* Kernels de avaliação em bloco: referência escalar + variantes SIMD com
+ * seleção em tempo de execução conforme a CPU.
+ *
+ * A variável de ambiente MULTICURVAS_SIMD (scalar, sse2, avx2, avx512) limita
+ * o nível escolhido na inicialização — útil para comparar resultados e medir.
+ */
+#define _GNU_SOURCE     /* sincos() da glibc */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "kernels.h"
+#include "evaluator.h"
+
+/* SIMD apenas em x86 com compiladores que suportam target por função */
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define KERNELS_HAVE_X86 1
+#else
+#define KERNELS_HAVE_X86 0
+#endif
+
+/* Marca erro na amostra i apenas se ela ainda não falhou (status NULL: modo
+ * sem verificação) */
+#define MARK_ERROR(status, i, err) \
+    do { if ((status) && (status)[i] == EVAL_OK) (status)[i] = (uint8_t)(err); } while (0)
+
+/* ========================================================================
+ * Kernels escalares (referência)
+ * ======================================================================== */
+
+/* Verifica resultado inválido (NaN/Inf) em todas as amostras do bloco */
+static inline void check_finite_block(const double *out, uint8_t *status, int n) {
+    if (!status) return;
+    for (int i = 0; i < n; i++) {
+        if (isnan(out[i]) || isinf(out[i])) MARK_ERROR(status, i, EVAL_MATH_ERROR);
+    }
+}
+
+void kernels_scalar_binary(TokenType type, const double *left, const double *right,
+                           double *out, uint8_t *status, int n) {
+    switch (type) {
+        case TOKEN_PLUS:
+            for (int i = 0; i < n; i++) out[i] = left[i] + right[i];
+            break;
+        case TOKEN_MINUS:
+            for (int i = 0; i < n; i++) out[i] = left[i] - right[i];
+            break;
+        case TOKEN_MULT:
+            for (int i = 0; i < n; i++) out[i] = left[i] * right[i];
+            break;
+        case TOKEN_DIV:
+            for (int i = 0; i < n; i++) {
+                if (right[i] == 0.0) {
+                    MARK_ERROR(status, i, EVAL_DIVISION_BY_ZERO);
+                    out[i] = 0.0;
+                } else {
+                    out[i] = left[i] / right[i];
+                }
+            }
+            break;
+        case TOKEN_POW:
+            for (int i = 0; i < n; i++) {
+                out[i] = pow(left[i], right[i]);
+                if (isnan(out[i])) MARK_ERROR(status, i, EVAL_DOMAIN_ERROR);
+            }
+            break;
+        default:
+            for (int i = 0; i < n; i++) MARK_ERROR(status, i, EVAL_MATH_ERROR);
+            return;
+    }
+
+    check_finite_block(out, status, n);
+}
+
+/* Laço de função sem verificação de domínio */
+#define FUNC_BLOCK(expr) \
+    for (int i = 0; i < n; i++) { double a = arg[i]; out[i] = (expr); }
+
+/* Laço de função com verificação de domínio por amostra */
+#define FUNC_BLOCK_DOMAIN(invalid, expr) \
+    for (int i = 0; i < n; i++) { \
+        double a = arg[i]; \
+        if (invalid) { MARK_ERROR(status, i, EVAL_DOMAIN_ERROR); out[i] = 0.0; } \
+        else out[i] = (expr); \
+    }
+
+void kernels_scalar_unary(TokenType type, const double *arg,
+                          double *out, uint8_t *status, int n) {
+    switch (type) {
+        case TOKEN_NEG:
+            /* Negação nunca gera erro */
+            for (int i = 0; i < n; i++) out[i] = -arg[i];
+            return;
+        case TOKEN_SIN:   FUNC_BLOCK(sin(a)); break;
+        case TOKEN_COS:   FUNC_BLOCK(cos(a)); break;
+        case TOKEN_TAN:   FUNC_BLOCK(tan(a)); break;
+        case TOKEN_ABS:   FUNC_BLOCK(fabs(a)); break;
+        case TOKEN_SQRT:  FUNC_BLOCK_DOMAIN(a < 0.0, sqrt(a)); break;
+        case TOKEN_EXP:   FUNC_BLOCK(exp(a)); break;
+        case TOKEN_LOG:   FUNC_BLOCK_DOMAIN(a <= 0.0, log(a)); break;
+        case TOKEN_LOG10: FUNC_BLOCK_DOMAIN(a <= 0.0, log10(a)); break;
+        case TOKEN_SINH:  FUNC_BLOCK(sinh(a)); break;
+        case TOKEN_COSH:  FUNC_BLOCK(cosh(a)); break;
+        case TOKEN_TANH:  FUNC_BLOCK(tanh(a)); break;
+        case TOKEN_ASIN:  FUNC_BLOCK_DOMAIN(a < -1.0 || a > 1.0, asin(a)); break;
+        case TOKEN_ACOS:  FUNC_BLOCK_DOMAIN(a < -1.0 || a > 1.0, acos(a)); break;
+        case TOKEN_ATAN:  FUNC_BLOCK(atan(a)); break;
+        case TOKEN_ASINH: FUNC_BLOCK(asinh(a)); break;
+        case TOKEN_ACOSH: FUNC_BLOCK_DOMAIN(a < 1.0, acosh(a)); break;
+        case TOKEN_ATANH: FUNC_BLOCK_DOMAIN(a <= -1.0 || a >= 1.0, atanh(a)); break;
+        case TOKEN_CEIL:  FUNC_BLOCK(ceil(a)); break;
+        case TOKEN_FLOOR: FUNC_BLOCK(floor(a)); break;
+        case TOKEN_FRAC:  FUNC_BLOCK(a - floor(a)); break;
+        default:
+            for (int i = 0; i < n; i++) MARK_ERROR(status, i, EVAL_MATH_ERROR);
+            return;
+    }
+
+    check_finite_block(out, status, n);
+}
+
+#undef FUNC_BLOCK
+#undef FUNC_BLOCK_DOMAIN
+
+void kernels_scalar_sincos(const double *arg, double *sin_out, double *cos_out,
+                           uint8_t *status, int n) {
+    for (int i = 0; i < n; i++) {
+        double s, c;
+#if defined(__GLIBC__)
+        /* Uma redução de argumento; bit a bit idêntico a sin() e cos() */
+        sincos(arg[i], &s, &c);
+#else
+        s = sin(arg[i]);
+        c = cos(arg[i]);
+#endif
+        sin_out[i] = s;
+        cos_out[i] = c;
+        /* sin e cos só falham juntos (argumento infinito ou NaN) */
+        if (isnan(s) || isinf(s)) MARK_ERROR(status, i, EVAL_MATH_ERROR);
+    }
+}
+
+/* ========================================================================
+ * Kernels vetoriais (mesmo código-fonte instanciado para cada largura)
+ * ======================================================================== */
+
+#if KERNELS_HAVE_X86
+#include <immintrin.h>
+
+#define KSUF       sse2
+#define KTARGET    "sse2"
+#define KLANES     2
+#define KSQRT(v)   ((VD)_mm_sqrt_pd((__m128d)(v)))
+#include "kernels_vec.h"
+
+#define KSUF       avx2
+#define KTARGET    "avx2"
+#define KLANES     4
+#define KSQRT(v)   ((VD)_mm256_sqrt_pd((__m256d)(v)))
+#include "kernels_vec.h"
+
+#define KSUF       avx512
+#define KTARGET    "avx512f"
+#define KLANES     8
+#define KSQRT(v)   ((VD)_mm512_sqrt_pd((__m512d)(v)))
+#include "kernels_vec.h"
+#endif
+
+/* ========================================================================
+ * Seleção em tempo de execução
+ * ======================================================================== */
+
+static const Kernels kernel_table[] = {
+    { KERNELS_SCALAR, "scalar", kernels_scalar_binary, kernels_scalar_unary,
+      kernels_scalar_sincos },
+#if KERNELS_HAVE_X86
+    { KERNELS_SSE2,   "sse2",   kern_sse2_binary,      kern_sse2_unary,   kern_sse2_sincos_block },
+    { KERNELS_AVX2,   "avx2",   kern_avx2_binary,      kern_avx2_unary,   kern_avx2_sincos_block },
+    { KERNELS_AVX512, "avx512", kern_avx512_binary,    kern_avx512_unary, kern_avx512_sincos_block },
+#endif
+};
+
+static const Kernels *active_kernels = NULL;
+
+KernelLevel kernels_detect(void) {
+#if KERNELS_HAVE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return KERNELS_AVX512;
+    if (__builtin_cpu_supports("avx2")) return KERNELS_AVX2;
+    if (__builtin_cpu_supports("sse2")) return KERNELS_SSE2;
+#endif
+    return KERNELS_SCALAR;
+}
+
+KernelLevel kernels_set_level(KernelLevel level) {
+    KernelLevel max = kernels_detect();
+    if (level > max) level = max;
+    active_kernels = &kernel_table[level];
+    return level;
+}
+
+/* Escolhe o melhor nível, respeitando MULTICURVAS_SIMD se definida */
+static void kernels_init(void) {
+    KernelLevel level = KERNELS_AVX512;
+    const char *env = getenv("MULTICURVAS_SIMD");
+    if (env) {
+        if (strcmp(env, "scalar") == 0) level = KERNELS_SCALAR;
+        else if (strcmp(env, "sse2") == 0) level = KERNELS_SSE2;
+        else if (strcmp(env, "avx2") == 0) level = KERNELS_AVX2;
+    }
+    kernels_set_level(level);
+}
+
+#if defined(__GNUC__)
+/* Seleção na inicialização do programa (antes de qualquer thread) */
+__attribute__((constructor)) static void kernels_startup(void) {
+    if (!active_kernels) kernels_init();
+}
+#endif
+
+const Kernels *kernels_active(void) {
+    if (!active_kernels) kernels_init();
+    return active_kernels;
+}
@@ -0,0 +1,407 @@
+/* Modelo dos kernels vetoriais — incluído por kernels.c uma vez por largura.
+ *
+ * Antes de cada inclusão, kernels.c define:
+ *   KSUF     sufixo dos nomes (sse2, avx2, avx512)
+ *   KTARGET  atributo target do GCC/Clang
+ *   KLANES   doubles por vetor
+ *   KSQRT(v) raiz quadrada vetorial (intrínseco da largura)
+ *
+ * O código usa as extensões vetoriais do GCC, então o mesmo texto gera SSE2,
+ * AVX2 ou AVX-512 conforme KTARGET. Verificações de domínio viram máscaras por
+ * lane; as funções transcendentais mais usadas nas curvas (sin, cos, tan, exp,
+ * log, cosh) têm aproximações polinomiais vetoriais (coeficientes Cephes; até
+ * 4 ulp da libm, limites por função em KERNELS_ULP_* de kernels.h). Lanes
+ * fora da faixa rápida e as demais funções caem para a libm lane a lane,
+ * mantendo a máscara de erros vetorial.
+ */
+
+#define KCAT_(a, b) a##_##b
+#define KCAT(a, b)  KCAT_(a, b)
+#define KNAME(name) KCAT(KCAT(kern, KSUF), name)
+
+#define VD KNAME(vd)
+#define VI KNAME(vi)
+#define KFN     static __attribute__((target(KTARGET)))
+#define KINLINE static inline __attribute__((always_inline, target(KTARGET)))
+
+typedef double    VD __attribute__((vector_size(KLANES * 8)));
+typedef long long VI __attribute__((vector_size(KLANES * 8)));
+
+/* ---- Utilitários ---- */
+
+KINLINE VD KNAME(load)(const double *p) { VD v; memcpy(&v, p, sizeof v); return v; }
+KINLINE void KNAME(store)(double *p, VD v) { memcpy(p, &v, sizeof v); }
+KINLINE VD KNAME(splat)(double c) { VD v = {0}; return v + c; }
+KINLINE VI KNAME(isplat)(long long c) { VI v = {0}; return v + c; }
+
+/* Seleciona a onde m é verdadeiro (-1), b caso contrário */
+KINLINE VD KNAME(sel)(VI m, VD a, VD b) { return (VD)(((VI)a & m) | ((VI)b & ~m)); }
+KINLINE VI KNAME(seli)(VI m, VI a, VI b) { return (a & m) | (b & ~m); }
+
+KINLINE VD KNAME(vabs)(VD v) { return (VD)((VI)v & 0x7fffffffffffffffLL); }
+
+/* Máscara de valores finitos (falso para NaN e ±Inf) */
+KINLINE VI KNAME(finite)(VD v) { return KNAME(vabs)(v) <= 1.7976931348623157e308; }
+
+/* floor vetorial sem SSE4.1: arredonda via 2^52 e corrige.
+ * Preserva -0.0 e valores já inteiros (|v| >= 2^52, NaN, Inf). */
+KINLINE VD KNAME(vfloor)(VD v) {
+    VI sign = (VI)v & (long long)0x8000000000000000ULL;
+    VD big = (VD)(sign | (VI)KNAME(splat)(4503599627370496.0));
+    VD t = (v + big) - big;
+    t = KNAME(sel)(t > v, t - 1.0, t);
+    t = (VD)((VI)t | sign);
+    return KNAME(sel)(KNAME(vabs)(v) < 4503599627370496.0, t, v);
+}
+
+/* Converte double inteiro (|v| < 2^51) para inteiro de 64 bits */
+KINLINE VI KNAME(toint)(VD v) {
+    VD magic = KNAME(splat)(6755399441055744.0);  /* 1.5 * 2^52 */
+    return (VI)(v + magic) - (VI)magic;
+}
+
+/* Grava o primeiro erro de cada lane */
+KINLINE void KNAME(merge)(uint8_t *status, VI code) {
+    for (int l = 0; l < KLANES; l++) {
+        if (status[l] == EVAL_OK) status[l] = (uint8_t)code[l];
+    }
+}
+
+/* Grava o código das lanes [i, i+KLANES) — nada sem `status` (modo sem
+ * verificação: o código nem é calculado) */
+#define KMERGE(code) do { if (status) KNAME(merge)(status + i, (code)); } while (0)
+
+/* Status das sobras a partir de i (NULL no modo sem verificação) */
+#define KTAIL (status ? status + i : NULL)
+
+/* Código de erro EVAL_MATH_ERROR onde o resultado não é finito */
+KINLINE VI KNAME(math_code)(VD v) {
+    return KNAME(seli)(KNAME(finite)(v), KNAME(isplat)(EVAL_OK), KNAME(isplat)(EVAL_MATH_ERROR));
+}
+
+/* ---- Aproximações transcendentais ---- */
+
+/* Faixa em que a redução de argumento de sin/cos é precisa */
+#define KSINCOS_MAX 1.073741824e9
+
+/* sin e cos simultâneos (redução por octante, Cody-Waite em 3 partes) */
+KINLINE void KNAME(sincos)(VD x, VD *s, VD *c) {
+    VD ax = KNAME(vabs)(x);
+    VD y = KNAME(vfloor)(ax * 1.27323954473516268615);   /* 4/pi */
+    VI j = KNAME(toint)(y);
+    VI odd = j & 1;
+    j += odd;
+    y += __builtin_convertvector(odd, VD);
+    VI q = (j & 7) >> 1;                                    /* quadrante 0..3 */
+
+    VD z = ((ax - y * 7.85398125648498535156e-1)
+                - y * 3.77489470793079817668e-8)
+                - y * 2.69515142907905952645e-15;
+    VD zz = z * z;
+
+    VD ps = ((((( 1.58962301576546568060e-10 * zz
+                - 2.50507477628578072866e-8) * zz
+                + 2.75573136213857245213e-6) * zz
+                - 1.98412698295895385996e-4) * zz
+                + 8.33333333332211858878e-3) * zz
+                - 1.66666666666666307295e-1);
+    ps = z + z * zz * ps;
+
+    VD pc = (((((-1.13585365213876817300e-11 * zz
+                + 2.08757008419747316778e-9) * zz
+                - 2.75573141792967388112e-7) * zz
+                + 2.48015872888517045348e-5) * zz
+                - 1.38888888888730564116e-3) * zz
+                + 4.16666666666665929218e-2);
+    pc = 1.0 - 0.5 * zz + zz * zz * pc;
+
+    VI swap = (q & 1) != 0;
+    VD sv = KNAME(sel)(swap, pc, ps);
+    VD cv = KNAME(sel)(swap, ps, pc);
+
+    const long long SIGN = (long long)0x8000000000000000ULL;
+    VI sneg = (((q & 2) != 0) ^ (x < 0.0)) & SIGN;
+    VI cneg = (((q + 1) & 2) != 0) & SIGN;
+    *s = (VD)((VI)sv ^ sneg);
+    *c = (VD)((VI)cv ^ cneg);
+}
+
+/* exp para |x| <= 700 (resultado sempre normal) */
+KINLINE VD KNAME(exp)(VD x) {
+    VD px = KNAME(vfloor)(1.4426950408889634073599 * x + 0.5);   /* log2(e) */
+    VI n = KNAME(toint)(px);
+    x = x - px * 6.93145751953125e-1;
+    x = x - px * 1.42860682030941723212e-6;
+
+    VD xx = x * x;
+    VD p = x * ((1.26177193074810590878e-4 * xx
+                + 3.02994407707441961300e-2) * xx
+                + 9.99999999999999999910e-1);
+    VD q = ((3.00198505138664455042e-6 * xx
+                + 2.52448340349684104192e-3) * xx
+                + 2.27265548208155028766e-1) * xx
+                + 2.00000000000000000009e0;
+    x = p / (q - p);
+    x = 1.0 + 2.0 * x;
+
+    return (VD)((VI)x + (n << 52));
+}
+
+/* log para x normal e positivo */
+KINLINE VD KNAME(log)(VD x) {
+    VI bits = (VI)x;
+    VI e = ((bits >> 52) & 0x7ff) - 1022;
+    VD m = (VD)((bits & 0x000fffffffffffffLL) | 0x3fe0000000000000LL);   /* [0.5, 1) */
+
+    VI small = m < 0.70710678118654752440;   /* sqrt(1/2) */
+    e += small;                              /* small == -1 onde verdadeiro */
+    m = KNAME(sel)(small, m + m - 1.0, m - 1.0);
+
+    VD z = m * m;
+    VD p = ((((1.01875663804580931796e-4 * m
+                + 4.97494994976747001425e-1) * m
+                + 4.70579119878881725854e0) * m
+                + 1.44989225341610930846e1) * m
+                + 1.79368678507819816313e1) * m
+                + 7.70838733755885391666e0;
+    VD q = ((((m + 1.12873587189167450590e1) * m
+                + 4.52279145837532221105e1) * m
+                + 8.29875266912776603211e1) * m
+                + 7.11544750618563894466e1) * m
+                + 2.31251620126765340583e1;
+    VD fe = __builtin_convertvector(e, VD);
+    VD y = m * (z * p / q);
+    y = y - fe * 2.121944400546905827679e-4;
+    y = y - 0.5 * z;
+    z = m + y;
+    return z + fe * 0.693359375;
+}
+
+/* ---- Kernels ---- */
+
+KFN void KNAME(binary)(TokenType type, const double *left, const double *right,
+                       double *out, uint8_t *status, int n) {
+    int i = 0;
+
+    switch (type) {
+        case TOKEN_PLUS:
+            for (; i + KLANES <= n; i += KLANES) {
+                VD o = KNAME(load)(left + i) + KNAME(load)(right + i);
+                KNAME(store)(out + i, o);
+                KMERGE(KNAME(math_code)(o));
+            }
+            break;
+        case TOKEN_MINUS:
+            for (; i + KLANES <= n; i += KLANES) {
+                VD o = KNAME(load)(left + i) - KNAME(load)(right + i);
+                KNAME(store)(out + i, o);
+                KMERGE(KNAME(math_code)(o));
+            }
+            break;
+        case TOKEN_MULT:
+            for (; i + KLANES <= n; i += KLANES) {
+                VD o = KNAME(load)(left + i) * KNAME(load)(right + i);
+                KNAME(store)(out + i, o);
+                KMERGE(KNAME(math_code)(o));
+            }
+            break;
+        case TOKEN_DIV:
+            for (; i + KLANES <= n; i += KLANES) {
+                VD r = KNAME(load)(right + i);
+                VI zero = r == 0.0;
+                VD o = KNAME(load)(left + i) / KNAME(sel)(zero, KNAME(splat)(1.0), r);
+                o = KNAME(sel)(zero, KNAME(splat)(0.0), o);
+                KNAME(store)(out + i, o);
+                KMERGE(KNAME(seli)(zero, KNAME(isplat)(EVAL_DIVISION_BY_ZERO),
+                                           KNAME(math_code)(o)));
+            }
+            break;
+        case TOKEN_POW:
+            /* pow geral fica na libm; a classificação de erros é vetorial */
+            for (; i + KLANES <= n; i += KLANES) {
+                VD o;
+                for (int l = 0; l < KLANES; l++) o[l] = pow(left[i + l], right[i + l]);
+                KNAME(store)(out + i, o);
+                KMERGE(KNAME(seli)(o != o, KNAME(isplat)(EVAL_DOMAIN_ERROR),
+                                   KNAME(math_code)(o)));
+            }
+            break;
+        default:
+            kernels_scalar_binary(type, left, right, out, status, n);
+            return;
+    }
+
+    if (i < n) kernels_scalar_binary(type, left + i, right + i, out + i, KTAIL, n - i);
+}
+
+/* Aplica domínio inválido: zera o resultado e marca EVAL_DOMAIN_ERROR */
+#define KDOMAIN(bad, o) \
+    do { \
+        (o) = KNAME(sel)((bad), KNAME(splat)(0.0), (o)); \
+        KNAME(store)(out + i, (o)); \
+        KMERGE(KNAME(seli)((bad), KNAME(isplat)(EVAL_DOMAIN_ERROR), \
+                           KNAME(math_code)(o))); \
+    } while (0)
+
+/* Recalcula pela libm as lanes fora da faixa da aproximação vetorial */
+#define KFALLBACK(slow, o, fn) \
+    for (int l = 0; l < KLANES; l++) { if ((slow)[l]) (o)[l] = fn(a[l]); }
+
+KFN void KNAME(unary)(TokenType type, const double *arg,
+                      double *out, uint8_t *status, int n) {
+    int i = 0;
+
+    switch (type) {
+        case TOKEN_NEG:
+            for (; i + KLANES <= n; i += KLANES) {
+                KNAME(store)(out + i, (VD)((VI)KNAME(load)(arg + i) ^ (long long)0x8000000000000000ULL));
+            }
+            break;
+        case TOKEN_ABS:
+            for (; i + KLANES <= n; i += KLANES) {
+                VD o = KNAME(vabs)(KNAME(load)(arg + i));
+                KNAME(store)(out + i, o);
+                KMERGE(KNAME(math_code)(o));
+            }
+            break;
+        case TOKEN_SQRT:
+            for (; i + KLANES <= n; i += KLANES) {
+                VD a = KNAME(load)(arg + i);
+                VI bad = a < 0.0;
+                VD o = KSQRT(KNAME(sel)(bad, KNAME(splat)(0.0), a));
+                KDOMAIN(bad, o);
+            }
+            break;
+        case TOKEN_FLOOR:
+        case TOKEN_CEIL:
+        case TOKEN_FRAC:
+            for (; i + KLANES <= n; i += KLANES) {
+                VD a = KNAME(load)(arg + i);
+                VD o;
+                if (type == TOKEN_FLOOR) o = KNAME(vfloor)(a);
+                else if (type == TOKEN_CEIL) o = -KNAME(vfloor)(-a);
+                else o = a - KNAME(vfloor)(a);
+                KNAME(store)(out + i, o);
+                KMERGE(KNAME(math_code)(o));
+            }
+            break;
+        case TOKEN_SIN:
+        case TOKEN_COS:
+        case TOKEN_TAN:
+            for (; i + KLANES <= n; i += KLANES) {
+                VD a = KNAME(load)(arg + i);
+                VI slow = ~(KNAME(vabs)(a) <= KSINCOS_MAX);
+                VD s, c, o;
+                KNAME(sincos)(a, &s, &c);
+                if (type == TOKEN_SIN) {
+                    o = s;
+                    KFALLBACK(slow, o, sin);
+                } else if (type == TOKEN_COS) {
+                    o = c;
+                    KFALLBACK(slow, o, cos);
+                } else {
+                    o = s / c;
+                    KFALLBACK(slow, o, tan);
+                }
+                KNAME(store)(out + i, o);
+                KMERGE(KNAME(math_code)(o));
+            }
+            break;
+        case TOKEN_EXP:
+        case TOKEN_COSH:
+            for (; i + KLANES <= n; i += KLANES) {
+                VD a = KNAME(load)(arg + i);
+                VI slow = ~(KNAME(vabs)(a) <= 700.0);
+                VD o;
+                if (type == TOKEN_EXP) {
+                    o = KNAME(exp)(KNAME(sel)(slow, KNAME(splat)(0.0), a));
+                    KFALLBACK(slow, o, exp);
+                } else {
+                    VD e = KNAME(exp)(KNAME(sel)(slow, KNAME(splat)(0.0), KNAME(vabs)(a)));
+                    o = 0.5 * (e + 1.0 / e);
+                    KFALLBACK(slow, o, cosh);
+                }
+                KNAME(store)(out + i, o);
+                KMERGE(KNAME(math_code)(o));
+            }
+            break;
+        case TOKEN_LOG:
+            for (; i + KLANES <= n; i += KLANES) {
+                VD a = KNAME(load)(arg + i);
+                VI bad = a <= 0.0;
+                VI slow = ~bad & ~((a >= 2.2250738585072014e-308) & (a <= 1.7976931348623157e308));
+                VD o = KNAME(log)(KNAME(sel)(bad | slow, KNAME(splat)(1.0), a));
+                KFALLBACK(slow, o, log);
+                KDOMAIN(bad, o);
+            }
+            break;
+        case TOKEN_LOG10:
+        case TOKEN_ASIN:
+        case TOKEN_ACOS:
+        case TOKEN_ACOSH:
+        case TOKEN_ATANH:
+            /* Domínio vetorial; avaliação pela libm */
+            for (; i + KLANES <= n; i += KLANES) {
+                VD a = KNAME(load)(arg + i);
+                VI bad;
+                if (type == TOKEN_LOG10) bad = a <= 0.0;
+                else if (type == TOKEN_ACOSH) bad = a < 1.0;
+                else if (type == TOKEN_ATANH) bad = (a <= -1.0) | (a >= 1.0);
+                else bad = (a < -1.0) | (a > 1.0);
+                VD o;
+                for (int l = 0; l < KLANES; l++) {
+                    if (bad[l]) { o[l] = 0.0; continue; }
+                    switch (type) {
+                        case TOKEN_LOG10: o[l] = log10(a[l]); break;
+                        case TOKEN_ASIN:  o[l] = asin(a[l]); break;
+                        case TOKEN_ACOS:  o[l] = acos(a[l]); break;
+                        case TOKEN_ACOSH: o[l] = acosh(a[l]); break;
+                        default:          o[l] = atanh(a[l]); break;
+                    }
+                }
+                KDOMAIN(bad, o);
+            }
+            break;
+        default:
+            /* sinh, tanh, atan, asinh: libm escalar */
+            kernels_scalar_unary(type, arg, out, status, n);
+            return;
+    }
+
+    if (i < n) kernels_scalar_unary(type, arg + i, out + i, KTAIL, n - i);
+}
+
+KFN void KNAME(sincos_block)(const double *arg, double *sin_out, double *cos_out,
+                             uint8_t *status, int n) {
+    int i = 0;
+    for (; i + KLANES <= n; i += KLANES) {
+        VD a = KNAME(load)(arg + i);
+        VI slow = ~(KNAME(vabs)(a) <= KSINCOS_MAX);
+        VD s, c;
+        KNAME(sincos)(a, &s, &c);
+        KFALLBACK(slow, s, sin);
+        KFALLBACK(slow, c, cos);
+        KNAME(store)(sin_out + i, s);
+        KNAME(store)(cos_out + i, c);
+        KMERGE(KNAME(math_code)(s));
+    }
+
+    if (i < n) kernels_scalar_sincos(arg + i, sin_out + i, cos_out + i, KTAIL, n - i);
+}
+
+#undef KDOMAIN
+#undef KMERGE
+#undef KTAIL
+#undef KFALLBACK
+#undef KSINCOS_MAX
+#undef VD
+#undef VI
+#undef KFN
+#undef KINLINE
+#undef KCAT_
+#undef KCAT
+#undef KNAME
+#undef KSUF
+#undef KTARGET
+#undef KLANES
+#undef KSQRT
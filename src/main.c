@@ -1,17 +1,57 @@
 /* Multicurvas - Gerador de curvas via linha de comando */
+#define _POSIX_C_SOURCE 200809L  /* mkdir, clock_gettime, sigaction */
 #include "../include/multicurvas_plot.h"
 #include "../include/render.h"
+#include "../include/plotbin.h"
+#include "../include/codegen.h"
+#include "../include/presets.h"
+#include "../include/threadpool.h"
+#include "../include/batch.h"
+#include "../include/serve.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+#include <signal.h>
+#include <sys/stat.h>
 
 static void mostrar_uso(const char *prog) {
     fprintf(stderr, "Uso: %s <expressão> [formato] [largura] [altura]\n", prog);
+    fprintf(stderr, "     %s --preset <número> [formato] [largura] [altura]\n", prog);
+    fprintf(stderr, "     %s --from-bin <arquivo> [formato] [largura] [altura]\n", prog);
+    fprintf(stderr, "     %s --emit-c <expressão> [nome]\n", prog);
+    fprintf(stderr, "     %s --batch <especificações> [--outdir <diretório>]\n", prog);
+    fprintf(stderr, "     %s --serve <socket | ->\n", prog);
+    fprintf(stderr, "     %s --threads <n> ... (antes dos demais argumentos)\n", prog);
+    fprintf(stderr, "     %s --adaptive <tolerância> ... (antes dos demais argumentos)\n", prog);
+    fprintf(stderr, "     %s --simplify <pixels> ... (antes dos demais argumentos)\n", prog);
+    fprintf(stderr, "     %s --samples <n> ... (antes dos demais argumentos)\n", prog);
+    fprintf(stderr, "     %s --float32 ... (antes dos demais argumentos)\n", prog);
     fprintf(stderr, "\n");
     fprintf(stderr, "Argumentos:\n");
-    fprintf(stderr, "  formato  - csv ou svg (padrão: svg)\n");
+    fprintf(stderr, "  formato  - csv, svg ou bin (padrão: svg)\n");
     fprintf(stderr, "  largura  - largura do canvas SVG (padrão: 800)\n");
     fprintf(stderr, "  altura   - altura do canvas SVG (padrão: 600)\n");
+    fprintf(stderr, "  --preset - curva N do ZX81 (1..77, 53a..53g) compilada em C\n");
+    fprintf(stderr, "  --from-bin - renderiza amostras salvas com o formato bin, sem reavaliar\n");
+    fprintf(stderr, "  --emit-c - escreve em C a avaliação da curva (função `nome`)\n");
+    fprintf(stderr, "  --batch  - uma curva por linha: <expressão> [formato] [largura altura] <arquivo>\n");
+    fprintf(stderr, "             gravadas em paralelo em --outdir (padrão: .); falhas em stderr\n");
+    fprintf(stderr, "  --serve  - servidor num socket Unix (- : stdin/stdout); um pedido por linha:\n");
+    fprintf(stderr, "             <expressão> [formato] [largura altura] [samples=N] [interval=C,D]\n");
+    fprintf(stderr, "             resposta \"OK <bytes>\" + payload ou \"ERR <mensagem>\"; ver serve.h\n");
+    fprintf(stderr, "  --threads - threads da amostragem (padrão: uma por CPU; 1 = sem threads)\n");
+    fprintf(stderr, "  --adaptive - amostragem adaptativa: desvio máximo da corda em pixels\n");
+    fprintf(stderr, "               (ex.: 0.5); o número de amostras vai para stderr\n");
+    fprintf(stderr, "  --simplify - SVG: remove pontos a menos de <pixels> da poligonal\n");
+    fprintf(stderr, "               (Ramer-Douglas-Peucker; ex.: 0.25)\n");
+    fprintf(stderr, "  --samples - número de amostras uniformes (padrão: %d); no SVG de Y=f(x)\n",
+            PLOT_DEFAULT_SAMPLES);
+    fprintf(stderr, "               ficam no máximo 4 pontos por coluna de pixel (M4)\n");
+    fprintf(stderr, "  --float32 - SVG: coordenadas em float (metade da memória por amostra)\n");
     fprintf(stderr, "\n");
     fprintf(stderr, "Exemplos:\n");
     fprintf(stderr, "  %s \"Y=sin(x)\" svg > sin.svg\n", prog);
@@ -32,13 +72,319 @@ static void mostrar_uso(const char *prog) {
     fprintf(stderr, "      A grade se ajusta aos dados, com linhas a cada 1.0 unidade.\n");
 }
 
+/* --emit-c <expressão> [nome]: unidade de tradução C com a avaliação da curva */
+static int emitir_c(const char *expressao, const char *nome) {
+    char *errmsg = NULL;
+    Plot *plot = plot_parse_text(expressao, &errmsg);
+    if (!plot) {
+        fprintf(stderr, "Erro ao interpretar expressão: %s\n", errmsg ? errmsg : "desconhecido");
+        free(errmsg);
+        return 1;
+    }
+    int ok = codegen_emit_plot(stdout, plot, nome, &errmsg);
+    if (!ok) fprintf(stderr, "Erro ao gerar código: %s\n", errmsg ? errmsg : "desconhecido");
+    free(errmsg);
+    plot_free(plot);
+    return ok ? 0 : 1;
+}
+
+/* --from-bin <arquivo>: amostras de um arquivo gravado no formato bin e um
+ * Plot com o tipo e o intervalo do cabeçalho (errmsg fica NULL se faltar
+ * memória) */
+static PlotData *carregar_bin(const char *arquivo, Plot **plot, char **errmsg) {
+    PlotBinFile *f = plotbin_open(arquivo, errmsg);
+    if (!f) return NULL;
+    if (f->samples > PLOTBIN_MAX_PLOTDATA) {
+        // Gravável em streaming, mas grande demais para um PlotData
+        char msg[160];
+        snprintf(msg, sizeof(msg), "%llu amostras; --from-bin aceita até %d",
+                 (unsigned long long)f->samples, PLOTBIN_MAX_PLOTDATA);
+        *errmsg = strdup(msg);
+        plotbin_close(f);
+        return NULL;
+    }
+    PlotData *data = plotbin_to_plotdata(f);
+    *plot = calloc(1, sizeof(Plot));
+    if (!data || !*plot) {
+        plot_data_free(data);
+        free(*plot);
+        *plot = NULL;
+        plotbin_close(f);
+        return NULL;
+    }
+    (*plot)->type = f->type;
+    (*plot)->C = f->C;
+    (*plot)->D = f->D;
+    (*plot)->has_interval = 1;
+    (*plot)->samples = data->samples;
+    plotbin_close(f);
+    return data;
+}
+
+/* --emit-presets <lista>: catálogo src/presets_gen.c (ver gerar_presets.sh) */
+static int emitir_presets(const char *arquivo) {
+    FILE *lista = strcmp(arquivo, "-") == 0 ? stdin : fopen(arquivo, "r");
+    if (!lista) {
+        fprintf(stderr, "Erro: não foi possível abrir '%s'\n", arquivo);
+        return 1;
+    }
+    char *errmsg = NULL;
+    int count = codegen_emit_catalog(stdout, lista, &errmsg);
+    if (count < 0) fprintf(stderr, "Erro ao gerar catálogo: %s\n", errmsg ? errmsg : "desconhecido");
+    free(errmsg);
+    if (lista != stdin) fclose(lista);
+    return count < 0 ? 1 : 0;
+}
+
+/* --batch <especificações> --outdir <diretório>: todas as curvas num só
+ * processo, --threads por vez; as falhas vão para stderr sem interromper */
+static int executar_lote(const char *arquivo, const char *outdir, uint64_t amostras,
+                         double tolerancia, int float32) {
+    FILE *specs = strcmp(arquivo, "-") == 0 ? stdin : fopen(arquivo, "r");
+    if (!specs) {
+        fprintf(stderr, "Erro: não foi possível abrir '%s'\n", arquivo);
+        return 1;
+    }
+    Batch *batch = batch_read(specs);
+    if (specs != stdin) fclose(specs);
+    if (!batch) {
+        fprintf(stderr, "Erro: memória insuficiente\n");
+        return 1;
+    }
+    if (mkdir(outdir, 0777) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Erro: não foi possível criar o diretório '%s'\n", outdir);
+        batch_free(batch);
+        return 1;
+    }
+
+    BatchOptions opts = { threadpool_default_threads(), 0, tolerancia, float32 };
+    if (amostras <= INT_MAX) opts.samples = (int)amostras;
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int falhas = batch_run(batch, outdir, &opts);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    for (int i = 0; i < batch->count; i++) {
+        const BatchJob *job = &batch->jobs[i];
+        if (!job->ok) {
+            fprintf(stderr, "%s:%d: %s\n", arquivo, job->line,
+                    job->errmsg ? job->errmsg : "memória insuficiente");
+        }
+    }
+    double ms = (t1.tv_sec - t0.tv_sec) * 1e3 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+    fprintf(stderr, "%d curvas em %s/ (%d com falha) em %.1f ms, %d em paralelo\n",
+            batch->count - falhas, outdir, falhas, ms, opts.workers);
+    ExprCache *cache = plot_program_cache();
+    if (cache) {
+        ExprCacheStats st = exprcache_stats(cache);
+        fprintf(stderr, "cache de programas: %llu acertos, %llu faltas\n",
+                (unsigned long long)st.hits, (unsigned long long)st.misses);
+    }
+    batch_free(batch);
+    return falhas ? 1 : 0;
+}
+
+/* --serve <socket | ->: atende pedidos até `shutdown` (ou SIGINT/SIGTERM) */
+static Server *servidor = NULL;
+
+static void parar_servidor(int sinal) {
+    (void)sinal;
+    if (servidor) server_stop(servidor);
+}
+
+static int servir(const char *caminho) {
+    servidor = server_create(threadpool_default_threads());
+    if (!servidor) {
+        fprintf(stderr, "Erro: memória insuficiente\n");
+        return 1;
+    }
+    // Cliente que desconecta no meio da resposta não derruba o servidor
+    signal(SIGPIPE, SIG_IGN);
+    
+    int ok = 1;
+    if (strcmp(caminho, "-") == 0) {
+        server_serve_fd(servidor, 0, 1);
+    } else {
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = parar_servidor;
+        sigemptyset(&sa.sa_mask);
+        sigaction(SIGINT, &sa, NULL);
+        sigaction(SIGTERM, &sa, NULL);
+        
+        fprintf(stderr, "servidor em %s (%d workers)\n", caminho, threadpool_default_threads());
+        char *errmsg = NULL;
+        ok = server_listen(servidor, caminho, &errmsg);
+        if (!ok) fprintf(stderr, "Erro: %s\n", errmsg ? errmsg : "memória insuficiente");
+        free(errmsg);
+    }
+    
+    ServerStats st = server_stats(servidor);
+    fprintf(stderr, "%llu pedidos (%llu com erro), p50 %.3f ms, p99 %.3f ms\n",
+            (unsigned long long)st.requests, (unsigned long long)st.errors,
+            st.p50_ms, st.p99_ms);
+    Server *s = servidor;
+    servidor = NULL;
+    server_destroy(s);
+    return ok ? 0 : 1;
+}
+
+/* Renderiza no formato pedido e libera `data`. Retorna 0 se a escrita falhar. */
+static int renderizar(const Plot *plot, PlotData *data, const char *titulo,
+                      const char *formato, int canvas_w, int canvas_h) {
+    int ok = render_plot(stdout, plot, data, titulo, formato, canvas_w, canvas_h);
+    if (!ok) fprintf(stderr, "Erro ao escrever a saída\n");
+    plot_data_free(data);
+    return ok;
+}
+
+/* CSV ou bin de amostragem uniforme (`amostras` 0: plot->samples) em
+ * streaming, com memória constante. Retorna 1 em caso de sucesso, 0 em caso
+ * de erro e -1 se stdout não servir para o bin em streaming (pipe). */
+static int renderizar_stream(const Plot *plot, uint64_t amostras, int is_bin) {
+    char *errmsg = NULL;
+    PlotSampler *sampler = plot_sampler_open(plot, amostras, &errmsg);
+    if (!sampler) {
+        fprintf(stderr, "Erro ao gerar dados: %s\n", errmsg ? errmsg : "desconhecido");
+        free(errmsg);
+        return 0;
+    }
+    int r;
+    if (is_bin) {
+        r = render_bin_stream(sampler, plot);
+        if (r == 0) fprintf(stderr, "Erro ao escrever a saída binária\n");
+    } else {
+        r = render_csv_stream(sampler);
+        if (r == 0) fprintf(stderr, "Erro ao escrever a saída\n");
+    }
+    plot_sampler_close(sampler);
+    return r;
+}
+
 int main(int argc, char **argv) {
     if (argc < 2) {
         mostrar_uso(argv[0]);
         return 1;
     }
     
-    const char *expressao = argv[1];
+    // --threads N: threads do pool de amostragem
+    // --adaptive TOL: amostragem adaptativa com desvio máximo TOL (pixels)
+    // --simplify TOL: simplificação da poligonal do SVG (pixels)
+    // --samples N: número de amostras uniformes
+    // --float32: SVG com coordenadas em float
+    double tolerancia = 0.0;
+    uint64_t amostras = 0;
+    int float32 = 0;
+    while (argc > 2 && (strcmp(argv[1], "--threads") == 0 ||
+                        strcmp(argv[1], "--adaptive") == 0 ||
+                        strcmp(argv[1], "--simplify") == 0 ||
+                        strcmp(argv[1], "--samples") == 0 ||
+                        strcmp(argv[1], "--float32") == 0)) {
+        if (strcmp(argv[1], "--float32") == 0) {
+            float32 = 1;
+            argv[1] = argv[0];
+            argv++;
+            argc--;
+            continue;
+        }
+        if (strcmp(argv[1], "--samples") == 0) {
+            char *fim;
+            amostras = strtoull(argv[2], &fim, 10);
+            if (amostras < 2 || *fim != '\0' || argv[2][0] == '-') {
+                fprintf(stderr, "Erro: número de amostras '%s' inválido\n", argv[2]);
+                return 1;
+            }
+        } else if (strcmp(argv[1], "--simplify") == 0) {
+            render_simplify_tolerance = atof(argv[2]);
+            if (!(render_simplify_tolerance > 0)) {
+                fprintf(stderr, "Erro: tolerância '%s' inválida\n", argv[2]);
+                return 1;
+            }
+        } else if (strcmp(argv[1], "--adaptive") == 0) {
+            tolerancia = atof(argv[2]);
+            if (!(tolerancia > 0)) {
+                fprintf(stderr, "Erro: tolerância '%s' inválida\n", argv[2]);
+                return 1;
+            }
+        } else {
+            int threads = atoi(argv[2]);
+            if (threads <= 0) {
+                fprintf(stderr, "Erro: número de threads '%s' inválido\n", argv[2]);
+                return 1;
+            }
+            threadpool_set_default_threads(threads);
+        }
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+    if (argc < 2) {
+        mostrar_uso(argv[0]);
+        return 1;
+    }
+    
+    if (strcmp(argv[1], "--emit-c") == 0) {
+        if (argc < 3) {
+            mostrar_uso(argv[0]);
+            return 1;
+        }
+        return emitir_c(argv[2], argc > 3 ? argv[3] : "multicurvas_plot");
+    }
+    if (strcmp(argv[1], "--serve") == 0) {
+        if (argc != 3) {
+            mostrar_uso(argv[0]);
+            return 1;
+        }
+        return servir(argv[2]);
+    }
+    if (strcmp(argv[1], "--batch") == 0) {
+        if (argc != 3 && !(argc == 5 && strcmp(argv[3], "--outdir") == 0)) {
+            mostrar_uso(argv[0]);
+            return 1;
+        }
+        if (amostras > INT_MAX) {
+            fprintf(stderr, "Erro: mais de %d amostras por curva no modo lote\n", INT_MAX);
+            return 1;
+        }
+        return executar_lote(argv[2], argc == 5 ? argv[4] : ".", amostras, tolerancia, float32);
+    }
+    if (strcmp(argv[1], "--emit-presets") == 0) {
+        if (argc < 3) {
+            mostrar_uso(argv[0]);
+            return 1;
+        }
+        return emitir_presets(argv[2]);
+    }
+    
+    // --preset N: curva do catálogo nativo no lugar da expressão
+    const PlotPreset *preset = NULL;
+    if (strcmp(argv[1], "--preset") == 0) {
+        if (argc < 3) {
+            mostrar_uso(argv[0]);
+            return 1;
+        }
+        preset = plot_preset_find(argv[2]);
+        if (!preset) {
+            fprintf(stderr, "Erro: preset '%s' inexistente\n", argv[2]);
+            return 1;
+        }
+        argv++;
+        argc--;
+    }
+    
+    // --from-bin ARQUIVO: amostras já avaliadas no lugar da expressão
+    const char *arquivo_bin = NULL;
+    if (!preset && strcmp(argv[1], "--from-bin") == 0) {
+        if (argc < 3) {
+            mostrar_uso(argv[0]);
+            return 1;
+        }
+        arquivo_bin = argv[2];
+        argv++;
+        argc--;
+    }
+    
+    const char *expressao = preset ? preset->spec : argv[1];
     const char *formato = (argc > 2) ? argv[2] : "svg";
     int canvas_w = 800;
     int canvas_h = 600;
@@ -56,20 +402,54 @@ int main(int argc, char **argv) {
     // Valida formato
     int is_csv = (strcmp(formato, "csv") == 0);
     int is_svg = (strcmp(formato, "svg") == 0);
-    if (!is_csv && !is_svg) {
-        fprintf(stderr, "Erro: formato '%s' inválido. Use 'csv' ou 'svg'\n", formato);
+    int is_bin = (strcmp(formato, "bin") == 0);
+    if (!is_csv && !is_svg && !is_bin) {
+        fprintf(stderr, "Erro: formato '%s' inválido. Use 'csv', 'svg' ou 'bin'\n", formato);
         return 1;
     }
     
-    // Parse da expressão
     char *errmsg = NULL;
-    Plot *plot = plot_parse_text(expressao, &errmsg);
+    if (arquivo_bin) {
+        Plot *plot = NULL;
+        PlotData *data = carregar_bin(arquivo_bin, &plot, &errmsg);
+        if (!data) {
+            fprintf(stderr, "Erro ao ler '%s': %s\n", arquivo_bin,
+                    errmsg ? errmsg : "memória insuficiente");
+            free(errmsg);
+            return 1;
+        }
+        int ok = renderizar(plot, data, expressao, formato, canvas_w, canvas_h);
+        plot_free(plot);
+        return ok ? 0 : 1;
+    }
+    
+    // Parse da expressão
+    Plot *plot = preset ? plot_from_preset(preset) : plot_parse_text(expressao, &errmsg);
     if (!plot) {
         fprintf(stderr, "Erro ao interpretar expressão: %s\n", errmsg ? errmsg : "desconhecido");
         free(errmsg);
         return 1;
     }
     
+    if (amostras > 0 && amostras <= INT_MAX) plot->samples = (int)amostras;
+    if (tolerancia > 0) plot_set_adaptive(plot, tolerancia, canvas_w, canvas_h);
+    if (float32 && is_svg) plot->precision = PLOT_FLOAT32;
+    
+    // CSV e bin uniformes: blocos consumidos à medida que são avaliados
+    if ((is_csv || is_bin) && !plot->adaptive.enabled) {
+        int r = renderizar_stream(plot, amostras, is_bin);
+        if (r >= 0) {
+            plot_free(plot);
+            return r ? 0 : 1;
+        }
+    }
+    if (amostras > INT_MAX) {
+        fprintf(stderr, "Erro: mais de %d amostras só com csv ou bin (arquivo) uniformes\n",
+                INT_MAX);
+        plot_free(plot);
+        return 1;
+    }
+    
     // Gera dados
     PlotData *data = plot_generate_samples(plot, &errmsg);
     if (!data) {
@@ -78,17 +458,12 @@ int main(int argc, char **argv) {
         plot_free(plot);
         return 1;
     }
-    
-    // Renderiza
-    if (is_csv) {
-        render_csv(data);
-    } else {
-        render_svg(data, expressao, canvas_w, canvas_h);
+    if (plot->adaptive.enabled) {
+        fprintf(stderr, "amostras avaliadas: %d (%d pontos válidos)\n", data->samples, data->count);
     }
     
-    // Cleanup
-    plot_data_free(data);
+    int ok = renderizar(plot, data, expressao, formato, canvas_w, canvas_h);
     plot_free(plot);
     
-    return 0;
+    return ok ? 0 : 1;
 }
@@ -10,16 +10,30 @@
 #include "../include/multicurvas_plot.h"
 #include "../include/parser.h"
 #include "../include/evaluator.h"
+#include "../include/optimizer.h"
+#include "../include/interval.h"
+#include "../include/threadpool.h"
+#include "../include/exprcache.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
 #include <ctype.h>
+#include <pthread.h>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+/* Amostras avaliadas por chamada ao avaliador em lote */
+#define PLOT_EVAL_CHUNK 256
+
+/* Amostras por tarefa do pool de threads (abaixo disso tudo roda na chamadora) */
+#define PLOT_TASK_SAMPLES 16384
+
+/* Menor faixa dividida pela análise por intervalos (ver avaliar_por_intervalos) */
+#define PLOT_INTERVAL_MIN 16
+
 /* Avalia uma expressão simples do intervalo (número, pi, -pi, frações, n*pi, etc.) */
 static int eval_simple_expr(const char *expr, double *result) {
     char *endptr;
@@ -127,35 +141,44 @@ static int parse_interval(char *buf, double *C, double *D) {
     return 0;
 }
 
+/* Cópia de uma string na arena ou, sem arena, com strdup */
+static char *copiar(Arena *arena, const char *s) {
+    return arena ? arena_strdup(arena, s) : strdup(s);
+}
+
 /* Detecta o tipo de curva olhando o prefixo (case-insensitive) */
-static PlotType detectar_tipo(char *expr, char **expr_limpa) {
+static PlotType detectar_tipo(char *expr, char **expr_limpa, Arena *arena) {
     // Pula espaços iniciais
     while (*expr && isspace(*expr)) expr++;
     
     // Verifica prefixos (case-insensitive)
     if (strncasecmp(expr, "Y=", 2) == 0) {
-        *expr_limpa = strdup(expr + 2);
+        *expr_limpa = copiar(arena, expr + 2);
         return PLOT_CARTESIAN;
     }
     if (strncasecmp(expr, "R**2=", 5) == 0) {
-        *expr_limpa = strdup(expr + 5);
+        *expr_limpa = copiar(arena, expr + 5);
         return PLOT_POLAR_R2;
     }
     if (strncasecmp(expr, "R=", 2) == 0) {
-        *expr_limpa = strdup(expr + 2);
+        *expr_limpa = copiar(arena, expr + 2);
         return PLOT_POLAR_R;
     }
     if (strncasecmp(expr, "X=", 2) == 0) {
-        *expr_limpa = strdup(expr + 2);
+        *expr_limpa = copiar(arena, expr + 2);
         return PLOT_PARAMETRIC;
     }
     
     // Sem prefixo: assume cartesiano
-    *expr_limpa = strdup(expr);
+    *expr_limpa = copiar(arena, expr);
     return PLOT_CARTESIAN;
 }
 
 Plot *plot_parse_text(const char *input, char **errmsg) {
+    return plot_parse_text_arena(input, NULL, errmsg);
+}
+
+Plot *plot_parse_text_arena(const char *input, Arena *arena, char **errmsg) {
     if (errmsg) *errmsg = NULL;
     if (!input || !*input) {
         if (errmsg) *errmsg = strdup("entrada vazia");
@@ -163,7 +186,7 @@ Plot *plot_parse_text(const char *input, char **errmsg) {
     }
     
     // Copia entrada
-    char *buf = strdup(input);
+    char *buf = copiar(arena, input);
     if (!buf) {
         if (errmsg) *errmsg = strdup("memória insuficiente");
         return NULL;
@@ -182,12 +205,13 @@ Plot *plot_parse_text(const char *input, char **errmsg) {
     }
     
     // Aloca estrutura
-    Plot *plot = calloc(1, sizeof(Plot));
+    Plot *plot = arena ? arena_calloc(arena, 1, sizeof(Plot)) : calloc(1, sizeof(Plot));
     if (!plot) {
         if (errmsg) *errmsg = strdup("memória insuficiente");
-        free(buf);
+        if (!arena) free(buf);
         return NULL;
     }
+    plot->arena = arena;
     
     plot->samples = PLOT_DEFAULT_SAMPLES;
     plot->C = C;
@@ -197,11 +221,11 @@ Plot *plot_parse_text(const char *input, char **errmsg) {
     // Detecta tipo e processa
     if (!e2) {
         // Uma expressão
-        plot->type = detectar_tipo(e1, &plot->expr1);
+        plot->type = detectar_tipo(e1, &plot->expr1, arena);
     } else {
         // Duas expressões: modo paramétrico
-        PlotType t1 = detectar_tipo(e1, &plot->expr1);
-        PlotType t2 = detectar_tipo(e2, &plot->expr2);
+        PlotType t1 = detectar_tipo(e1, &plot->expr1, arena);
+        PlotType t2 = detectar_tipo(e2, &plot->expr2, arena);
         
         // Se temos X= e Y=, ordena corretamente
         if (t1 == PLOT_PARAMETRIC) {
@@ -218,9 +242,9 @@ Plot *plot_parse_text(const char *input, char **errmsg) {
         }
     }
     
-    free(buf);
+    if (!arena) free(buf);
     
-    if (!plot->expr1) {
+    if (!plot->expr1 || (e2 && !plot->expr2)) {
         if (errmsg) *errmsg = strdup("não foi possível interpretar a entrada");
         plot_free(plot);
         return NULL;
@@ -230,20 +254,128 @@ Plot *plot_parse_text(const char *input, char **errmsg) {
 }
 
 void plot_free(Plot *p) {
-    if (!p) return;
+    if (!p || p->arena) return;
     free(p->expr1);
     free(p->expr2);
     free(p);
 }
 
+/* Bytes de uma coluna arredondados para PLOT_DATA_ALIGN */
+static size_t coluna_alinhada(size_t bytes) {
+    return (bytes + PLOT_DATA_ALIGN - 1) & ~(size_t)(PLOT_DATA_ALIGN - 1);
+}
+
+size_t plot_data_size(int capacity, PlotPrecision precision) {
+    size_t n = capacity > 0 ? (size_t)capacity : 1;
+    size_t coord = precision == PLOT_FLOAT32 ? sizeof(float) : sizeof(double);
+    size_t palavras = (n + 63) / 64;
+    return 2 * coluna_alinhada(n * coord) + coluna_alinhada(palavras * sizeof(uint64_t));
+}
+
+PlotData *plot_data_create(int capacity, PlotPrecision precision, Arena *arena) {
+    if (capacity < 1) capacity = 1;
+    size_t bytes = plot_data_size(capacity, precision);
+    PlotData *data;
+    unsigned char *bloco;
+    if (arena) {
+        // A arena alinha a ARENA_ALIGNMENT: sobra o bastante para alinhar a 64
+        data = arena_calloc(arena, 1, sizeof(PlotData));
+        bloco = data ? arena_alloc(arena, bytes + PLOT_DATA_ALIGN - ARENA_ALIGNMENT) : NULL;
+        if (!bloco) return NULL;
+        bloco = (unsigned char *)(((uintptr_t)bloco + PLOT_DATA_ALIGN - 1) &
+                                  ~(uintptr_t)(PLOT_DATA_ALIGN - 1));
+        data->arena = arena;
+    } else {
+        void *mem;
+        data = calloc(1, sizeof(PlotData));
+        if (!data || posix_memalign(&mem, PLOT_DATA_ALIGN, bytes) != 0) {
+            free(data);
+            return NULL;
+        }
+        bloco = mem;
+    }
+    
+    // [x | y | valid], cada coluna começando numa linha de cache
+    size_t coord = precision == PLOT_FLOAT32 ? sizeof(float) : sizeof(double);
+    size_t coluna = coluna_alinhada((size_t)capacity * coord);
+    if (precision == PLOT_FLOAT32) {
+        data->xf = (float *)bloco;
+        data->yf = (float *)(bloco + coluna);
+    } else {
+        data->x = (double *)bloco;
+        data->y = (double *)(bloco + coluna);
+    }
+    data->valid = (uint64_t *)(bloco + 2 * coluna);
+    memset(data->valid, 0, ((size_t)capacity + 63) / 64 * sizeof(uint64_t));
+    data->capacity = capacity;
+    data->precision = precision;
+    return data;
+}
+
+int plot_data_append(PlotData *data, int ok, double x, double y) {
+    if (data->samples >= data->capacity) return 0;
+    int s = data->samples++;
+    if (!ok) return 1;      /* bit já zerado por plot_data_create */
+    data->valid[s >> 6] |= (uint64_t)1 << (s & 63);
+    if (data->xf) {
+        data->xf[data->count] = (float)x;
+        data->yf[data->count] = (float)y;
+    } else {
+        data->x[data->count] = x;
+        data->y[data->count] = y;
+    }
+    data->count++;
+    return 1;
+}
+
+/* Primeira amostra s' >= s, s' < n, com o bit igual a `bit` (ou n) */
+static int proximo_bit(const uint64_t *valid, int s, int n, int bit) {
+    while (s < n) {
+        uint64_t w = bit ? valid[s >> 6] : ~valid[s >> 6];
+        w >>= (s & 63);
+        if (w) {
+            s += __builtin_ctzll(w);
+            return s < n ? s : n;
+        }
+        s = (s | 63) + 1;
+    }
+    return n;
+}
+
+int plot_data_next_segment(const PlotData *data, PlotSegment *seg) {
+    int first = seg->first + seg->len;
+    if (!data || first >= data->count) return 0;
+    if (!data->valid) {
+        // Sem bitset: um só trecho com todos os pontos
+        seg->sample = seg->first = first;
+        seg->len = data->count - first;
+        return 1;
+    }
+    int inicio = proximo_bit(data->valid, seg->sample + seg->len, data->samples, 1);
+    int fim = proximo_bit(data->valid, inicio, data->samples, 0);
+    if (inicio == fim) return 0;
+    seg->sample = inicio;
+    seg->first = first;
+    seg->len = fim - inicio;
+    return 1;
+}
+
 void plot_data_free(PlotData *data) {
-    if (!data) return;
-    free(data->x);
-    free(data->y);
-    free(data->status);
+    if (!data || data->arena) return;
+    free(data->x ? (void *)data->x : (void *)data->xf);     /* início do bloco */
     free(data);
 }
 
+void plot_set_adaptive(Plot *plot, double tolerance, int width, int height) {
+    if (!plot) return;
+    plot->adaptive.enabled = 1;
+    plot->adaptive.tolerance = (tolerance > 0) ? tolerance : PLOT_ADAPTIVE_TOLERANCE;
+    plot->adaptive.min_depth = PLOT_ADAPTIVE_MIN_DEPTH;
+    plot->adaptive.max_depth = PLOT_ADAPTIVE_MAX_DEPTH;
+    plot->adaptive.width = width;
+    plot->adaptive.height = height;
+}
+
 /* Define intervalos padrão conforme programa original ZX81 */
 static void definir_intervalo_padrao(PlotType type, double *C, double *D) {
     switch (type) {
@@ -262,154 +394,787 @@ static void definir_intervalo_padrao(PlotType type, double *C, double *D) {
     }
 }
 
-PlotData *plot_generate_samples(const Plot *plot, char **errmsg) {
-    if (errmsg) *errmsg = NULL;
-    if (!plot || !plot->expr1) {
-        if (errmsg) *errmsg = strdup("plot inválido");
-        return NULL;
+void plot_get_interval(const Plot *plot, double *C, double *D) {
+    *C = plot->C;
+    *D = plot->D;
+    if (!plot->has_interval) {
+        definir_intervalo_padrao(plot->type, C, D);
+    }
+}
+
+/* Prepara uma expressão (compilação em uma passada + otimização). Sem o
+ * otimizador o RPN é do heap; com ele, o RPN intermediário usa `arena` (se
+ * não for NULL) e o otimizado é do heap.
+ * Retorna NULL em caso de sucesso ou o formato da mensagem de erro da etapa
+ * que falhou (com %s para "primeira"/"segunda"). */
+static const char *preparar_expressao(const char *expr, TokenBuffer *rpn, Arena *arena) {
+    if (parser_compile_arena(expr, rpn, optimizer_enabled ? arena : NULL) != PARSER_OK) {
+        return "erro ao compilar %s expressão";
     }
     
-    // Define intervalo [C,D]
-    double C = plot->C, D = plot->D;
-    if (!plot->has_interval) {
-        definir_intervalo_padrao(plot->type, &C, &D);
+    if (optimizer_enabled) {
+        TokenBuffer otimizado;
+        if (!optimizer_run(rpn, &otimizado, NULL)) {
+            parser_free_buffer(rpn);
+            return "memória insuficiente ao otimizar %s expressão";
+        }
+        parser_free_buffer(rpn);
+        *rpn = otimizado;
     }
     
-    // Para polar, converte para radianos
-    int is_polar = (plot->type == PLOT_POLAR_R || plot->type == PLOT_POLAR_R2);
-    if (is_polar) {
-        C = C * M_PI;
-        D = D * M_PI;
+    return NULL;
+}
+
+/* Polar: copia o programa do raio anexando a conversão para cartesiano,
+ * `r*cos(t)` ou `r*sin(t)` (R**2: r = sqrt(f), que falha se f < 0). Os dois
+ * programas compilados juntos compartilham o raio, e cos/sin do ângulo viram
+ * um único sincos no motor de registradores. Retorna 0 sem memória. */
+static int montar_polar(const TokenBuffer *raio, int quadrado, TokenType trig,
+                        TokenBuffer *out) {
+    if (!parser_copy_buffer(raio, out)) return 0;
+    for (int i = 0; i < out->size; i++) {
+        if (out->tokens[i].type == TOKEN_END) {
+            out->size = i;
+            break;
+        }
     }
     
-    // Aloca estrutura de dados
-    PlotData *data = calloc(1, sizeof(PlotData));
-    if (!data) {
-        if (errmsg) *errmsg = strdup("memória insuficiente");
-        return NULL;
+    Token sufixo[5] = {
+        {TOKEN_SQRT, 0}, {TOKEN_VARIABLE_T, 0}, {(uint8_t)trig, 0},
+        {TOKEN_MULT, 0}, {TOKEN_END, 0}
+    };
+    for (int i = quadrado ? 0 : 1; i < 5; i++) {
+        if (!parser_add_token(out, sufixo[i])) {
+            parser_free_buffer(out);
+            return 0;
+        }
     }
+    return 1;
+}
+
+/* Monta a mensagem de erro de compilação para a expressão indicada */
+static char *erro_compilacao(const char *qual, const char *formato) {
+    char msg[96];
+    snprintf(msg, sizeof(msg), formato, qual);
+    return strdup(msg);
+}
+
+/* plot_build_programs, com o RPN intermediário em `arena` */
+static int construir_programas(const Plot *plot, TokenBuffer rpn[2], Arena *arena,
+                               char **errmsg) {
+    if (errmsg) *errmsg = NULL;
     
-    int n = plot->samples;
-    data->x = malloc(n * sizeof(double));
-    data->y = malloc(n * sizeof(double));
-    data->status = calloc(n, sizeof(int));
-    data->capacity = n;
+    // X e Y paramétricos viram um único programa com duas saídas, de modo que
+    // subexpressões comuns (cos(t), t/2, ...) são avaliadas uma vez por amostra.
+    // Polares também: X = r*cos(t), Y = r*sin(t).
+    int tem_expr2 = (plot->type == PLOT_PARAMETRIC && plot->expr2);
+    const char *falha = preparar_expressao(plot->expr1, &rpn[0], arena);
+    if (falha) {
+        if (errmsg) *errmsg = erro_compilacao("primeira", falha);
+        return 0;
+    }
     
-    if (!data->x || !data->y || !data->status) {
-        if (errmsg) *errmsg = strdup("memória insuficiente");
-        plot_data_free(data);
-        return NULL;
+    if (tem_expr2) {
+        falha = preparar_expressao(plot->expr2, &rpn[1], arena);
+        if (falha) {
+            if (errmsg) *errmsg = erro_compilacao("segunda", falha);
+            parser_free_buffer(&rpn[0]);
+            return 0;
+        }
     }
     
-    // Compila expressão(ões)
-    TokenBuffer tokens1, rpn1;
-    parser_init_buffer(&tokens1);
-    parser_init_buffer(&rpn1);
+    if (plot->type == PLOT_POLAR_R || plot->type == PLOT_POLAR_R2) {
+        TokenBuffer raio = rpn[0];
+        int quadrado = (plot->type == PLOT_POLAR_R2);
+        int ok = montar_polar(&raio, quadrado, TOKEN_COS, &rpn[0]);
+        if (ok && !montar_polar(&raio, quadrado, TOKEN_SIN, &rpn[1])) {
+            parser_free_buffer(&rpn[0]);
+            ok = 0;
+        }
+        parser_free_buffer(&raio);
+        if (!ok) {
+            if (errmsg) *errmsg = strdup("memória insuficiente ao traduzir expressão");
+            return 0;
+        }
+        return 2;
+    }
     
-    ParserError perr = parser_tokenize(plot->expr1, &tokens1);
-    if (perr != PARSER_OK) {
-        if (errmsg) *errmsg = strdup("erro ao compilar primeira expressão");
-        parser_free_buffer(&tokens1);
-        parser_free_buffer(&rpn1);
-        plot_data_free(data);
+    return tem_expr2 ? 2 : 1;
+}
+
+int plot_build_programs(const Plot *plot, TokenBuffer rpn[2], char **errmsg) {
+    return construir_programas(plot, rpn, NULL, errmsg);
+}
+
+/* Programas compilados de um plot: valor imutável do cache de programas */
+typedef struct {
+    TokenBuffer rpn[2];
+    int nrpn;
+    EvalProgram *prog;
+} ProgramasPlot;
+
+static void liberar_programas(void *valor) {
+    ProgramasPlot *p = valor;
+    evaluator_program_free(p->prog);
+    for (int k = 0; k < p->nrpn; k++) parser_free_buffer(&p->rpn[k]);
+    free(p);
+}
+
+static ProgramasPlot *compilar_programas(const Plot *plot, Arena *arena, char **errmsg) {
+    ProgramasPlot *p = calloc(1, sizeof(ProgramasPlot));
+    if (!p) {
+        if (errmsg) *errmsg = strdup("memória insuficiente");
         return NULL;
     }
-    
-    perr = parser_to_rpn(&tokens1, &rpn1);
-    if (perr != PARSER_OK) {
-        if (errmsg) *errmsg = strdup("erro ao converter primeira expressão para RPN");
-        parser_free_buffer(&tokens1);
-        parser_free_buffer(&rpn1);
-        plot_data_free(data);
+    p->nrpn = construir_programas(plot, p->rpn, arena, errmsg);
+    if (!p->nrpn) {
+        free(p);
         return NULL;
     }
-    
-    // Segunda expressão (paramétrico)
-    TokenBuffer tokens2, rpn2;
+    const TokenBuffer *programas[2] = { &p->rpn[0], &p->rpn[1] };
+    p->prog = evaluator_compile_multi(programas, p->nrpn, evaluator_engine);
+    if (!p->prog) {
+        liberar_programas(p);
+        if (errmsg) *errmsg = strdup("memória insuficiente ao traduzir expressão");
+        return NULL;
+    }
+    return p;
+}
+
+/* ========================================================================
+ * Cache de programas compilados
+ * ======================================================================== */
+
+int plot_cache_enabled = 1;
+
+static ExprCache *cache_programas = NULL;
+static pthread_once_t cache_programas_once = PTHREAD_ONCE_INIT;
+
+static void destruir_cache_programas(void) {
+    exprcache_destroy(cache_programas);
+    cache_programas = NULL;
+}
+
+static void criar_cache_programas(void) {
+    cache_programas = exprcache_create(PLOT_CACHE_CAPACITY, liberar_programas);
+    if (cache_programas) atexit(destruir_cache_programas);
+}
+
+ExprCache *plot_program_cache(void) {
+    pthread_once(&cache_programas_once, criar_cache_programas);
+    return cache_programas;
+}
+
+/* Chave do cache: tudo o que muda a compilação (locale do parser, tipo do
+ * plot, otimizador, motor) e as expressões normalizadas. Alocada em `arena`
+ * ou, sem arena, com malloc. NULL sem memória. */
+static char *chave_programas(const Plot *plot, Arena *arena) {
     int tem_expr2 = (plot->type == PLOT_PARAMETRIC && plot->expr2);
+    size_t n1 = exprcache_normalize(plot->expr1, NULL, 0);
+    size_t n2 = tem_expr2 ? exprcache_normalize(plot->expr2, NULL, 0) : 0;
+    char prefixo[32];
+    int np = snprintf(prefixo, sizeof(prefixo), "%d:%d:%d:%d:", (int)parser_locale,
+                      (int)plot->type, optimizer_enabled, (int)evaluator_engine);
+    size_t n = np + n1 + n2 + 3;
+    char *chave = arena ? arena_alloc(arena, n) : malloc(n);
+    if (!chave) return NULL;
+    memcpy(chave, prefixo, np);
+    char *p = chave + np;
+    p += exprcache_normalize(plot->expr1, p, n1 + 1);
     if (tem_expr2) {
-        parser_init_buffer(&tokens2);
-        parser_init_buffer(&rpn2);
+        *p++ = '\n';
+        p += exprcache_normalize(plot->expr2, p, n2 + 1);
+    }
+    *p = '\0';
+    return chave;
+}
+
+/* Programas do plot: do cache (entrada adquirida em *entrada) ou compilados
+ * só para esta chamada (*entrada NULL). Retorna NULL em caso de erro. */
+static const ProgramasPlot *obter_programas(const Plot *plot, ExprCacheEntry **entrada,
+                                            Arena *arena, char **errmsg) {
+    *entrada = NULL;
+    ExprCache *cache = plot_cache_enabled ? plot_program_cache() : NULL;
+    char *chave = cache ? chave_programas(plot, arena) : NULL;
+    if (chave) {
+        *entrada = exprcache_get(cache, chave);
+        if (*entrada) {
+            if (!arena) free(chave);
+            return exprcache_value(*entrada);
+        }
+    }
+    
+    ProgramasPlot *p = compilar_programas(plot, arena, errmsg);
+    if (p && chave) {
+        // Outra thread pode ter inserido a mesma chave: vale a do cache
+        *entrada = exprcache_put(cache, chave, p);
+        if (*entrada) p = (ProgramasPlot *)exprcache_value(*entrada);
+    }
+    if (!arena) free(chave);
+    return p;
+}
+
+static void soltar_programas(const ProgramasPlot *p, ExprCacheEntry *entrada) {
+    if (entrada) {
+        exprcache_release(plot_program_cache(), entrada);
+    } else if (p) {
+        liberar_programas((void *)p);
+    }
+}
+
+/* Estado compartilhado pelas tarefas de amostragem */
+typedef struct {
+    const Plot *plot;
+    const ProgramasPlot *programas; /* NULL: plot->native sem análise */
+    ExprCacheEntry *entrada;    /* programas vindos do cache */
+    const EvalProgram *prog;    /* NULL: plot->native */
+    const TokenBuffer *rpn;     /* programas para a análise por intervalos */
+    int nrpn;                   /* 0: análise desligada */
+    double *x, *y;              /* saída em double: linha i = amostra first + i */
+    float *xf, *yf;             /* ou em float (PLOT_FLOAT32) */
+    uint8_t *status;            /* status por linha (sampler) ou */
+    uint64_t *valid;            /* bit por linha (PlotData) */
+    uint64_t first;
+    int n;                      /* linhas a avaliar */
+    double C;
+    double step;
+    int tem_expr2;
+    int is_polar;
+} Amostragem;
+
+/* Classifica a faixa de parâmetros [t0, t1] (em qualquer ordem) pelo pior
+ * status dos programas avaliados por intervalos */
+static IntervalStatus classificar_faixa(const Amostragem *a, double t0, double t1) {
+    Interval t = { fmin(t0, t1), fmax(t0, t1) };
+    IntervalStatus status = INTERVAL_SAFE;
+    for (int k = 0; k < a->nrpn; k++) {
+        IntervalStatus sk = interval_eval_rpn(&a->rpn[k], t).status;
+        if (sk > status) status = sk;
+    }
+    return status;
+}
+
+/* Avalia os parâmetros tv[0..len) (len <= PLOT_EVAL_CHUNK) com o avaliador
+ * em lote e grava x/y/status na posição de cada ponto. `prova` vem da análise
+ * por intervalos: INTERVAL_FAILS marca tudo como inválido sem avaliar e
+ * INTERVAL_SAFE usa o avaliador sem verificação. */
+static void avaliar_pontos(const Amostragem *a, const double *tv, int len,
+                           double *x, double *y, uint8_t *status, IntervalStatus prova) {
+    const Plot *plot = a->plot;
+    double v1[PLOT_EVAL_CHUNK], v2[PLOT_EVAL_CHUNK];
+    uint8_t s1[PLOT_EVAL_CHUNK], s2[PLOT_EVAL_CHUNK];
+    double *saidas[2] = { v1, v2 };
+    uint8_t *estados[2] = { s1, s2 };
+    
+    if (prova == INTERVAL_FAILS) {
+        for (int j = 0; j < len; j++) status[j] = 1;
+        return;
+    }
+    if (prova == INTERVAL_SAFE && a->prog) {
+        evaluator_program_eval_batch_unchecked(a->prog, tv, saidas, len);
+        memset(s1, EVAL_OK, len);
+        memset(s2, EVAL_OK, len);
+    } else if (a->prog) {
+        evaluator_program_eval_batch_multi(a->prog, tv, saidas, estados, len);
+    } else {
+        plot->native(tv, saidas, estados, len);
+    }
+    
+    for (int j = 0; j < len; j++) {
+        double t = tv[j];
+        status[j] = 1;
         
-        perr = parser_tokenize(plot->expr2, &tokens2);
-        if (perr != PARSER_OK) {
-            if (errmsg) *errmsg = strdup("erro ao compilar segunda expressão");
-            parser_free_buffer(&tokens1);
-            parser_free_buffer(&rpn1);
-            parser_free_buffer(&tokens2);
-            parser_free_buffer(&rpn2);
-            plot_data_free(data);
-            return NULL;
+        if (s1[j] != EVAL_OK) continue;
+        
+        // Coordenadas cartesianas (polares já convertidas pelo programa)
+        if (plot->type == PLOT_CARTESIAN) {
+            x[j] = t;
+            y[j] = v1[j];
+        } else if (a->is_polar) {
+            // R**2 = f(t): sqrt falha (s1/s2) quando f(t) < 0
+            if (s2[j] != EVAL_OK) continue;
+            x[j] = v1[j];
+            y[j] = v2[j];
+        } else if (plot->type == PLOT_PARAMETRIC) {
+            if (!a->tem_expr2 || s2[j] != EVAL_OK) continue;
+            x[j] = v1[j];
+            y[j] = v2[j];
+        } else {
+            continue;
+        }
+        status[j] = 0;
+    }
+}
+
+/* Avalia os parâmetros crescentes (ou decrescentes) tv[0..len) classificando
+ * a faixa por intervalos: faixas em que tudo falha (sqrt de negativo) não são
+ * avaliadas, faixas seguras usam kernels sem verificação, e as demais (polos,
+ * fronteiras de domínio) são divididas ao meio até PLOT_INTERVAL_MIN
+ * amostras, que usam o avaliador com verificação. */
+static void avaliar_por_intervalos(const Amostragem *a, const double *tv, int len,
+                                   double *x, double *y, uint8_t *status) {
+    if (a->nrpn == 0) {
+        avaliar_pontos(a, tv, len, x, y, status, INTERVAL_MAYBE);
+        return;
+    }
+    
+    IntervalStatus prova = classificar_faixa(a, tv[0], tv[len - 1]);
+    if (prova == INTERVAL_MAYBE && len > PLOT_INTERVAL_MIN) {
+        int meio = len / 2;
+        avaliar_por_intervalos(a, tv, meio, x, y, status);
+        avaliar_por_intervalos(a, tv + meio, len - meio, x + meio, y + meio, status + meio);
+        return;
+    }
+    avaliar_pontos(a, tv, len, x, y, status, prova);
+}
+
+/* Grava o bloco de linhas [base, base + len) nas colunas de saída, na
+ * precisão delas; o status vai em bytes ou em bits. Com bits, `base` é
+ * múltiplo de 64 e o bloco termina num múltiplo de 64 ou na última linha,
+ * então cada tarefa escreve palavras só suas. */
+static void gravar_linhas(const Amostragem *a, int base, int len, const double *x,
+                          const double *y, const uint8_t *status) {
+    if (a->xf) {
+        for (int j = 0; j < len; j++) {
+            if (status[j]) continue;
+            a->xf[base + j] = (float)x[j];
+            a->yf[base + j] = (float)y[j];
         }
+    } else {
+        memcpy(a->x + base, x, len * sizeof(double));
+        memcpy(a->y + base, y, len * sizeof(double));
+    }
+    
+    if (a->status) {
+        memcpy(a->status + base, status, len);
+        return;
+    }
+    for (int j = 0; j < len; j += 64) {
+        int m = (len - j < 64) ? len - j : 64;
+        uint64_t w = 0;
+        for (int k = 0; k < m; k++) w |= (uint64_t)(status[j + k] == 0) << k;
+        a->valid[(base + j) >> 6] = w;
+    }
+}
+
+/* Avalia as linhas [lo, hi) em blocos. Cada ponto é gravado na linha da
+ * própria amostra; a compactação vem depois. */
+static void avaliar_faixa(const Amostragem *a, int lo, int hi) {
+    double tv[PLOT_EVAL_CHUNK];
+    double x[PLOT_EVAL_CHUNK], y[PLOT_EVAL_CHUNK];
+    uint8_t status[PLOT_EVAL_CHUNK];
+    
+    for (int base = lo; base < hi; base += PLOT_EVAL_CHUNK) {
+        int len = (hi - base < PLOT_EVAL_CHUNK) ? hi - base : PLOT_EVAL_CHUNK;
         
-        perr = parser_to_rpn(&tokens2, &rpn2);
-        if (perr != PARSER_OK) {
-            if (errmsg) *errmsg = strdup("erro ao converter segunda expressão para RPN");
-            parser_free_buffer(&tokens1);
-            parser_free_buffer(&rpn1);
-            parser_free_buffer(&tokens2);
-            parser_free_buffer(&rpn2);
-            plot_data_free(data);
-            return NULL;
+        for (int j = 0; j < len; j++) {
+            tv[j] = a->C + (double)(a->first + base + j) * a->step;
         }
+        avaliar_por_intervalos(a, tv, len, x, y, status);
+        gravar_linhas(a, base, len, x, y, status);
     }
+}
+
+static void tarefa_amostragem(void *ctx, int tarefa) {
+    const Amostragem *a = ctx;
+    int lo = tarefa * PLOT_TASK_SAMPLES;
+    int hi = (a->n - lo < PLOT_TASK_SAMPLES) ? a->n : lo + PLOT_TASK_SAMPLES;
+    avaliar_faixa(a, lo, hi);
+}
+
+/* Avalia as a->n linhas (em paralelo se houver pool e amostras suficientes) */
+static void avaliar_linhas(const Amostragem *a) {
+    int tarefas = (a->n + PLOT_TASK_SAMPLES - 1) / PLOT_TASK_SAMPLES;
+    ThreadPool *pool = (tarefas > 1) ? threadpool_default() : NULL;
+    threadpool_run(pool, tarefa_amostragem, (void *)a, tarefas);
+}
+
+/* Lista de parâmetros avaliada em tarefas do pool (amostragem adaptativa) */
+typedef struct {
+    const Amostragem *a;
+    const double *t;
+    double *x, *y;
+    uint8_t *status;
+    int n;
+} ListaPontos;
+
+static void tarefa_lista(void *ctx, int tarefa) {
+    const ListaPontos *l = ctx;
+    int lo = tarefa * PLOT_TASK_SAMPLES;
+    int hi = (l->n - lo < PLOT_TASK_SAMPLES) ? l->n : lo + PLOT_TASK_SAMPLES;
+    for (int base = lo; base < hi; base += PLOT_EVAL_CHUNK) {
+        int len = (hi - base < PLOT_EVAL_CHUNK) ? hi - base : PLOT_EVAL_CHUNK;
+        avaliar_pontos(l->a, l->t + base, len, l->x + base, l->y + base, l->status + base,
+                       INTERVAL_MAYBE);
+    }
+}
+
+static void avaliar_lista(const Amostragem *a, const double *t, int n,
+                          double *x, double *y, uint8_t *status) {
+    ListaPontos lista = { a, t, x, y, status, n };
+    int tarefas = (n + PLOT_TASK_SAMPLES - 1) / PLOT_TASK_SAMPLES;
+    ThreadPool *pool = (tarefas > 1) ? threadpool_default() : NULL;
+    threadpool_run(pool, tarefa_lista, &lista, tarefas);
+}
+
+/* Amostras da subdivisão adaptativa, em ordem de parâmetro. k é o índice na
+ * grade mais fina (t = C + k*step); `ativo[i]` marca o intervalo [i, i+1]
+ * ainda por subdividir. */
+typedef struct {
+    int *k;
+    double *x, *y;
+    uint8_t *status;
+    char *ativo;
+    int n;
+} Subdivisao;
+
+static void subdivisao_free(Subdivisao *s) {
+    free(s->k);
+    free(s->x);
+    free(s->y);
+    free(s->status);
+    free(s->ativo);
+}
+
+static int subdivisao_alloc(Subdivisao *s, int n) {
+    s->k = malloc(n * sizeof(int));
+    s->x = malloc(n * sizeof(double));
+    s->y = malloc(n * sizeof(double));
+    s->status = malloc(n);
+    s->ativo = calloc(n, 1);
+    s->n = n;
+    if (s->k && s->x && s->y && s->status && s->ativo) return 1;
+    subdivisao_free(s);
+    return 0;
+}
+
+/* Subdivide [p0, p1] (ponto médio pm)? Sempre que a validade muda dentro do
+ * intervalo (fronteira de domínio, polo) ou a análise por intervalos não prova
+ * que ele está livre de polos; senão, quando o ponto médio está a mais de
+ * `tol` pixels do meio da corda. */
+static int precisa_subdividir(const Amostragem *a, const Subdivisao *s, int i0, int i1,
+                              double step, double xm, double ym, int sm,
+                              double sx, double sy, double tol) {
+    int ok0 = !s->status[i0], ok1 = !s->status[i1], okm = !sm;
+    if (!ok0 && !ok1 && !okm) return 0;
+    if (!(ok0 && ok1 && okm)) return 1;
     
-    // Gera e avalia amostras
-    double step = (D - C) / (n - 1);
-    int count = 0;
+    // Polo entre três pontos válidos (tan, 1/x): a corda pode não denunciá-lo
+    if (a->nrpn && classificar_faixa(a, a->C + s->k[i0] * step,
+                                     a->C + s->k[i1] * step) != INTERVAL_SAFE) {
+        return 1;
+    }
+    double dx = (xm - 0.5 * (s->x[i0] + s->x[i1])) * sx;
+    double dy = (ym - 0.5 * (s->y[i0] + s->y[i1])) * sy;
+    return !(dx * dx + dy * dy <= tol * tol);
+}
+
+/* Amostragem adaptativa (ver PlotAdaptive). Nível a nível: os pontos médios
+ * de todos os intervalos ativos são avaliados em um só lote e intercalados
+ * na lista, que continua em ordem de parâmetro. */
+static PlotData *amostrar_adaptativo(const Amostragem *a, const PlotAdaptive *cfg,
+                                     double D, Arena *arena, char **errmsg) {
+    int max_depth = cfg->max_depth < 1 ? 1 : (cfg->max_depth > 30 ? 30 : cfg->max_depth);
+    int min_depth = cfg->min_depth < 0 ? 0 : (cfg->min_depth > max_depth ? max_depth : cfg->min_depth);
+    double step = (D - a->C) / (double)(1 << max_depth);
+    int n = (1 << min_depth) + 1;
+    int passo = 1 << (max_depth - min_depth);
     
+    Subdivisao s;
+    double *t = malloc(n * sizeof(double));
+    if (!t || !subdivisao_alloc(&s, n)) {
+        free(t);
+        if (errmsg) *errmsg = strdup("memória insuficiente");
+        return NULL;
+    }
+    
+    // Grade inicial uniforme
     for (int i = 0; i < n; i++) {
-        double t = C + i * step;
-        EvalResult res1 = evaluator_eval_rpn(&rpn1, t);
+        s.k[i] = i * passo;
+        t[i] = a->C + s.k[i] * step;
+    }
+    avaliar_lista(a, t, n, s.x, s.y, s.status);
+    free(t);
+    
+    // Escala em pixels: mesma área de plotagem e bounding box de render_svg
+    double minx = 0, maxx = 0, miny = 0, maxy = 0;
+    int primeiro = 1;
+    for (int i = 0; i < n; i++) {
+        if (s.status[i]) continue;
+        double x = s.x[i], y = s.y[i];
+        if (!isfinite(x) || fabs(x) > 1e6 || !isfinite(y) || fabs(y) > 1e6) continue;
+        if (primeiro || x < minx) minx = x;
+        if (primeiro || x > maxx) maxx = x;
+        if (primeiro || y < miny) miny = y;
+        if (primeiro || y > maxy) maxy = y;
+        primeiro = 0;
+    }
+    double rangex = maxx - minx, rangey = maxy - miny;
+    if (rangex < 0.01) rangex = 1.0;
+    if (rangey < 0.01) rangey = 1.0;
+    double sx = cfg->width * 0.8 / rangex;
+    double sy = cfg->height * 0.8 / rangey;
+    
+    for (int i = 0; i + 1 < n; i++) s.ativo[i] = (passo > 1);
+    
+    for (int nivel = min_depth; nivel < max_depth; nivel++) {
+        int ativos = 0;
+        for (int i = 0; i + 1 < s.n; i++) ativos += s.ativo[i];
+        if (ativos == 0) break;
         
-        if (res1.error != EVAL_OK) {
-            data->status[i] = 1;
-            continue;
+        // Pontos médios dos intervalos ativos
+        double *tm = malloc(ativos * sizeof(double));
+        double *xm = malloc(ativos * sizeof(double));
+        double *ym = malloc(ativos * sizeof(double));
+        uint8_t *sm = malloc(ativos);
+        Subdivisao nova;
+        if (!tm || !xm || !ym || !sm || !subdivisao_alloc(&nova, s.n + ativos)) {
+            free(tm); free(xm); free(ym); free(sm);
+            subdivisao_free(&s);
+            if (errmsg) *errmsg = strdup("memória insuficiente");
+            return NULL;
         }
+        for (int i = 0, j = 0; i + 1 < s.n; i++) {
+            if (s.ativo[i]) tm[j++] = a->C + ((s.k[i] + s.k[i + 1]) / 2) * step;
+        }
+        avaliar_lista(a, tm, ativos, xm, ym, sm);
         
-        // Converte para coordenadas cartesianas
-        if (plot->type == PLOT_CARTESIAN) {
-            data->x[count] = t;
-            data->y[count] = res1.value;
-        } else if (plot->type == PLOT_POLAR_R) {
-            double r = res1.value;
-            data->x[count] = r * cos(t);
-            data->y[count] = r * sin(t);
-        } else if (plot->type == PLOT_POLAR_R2) {
-            // R**2 = f(t) → R = sqrt(f(t)) se f(t) >= 0
-            if (res1.value < 0) {
-                data->status[i] = 1;
-                continue;
+        // Intercala; metades de intervalos ainda fora da tolerância seguem ativas
+        int ultimo = (nivel + 1 == max_depth);
+        int o = 0;
+        for (int i = 0, j = 0; i < s.n; i++) {
+            nova.k[o] = s.k[i];
+            nova.x[o] = s.x[i];
+            nova.y[o] = s.y[i];
+            nova.status[o] = s.status[i];
+            o++;
+            if (i + 1 < s.n && s.ativo[i]) {
+                int dividir = !ultimo &&
+                    precisa_subdividir(a, &s, i, i + 1, step, xm[j], ym[j], sm[j],
+                                       sx, sy, cfg->tolerance);
+                nova.ativo[o - 1] = (char)dividir;
+                nova.k[o] = (s.k[i] + s.k[i + 1]) / 2;
+                nova.x[o] = xm[j];
+                nova.y[o] = ym[j];
+                nova.status[o] = sm[j];
+                nova.ativo[o] = (char)dividir;
+                o++;
+                j++;
             }
-            double r = sqrt(res1.value);
-            data->x[count] = r * cos(t);
-            data->y[count] = r * sin(t);
-        } else if (plot->type == PLOT_PARAMETRIC) {
-            if (!tem_expr2) {
-                data->status[i] = 1;
-                continue;
-            }
-            EvalResult res2 = evaluator_eval_rpn(&rpn2, t);
-            if (res2.error != EVAL_OK) {
-                data->status[i] = 1;
-                continue;
+        }
+        free(tm); free(xm); free(ym); free(sm);
+        subdivisao_free(&s);
+        s = nova;
+    }
+    
+    // Converte em PlotData (bit por amostra; pontos válidos compactados)
+    PlotData *data = plot_data_create(s.n, a->plot->precision, arena);
+    if (!data) {
+        subdivisao_free(&s);
+        if (errmsg) *errmsg = strdup("memória insuficiente");
+        return NULL;
+    }
+    for (int i = 0; i < s.n; i++) plot_data_append(data, !s.status[i], s.x[i], s.y[i]);
+    subdivisao_free(&s);
+    return data;
+}
+
+/* Obtém os programas do plot (cache de programas) e preenche `a` (menos as
+ * linhas de saída); liberar com liberar_amostragem. Memória temporária vem
+ * de `arena`, se não for NULL. Retorna 0 em caso de erro, com a mensagem em
+ * errmsg. */
+static int preparar_amostragem(const Plot *plot, Amostragem *a, double *D, Arena *arena,
+                               char **errmsg) {
+    if (!plot || !plot->expr1) {
+        if (errmsg) *errmsg = strdup("plot inválido");
+        return 0;
+    }
+    
+    // Define intervalo [C,D]
+    double C;
+    plot_get_interval(plot, &C, D);
+    
+    // Para polar, converte para radianos
+    int is_polar = (plot->type == PLOT_POLAR_R || plot->type == PLOT_POLAR_R2);
+    if (is_polar) {
+        C = C * M_PI;
+        *D = *D * M_PI;
+    }
+    
+    // Programas para o motor de avaliação padrão (presets já trazem a função
+    // nativa). O RPN fica para a análise por intervalos, inclusive nos presets.
+    memset(a, 0, sizeof(*a));
+    if (!plot->native || interval_enabled) {
+        a->programas = obter_programas(plot, &a->entrada, arena, errmsg);
+        if (!a->programas) return 0;
+        if (!plot->native) a->prog = a->programas->prog;
+        if (interval_enabled) {
+            a->rpn = a->programas->rpn;
+            a->nrpn = a->programas->nrpn;
+        }
+    }
+    
+    a->plot = plot;
+    a->C = C;
+    a->tem_expr2 = (plot->type == PLOT_PARAMETRIC && plot->expr2);
+    a->is_polar = is_polar;
+    return 1;
+}
+
+static void liberar_amostragem(const Amostragem *a) {
+    soltar_programas(a->programas, a->entrada);
+}
+
+PlotData *plot_generate_samples(const Plot *plot, char **errmsg) {
+    return plot_generate_samples_arena(plot, NULL, errmsg);
+}
+
+PlotData *plot_generate_samples_arena(const Plot *plot, Arena *arena, char **errmsg) {
+    if (errmsg) *errmsg = NULL;
+    Amostragem amostragem;
+    double D;
+    if (!preparar_amostragem(plot, &amostragem, &D, arena, errmsg)) return NULL;
+    
+    if (plot->adaptive.enabled) {
+        // A lista cresce nível a nível no heap; só o resultado vai para a arena
+        PlotData *data = amostrar_adaptativo(&amostragem, &plot->adaptive, D, arena, errmsg);
+        liberar_amostragem(&amostragem);
+        return data;
+    }
+    
+    // Aloca estrutura de dados
+    int n = plot->samples;
+    PlotData *data = plot_data_create(n, plot->precision, arena);
+    if (!data) {
+        if (errmsg) *errmsg = strdup("memória insuficiente");
+        liberar_amostragem(&amostragem);
+        return NULL;
+    }
+    
+    // Avalia as amostras e compacta os pontos válidos na ordem original
+    amostragem.x = data->x;
+    amostragem.y = data->y;
+    amostragem.xf = data->xf;
+    amostragem.yf = data->yf;
+    amostragem.valid = data->valid;
+    amostragem.n = n;
+    amostragem.step = (D - amostragem.C) / (n - 1);
+    avaliar_linhas(&amostragem);
+    data->samples = n;
+    
+    int count = 0;
+    for (int w = 0; w < (n + 63) / 64; w++) {
+        for (uint64_t bits = data->valid[w]; bits; bits &= bits - 1) {
+            int i = w * 64 + __builtin_ctzll(bits);
+            if (data->xf) {
+                data->xf[count] = data->xf[i];
+                data->yf[count] = data->yf[i];
+            } else {
+                data->x[count] = data->x[i];
+                data->y[count] = data->y[i];
             }
-            data->x[count] = res1.value;
-            data->y[count] = res2.value;
+            count++;
         }
-        
-        count++;
     }
     
     data->count = count;
     
-    // Libera buffers
-    parser_free_buffer(&tokens1);
-    parser_free_buffer(&rpn1);
-    if (tem_expr2) {
-        parser_free_buffer(&tokens2);
-        parser_free_buffer(&rpn2);
-    }
+    // Libera programas
+    liberar_amostragem(&amostragem);
     
     return data;
 }
+
+struct PlotSampler {
+    Amostragem a;
+    uint64_t samples;
+    uint64_t next;          /* primeira amostra do próximo bloco */
+    double *x, *y;
+    uint8_t *status;
+};
+
+PlotSampler *plot_sampler_open(const Plot *plot, uint64_t samples, char **errmsg) {
+    if (errmsg) *errmsg = NULL;
+    if (plot && plot->adaptive.enabled) {
+        if (errmsg) *errmsg = strdup("amostragem adaptativa não suporta streaming");
+        return NULL;
+    }
+    if (plot && samples == 0) samples = plot->samples > 0 ? (uint64_t)plot->samples : 0;
+    if (samples < 2) {
+        if (errmsg) *errmsg = strdup("número de amostras inválido");
+        return NULL;
+    }
+    
+    PlotSampler *s = calloc(1, sizeof(PlotSampler));
+    if (s) {
+        s->x = malloc(PLOT_SAMPLER_CHUNK * sizeof(double));
+        s->y = malloc(PLOT_SAMPLER_CHUNK * sizeof(double));
+        s->status = malloc(PLOT_SAMPLER_CHUNK);
+    }
+    if (!s || !s->x || !s->y || !s->status) {
+        if (s) {
+            free(s->x);
+            free(s->y);
+            free(s->status);
+            free(s);
+        }
+        if (errmsg) *errmsg = strdup("memória insuficiente");
+        return NULL;
+    }
+    
+    double D;
+    if (!preparar_amostragem(plot, &s->a, &D, NULL, errmsg)) {
+        free(s->x);
+        free(s->y);
+        free(s->status);
+        free(s);
+        return NULL;
+    }
+    s->a.x = s->x;
+    s->a.y = s->y;
+    s->a.status = s->status;
+    s->a.step = (D - s->a.C) / (double)(samples - 1);
+    s->samples = samples;
+    return s;
+}
+
+int plot_sampler_next(PlotSampler *s, PlotChunk *chunk) {
+    if (!s || s->next >= s->samples) return 0;
+    uint64_t restantes = s->samples - s->next;
+    int n = restantes < PLOT_SAMPLER_CHUNK ? (int)restantes : PLOT_SAMPLER_CHUNK;
+    
+    s->a.first = s->next;
+    s->a.n = n;
+    avaliar_linhas(&s->a);
+    
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        if (s->status[i]) {
+            s->x[i] = s->y[i] = NAN;
+        } else {
+            count++;
+        }
+    }
+    
+    chunk->first = s->next;
+    chunk->n = n;
+    chunk->count = count;
+    chunk->x = s->x;
+    chunk->y = s->y;
+    chunk->status = s->status;
+    s->next += n;
+    return 1;
+}
+
+uint64_t plot_sampler_samples(const PlotSampler *s) {
+    return s ? s->samples : 0;
+}
+
+void plot_sampler_close(PlotSampler *s) {
+    if (!s) return;
+    liberar_amostragem(&s->a);
+    free(s->x);
+    free(s->y);
+    free(s->status);
+    free(s);
+}
@@ -0,0 +1,195 @@
+/* Otimizador de RPN: reconstrói a árvore, simplifica de baixo para cima e
+ * reemite em pós-ordem (a ordem de avaliação — e portanto de erros — é mantida) */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "optimizer.h"
+#include "evaluator.h"
+
+int optimizer_enabled = 1;
+
+/* Nó da árvore de expressão. Constantes (números, pi, e e subárvores dobradas)
+ * viram TOKEN_NUMBER com o valor já resolvido. */
+typedef struct {
+    uint8_t type;
+    int a, b;           /* filhos (-1 se ausente) */
+    int pow_n;          /* > 0: TOKEN_POW reescrito como cadeia de a*a*...*a */
+    double value;       /* TOKEN_NUMBER */
+} OptNode;
+
+static int is_binary(TokenType type) {
+    return (type == TOKEN_PLUS || type == TOKEN_MINUS || type == TOKEN_MULT ||
+            type == TOKEN_DIV || type == TOKEN_POW);
+}
+
+static int is_variable(TokenType type) {
+    return (type >= TOKEN_VARIABLE_START && type <= TOKEN_VARIABLE_END);
+}
+
+/* Transforma o nó em constante */
+static void make_constant(OptNode *node, double value) {
+    node->type = TOKEN_NUMBER;
+    node->a = node->b = -1;
+    node->pow_n = 0;
+    node->value = value;
+}
+
+/* Simplifica um nó cujos filhos já foram simplificados.
+ * Retorna o índice do nó que o substitui (o próprio ou um descendente). */
+static int simplify(OptNode *nodes, int id, OptimizerStats *st) {
+    OptNode *n = &nodes[id];
+    TokenType type = (TokenType)n->type;
+
+    if (type == TOKEN_NEG) {
+        OptNode *c = &nodes[n->a];
+        if (c->type == TOKEN_NUMBER) {
+            make_constant(n, -c->value);
+            st->folded++;
+        } else if (c->type == TOKEN_NEG) {
+            st->negations++;
+            return c->a;
+        }
+        return id;
+    }
+
+    if (is_binary(type)) {
+        OptNode *l = &nodes[n->a];
+        OptNode *r = &nodes[n->b];
+
+        if (l->type == TOKEN_NUMBER && r->type == TOKEN_NUMBER) {
+            EvalResult res = evaluator_apply_operator(type, l->value, r->value);
+            if (res.error == EVAL_OK) {
+                make_constant(n, res.value);
+                st->folded++;
+            }
+            return id;
+        }
+
+        if (type == TOKEN_POW && r->type == TOKEN_NUMBER && is_variable((TokenType)l->type)) {
+            double e = r->value;
+            if (e >= 2.0 && e <= OPTIMIZER_MAX_POW && e == floor(e)) {
+                n->pow_n = (int)e;
+                st->powers++;
+            }
+            return id;
+        }
+
+        if (type == TOKEN_DIV && r->type == TOKEN_NUMBER && r->value != 0.0) {
+            double inv = 1.0 / r->value;
+            if (!isinf(inv) && !isnan(inv)) {
+                n->type = TOKEN_MULT;
+                r->value = inv;
+                st->reciprocals++;
+            }
+        }
+        return id;
+    }
+
+    /* Função unária */
+    OptNode *c = &nodes[n->a];
+    if (c->type == TOKEN_NUMBER) {
+        EvalResult res = evaluator_apply_function(type, c->value);
+        if (res.error == EVAL_OK) {
+            make_constant(n, res.value);
+            st->folded++;
+        }
+    }
+    return id;
+}
+
+static int emit_token(TokenBuffer *out, TokenType type, uint16_t value_index) {
+    Token t = {(uint8_t)type, value_index};
+    return parser_add_token(out, t);
+}
+
+/* Emite a subárvore em pós-ordem */
+static int emit(const OptNode *nodes, int id, TokenBuffer *out) {
+    const OptNode *n = &nodes[id];
+
+    if (n->type == TOKEN_NUMBER) {
+        int idx = parser_add_value(out, n->value);
+        return idx >= 0 && emit_token(out, TOKEN_NUMBER, (uint16_t)idx);
+    }
+    if (is_variable((TokenType)n->type)) {
+        return emit_token(out, (TokenType)n->type, 0);
+    }
+    if (n->pow_n > 0) {
+        if (!emit(nodes, n->a, out)) return 0;
+        for (int k = 1; k < n->pow_n; k++) {
+            if (!emit(nodes, n->a, out) || !emit_token(out, TOKEN_MULT, 0)) return 0;
+        }
+        return 1;
+    }
+
+    if (!emit(nodes, n->a, out)) return 0;
+    if (n->b >= 0 && !emit(nodes, n->b, out)) return 0;
+    return emit_token(out, (TokenType)n->type, 0);
+}
+
+int optimizer_run(const TokenBuffer *rpn, TokenBuffer *out, OptimizerStats *stats) {
+    OptimizerStats st = {0, 0, 0, 0, 0, 0};
+    if (!rpn) return 0;
+    st.tokens_before = rpn->tokens ? rpn->size : 0;
+
+    EvalError stop_error = EVAL_STACK_ERROR;
+    int stop = 0;
+    if (rpn->tokens && rpn->size > 0) {
+        stop = evaluator_validate_rpn(rpn, &stop_error);
+    }
+
+    /* Programa inválido: copia como está (o erro é reportado na avaliação) */
+    if (stop_error != EVAL_OK) {
+        if (!parser_copy_buffer(rpn, out)) return 0;
+        st.tokens_after = out->size;
+        if (stats) *stats = st;
+        return 1;
+    }
+
+    OptNode *nodes = malloc(rpn->size * sizeof(OptNode));
+    if (!nodes) return 0;
+
+    /* O RPN é pós-ordem: os filhos de cada nó já foram simplificados */
+    int stack[MAX_EVAL_STACK_SIZE];
+    int depth = 0;
+
+    for (int i = 0; i < stop; i++) {
+        Token token = rpn->tokens[i];
+        TokenType type = (TokenType)token.type;
+        OptNode *n = &nodes[i];
+
+        n->type = token.type;
+        n->a = n->b = -1;
+        n->pow_n = 0;
+        n->value = 0.0;
+
+        if (type == TOKEN_NUMBER) {
+            n->value = rpn->values[token.value_index];
+        } else if (type >= TOKEN_CONST_START && type <= TOKEN_CONST_END) {
+            make_constant(n, evaluator_constant(type));
+        } else if (!is_variable(type)) {
+            if (is_binary(type)) n->b = stack[--depth];
+            n->a = stack[--depth];
+            stack[depth++] = simplify(nodes, i, &st);
+            continue;
+        }
+        stack[depth++] = i;
+    }
+
+    parser_init_buffer(out);
+    int ok = out->tokens && out->values && emit(nodes, stack[0], out);
+    if (ok && stop < rpn->size) ok = emit_token(out, TOKEN_END, 0);
+    free(nodes);
+
+    if (!ok) {
+        parser_free_buffer(out);
+        return 0;
+    }
+
+    st.tokens_after = out->size;
+    if (stats) *stats = st;
+    return 1;
+}
+
+int optimizer_saved(const OptimizerStats *stats) {
+    return stats->tokens_before - stats->tokens_after;
+}
@@ -0,0 +1,389 @@
+/* Saída bufferizada, sinks e formatação de doubles com casas fixas (ver
+ * outbuf.h) */
+#define _POSIX_C_SOURCE 200809L  /* mmap, ftruncate, writev */
+
+#include "../include/outbuf.h"
+#include <errno.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef __SIZEOF_INT128__
+static const uint64_t potencias10[FORMAT_FIXED_MAX_DECIMALS + 1] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+    10000000ULL, 100000000ULL, 1000000000ULL
+};
+#endif
+
+/* Pares de dígitos "00".."99" */
+static const char pares[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/* Escreve os dígitos de u (largura mínima `largura`, com zeros à esquerda) */
+static int escrever_inteiro(char *dst, uint64_t u, int largura) {
+    char tmp[24];
+    int n = sizeof(tmp);
+    while (u >= 100) {
+        unsigned d = (unsigned)(u % 100) * 2;
+        u /= 100;
+        tmp[--n] = pares[d + 1];
+        tmp[--n] = pares[d];
+    }
+    if (u >= 10) {
+        tmp[--n] = pares[u * 2 + 1];
+        tmp[--n] = pares[u * 2];
+    } else {
+        tmp[--n] = (char)('0' + u);
+    }
+    while ((int)sizeof(tmp) - n < largura) tmp[--n] = '0';
+    memcpy(dst, tmp + n, sizeof(tmp) - n);
+    return sizeof(tmp) - n;
+}
+
+int format_fixed(char *dst, double v, int decimals) {
+    if (decimals < 0) decimals = 0;
+    if (decimals > FORMAT_FIXED_MAX_DECIMALS) decimals = FORMAT_FIXED_MAX_DECIMALS;
+
+    // Campos do double: v = m / 2^k exatamente (m de 53 bits)
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    int expoente = (int)((bits >> 52) & 0x7ff);
+    uint64_t m = bits & ((UINT64_C(1) << 52) - 1);
+
+    int n = 0;
+    if (bits >> 63) dst[n++] = '-';
+    if (expoente == 0x7ff) {
+        memcpy(dst + n, m ? "nan" : "inf", 3);
+        return n + 3;
+    }
+
+    uint64_t inteiro = 0, fracao = 0;
+    int k = 1075 - expoente;
+    if (expoente == 0) {
+        k = 120;    // zero ou subnormal: arredonda para zero
+    } else {
+        m |= UINT64_C(1) << 52;
+    }
+    int via_printf = k <= 0;
+#ifndef __SIZEOF_INT128__
+    via_printf = k < 120;   // sem inteiro de 128 bits: tudo pelo printf
+#endif
+    if (via_printf) {
+        // |v| >= 2^53: raro nas coordenadas, fica com o printf
+        char tmp[FORMAT_FIXED_MAX_LEN + 1];
+        int len = snprintf(tmp, sizeof(tmp), "%.*f", decimals, fabs(v));
+        memcpy(dst + n, tmp, len);
+        return n + len;
+    }
+#ifdef __SIZEOF_INT128__
+    if (k < 120) {
+        // Parte inteira e fração exatas; fração * 10^d arredondada para o
+        // mais próximo, empate para o par (como a libc)
+        unsigned __int128 r = k < 64 ? (m & ((UINT64_C(1) << k) - 1)) : m;
+        inteiro = k < 64 ? m >> k : 0;
+        unsigned __int128 escalado = r * potencias10[decimals];
+        unsigned __int128 q = escalado >> k;
+        unsigned __int128 resto = escalado - (q << k);
+        unsigned __int128 metade = (unsigned __int128)1 << (k - 1);
+        fracao = (uint64_t)q;
+        uint64_t ultimo = decimals > 0 ? fracao : inteiro;
+        if (resto > metade || (resto == metade && (ultimo & 1))) {
+            if (decimals > 0 && ++fracao == potencias10[decimals]) {
+                fracao = 0;
+                inteiro++;
+            } else if (decimals == 0) {
+                inteiro++;
+            }
+        }
+    }
+#endif
+    // k >= 120: |v| < 2^-67, arredonda para zero com qualquer precisão
+
+    n += escrever_inteiro(dst + n, inteiro, 1);
+    if (decimals > 0) {
+        dst[n++] = '.';
+        n += escrever_inteiro(dst + n, fracao, decimals);
+    }
+    return n;
+}
+
+/* ---- Sinks ---- */
+
+static void sink_zerar(OutSink *sink, OutSinkKind kind) {
+    memset(sink, 0, sizeof(*sink));
+    sink->kind = kind;
+    sink->fd = -1;
+}
+
+void outsink_file(OutSink *sink, FILE *file) {
+    sink_zerar(sink, OUTSINK_FILE);
+    sink->file = file;
+}
+
+void outsink_fd(OutSink *sink, int fd) {
+    sink_zerar(sink, OUTSINK_FD);
+    sink->fd = fd;
+}
+
+void outsink_memory(OutSink *sink, Arena *arena) {
+    sink_zerar(sink, OUTSINK_MEMORY);
+    sink->arena = arena;
+}
+
+/* (Re)mapeia o arquivo com `capacity` bytes */
+static int mapear(OutSink *sink, size_t capacity) {
+    if (sink->data) munmap(sink->data, sink->capacity);
+    sink->data = NULL;
+    if (ftruncate(sink->fd, (off_t)capacity) != 0) return 0;
+    void *p = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, sink->fd, 0);
+    if (p == MAP_FAILED) return 0;
+    sink->data = p;
+    sink->capacity = capacity;
+    return 1;
+}
+
+int outsink_mmap(OutSink *sink, int fd) {
+    sink_zerar(sink, OUTSINK_MMAP);
+    sink->fd = fd;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size == 0) {
+        if (mapear(sink, OUTSINK_MMAP_INITIAL)) return 1;
+        // Sem mmap (sistema de arquivos sem suporte): desfaz o ftruncate
+        if (ftruncate(fd, 0) != 0) sink->error = 1;
+    }
+    sink->kind = OUTSINK_FD;
+    return 0;
+}
+
+char *outsink_reserve(OutSink *sink, size_t n) {
+    if (sink->error) return NULL;
+    if (sink->capacity - sink->len >= n) return sink->data + sink->len;
+    if (sink->kind != OUTSINK_MEMORY && sink->kind != OUTSINK_MMAP) return NULL;
+
+    size_t capacity = sink->capacity ? sink->capacity * 2 : OUTBUF_SIZE;
+    while (capacity - sink->len < n) capacity *= 2;
+    if (sink->kind == OUTSINK_MMAP) {
+        if (!mapear(sink, capacity)) {
+            sink->error = 1;
+            return NULL;
+        }
+        return sink->data + sink->len;
+    }
+    char *p = sink->arena ? arena_realloc(sink->arena, sink->data, sink->capacity, capacity)
+                          : realloc(sink->data, capacity);
+    if (!p) {
+        sink->error = 1;
+        return NULL;
+    }
+    sink->data = p;
+    sink->capacity = capacity;
+    return p + sink->len;
+}
+
+/* writev até o fim, seguindo escritas parciais (sockets e pipes) */
+static int escrever_fd(int fd, struct iovec *iov, int n) {
+    while (n > 0) {
+        ssize_t w = writev(fd, iov, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return 0;
+        }
+        while (n > 0 && (size_t)w >= iov->iov_len) {
+            w -= iov->iov_len;
+            iov++;
+            n--;
+        }
+        if (n > 0) {
+            iov->iov_base = (char *)iov->iov_base + w;
+            iov->iov_len -= w;
+        }
+    }
+    return 1;
+}
+
+int outsink_writev(OutSink *sink, const struct iovec *iov, int n) {
+    if (sink->error) return 0;
+    if (sink->kind == OUTSINK_FD) {
+        // Em lotes de até OUTSINK_IOV_MAX pedaços (cópia local: escrever_fd
+        // altera os iovec nas escritas parciais)
+        struct iovec v[OUTSINK_IOV_MAX];
+        int i = 0;
+        while (i < n) {
+            int m = 0;
+            size_t total = 0;
+            for (; i < n && m < OUTSINK_IOV_MAX; i++) {
+                if (iov[i].iov_len == 0) continue;
+                v[m++] = iov[i];
+                total += iov[i].iov_len;
+            }
+            if (!escrever_fd(sink->fd, v, m)) {
+                sink->error = 1;
+                return 0;
+            }
+            sink->len += total;
+        }
+        return 1;
+    }
+    for (int i = 0; i < n; i++) {
+        size_t len = iov[i].iov_len;
+        if (len == 0) continue;
+        if (sink->kind == OUTSINK_FILE) {
+            if (fwrite(iov[i].iov_base, 1, len, sink->file) != len) sink->error = 1;
+            else sink->len += len;
+        } else {
+            char *dst = outsink_reserve(sink, len);
+            if (!dst) return 0;
+            memcpy(dst, iov[i].iov_base, len);
+            sink->len += len;
+        }
+        if (sink->error) return 0;
+    }
+    return 1;
+}
+
+int outsink_write(OutSink *sink, const void *data, size_t n) {
+    struct iovec v = { (void *)data, n };
+    return outsink_writev(sink, &v, 1);
+}
+
+int outsink_finish(OutSink *sink) {
+    if (sink->kind == OUTSINK_FILE) {
+        if (fflush(sink->file) != 0 || ferror(sink->file)) sink->error = 1;
+    } else if (sink->kind == OUTSINK_MMAP && sink->data) {
+        munmap(sink->data, sink->capacity);
+        sink->data = NULL;
+        sink->capacity = 0;
+        if (ftruncate(sink->fd, (off_t)sink->len) != 0) sink->error = 1;
+    }
+    return !sink->error;
+}
+
+void outsink_free(OutSink *sink) {
+    if (sink->kind == OUTSINK_MEMORY && !sink->arena) free(sink->data);
+    if (sink->kind == OUTSINK_MEMORY) {
+        sink->data = NULL;
+        sink->capacity = sink->len = 0;
+    }
+}
+
+/* ---- OutBuf ---- */
+
+static int direto(const OutSink *sink) {
+    return sink->kind == OUTSINK_MEMORY || sink->kind == OUTSINK_MMAP;
+}
+
+/* Aponta a janela para o espaço livre do sink (pelo menos `n` bytes). Sem
+ * memória, volta ao buffer local, cujo conteúdo o sink com erro descarta. */
+static void abrir_janela(OutBuf *ob, size_t n) {
+    char *p = outsink_reserve(ob->sink, n > OUTBUF_SIZE ? n : OUTBUF_SIZE);
+    if (p) {
+        ob->buf = p;
+        ob->size = ob->sink->capacity - ob->sink->len;
+    } else {
+        ob->buf = ob->local;
+        ob->size = OUTBUF_SIZE;
+    }
+    ob->len = 0;
+}
+
+/* Entrega a janela e garante `n` bytes livres (n <= OUTBUF_SIZE, ou
+ * qualquer n com memória/mmap) */
+static void trocar_janela(OutBuf *ob, size_t n) {
+    outbuf_flush(ob);
+    if (ob->buf != ob->local) abrir_janela(ob, n);
+}
+
+void outbuf_init_sink(OutBuf *ob, OutSink *sink) {
+    ob->sink = sink;
+    if (direto(sink)) {
+        abrir_janela(ob, OUTBUF_SIZE);
+    } else {
+        ob->buf = ob->local;
+        ob->size = OUTBUF_SIZE;
+        ob->len = 0;
+    }
+}
+
+void outbuf_init(OutBuf *ob, FILE *out) {
+    outsink_file(&ob->arquivo, out);
+    outbuf_init_sink(ob, &ob->arquivo);
+}
+
+void outbuf_flush(OutBuf *ob) {
+    if (ob->len == 0) return;
+    if (ob->buf != ob->local) {
+        // A escrita já está no sink: só conta os bytes
+        ob->sink->len += ob->len;
+        ob->buf += ob->len;
+        ob->size -= ob->len;
+    } else {
+        outsink_write(ob->sink, ob->local, ob->len);
+    }
+    ob->len = 0;
+}
+
+void outbuf_write(OutBuf *ob, const char *s, size_t n) {
+    if (ob->len + n > ob->size) {
+        if (ob->buf == ob->local && n > OUTBUF_SIZE) {
+            // Grande: o pendente e `s` numa escrita só (writev num fd)
+            struct iovec v[2] = { { ob->local, ob->len }, { (void *)s, n } };
+            outsink_writev(ob->sink, v, 2);
+            ob->len = 0;
+            return;
+        }
+        trocar_janela(ob, n);
+        if (ob->len + n > ob->size) return;     /* sink sem memória */
+    }
+    memcpy(ob->buf + ob->len, s, n);
+    ob->len += n;
+}
+
+void outbuf_puts(OutBuf *ob, const char *s) {
+    outbuf_write(ob, s, strlen(s));
+}
+
+void outbuf_putc(OutBuf *ob, char c) {
+    if (ob->len == ob->size) trocar_janela(ob, 1);
+    ob->buf[ob->len++] = c;
+}
+
+void outbuf_printf(OutBuf *ob, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(ob->buf + ob->len, ob->size - ob->len, fmt, ap);
+    va_end(ap);
+    if (n < 0) return;
+    if ((size_t)n < ob->size - ob->len) {
+        ob->len += n;
+        return;
+    }
+    // Não coube: troca a janela e tenta de novo (ou formata num buffer
+    // temporário se for maior que o buffer local)
+    trocar_janela(ob, (size_t)n + 1);
+    va_start(ap, fmt);
+    if ((size_t)n < ob->size - ob->len) {
+        ob->len += vsnprintf(ob->buf + ob->len, ob->size - ob->len, fmt, ap);
+    } else {
+        char *tmp = malloc((size_t)n + 1);
+        if (tmp) {
+            vsnprintf(tmp, (size_t)n + 1, fmt, ap);
+            outsink_write(ob->sink, tmp, n);
+            free(tmp);
+        } else {
+            ob->sink->error = 1;
+        }
+    }
+    va_end(ap);
+}
+
+void outbuf_fixed(OutBuf *ob, double v, int decimals) {
+    if (ob->size - ob->len < FORMAT_FIXED_MAX_LEN) trocar_janela(ob, FORMAT_FIXED_MAX_LEN);
+    ob->len += format_fixed(ob->buf + ob->len, v, decimals);
+}
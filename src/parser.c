@@ -3,6 +3,7 @@
 #include <string.h>
 #include <ctype.h>
 #include <math.h>
+#include <float.h>
 #include "parser.h"
 
 /* Configuração global */
@@ -23,140 +24,392 @@ void parser_set_locale(LocaleConfig locale) {
 
 /* Inicializa buffer */
 void parser_init_buffer(TokenBuffer *buf) {
+    parser_init_buffer_arena(buf, NULL);
+}
+
+/* Aloca ou aumenta um array do buffer (na arena ou com realloc) */
+static void *crescer(TokenBuffer *buf, void *ptr, size_t old_size, size_t size) {
+    if (buf->arena) return arena_realloc(buf->arena, ptr, old_size, size);
+    return realloc(ptr, size);
+}
+
+void parser_init_buffer_arena(TokenBuffer *buf, Arena *arena) {
+    buf->arena = arena;
     buf->capacity = 64;
     buf->size = 0;
-    buf->tokens = malloc(buf->capacity * sizeof(Token));
+    buf->tokens = crescer(buf, NULL, 0, buf->capacity * sizeof(Token));
     
     buf->values_capacity = 16;  /* Menos valores que tokens */
     buf->values_size = 0;
-    buf->values = malloc(buf->values_capacity * sizeof(double));
+    buf->values = crescer(buf, NULL, 0, buf->values_capacity * sizeof(double));
 }
 
 /* Libera buffer */
 void parser_free_buffer(TokenBuffer *buf) {
-    free(buf->tokens);
+    if (!buf->arena) {
+        free(buf->tokens);
+        free(buf->values);
+    }
     buf->tokens = NULL;
     buf->size = 0;
     buf->capacity = 0;
     
-    free(buf->values);
     buf->values = NULL;
     buf->values_size = 0;
     buf->values_capacity = 0;
+    buf->arena = NULL;
 }
 
 /* Adiciona token ao buffer (com realocação se necessário) */
 int parser_add_token(TokenBuffer *buf, Token token) {
     if (buf->size >= buf->capacity) {
-        buf->capacity *= 2;
-        Token *new_tokens = realloc(buf->tokens, buf->capacity * sizeof(Token));
+        Token *new_tokens = crescer(buf, buf->tokens, buf->capacity * sizeof(Token),
+                                    2 * buf->capacity * sizeof(Token));
         if (!new_tokens) return 0;
         buf->tokens = new_tokens;
+        buf->capacity *= 2;
     }
     buf->tokens[buf->size++] = token;
     return 1;
 }
 
+/* Copia um buffer (tokens + valores) para um novo buffer do mesmo tamanho */
+int parser_copy_buffer(const TokenBuffer *src, TokenBuffer *dst) {
+    dst->arena = NULL;
+    dst->size = src->size;
+    dst->capacity = src->size > 0 ? src->size : 1;
+    dst->tokens = malloc(dst->capacity * sizeof(Token));
+    
+    dst->values_size = src->values_size;
+    dst->values_capacity = src->values_size > 0 ? src->values_size : 1;
+    dst->values = malloc(dst->values_capacity * sizeof(double));
+    
+    if (!dst->tokens || !dst->values) {
+        parser_free_buffer(dst);
+        return 0;
+    }
+    
+    memcpy(dst->tokens, src->tokens, src->size * sizeof(Token));
+    memcpy(dst->values, src->values, src->values_size * sizeof(double));
+    return 1;
+}
+
 /* Adiciona valor numérico ao buffer e retorna o índice */
-static int parser_add_value(TokenBuffer *buf, double value) {
+int parser_add_value(TokenBuffer *buf, double value) {
     if (buf->values_size >= buf->values_capacity) {
-        buf->values_capacity *= 2;
-        double *new_values = realloc(buf->values, buf->values_capacity * sizeof(double));
+        double *new_values = crescer(buf, buf->values, buf->values_capacity * sizeof(double),
+                                     2 * buf->values_capacity * sizeof(double));
         if (!new_values) return -1;
         buf->values = new_values;
+        buf->values_capacity *= 2;
     }
     buf->values[buf->values_size] = value;
     return buf->values_size++;
 }
 
-/* Tenta fazer parse de um número */
+/* ========================================================================
+ * Números: leitura decimal sem locale e com arredondamento correto
+ * ======================================================================== */
+
+/* Dígitos significativos acumulados em 64 bits (10^19 < 2^64) */
+#define NUMERO_DIGITOS_RAPIDOS 19
+
+/* Limite de dígitos significativos do caminho exato: o resto só importa
+ * como "sobrou algo diferente de zero" (mesmo critério de strtod) */
+#define NUMERO_DIGITOS_MAX 780
+
+/* Inteiro grande (limbs de 32 bits, menos significativo primeiro), só com
+ * o necessário para comparar D * 10^e com o ponto médio entre dois doubles:
+ * até ~780 dígitos, 10^1110 e 2^1075 (cerca de 3900 bits) */
+#define BIGNUM_LIMBS 160
+
+typedef struct {
+    uint32_t limb[BIGNUM_LIMBS];
+    int n;
+} Bignum;
+
+static void bignum_set(Bignum *b, uint64_t v) {
+    b->n = 0;
+    while (v) {
+        b->limb[b->n++] = (uint32_t)v;
+        v >>= 32;
+    }
+}
+
+/* b = b * m + a */
+static void bignum_mul_add(Bignum *b, uint32_t m, uint32_t a) {
+    uint64_t carry = a;
+    for (int i = 0; i < b->n; i++) {
+        uint64_t p = (uint64_t)b->limb[i] * m + carry;
+        b->limb[i] = (uint32_t)p;
+        carry = p >> 32;
+    }
+    if (carry && b->n < BIGNUM_LIMBS) b->limb[b->n++] = (uint32_t)carry;
+}
+
+static void bignum_mul_pow10(Bignum *b, int e) {
+    static const uint32_t pot[10] = { 1, 10, 100, 1000, 10000, 100000, 1000000,
+                                      10000000, 100000000, 1000000000 };
+    for (; e >= 9; e -= 9) bignum_mul_add(b, pot[9], 0);
+    if (e > 0) bignum_mul_add(b, pot[e], 0);
+}
+
+static void bignum_shl(Bignum *b, int bits) {
+    if (b->n == 0) return;
+    int words = bits / 32, r = bits % 32;
+    int n = b->n + words + 1;
+    if (n > BIGNUM_LIMBS) n = BIGNUM_LIMBS;
+    for (int i = n - 1; i >= 0; i--) {
+        int src = i - words;
+        uint32_t hi = (src >= 0 && src < b->n) ? b->limb[src] : 0;
+        uint32_t lo = (src - 1 >= 0 && src - 1 < b->n) ? b->limb[src - 1] : 0;
+        b->limb[i] = r ? (hi << r) | (lo >> (32 - r)) : hi;
+    }
+    b->n = n;
+    while (b->n > 0 && b->limb[b->n - 1] == 0) b->n--;
+}
+
+static int bignum_cmp(const Bignum *a, const Bignum *b) {
+    if (a->n != b->n) return a->n < b->n ? -1 : 1;
+    for (int i = a->n - 1; i >= 0; i--) {
+        if (a->limb[i] != b->limb[i]) return a->limb[i] < b->limb[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+/* Dígitos de um número já delimitado: [ini, fim) com no máximo uma marca
+ * decimal, lidos direto da entrada (sem cópia) */
+typedef struct {
+    const char *ini;
+    const char *fim;
+    char marca;
+} Digitos;
+
+/* Compara D * 10^e com o ponto médio entre x (finito, >= 0) e o double
+ * seguinte. D são os `ndig` dígitos significativos a partir de `p`; com
+ * `resto` (dígitos descartados não nulos), D ganha um 1 no fim. */
+static int comparar_meio(const Digitos *d, const char *p, int ndig, int resto, int e, double x) {
+    Bignum esq, dir;
+    bignum_set(&esq, 0);
+    for (int k = 0; k < ndig; p++) {
+        if (*p == d->marca) continue;
+        bignum_mul_add(&esq, 10, (uint32_t)(*p - '0'));
+        k++;
+    }
+    if (resto) {
+        bignum_mul_add(&esq, 10, 1);
+        e--;
+    }
+    
+    // x = M * 2^Q; ponto médio = (2M + 1) * 2^(Q-1)
+    int q;
+    double f = frexp(x, &q);            /* x = f * 2^q, 0.5 <= f < 1 */
+    uint64_t m = (uint64_t)ldexp(f, 53);
+    q -= 53;
+    if (x == 0 || q < -1074) {          /* subnormais: expoente fixo */
+        m = (uint64_t)ldexp(x, 1074);
+        q = -1074;
+    }
+    bignum_set(&dir, 2 * m + 1);
+    
+    if (e >= 0) bignum_mul_pow10(&esq, e);
+    else bignum_mul_pow10(&dir, -e);
+    if (q - 1 >= 0) bignum_shl(&dir, q - 1);
+    else bignum_shl(&esq, 1 - q);
+    return bignum_cmp(&esq, &dir);
+}
+
+static int mantissa_impar(double x) {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return (int)(bits & 1);
+}
+
+/* Converte os dígitos em double com arredondamento correto (ao par) */
+static double converter_digitos(const Digitos *d) {
+    // Pula zeros à esquerda; e10 = expoente decimal do último dígito lido
+    const char *p = d->ini;
+    int depois_marca = 0, e10 = 0;
+    while (p < d->fim && (*p == '0' || *p == d->marca)) {
+        if (*p == d->marca) depois_marca = 1;
+        else if (depois_marca) e10--;
+        p++;
+    }
+    const char *primeiro = p;
+    
+    uint64_t m = 0;
+    int ndig = 0, resto = 0;
+    for (; p < d->fim; p++) {
+        if (*p == d->marca) {
+            depois_marca = 1;
+            continue;
+        }
+        int dig = *p - '0';
+        if (ndig >= NUMERO_DIGITOS_MAX) {   /* fora de D: só importa se não é zero */
+            if (dig) resto = 1;
+            if (!depois_marca) e10++;
+            continue;
+        }
+        if (ndig < NUMERO_DIGITOS_RAPIDOS) m = m * 10 + dig;
+        if (depois_marca) e10--;
+        ndig++;
+    }
+    if (ndig == 0) return 0.0;
+    int e = e10;                            /* valor = D * 10^e */
+    
+    // Caminho rápido (Clinger): D e 10^|e| exatos em double, uma operação
+    static const double pot10[23] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    if (ndig <= NUMERO_DIGITOS_RAPIDOS && !resto && m <= (1ULL << 53) && e >= -22 && e <= 22) {
+        return e < 0 ? (double)m / pot10[-e] : (double)m * pot10[e];
+    }
+    
+    // Magnitude fora do alcance de double
+    int magnitude = ndig + e;               /* valor < 10^magnitude */
+    if (magnitude > 310) return HUGE_VAL;
+    if (magnitude < -325) return 0.0;
+    
+    // Aproximação com os primeiros dígitos e correção ulp a ulp por
+    // comparação exata com os pontos médios
+    int usados = ndig < NUMERO_DIGITOS_RAPIDOS ? ndig : NUMERO_DIGITOS_RAPIDOS;
+    int ex = e + (ndig - usados);
+    double x = (double)m;
+    if (ex < -300) x = x * pow(10.0, ex + 300) * 1e-300;
+    else x *= pow(10.0, ex);
+    if (isinf(x)) x = DBL_MAX;
+    
+    for (;;) {
+        int c = comparar_meio(d, primeiro, ndig, resto, e, x);
+        if (c > 0 || (c == 0 && mantissa_impar(x))) {
+            if (x == DBL_MAX) return HUGE_VAL;
+            x = nextafter(x, HUGE_VAL);
+            continue;
+        }
+        if (x > 0) {
+            double antes = nextafter(x, 0.0);
+            c = comparar_meio(d, primeiro, ndig, resto, e, antes);
+            if (c < 0 || (c == 0 && !mantissa_impar(antes))) {
+                x = antes;
+                continue;
+            }
+        }
+        return x;
+    }
+}
+
+/* Tenta fazer parse de um número: dígitos com no máximo uma marca decimal
+ * do locale do parser, lidos na própria string */
 static int try_parse_number(const char *str, int *pos, double *value) {
-    char buffer[64];  /* Buffer para normalizar marca decimal */
-    const char *src = str + *pos;
-    char *dst = buffer;
-    char dec_mark = (parser_locale == LOCALE_COMMA) ? ',' : '.';
+    Digitos d;
+    d.marca = (parser_locale == LOCALE_COMMA) ? ',' : '.';
+    d.ini = str + *pos;
+    const char *p = d.ini;
     int has_decimal = 0;
     int digit_count = 0;
     
-    /* Copia dígitos normalizando marca decimal para ponto (padrão C) */
-    while (dst - buffer < (int)sizeof(buffer) - 2 && 
-           (isdigit(*src) || (*src == dec_mark && !has_decimal))) {
-        
-        if (*src == dec_mark) {
-            *dst++ = '.';  /* Normaliza para ponto */
-            has_decimal = 1;
-            src++;
-        } else {
-            *dst++ = *src++;
-            digit_count++;
-        }
+    while ((*p >= '0' && *p <= '9') || (*p == d.marca && !has_decimal)) {
+        if (*p == d.marca) has_decimal = 1;
+        else digit_count++;
+        p++;
     }
-    *dst = '\0';
     
     /* Precisa ter pelo menos um dígito */
     if (digit_count == 0) {
         return 0;
     }
     
-    char *endptr;
-    double num = strtod(buffer, &endptr);
-    
-    if (endptr == buffer) {
-        return 0;
-    }
-    
-    *value = num;
-    *pos += (endptr - buffer);
-    
+    d.fim = p;
+    *value = converter_digitos(&d);
+    *pos += (int)(p - d.ini);
     return 1;
 }
 
-/* Tenta fazer parse de uma palavra-chave (função, constante, variável) */
+/* ========================================================================
+ * Palavras-chave: hash perfeito
+ * ======================================================================== */
+
+typedef struct {
+    const char *nome;
+    int len;
+    uint8_t token;
+} PalavraChave;
+
+#define PALAVRA_MAX 5
+
+/* Hash perfeito das palavras-chave: primeiro e segundo caracteres, último
+ * e tamanho. Multiplicadores escolhidos por busca exaustiva (os menores sem
+ * colisão em 64 posições); ao acrescentar uma palavra, refazer a busca.
+ * test/tokenizer.c confere a tabela contra a lista de palavras. */
+static unsigned hash_palavra(const char *s, int len) {
+    unsigned c1 = len > 1 ? (unsigned char)s[1] : 0;
+    return ((unsigned char)s[0] + c1 + 17u * (unsigned char)s[len - 1] + 6u * len) & 63;
+}
+
+static const PalavraChave palavras[64] = {
+    [2]  = { "floor", 5, TOKEN_FLOOR },
+    [3]  = { "frac",  4, TOKEN_FRAC },
+    [4]  = { "log",   3, TOKEN_LOG },
+    [7]  = { "cos",   3, TOKEN_COS },
+    [10] = { "acosh", 5, TOKEN_ACOSH },
+    [12] = { "ceil",  4, TOKEN_CEIL },
+    [18] = { "cosh",  4, TOKEN_COSH },
+    [21] = { "tanh",  4, TOKEN_TANH },
+    [26] = { "asinh", 5, TOKEN_ASINH },
+    [27] = { "atanh", 5, TOKEN_ATANH },
+    [28] = { "sinh",  4, TOKEN_SINH },
+    [30] = { "pi",    2, TOKEN_CONST_PI },
+    [31] = { "exp",   3, TOKEN_EXP },
+    [32] = { "e",     1, TOKEN_CONST_E },
+    [41] = { "log10", 5, TOKEN_LOG10 },
+    [43] = { "theta", 5, TOKEN_VARIABLE_THETA },
+    [46] = { "t",     1, TOKEN_VARIABLE_T },
+    [48] = { "sqrt",  4, TOKEN_SQRT },
+    [52] = { "ln",    2, TOKEN_LOG },       /* ln é alias de log (logaritmo natural) */
+    [53] = { "tan",   3, TOKEN_TAN },
+    [54] = { "x",     1, TOKEN_VARIABLE_X },
+    [56] = { "abs",   3, TOKEN_ABS },
+    [58] = { "asin",  4, TOKEN_ASIN },
+    [59] = { "atan",  4, TOKEN_ATAN },
+    [60] = { "sin",   3, TOKEN_SIN },
+    [63] = { "acos",  4, TOKEN_ACOS },
+};
+
+/* Letras e dígitos ASCII (sem depender do locale de <ctype.h>) */
+static int ascii_alnum(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+/* Tenta fazer parse de uma palavra-chave (função, constante, variável): o
+ * identificador inteiro (letras e dígitos) precisa ser uma palavra */
 static TokenType try_parse_keyword(const char *str, int *pos) {
-    #define CHECK_KEYWORD(keyword, token) \
-        if (strncmp(str + *pos, keyword, strlen(keyword)) == 0 && \
-            !isalnum(str[*pos + strlen(keyword)])) { \
-            *pos += strlen(keyword); \
-            return token; \
-        }
+    const char *s = str + *pos;
+    int len = 0;
+    while (len <= PALAVRA_MAX && ascii_alnum(s[len])) len++;
+    if (len == 0 || len > PALAVRA_MAX) return TOKEN_ERROR;
     
-    CHECK_KEYWORD("sin", TOKEN_SIN);
-    CHECK_KEYWORD("cos", TOKEN_COS);
-    CHECK_KEYWORD("tan", TOKEN_TAN);
-    CHECK_KEYWORD("abs", TOKEN_ABS);
-    CHECK_KEYWORD("sqrt", TOKEN_SQRT);
-    CHECK_KEYWORD("exp", TOKEN_EXP);
-    CHECK_KEYWORD("log10", TOKEN_LOG10);
-    CHECK_KEYWORD("log", TOKEN_LOG);
-    CHECK_KEYWORD("ln", TOKEN_LOG);  /* ln é alias de log (logaritmo natural) */
-    CHECK_KEYWORD("sinh", TOKEN_SINH);
-    CHECK_KEYWORD("cosh", TOKEN_COSH);
-    CHECK_KEYWORD("tanh", TOKEN_TANH);
-    CHECK_KEYWORD("asin", TOKEN_ASIN);
-    CHECK_KEYWORD("acos", TOKEN_ACOS);
-    CHECK_KEYWORD("atan", TOKEN_ATAN);
-    CHECK_KEYWORD("asinh", TOKEN_ASINH);
-    CHECK_KEYWORD("acosh", TOKEN_ACOSH);
-    CHECK_KEYWORD("atanh", TOKEN_ATANH);
-    CHECK_KEYWORD("ceil", TOKEN_CEIL);
-    CHECK_KEYWORD("floor", TOKEN_FLOOR);
-    CHECK_KEYWORD("frac", TOKEN_FRAC);
-    CHECK_KEYWORD("pi", TOKEN_CONST_PI);
-    CHECK_KEYWORD("e", TOKEN_CONST_E);
-    CHECK_KEYWORD("theta", TOKEN_VARIABLE_THETA);
-    CHECK_KEYWORD("x", TOKEN_VARIABLE_X);
-    CHECK_KEYWORD("t", TOKEN_VARIABLE_T);
-    
-    #undef CHECK_KEYWORD
-    
-    return TOKEN_ERROR;  /* Palavra-chave desconhecida */
+    const PalavraChave *p = &palavras[hash_palavra(s, len)];
+    if (p->len != len || memcmp(p->nome, s, len) != 0) {
+        return TOKEN_ERROR;  /* Palavra-chave desconhecida */
+    }
+    *pos += len;
+    return (TokenType)p->token;
 }
 
 /* Tokenizador principal */
 ParserError parser_tokenize(const char *expr, TokenBuffer *output) {
+    return parser_tokenize_arena(expr, output, NULL);
+}
+
+ParserError parser_tokenize_arena(const char *expr, TokenBuffer *output, Arena *arena) {
     if (!expr || !output) return PARSER_SYNTAX_ERROR;
     
-    parser_init_buffer(output);
+    parser_init_buffer_arena(output, arena);
+    if (!output->tokens || !output->values) {
+        parser_free_buffer(output);
+        return PARSER_MEMORY_ERROR;
+    }
     
     int i = 0;
     while (expr[i] != '\0') {
@@ -404,25 +657,39 @@ static int is_constant(TokenType type) {
 
 /* Algoritmo Shunting Yard - Converte infixa para RPN */
 ParserError parser_to_rpn(TokenBuffer *tokens, TokenBuffer *rpn) {
+    return parser_to_rpn_arena(tokens, rpn, NULL);
+}
+
+/* Pilha de operadores na pilha de C até este tamanho (sem malloc) */
+#define RPN_STACK_LOCAL 128
+
+ParserError parser_to_rpn_arena(TokenBuffer *tokens, TokenBuffer *rpn, Arena *arena) {
     if (!tokens || !rpn) return PARSER_SYNTAX_ERROR;
     
-    parser_init_buffer(rpn);
+    parser_init_buffer_arena(rpn, arena);
+    if (!rpn->tokens || !rpn->values) {
+        parser_free_buffer(rpn);
+        return PARSER_MEMORY_ERROR;
+    }
     
     /* Copia o array de valores (compartilhado entre tokens e rpn) */
-    if (tokens->values_size > 0) {
-        rpn->values = malloc(tokens->values_size * sizeof(double));
-        if (!rpn->values) {
+    for (int i = 0; i < tokens->values_size; i++) {
+        if (parser_add_value(rpn, tokens->values[i]) < 0) {
             parser_free_buffer(rpn);
             return PARSER_MEMORY_ERROR;
         }
-        memcpy(rpn->values, tokens->values, tokens->values_size * sizeof(double));
-        rpn->values_size = tokens->values_size;
-        rpn->values_capacity = tokens->values_size;
     }
     
     /* Pilha de operadores */
-    Token *stack = malloc(tokens->size * sizeof(Token));
-    if (!stack) return PARSER_MEMORY_ERROR;
+    Token pilha_local[RPN_STACK_LOCAL];
+    Token *stack = pilha_local;
+    if (tokens->size > RPN_STACK_LOCAL) {
+        stack = malloc(tokens->size * sizeof(Token));
+        if (!stack) {
+            parser_free_buffer(rpn);
+            return PARSER_MEMORY_ERROR;
+        }
+    }
     int stack_top = -1;
     
     /* Processa cada token */
@@ -436,7 +703,7 @@ ParserError parser_to_rpn(TokenBuffer *tokens, TokenBuffer *rpn) {
         /* Números, variáveis e constantes vão direto para a saída */
         if (type == TOKEN_NUMBER || is_variable(type) || is_constant(type)) {
             if (!parser_add_token(rpn, token)) {
-                free(stack);
+                if (stack != pilha_local) free(stack);
                 parser_free_buffer(rpn);
                 return PARSER_MEMORY_ERROR;
             }
@@ -453,7 +720,7 @@ ParserError parser_to_rpn(TokenBuffer *tokens, TokenBuffer *rpn) {
         else if (type == TOKEN_RPAREN) {
             while (stack_top >= 0 && stack[stack_top].type != TOKEN_LPAREN) {
                 if (!parser_add_token(rpn, stack[stack_top--])) {
-                    free(stack);
+                    if (stack != pilha_local) free(stack);
                     parser_free_buffer(rpn);
                     return PARSER_MEMORY_ERROR;
                 }
@@ -465,7 +732,7 @@ ParserError parser_to_rpn(TokenBuffer *tokens, TokenBuffer *rpn) {
             /* Se há uma função no topo, desempilha ela também */
             if (stack_top >= 0 && is_function(stack[stack_top].type)) {
                 if (!parser_add_token(rpn, stack[stack_top--])) {
-                    free(stack);
+                    if (stack != pilha_local) free(stack);
                     parser_free_buffer(rpn);
                     return PARSER_MEMORY_ERROR;
                 }
@@ -489,7 +756,7 @@ ParserError parser_to_rpn(TokenBuffer *tokens, TokenBuffer *rpn) {
                 }
                 
                 if (!parser_add_token(rpn, stack[stack_top--])) {
-                    free(stack);
+                    if (stack != pilha_local) free(stack);
                     parser_free_buffer(rpn);
                     return PARSER_MEMORY_ERROR;
                 }
@@ -502,7 +769,7 @@ ParserError parser_to_rpn(TokenBuffer *tokens, TokenBuffer *rpn) {
     /* Desempilha todos os operadores restantes */
     while (stack_top >= 0) {
         if (!parser_add_token(rpn, stack[stack_top--])) {
-            free(stack);
+            if (stack != pilha_local) free(stack);
             parser_free_buffer(rpn);
             return PARSER_MEMORY_ERROR;
         }
@@ -511,11 +778,182 @@ ParserError parser_to_rpn(TokenBuffer *tokens, TokenBuffer *rpn) {
     /* Adiciona token de fim */
     Token end_token = {TOKEN_END, 0};
     if (!parser_add_token(rpn, end_token)) {
-        free(stack);
+        if (stack != pilha_local) free(stack);
         parser_free_buffer(rpn);
         return PARSER_MEMORY_ERROR;
     }
     
-    free(stack);
+    if (stack != pilha_local) free(stack);
     return PARSER_OK;
 }
+
+/* ========================================================================
+ * Compilação em uma passada: tokenização, validação e Shunting Yard juntos
+ * ======================================================================== */
+
+/* Estado do compilador: a pilha de operadores e o que as validações de
+ * parser_tokenize acumulam ao longo da expressão */
+typedef struct {
+    TokenBuffer *rpn;
+    Token *stack;
+    int stack_top;
+    int stack_capacity;
+    Token *stack_local;     /* pilha inicial (na pilha de C) */
+    TokenType prev;         /* último token emitido (TOKEN_END: nenhum) */
+    TokenType var;          /* variável da expressão (TOKEN_END: nenhuma) */
+    int mixed_vars;
+    int paren_depth;
+    int paren_error;        /* ')' sem '(' correspondente */
+} Compilador;
+
+static int compilador_push(Compilador *c, Token token) {
+    if (c->stack_top + 1 >= c->stack_capacity) {
+        int capacity = 2 * c->stack_capacity;
+        Token *stack = malloc(capacity * sizeof(Token));
+        if (!stack) return 0;
+        memcpy(stack, c->stack, (c->stack_top + 1) * sizeof(Token));
+        if (c->stack != c->stack_local) free(c->stack);
+        c->stack = stack;
+        c->stack_capacity = capacity;
+    }
+    c->stack[++c->stack_top] = token;
+    return 1;
+}
+
+/* Um passo do Shunting Yard (mesmas regras de parser_to_rpn) e das
+ * validações. Retorna 0 sem memória. */
+static int compilador_emit(Compilador *c, Token token) {
+    TokenType type = token.type;
+    c->prev = type;
+    
+    if (type == TOKEN_NUMBER || is_variable(type) || is_constant(type)) {
+        if (is_variable(type)) {
+            if (c->var == TOKEN_END) c->var = type;
+            else if (c->var != type) c->mixed_vars = 1;
+        }
+        return parser_add_token(c->rpn, token);
+    }
+    
+    if (is_function(type)) return compilador_push(c, token);
+    
+    if (type == TOKEN_LPAREN) {
+        c->paren_depth++;
+        return compilador_push(c, token);
+    }
+    
+    if (type == TOKEN_RPAREN) {
+        if (--c->paren_depth < 0) c->paren_error = 1;
+        while (c->stack_top >= 0 && c->stack[c->stack_top].type != TOKEN_LPAREN) {
+            if (!parser_add_token(c->rpn, c->stack[c->stack_top--])) return 0;
+        }
+        if (c->stack_top >= 0) c->stack_top--;
+        if (c->stack_top >= 0 && is_function(c->stack[c->stack_top].type)) {
+            if (!parser_add_token(c->rpn, c->stack[c->stack_top--])) return 0;
+        }
+        return 1;
+    }
+    
+    /* Operadores: ^ e a negação são associativos à direita */
+    int prec = get_precedence(type);
+    while (c->stack_top >= 0 && is_operator(c->stack[c->stack_top].type)) {
+        int stack_prec = get_precedence(c->stack[c->stack_top].type);
+        if (type == TOKEN_POW || type == TOKEN_NEG) {
+            if (stack_prec <= prec) break;
+        } else {
+            if (stack_prec < prec) break;
+        }
+        if (!parser_add_token(c->rpn, c->stack[c->stack_top--])) return 0;
+    }
+    return compilador_push(c, token);
+}
+
+/* '+' e '-' são unários no início e depois de '(' ou de um operador */
+static int compilador_unario(const Compilador *c) {
+    TokenType prev = c->prev;
+    return prev == TOKEN_END || prev == TOKEN_LPAREN || prev == TOKEN_PLUS ||
+           prev == TOKEN_MINUS || prev == TOKEN_MULT || prev == TOKEN_DIV ||
+           prev == TOKEN_POW || prev == TOKEN_NEG;
+}
+
+ParserError parser_compile(const char *expr, TokenBuffer *rpn) {
+    return parser_compile_arena(expr, rpn, NULL);
+}
+
+ParserError parser_compile_arena(const char *expr, TokenBuffer *rpn, Arena *arena) {
+    if (!expr || !rpn) return PARSER_SYNTAX_ERROR;
+    
+    parser_init_buffer_arena(rpn, arena);
+    if (!rpn->tokens || !rpn->values) {
+        parser_free_buffer(rpn);
+        return PARSER_MEMORY_ERROR;
+    }
+    
+    Token pilha_local[RPN_STACK_LOCAL];
+    Compilador c = { rpn, pilha_local, -1, RPN_STACK_LOCAL, pilha_local,
+                     TOKEN_END, TOKEN_END, 0, 0, 0 };
+    char dec_mark = (parser_locale == LOCALE_COMMA) ? ',' : '.';
+    ParserError err = PARSER_OK;
+    
+    int i = 0;
+    while (expr[i] != '\0' && err == PARSER_OK) {
+        if (isspace(expr[i])) {
+            i++;
+            continue;
+        }
+        
+        Token token = {0};
+        
+        if (isdigit(expr[i]) || (expr[i] == dec_mark && isdigit(expr[i+1]))) {
+            double value;
+            if (try_parse_number(expr, &i, &value)) {
+                int value_idx = parser_add_value(rpn, value);
+                token.type = TOKEN_NUMBER;
+                token.value_index = (uint16_t)value_idx;
+                if (value_idx < 0 || !compilador_emit(&c, token)) err = PARSER_MEMORY_ERROR;
+                continue;
+            }
+        }
+        
+        if (isalpha(expr[i])) {
+            token.type = try_parse_keyword(expr, &i);
+            if (token.type == TOKEN_ERROR) err = PARSER_UNKNOWN_FUNCTION;
+            else if (!compilador_emit(&c, token)) err = PARSER_MEMORY_ERROR;
+            continue;
+        }
+        
+        switch (expr[i]) {
+            case '+':
+                if (!compilador_unario(&c)) token.type = TOKEN_PLUS;
+                break;
+            case '-':
+                token.type = compilador_unario(&c) ? TOKEN_NEG : TOKEN_MINUS;
+                break;
+            case '*': case '/': case '^':
+            case '(': case ')':
+                token.type = (TokenType)expr[i];
+                break;
+            default:
+                err = PARSER_SYNTAX_ERROR;
+                continue;
+        }
+        i++;
+        
+        /* '+' unário não gera token */
+        if (token.type && !compilador_emit(&c, token)) err = PARSER_MEMORY_ERROR;
+    }
+    
+    /* Mesma ordem de erros de parser_tokenize: caracteres, variáveis, parênteses */
+    if (err == PARSER_OK && c.mixed_vars) err = PARSER_MIXED_VARIABLES;
+    if (err == PARSER_OK && (c.paren_error || c.paren_depth != 0)) err = PARSER_SYNTAX_ERROR;
+    
+    while (err == PARSER_OK && c.stack_top >= 0) {
+        if (!parser_add_token(rpn, c.stack[c.stack_top--])) err = PARSER_MEMORY_ERROR;
+    }
+    
+    Token end_token = {TOKEN_END, 0};
+    if (err == PARSER_OK && !parser_add_token(rpn, end_token)) err = PARSER_MEMORY_ERROR;
+    
+    if (c.stack != pilha_local) free(c.stack);
+    if (err != PARSER_OK) parser_free_buffer(rpn);
+    return err;
+}
@@ -0,0 +1,354 @@
+/* Formato binário colunar de PlotData (ver plotbin.h) */
+#define _POSIX_C_SOURCE 200809L  /* mmap, fstat */
+#include "../include/plotbin.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Doubles por bloco ao escrever uma coluna */
+#define PLOTBIN_BLOCK 1024
+
+static int host_little_endian(void) {
+    const uint16_t um = 1;
+    return *(const uint8_t *)&um == 1;
+}
+
+static uint64_t alinhar(uint64_t v) {
+    return (v + PLOTBIN_ALIGN - 1) / PLOTBIN_ALIGN * PLOTBIN_ALIGN;
+}
+
+/* Grava/lê inteiros e doubles little-endian byte a byte */
+static void put_u32(uint8_t *p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static void put_u64(uint8_t *p, uint64_t v) {
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static void put_f64(uint8_t *p, double v) {
+    uint64_t u;
+    memcpy(&u, &v, sizeof(u));
+    put_u64(p, u);
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; i--) v = (v << 8) | p[i];
+    return v;
+}
+
+static uint64_t get_u64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) v = (v << 8) | p[i];
+    return v;
+}
+
+static double get_f64(const uint8_t *p) {
+    uint64_t u = get_u64(p);
+    double v;
+    memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+/* Destino de plotbin_write_sink: blocos entregues com outsink_write ou,
+ * em memória/mmap, o espaço já reservado no próprio sink */
+typedef struct {
+    OutSink *sink;
+    uint8_t *direto;        /* próxima posição no sink (NULL: blocos) */
+    uint8_t bloco[PLOTBIN_BLOCK * 8];
+} Saida;
+
+/* Onde escrever os próximos (até PLOTBIN_BLOCK * 8) bytes */
+static uint8_t *saida_bloco(Saida *s) {
+    return s->direto ? s->direto : s->bloco;
+}
+
+/* Entrega os n bytes escritos em saida_bloco */
+static int saida_entregar(Saida *s, size_t n) {
+    if (!s->direto) return outsink_write(s->sink, s->bloco, n);
+    s->direto += n;
+    s->sink->len += n;
+    return 1;
+}
+
+static int escrever_zeros(Saida *out, uint64_t n) {
+    if (n == 0) return 1;
+    memset(saida_bloco(out), 0, n);
+    return saida_entregar(out, n);
+}
+
+/* Coluna de doubles (x se `coluna` == 0, senão y) com uma linha por
+ * amostra: o ponto válido seguinte ou NaN nas amostras inválidas */
+static int escrever_coluna(Saida *out, const PlotData *data, int coluna) {
+    uint8_t *bloco = saida_bloco(out);
+    int n = 0, j = 0;
+    for (int s = 0; s < data->samples; s++) {
+        double v = NAN;
+        if (plot_data_sample_ok(data, s)) {
+            v = coluna == 0 ? plot_data_x(data, j) : plot_data_y(data, j);
+            j++;
+        }
+        if (host_little_endian()) {
+            memcpy(bloco + 8 * n, &v, 8);
+        } else {
+            put_f64(bloco + 8 * n, v);
+        }
+        if (++n == PLOTBIN_BLOCK) {
+            if (!saida_entregar(out, 8 * (size_t)n)) return 0;
+            bloco = saida_bloco(out);
+            n = 0;
+        }
+    }
+    return n == 0 || saida_entregar(out, 8 * (size_t)n);
+}
+
+/* Offsets das colunas para `samples` linhas */
+static void offsets(uint64_t samples, uint64_t *x_offset, uint64_t *y_offset,
+                    uint64_t *status_offset) {
+    *x_offset = PLOTBIN_HEADER_SIZE;
+    *y_offset = alinhar(*x_offset + 8 * samples);
+    *status_offset = alinhar(*y_offset + 8 * samples);
+}
+
+static void montar_cabecalho(uint8_t *h, const Plot *plot, uint64_t samples, uint64_t count) {
+    double C, D;
+    plot_get_interval(plot, &C, &D);
+    uint64_t x_offset, y_offset, status_offset;
+    offsets(samples, &x_offset, &y_offset, &status_offset);
+
+    memset(h, 0, PLOTBIN_HEADER_SIZE);
+    memcpy(h, PLOTBIN_MAGIC, sizeof(PLOTBIN_MAGIC));
+    put_u32(h + 8, PLOTBIN_VERSION);
+    put_u32(h + 12, PLOTBIN_HEADER_SIZE);
+    put_u32(h + 16, (uint32_t)plot->type);
+    put_u32(h + 20, 0);
+    put_f64(h + 24, C);
+    put_f64(h + 32, D);
+    put_u64(h + 40, samples);
+    put_u64(h + 48, count);
+    put_u64(h + 56, x_offset);
+    put_u64(h + 64, y_offset);
+    put_u64(h + 72, status_offset);
+}
+
+int plotbin_write_sink(OutSink *sink, const Plot *plot, const PlotData *data) {
+    if (!sink || !plot || !data || !data->valid) return 0;
+
+    uint64_t samples = (uint64_t)data->samples;
+    uint64_t x_offset, y_offset, status_offset;
+    offsets(samples, &x_offset, &y_offset, &status_offset);
+    Saida out;
+    out.sink = sink;
+    out.direto = NULL;
+    if (sink->kind == OUTSINK_MEMORY || sink->kind == OUTSINK_MMAP) {
+        out.direto = (uint8_t *)outsink_reserve(sink, status_offset + samples);
+        if (!out.direto) return 0;
+    }
+    montar_cabecalho(saida_bloco(&out), plot, samples, (uint64_t)data->count);
+    if (!saida_entregar(&out, PLOTBIN_HEADER_SIZE)) return 0;
+
+    if (!escrever_coluna(&out, data, 0)) return 0;
+    if (!escrever_zeros(&out, y_offset - (x_offset + 8 * samples))) return 0;
+    if (!escrever_coluna(&out, data, 1)) return 0;
+    if (!escrever_zeros(&out, status_offset - (y_offset + 8 * samples))) return 0;
+
+    uint8_t *bloco = saida_bloco(&out);
+    int n = 0;
+    for (int s = 0; s < data->samples; s++) {
+        bloco[n++] = plot_data_sample_ok(data, s) ? 0 : 1;
+        if (n == PLOTBIN_BLOCK) {
+            if (!saida_entregar(&out, n)) return 0;
+            bloco = saida_bloco(&out);
+            n = 0;
+        }
+    }
+    return n == 0 || saida_entregar(&out, n);
+}
+
+int plotbin_write(FILE *out, const Plot *plot, const PlotData *data) {
+    if (!out) return 0;
+    OutSink sink;
+    outsink_file(&sink, out);
+    return plotbin_write_sink(&sink, plot, data) && outsink_finish(&sink);
+}
+
+/* pwrite completo (repete em escritas parciais) */
+static int gravar_em(int fd, const void *buf, size_t n, uint64_t pos) {
+    const uint8_t *p = buf;
+    while (n > 0) {
+        ssize_t w = pwrite(fd, p, n, (off_t)pos);
+        if (w <= 0) return 0;
+        p += w;
+        n -= (size_t)w;
+        pos += (uint64_t)w;
+    }
+    return 1;
+}
+
+/* Coluna de doubles do bloco em little-endian (conversão só em big-endian) */
+static int gravar_doubles(int fd, const double *v, int n, uint64_t pos) {
+    if (host_little_endian()) return gravar_em(fd, v, (size_t)n * 8, pos);
+    uint8_t bloco[PLOTBIN_BLOCK * 8];
+    for (int i = 0; i < n; i += PLOTBIN_BLOCK) {
+        int len = n - i < PLOTBIN_BLOCK ? n - i : PLOTBIN_BLOCK;
+        for (int j = 0; j < len; j++) put_f64(bloco + 8 * j, v[i + j]);
+        if (!gravar_em(fd, bloco, (size_t)len * 8, pos + 8 * (uint64_t)i)) return 0;
+    }
+    return 1;
+}
+
+int plotbin_write_stream(int fd, const Plot *plot, PlotSampler *sampler) {
+    if (fd < 0 || !plot || !sampler) return 0;
+
+    // Precisa de um arquivo comum, sem O_APPEND (pwrite em posições fixas)
+    struct stat st;
+    int flags = fcntl(fd, F_GETFL);
+    off_t inicio = lseek(fd, 0, SEEK_CUR);
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || flags < 0 ||
+        (flags & O_APPEND) || inicio < 0) {
+        return -1;
+    }
+    uint64_t base = (uint64_t)inicio;
+
+    uint64_t samples = plot_sampler_samples(sampler);
+    uint64_t x_offset, y_offset, status_offset;
+    offsets(samples, &x_offset, &y_offset, &status_offset);
+    uint8_t h[PLOTBIN_HEADER_SIZE];
+    montar_cabecalho(h, plot, samples, 0);
+    if (!gravar_em(fd, h, sizeof(h), base)) return 0;
+
+    // Cada bloco vai direto para a sua posição nas três colunas
+    uint8_t estados[PLOTBIN_BLOCK];
+    uint64_t count = 0;
+    PlotChunk chunk;
+    while (plot_sampler_next(sampler, &chunk)) {
+        uint64_t linha = chunk.first;
+        if (!gravar_doubles(fd, chunk.x, chunk.n, base + x_offset + 8 * linha)) return 0;
+        if (!gravar_doubles(fd, chunk.y, chunk.n, base + y_offset + 8 * linha)) return 0;
+        for (int i = 0; i < chunk.n; i += PLOTBIN_BLOCK) {
+            int len = chunk.n - i < PLOTBIN_BLOCK ? chunk.n - i : PLOTBIN_BLOCK;
+            for (int j = 0; j < len; j++) estados[j] = chunk.status[i + j] ? 1 : 0;
+            if (!gravar_em(fd, estados, len, base + status_offset + linha + i)) return 0;
+        }
+        count += (uint64_t)chunk.count;
+    }
+
+    // Cabeçalho final com o número de válidas; preenchimento entre as
+    // colunas fica como buraco (zeros) no arquivo
+    montar_cabecalho(h, plot, samples, count);
+    if (!gravar_em(fd, h, sizeof(h), base)) return 0;
+    uint64_t fim = base + status_offset + samples;
+    if (ftruncate(fd, (off_t)fim) != 0) return 0;
+    return lseek(fd, (off_t)fim, SEEK_SET) >= 0;
+}
+
+static PlotBinFile *falhar(PlotBinFile *f, char **errmsg, const char *msg) {
+    if (errmsg) *errmsg = strdup(msg);
+    plotbin_close(f);
+    return NULL;
+}
+
+/* Coluna [offset, offset + bytes) dentro do arquivo e alinhada */
+static int coluna_valida(uint64_t offset, uint64_t bytes, uint64_t size) {
+    return offset >= PLOTBIN_HEADER_SIZE && offset % 8 == 0 &&
+           offset <= size && bytes <= size - offset;
+}
+
+PlotBinFile *plotbin_open(const char *path, char **errmsg) {
+    if (errmsg) *errmsg = NULL;
+    PlotBinFile *f = calloc(1, sizeof(PlotBinFile));
+    if (!f) return falhar(NULL, errmsg, "memória insuficiente");
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return falhar(f, errmsg, "não foi possível abrir o arquivo");
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < PLOTBIN_HEADER_SIZE) {
+        close(fd);
+        return falhar(f, errmsg, "arquivo menor que o cabeçalho");
+    }
+    f->size = (size_t)st.st_size;
+    void *map = mmap(NULL, f->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return falhar(f, errmsg, "não foi possível mapear o arquivo");
+    f->map = map;
+    f->mapped = 1;
+
+    const uint8_t *h = map;
+    if (memcmp(h, PLOTBIN_MAGIC, sizeof(PLOTBIN_MAGIC)) != 0) {
+        return falhar(f, errmsg, "não é um arquivo binário do multicurvas");
+    }
+    if (get_u32(h + 8) != PLOTBIN_VERSION) {
+        return falhar(f, errmsg, "versão do formato binário não suportada");
+    }
+    uint32_t header_size = get_u32(h + 12);
+    uint32_t type = get_u32(h + 16);
+    f->C = get_f64(h + 24);
+    f->D = get_f64(h + 32);
+    f->samples = get_u64(h + 40);
+    f->count = get_u64(h + 48);
+    uint64_t x_offset = get_u64(h + 56);
+    uint64_t y_offset = get_u64(h + 64);
+    uint64_t status_offset = get_u64(h + 72);
+
+    if (header_size < PLOTBIN_HEADER_SIZE || type > PLOT_PARAMETRIC ||
+        f->count > f->samples || f->samples > f->size / 8 ||
+        !coluna_valida(x_offset, 8 * f->samples, f->size) ||
+        !coluna_valida(y_offset, 8 * f->samples, f->size) ||
+        !coluna_valida(status_offset, f->samples, f->size)) {
+        return falhar(f, errmsg, "cabeçalho do arquivo binário inválido");
+    }
+    f->type = (PlotType)type;
+
+    if (!host_little_endian()) {
+        // Big-endian: converte as colunas numa cópia
+        size_t bytes = 16 * f->samples + f->samples;
+        uint8_t *copia = malloc(bytes > 0 ? bytes : 1);
+        if (!copia) return falhar(f, errmsg, "memória insuficiente");
+        double *x = (double *)copia;
+        double *y = x + f->samples;
+        for (uint64_t i = 0; i < f->samples; i++) {
+            x[i] = get_f64(h + x_offset + 8 * i);
+            y[i] = get_f64(h + y_offset + 8 * i);
+        }
+        memcpy(copia + 16 * f->samples, h + status_offset, f->samples);
+        munmap(f->map, f->size);
+        f->map = copia;
+        f->mapped = 0;
+        f->x = x;
+        f->y = y;
+        f->status = copia + 16 * f->samples;
+        return f;
+    }
+
+    f->x = (const double *)(h + x_offset);
+    f->y = (const double *)(h + y_offset);
+    f->status = h + status_offset;
+    return f;
+}
+
+void plotbin_close(PlotBinFile *f) {
+    if (!f) return;
+    if (f->map) {
+        if (f->mapped) {
+            munmap(f->map, f->size);
+        } else {
+            free(f->map);
+        }
+    }
+    free(f);
+}
+
+PlotData *plotbin_to_plotdata(const PlotBinFile *f) {
+    if (!f || f->samples > (uint64_t)PLOTBIN_MAX_PLOTDATA) return NULL;
+    int samples = (int)f->samples;
+
+    PlotData *data = plot_data_create(samples, PLOT_FLOAT64, NULL);
+    if (!data) return NULL;
+    for (int s = 0; s < samples; s++) plot_data_append(data, !f->status[s], f->x[s], f->y[s]);
+    return data;
+}
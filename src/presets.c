@@ -0,0 +1,34 @@
+/* Consulta ao catálogo de presets nativos (tabela em presets_gen.c) */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include "presets.h"
+
+const PlotPreset *plot_preset_find(const char *id) {
+    if (!id) return NULL;
+    for (int i = 0; i < plot_presets_count; i++) {
+        if (strcmp(plot_presets[i].id, id) == 0) return &plot_presets[i];
+    }
+    return NULL;
+}
+
+Plot *plot_from_preset(const PlotPreset *preset) {
+    Plot *plot = calloc(1, sizeof(Plot));
+    if (!plot) return NULL;
+
+    plot->type = preset->type;
+    plot->expr1 = strdup(preset->expr1);
+    plot->expr2 = preset->expr2 ? strdup(preset->expr2) : NULL;
+    plot->C = preset->C;
+    plot->D = preset->D;
+    plot->has_interval = preset->has_interval;
+    plot->samples = PLOT_DEFAULT_SAMPLES;
+    plot->native = preset->eval;
+
+    if (!plot->expr1 || (preset->expr2 && !plot->expr2)) {
+        plot_free(plot);
+        return NULL;
+    }
+    return plot;
+}
@@ -0,0 +1,2705 @@
+/* Catálogo de presets nativos (curvas de gerar_77_curvas.sh).
+ * GERADO por `make presets` (multicurvas --emit-presets): não editar. */
+#include "presets.h"
+
+#define MC_LINKAGE static
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef MC_LINKAGE
+#define MC_LINKAGE
+#endif
+
+/* Códigos de EvalError (evaluator.h) */
+#define MC_STACK_ERROR      1
+#define MC_DIVISION_BY_ZERO 2
+#define MC_DOMAIN_ERROR     3
+#define MC_MATH_ERROR       4
+
+/* 1) Função constante: Y=5
+ * saída 0: Y */
+MC_LINKAGE void preset_1(const double *in, double *const *out,
+                         uint8_t *const *status, size_t n) {
+    (void)in;
+    for (size_t i = 0; i < n; i++) {
+        int e0 = 0;
+
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : 0x1.4p+2;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 2) Função valor absoluto: Y=abs(x)
+ * saída 0: Y */
+MC_LINKAGE void preset_2(const double *in, double *const *out,
+                         uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0;
+        int e0 = 0;
+
+        r1 = fabs(v);
+        if (!isfinite(r1)) { e0 = MC_MATH_ERROR; goto fim; }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r1;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 3) Função linear: Y=x/3+2
+ * saída 0: Y */
+MC_LINKAGE void preset_3(const double *in, double *const *out,
+                         uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0;
+        int e0 = 0;
+
+        r3 = v * 0x1.5555555555555p-2;
+        if (!isfinite(r3)) { e0 = MC_MATH_ERROR; goto fim; }
+        r3 = 0x1p+1 + r3;
+        if (!isfinite(r3)) { e0 = MC_MATH_ERROR; goto fim; }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 4) Circunferência: R=6
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_4(const double *in, double *const *out,
+                         uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r3 = sin(u); r2 = cos(u); }
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = 0x1.8p+2 * r2;
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r3 = 0x1.8p+2 * r3;
+        if (!isfinite(r3)) { if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r2;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r3;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 5) Elipse: R=6/(2-sin(t))
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_5(const double *in, double *const *out,
+                         uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r3 = sin(u); r4 = cos(u); }
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r5 = 0x1p+1 - r3;
+        if (!isfinite(r5)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        {
+            const double q = r5;
+            r5 = 0x1.8p+2 / q;
+            if (q == 0.0) { if (2 < b0) { b0 = 2; e0 = MC_DIVISION_BY_ZERO; } if (2 < b1) { b1 = 2; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r5)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        }
+        r4 = r5 * r4;
+        if (!isfinite(r4)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r5 = r3 * r5;
+        if (!isfinite(r5)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r5;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 6) Parábola: Y=x*x
+ * saída 0: Y */
+MC_LINKAGE void preset_6(const double *in, double *const *out,
+                         uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0;
+        int e0 = 0;
+
+        r1 = v * v;
+        if (!isfinite(r1)) { e0 = MC_MATH_ERROR; goto fim; }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r1;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 7) Função fracionária: Y=1/(x*x)
+ * saída 0: Y */
+MC_LINKAGE void preset_7(const double *in, double *const *out,
+                         uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0;
+        int e0 = 0;
+
+        r2 = v * v;
+        if (!isfinite(r2)) { e0 = MC_MATH_ERROR; goto fim; }
+        {
+            const double q = r2;
+            r2 = 0x1p+0 / q;
+            if (q == 0.0) { e0 = MC_DIVISION_BY_ZERO; goto fim; }
+            else if (!isfinite(r2)) { e0 = MC_MATH_ERROR; goto fim; }
+        }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r2;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 8) Parábola cúbica: Y=x*x*x
+ * saída 0: Y */
+MC_LINKAGE void preset_8(const double *in, double *const *out,
+                         uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0;
+        int e0 = 0;
+
+        r1 = v * v;
+        if (!isfinite(r1)) { e0 = MC_MATH_ERROR; goto fim; }
+        r1 = v * r1;
+        if (!isfinite(r1)) { e0 = MC_MATH_ERROR; goto fim; }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r1;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 9) Parábola semicúbica ou de Neil: Y=(x*x)**(1/3)
+ * saída 0: Y */
+MC_LINKAGE void preset_9(const double *in, double *const *out,
+                         uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0;
+        int e0 = 0;
+
+        r1 = v * v;
+        if (!isfinite(r1)) { e0 = MC_MATH_ERROR; goto fim; }
+    fim:
+        if (!e0) e0 = 1;
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : v;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 10) Hipérbole: R=4/(2-3*cos(t))
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_10(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r4 = 0.0, r5 = 0.0, r6 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r5 = sin(u); r4 = cos(u); }
+        if (!isfinite(r5)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r6 = 0x1.8p+1 * r4;
+        if (!isfinite(r6)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r6 = 0x1p+1 - r6;
+        if (!isfinite(r6)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        {
+            const double q = r6;
+            r6 = 0x1p+2 / q;
+            if (q == 0.0) { if (3 < b0) { b0 = 3; e0 = MC_DIVISION_BY_ZERO; } if (3 < b1) { b1 = 3; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r6)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        }
+        r4 = r4 * r6;
+        if (!isfinite(r4)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r5 = r6 * r5;
+        if (!isfinite(r5)) { if (5 < b1) { b1 = 5; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r5;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 11) Hipérbole equilátera: Y=1/x
+ * saída 0: Y */
+MC_LINKAGE void preset_11(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0;
+        int e0 = 0;
+
+        {
+            const double q = v;
+            r2 = 0x1p+0 / q;
+            if (q == 0.0) { e0 = MC_DIVISION_BY_ZERO; goto fim; }
+            else if (!isfinite(r2)) { e0 = MC_MATH_ERROR; goto fim; }
+        }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r2;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 12) Curva exponencial: Y=1.3**x
+ * saída 0: Y */
+MC_LINKAGE void preset_12(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        int e0 = 0;
+
+        if (!e0) e0 = 1;
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : v;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 13) Curva logarítmica: Y=ln(x)
+ * saída 0: Y */
+MC_LINKAGE void preset_13(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0;
+        int e0 = 0;
+
+        if (v <= 0.0) { e0 = MC_DOMAIN_ERROR; goto fim; }
+        r1 = log(v);
+        if (!isfinite(r1)) { e0 = MC_MATH_ERROR; goto fim; }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r1;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 14) Curva de probabilidade ou de Gauss: Y=exp(1)**(-x*x)
+ * saída 0: Y */
+MC_LINKAGE void preset_14(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0;
+        int e0 = 0;
+
+        r2 = exp(0x1p+0);
+        if (!isfinite(r2)) { e0 = MC_MATH_ERROR; goto fim; }
+    fim:
+        if (!e0) e0 = 1;
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : v;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 15) Senóide: Y=sin(x)
+ * saída 0: Y */
+MC_LINKAGE void preset_15(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0;
+        int e0 = 0;
+
+        r1 = sin(v);
+        if (!isfinite(r1)) { e0 = MC_MATH_ERROR; goto fim; }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r1;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 16) Co-senóide: Y=cos(x)
+ * saída 0: Y */
+MC_LINKAGE void preset_16(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0;
+        int e0 = 0;
+
+        r1 = cos(v);
+        if (!isfinite(r1)) { e0 = MC_MATH_ERROR; goto fim; }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r1;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 17) Tangentóide: Y=tan(x)
+ * saída 0: Y */
+MC_LINKAGE void preset_17(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0;
+        int e0 = 0;
+
+        r1 = tan(v);
+        if (!isfinite(r1)) { e0 = MC_MATH_ERROR; goto fim; }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r1;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 18) Secantóide: Y=1/cos(x)
+ * saída 0: Y */
+MC_LINKAGE void preset_18(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0;
+        int e0 = 0;
+
+        r2 = cos(v);
+        if (!isfinite(r2)) { e0 = MC_MATH_ERROR; goto fim; }
+        {
+            const double q = r2;
+            r2 = 0x1p+0 / q;
+            if (q == 0.0) { e0 = MC_DIVISION_BY_ZERO; goto fim; }
+            else if (!isfinite(r2)) { e0 = MC_MATH_ERROR; goto fim; }
+        }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r2;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 19) Inversa da senóide: Y=asin(x)
+ * saída 0: Y */
+MC_LINKAGE void preset_19(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0;
+        int e0 = 0;
+
+        if (v < -1.0 || v > 1.0) { e0 = MC_DOMAIN_ERROR; goto fim; }
+        r1 = asin(v);
+        if (!isfinite(r1)) { e0 = MC_MATH_ERROR; goto fim; }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r1;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 20) Inversa da co-senóide: Y=acos(x)
+ * saída 0: Y */
+MC_LINKAGE void preset_20(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0;
+        int e0 = 0;
+
+        if (v < -1.0 || v > 1.0) { e0 = MC_DOMAIN_ERROR; goto fim; }
+        r1 = acos(v);
+        if (!isfinite(r1)) { e0 = MC_MATH_ERROR; goto fim; }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r1;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 21) Inversa da tangentóide: Y=atan(x)
+ * saída 0: Y */
+MC_LINKAGE void preset_21(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0;
+        int e0 = 0;
+
+        r1 = atan(v);
+        if (!isfinite(r1)) { e0 = MC_MATH_ERROR; goto fim; }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r1;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 22) Ciclóide de cúspide na origem: X=t-sin(t);Y=1-cos(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_22(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r2 = sin(u); r3 = cos(u); }
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = v - r2;
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r3 = 0x1p+0 - r3;
+        if (!isfinite(r3)) { if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r2;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r3;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 23) Ciclóide de vértice na origem: X=t+sin(t);Y=1-cos(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_23(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r2 = sin(u); r3 = cos(u); }
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = v + r2;
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r3 = 0x1p+0 - r3;
+        if (!isfinite(r3)) { if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r2;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r3;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 24) Ciclóide alongada: X=3*t-5*sin(t);Y=3-5*cos(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_24(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r3 = v * 0x1.8p+1;
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r5 = cos(u); }
+        if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r4 = 0x1.4p+2 * r4;
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } }
+        r4 = r3 - r4;
+        if (!isfinite(r4)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r5 = 0x1.4p+2 * r5;
+        if (!isfinite(r5)) { if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r5 = 0x1.8p+1 - r5;
+        if (!isfinite(r5)) { if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r5;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 25) Ciclóide encurtada: X=4*t-3*sin(t);Y=4-3*cos(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_25(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r3 = v * 0x1p+2;
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r5 = cos(u); }
+        if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r4 = 0x1.8p+1 * r4;
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } }
+        r4 = r3 - r4;
+        if (!isfinite(r4)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r5 = 0x1.8p+1 * r5;
+        if (!isfinite(r5)) { if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r5 = 0x1p+2 - r5;
+        if (!isfinite(r5)) { if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r5;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 26) Catenária: Y=(exp(1)**x+exp(1)**-x)/2
+ * saída 0: Y */
+MC_LINKAGE void preset_26(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0;
+        int e0 = 0;
+
+        r2 = exp(0x1p+0);
+        if (!isfinite(r2)) { e0 = MC_MATH_ERROR; goto fim; }
+    fim:
+        if (!e0) e0 = 1;
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : v;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 27) Epiciclóide de 4 cúspides: X=5*cos(t)-cos(5*t);Y=5*sin(t)-sin(5*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_27(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0, r5 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r3 = sin(u); r2 = cos(u); }
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = 0x1.4p+2 * r2;
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r4 = v * 0x1.4p+2;
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        { const double u = r4; r5 = sin(u); r4 = cos(u); }
+        if (!isfinite(r5)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r4 = r2 - r4;
+        if (!isfinite(r4)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r3 = 0x1.4p+2 * r3;
+        if (!isfinite(r3)) { if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r5 = r3 - r5;
+        if (!isfinite(r5)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r5;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 28) Deltóide ou hipociclóide tricúspide: X=2*cos(t)+cos(2*t);Y=2*sin(t)-sin(2*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_28(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0, r5 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r3 = sin(u); r2 = cos(u); }
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = 0x1p+1 * r2;
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r4 = v * 0x1p+1;
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        { const double u = r4; r5 = sin(u); r4 = cos(u); }
+        if (!isfinite(r5)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r4 = r2 + r4;
+        if (!isfinite(r4)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r3 = 0x1p+1 * r3;
+        if (!isfinite(r3)) { if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r5 = r3 - r5;
+        if (!isfinite(r5)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r5;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 29) Astróide ou hipociclóide de 4 cúspides: X=cos(t)*cos(t)*cos(t);Y=sin(t)*sin(t)*sin(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_29(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0, r2 = 0.0, r3 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r2 = sin(u); r1 = cos(u); }
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r3 = r1 * r1;
+        if (!isfinite(r3)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r3 = r1 * r3;
+        if (!isfinite(r3)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } }
+        r1 = r2 * r2;
+        if (!isfinite(r1)) { if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r1 = r2 * r1;
+        if (!isfinite(r1)) { if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r1;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 30) Evolvente da circunferência: X=5*cos(t)+5*t*sin(t);Y=5*sin(t)-5*t*cos(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_30(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0, r5 = 0.0, r6 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r3 = sin(u); r2 = cos(u); }
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r4 = 0x1.4p+2 * r2;
+        if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r5 = v * 0x1.4p+2;
+        if (!isfinite(r5)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r6 = r5 * r3;
+        if (!isfinite(r6)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r6 = r4 + r6;
+        if (!isfinite(r6)) { if (5 < b0) { b0 = 5; e0 = MC_MATH_ERROR; } }
+        r3 = 0x1.4p+2 * r3;
+        if (!isfinite(r3)) { if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r5 = r2 * r5;
+        if (!isfinite(r5)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        r5 = r3 - r5;
+        if (!isfinite(r5)) { if (5 < b1) { b1 = 5; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r6;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r5;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 31) Concóide de reta ou de Nicodemes: R=(2/cos(t))+3
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_31(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        {
+            const double q = r3;
+            r5 = 0x1p+1 / q;
+            if (q == 0.0) { if (1 < b0) { b0 = 1; e0 = MC_DIVISION_BY_ZERO; } if (1 < b1) { b1 = 1; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r5)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        }
+        r5 = 0x1.8p+1 + r5;
+        if (!isfinite(r5)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r3 * r5;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r5 * r4;
+        if (!isfinite(r4)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 32) Cissóide de diocles: R=2*tan(t)*sin(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_32(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = tan(v);
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = 0x1p+1 * r2;
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r3 = sin(u); r4 = cos(u); }
+        if (!isfinite(r3)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r2 = r2 * r3;
+        if (!isfinite(r2)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (5 < b0) { b0 = 5; e0 = MC_MATH_ERROR; } }
+        r2 = r3 * r2;
+        if (!isfinite(r2)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r2;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 33) Estrofóide: R=-3*cos(2*t)/(cos(t))
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_33(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r3 = v * 0x1p+1;
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r3 = cos(r3);
+        if (!isfinite(r3)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r3 = (-0x1.8p+1) * r3;
+        if (!isfinite(r3)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r5 = sin(u); r4 = cos(u); }
+        if (!isfinite(r5)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        {
+            const double q = r4;
+            r3 = r3 / q;
+            if (q == 0.0) { if (4 < b0) { b0 = 4; e0 = MC_DIVISION_BY_ZERO; } if (4 < b1) { b1 = 4; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r3)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        }
+        r4 = r4 * r3;
+        if (!isfinite(r4)) { if (5 < b0) { b0 = 5; e0 = MC_MATH_ERROR; } }
+        r5 = r3 * r5;
+        if (!isfinite(r5)) { if (6 < b1) { b1 = 6; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r5;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 34) Ofiuróide: R=4*sin(t)-(2*sin(t)*sin(t)/cos(t))
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_34(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0, r6 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r3 = sin(u); r4 = cos(u); }
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r5 = 0x1p+2 * r3;
+        if (!isfinite(r5)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r6 = 0x1p+1 * r3;
+        if (!isfinite(r6)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r6 = r3 * r6;
+        if (!isfinite(r6)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        {
+            const double q = r4;
+            r6 = r6 / q;
+            if (q == 0.0) { if (5 < b0) { b0 = 5; e0 = MC_DIVISION_BY_ZERO; } if (5 < b1) { b1 = 5; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r6)) { if (5 < b0) { b0 = 5; e0 = MC_MATH_ERROR; } if (5 < b1) { b1 = 5; e1 = MC_MATH_ERROR; } }
+        }
+        r6 = r5 - r6;
+        if (!isfinite(r6)) { if (6 < b0) { b0 = 6; e0 = MC_MATH_ERROR; } if (6 < b1) { b1 = 6; e1 = MC_MATH_ERROR; } }
+        r4 = r4 * r6;
+        if (!isfinite(r4)) { if (7 < b0) { b0 = 7; e0 = MC_MATH_ERROR; } }
+        r6 = r3 * r6;
+        if (!isfinite(r6)) { if (7 < b1) { b1 = 7; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r6;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 35) Folium de Descartes: R=(6*sin(t)*cos(t))/(sin(t)*sin(t)*sin(t)+cos(t)*cos(t)*cos(t))
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_35(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0, r5 = 0.0, r6 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r2 = sin(u); r3 = cos(u); }
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r4 = 0x1.8p+2 * r2;
+        if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r4 = r4 * r3;
+        if (!isfinite(r4)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r5 = r2 * r2;
+        if (!isfinite(r5)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        r5 = r2 * r5;
+        if (!isfinite(r5)) { if (5 < b0) { b0 = 5; e0 = MC_MATH_ERROR; } if (5 < b1) { b1 = 5; e1 = MC_MATH_ERROR; } }
+        r6 = r3 * r3;
+        if (!isfinite(r6)) { if (6 < b0) { b0 = 6; e0 = MC_MATH_ERROR; } if (6 < b1) { b1 = 6; e1 = MC_MATH_ERROR; } }
+        r6 = r3 * r6;
+        if (!isfinite(r6)) { if (7 < b0) { b0 = 7; e0 = MC_MATH_ERROR; } if (7 < b1) { b1 = 7; e1 = MC_MATH_ERROR; } }
+        r6 = r5 + r6;
+        if (!isfinite(r6)) { if (8 < b0) { b0 = 8; e0 = MC_MATH_ERROR; } if (8 < b1) { b1 = 8; e1 = MC_MATH_ERROR; } }
+        {
+            const double q = r6;
+            r6 = r4 / q;
+            if (q == 0.0) { if (9 < b0) { b0 = 9; e0 = MC_DIVISION_BY_ZERO; } if (9 < b1) { b1 = 9; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r6)) { if (9 < b0) { b0 = 9; e0 = MC_MATH_ERROR; } if (9 < b1) { b1 = 9; e1 = MC_MATH_ERROR; } }
+        }
+        r3 = r3 * r6;
+        if (!isfinite(r3)) { if (10 < b0) { b0 = 10; e0 = MC_MATH_ERROR; } }
+        r6 = r2 * r6;
+        if (!isfinite(r6)) { if (10 < b1) { b1 = 10; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r6;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 36) Trissectriz de Maclaurin: R=4*sin(3*t)/sin(2*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_36(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r4 = 0.0, r5 = 0.0, r6 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r4 = v * 0x1.8p+1;
+        if (!isfinite(r4)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r4 = sin(r4);
+        if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r4 = 0x1p+2 * r4;
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r5 = v * 0x1p+1;
+        if (!isfinite(r5)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r5 = sin(r5);
+        if (!isfinite(r5)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        {
+            const double q = r5;
+            r5 = r4 / q;
+            if (q == 0.0) { if (5 < b0) { b0 = 5; e0 = MC_DIVISION_BY_ZERO; } if (5 < b1) { b1 = 5; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r5)) { if (5 < b0) { b0 = 5; e0 = MC_MATH_ERROR; } if (5 < b1) { b1 = 5; e1 = MC_MATH_ERROR; } }
+        }
+        { const double u = v; r6 = sin(u); r4 = cos(u); }
+        if (!isfinite(r6)) { if (6 < b0) { b0 = 6; e0 = MC_MATH_ERROR; } if (6 < b1) { b1 = 6; e1 = MC_MATH_ERROR; } }
+        r4 = r5 * r4;
+        if (!isfinite(r4)) { if (7 < b0) { b0 = 7; e0 = MC_MATH_ERROR; } }
+        r6 = r5 * r6;
+        if (!isfinite(r6)) { if (7 < b1) { b1 = 7; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r6;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 37) Quadratriz de Hípias ou de Dinóstrato: R=(2*t)/(pi*sin(t))
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_37(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0, r6 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r3 = v * 0x1p+1;
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r5 = cos(u); }
+        if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r6 = 0x1.921fb54442d18p+1 * r4;
+        if (!isfinite(r6)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        {
+            const double q = r6;
+            r6 = r3 / q;
+            if (q == 0.0) { if (3 < b0) { b0 = 3; e0 = MC_DIVISION_BY_ZERO; } if (3 < b1) { b1 = 3; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r6)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        }
+        r5 = r6 * r5;
+        if (!isfinite(r5)) { if (5 < b0) { b0 = 5; e0 = MC_MATH_ERROR; } }
+        r6 = r4 * r6;
+        if (!isfinite(r6)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r5;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r6;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 38) Cruciforme: R=2/sin(2*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_38(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1p+1;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = sin(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        {
+            const double q = r2;
+            r2 = 0x1p+1 / q;
+            if (q == 0.0) { if (2 < b0) { b0 = 2; e0 = MC_DIVISION_BY_ZERO; } if (2 < b1) { b1 = 2; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r2)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 39) Curva de Gutschoven: R=1/tan(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_39(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = tan(v);
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        {
+            const double q = r2;
+            r2 = 0x1p+0 / q;
+            if (q == 0.0) { if (1 < b0) { b0 = 1; e0 = MC_DIVISION_BY_ZERO; } if (1 < b1) { b1 = 1; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 40) Cúbica de Agnesi ou "versiera": Y=8/(4+x*x)
+ * saída 0: Y */
+MC_LINKAGE void preset_40(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0;
+        int e0 = 0;
+
+        r3 = v * v;
+        if (!isfinite(r3)) { e0 = MC_MATH_ERROR; goto fim; }
+        r3 = 0x1p+2 + r3;
+        if (!isfinite(r3)) { e0 = MC_MATH_ERROR; goto fim; }
+        {
+            const double q = r3;
+            r3 = 0x1p+3 / q;
+            if (q == 0.0) { e0 = MC_DIVISION_BY_ZERO; goto fim; }
+            else if (!isfinite(r3)) { e0 = MC_MATH_ERROR; goto fim; }
+        }
+    fim:
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+    }
+}
+
+/* 41) Bifolium: R=5*sin(t)*cos(t)*cos(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_41(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r2 = sin(u); r3 = cos(u); }
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r4 = 0x1.4p+2 * r2;
+        if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r4 = r4 * r3;
+        if (!isfinite(r4)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r4 = r3 * r4;
+        if (!isfinite(r4)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        r3 = r3 * r4;
+        if (!isfinite(r3)) { if (5 < b0) { b0 = 5; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (5 < b1) { b1 = 5; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 42) Lemniscata de Bernoulli: R**2=cos(2*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_42(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1p+1;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = cos(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        if (r2 < 0.0) { if (2 < b0) { b0 = 2; e0 = MC_DOMAIN_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_DOMAIN_ERROR; } }
+        r2 = (r2 < 0.0) ? 0.0 : sqrt(r2);
+        if (!isfinite(r2)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 43) Lemniscata: R**2=sin(2*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_43(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1p+1;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = sin(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        if (r2 < 0.0) { if (2 < b0) { b0 = 2; e0 = MC_DOMAIN_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_DOMAIN_ERROR; } }
+        r2 = (r2 < 0.0) ? 0.0 : sqrt(r2);
+        if (!isfinite(r2)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 44) Rosácea de 3 folhas: R=sin(3*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_44(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1.8p+1;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = sin(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 45) Rosácea de 4 folhas: R=cos(2*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_45(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1p+1;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = cos(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 46) Rosácea de 5 folhas: R=sin(5*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_46(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1.4p+2;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = sin(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 47) Rosácea de 8 folhas: R=sin(4*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_47(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1p+2;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = sin(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 48) Caracol de Pascal: R=4*cos(t)+2
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_48(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r5 = 0x1p+2 * r3;
+        if (!isfinite(r5)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r5 = 0x1p+1 + r5;
+        if (!isfinite(r5)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r3 * r5;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r5 * r4;
+        if (!isfinite(r4)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 49) Cardióide: R=4*cos(t)+4
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_49(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r3 = sin(u); r2 = cos(u); }
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r4 = 0x1p+2 * r2;
+        if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r4 = 0x1p+2 + r4;
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r2 = r2 * r4;
+        if (!isfinite(r2)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r3 = r4 * r3;
+        if (!isfinite(r3)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r2;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r3;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 50) Coclóide: R=3*sin(t)/t
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_50(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r2 = sin(u); r3 = cos(u); }
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r4 = 0x1.8p+1 * r2;
+        if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        {
+            const double q = v;
+            r4 = r4 / q;
+            if (q == 0.0) { if (2 < b0) { b0 = 2; e0 = MC_DIVISION_BY_ZERO; } if (2 < b1) { b1 = 2; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        }
+        r3 = r4 * r3;
+        if (!isfinite(r3)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 51) Nefróide de Freeth: R=1+2*sin(t/2)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_51(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r4 = 0.0, r5 = 0.0, r6 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r4 = v * 0x1p-1;
+        if (!isfinite(r4)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r4 = sin(r4);
+        if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r4 = 0x1p+1 * r4;
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r4 = 0x1p+0 + r4;
+        if (!isfinite(r4)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r6 = sin(u); r5 = cos(u); }
+        if (!isfinite(r6)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        r5 = r4 * r5;
+        if (!isfinite(r5)) { if (5 < b0) { b0 = 5; e0 = MC_MATH_ERROR; } }
+        r6 = r4 * r6;
+        if (!isfinite(r6)) { if (5 < b1) { b1 = 5; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r5;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r6;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 52) Nefróide de Proctor ou Epiciclóide de Huygens: X=5*(3*cos(t)-cos(3*t));Y=5*(3*sin(t)-sin(3*t))
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_52(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0, r6 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r3 = 0x1.8p+1 * r3;
+        if (!isfinite(r3)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r5 = v * 0x1.8p+1;
+        if (!isfinite(r5)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        { const double u = r5; r6 = sin(u); r5 = cos(u); }
+        if (!isfinite(r6)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r5 = r3 - r5;
+        if (!isfinite(r5)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r5 = 0x1.4p+2 * r5;
+        if (!isfinite(r5)) { if (5 < b0) { b0 = 5; e0 = MC_MATH_ERROR; } }
+        r4 = 0x1.8p+1 * r4;
+        if (!isfinite(r4)) { if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r6 = r4 - r6;
+        if (!isfinite(r6)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        r6 = 0x1.4p+2 * r6;
+        if (!isfinite(r6)) { if (5 < b1) { b1 = 5; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r5;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r6;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 53a) Curva de Bowditch ou de Lissajous (a): X=sin(3*t);Y=sin(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_53a(const double *in, double *const *out,
+                           uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1.8p+1;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } }
+        r2 = sin(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r3 = sin(v);
+        if (!isfinite(r3)) { if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r2;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r3;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 53b) Curva de Bowditch ou de Lissajous (b): X=sin(t/2+pi/8);Y=sin(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_53b(const double *in, double *const *out,
+                           uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r3 = v * 0x1p-1;
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } }
+        r3 = 0x1.921fb54442d18p-2 + r3;
+        if (!isfinite(r3)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r3 = sin(r3);
+        if (!isfinite(r3)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } }
+        r4 = sin(v);
+        if (!isfinite(r4)) { if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 53c) Curva de Bowditch ou de Lissajous (c): X=sin(3/2*t);Y=sin(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_53c(const double *in, double *const *out,
+                           uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1.8p+0;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } }
+        r2 = sin(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r3 = sin(v);
+        if (!isfinite(r3)) { if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r2;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r3;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 53d) Curva de Bowditch ou de Lissajous (d): X=sin(2*t);Y=sin(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_53d(const double *in, double *const *out,
+                           uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1p+1;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } }
+        r2 = sin(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r3 = sin(v);
+        if (!isfinite(r3)) { if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r2;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r3;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 53e) Curva de Bowditch ou de Lissajous (e): X=sin(3*t+pi/2);Y=sin(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_53e(const double *in, double *const *out,
+                           uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r3 = v * 0x1.8p+1;
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } }
+        r3 = 0x1.921fb54442d18p+0 + r3;
+        if (!isfinite(r3)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r3 = sin(r3);
+        if (!isfinite(r3)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } }
+        r4 = sin(v);
+        if (!isfinite(r4)) { if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 53f) Curva de Bowditch ou de Lissajous (f): X=sin(3*t+pi/4);Y=sin(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_53f(const double *in, double *const *out,
+                           uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r3 = v * 0x1.8p+1;
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } }
+        r3 = 0x1.921fb54442d18p-1 + r3;
+        if (!isfinite(r3)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r3 = sin(r3);
+        if (!isfinite(r3)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } }
+        r4 = sin(v);
+        if (!isfinite(r4)) { if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 53g) Curva de Bowditch ou de Lissajous (g): X=sin(t/2+pi/16);Y=sin(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_53g(const double *in, double *const *out,
+                           uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r3 = v * 0x1p-1;
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } }
+        r3 = 0x1.921fb54442d18p-3 + r3;
+        if (!isfinite(r3)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r3 = sin(r3);
+        if (!isfinite(r3)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } }
+        r4 = sin(v);
+        if (!isfinite(r4)) { if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 54) Espiral de Arquimedes: R=t
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_54(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0, r2 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r2 = sin(u); r1 = cos(u); }
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r1 = v * r1;
+        if (!isfinite(r1)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } }
+        r2 = v * r2;
+        if (!isfinite(r2)) { if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r1;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r2;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 55) Espiral parabólica: R**2=4*t
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_55(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1p+2;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        if (r2 < 0.0) { if (1 < b0) { b0 = 1; e0 = MC_DOMAIN_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_DOMAIN_ERROR; } }
+        r2 = (r2 < 0.0) ? 0.0 : sqrt(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 56) Espiral logarítmica: R=e**(t/5)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_56(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        int e0 = 0, e1 = 0;
+
+        if (!e0) e0 = 1;
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : v;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (!e1) e1 = 1;
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : v;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 57) Espiral hiperbólica ou recíproca: R=2*pi/t
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_57(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        {
+            const double q = v;
+            r2 = 0x1.921fb54442d18p+2 / q;
+            if (q == 0.0) { if (0 < b0) { b0 = 0; e0 = MC_DIVISION_BY_ZERO; } if (0 < b1) { b1 = 0; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 58) Lituus: R**2=pi/t
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_58(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        {
+            const double q = v;
+            r2 = 0x1.921fb54442d18p+1 / q;
+            if (q == 0.0) { if (0 < b0) { b0 = 0; e0 = MC_DIVISION_BY_ZERO; } if (0 < b1) { b1 = 0; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        }
+        if (r2 < 0.0) { if (1 < b0) { b0 = 1; e0 = MC_DOMAIN_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_DOMAIN_ERROR; } }
+        r2 = (r2 < 0.0) ? 0.0 : sqrt(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 59) R=1/4+sin(t): R=1/4+sin(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_59(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r2 = sin(u); r3 = cos(u); }
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r4 = 0x1p-2 + r2;
+        if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r3 = r4 * r3;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 60) R=sin(t/3):0,3:: R=sin(t/3)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_60(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1.5555555555555p-2;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = sin(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 61) R=1-ln(t):1/10,4:: R=1-ln(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_61(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        if (v <= 0.0) { if (0 < b0) { b0 = 0; e0 = MC_DOMAIN_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_DOMAIN_ERROR; } }
+        r2 = (v <= 0.0) ? 0.0 : log(v);
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = 0x1p+0 - r2;
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 62) R=1-sin(3/2*t): R=1-sin(3/2*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_62(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r3 = v * 0x1.8p+0;
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r3 = sin(r3);
+        if (!isfinite(r3)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r3 = 0x1p+0 - r3;
+        if (!isfinite(r3)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r5 = sin(u); r4 = cos(u); }
+        if (!isfinite(r5)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r4 = r3 * r4;
+        if (!isfinite(r4)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r5 = r3 * r5;
+        if (!isfinite(r5)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r5;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 63) R=sin(t)*cos(2*t): R=sin(t)*cos(2*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_63(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r2 = sin(u); r3 = cos(u); }
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r4 = v * 0x1p+1;
+        if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r4 = cos(r4);
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r3 = r4 * r3;
+        if (!isfinite(r3)) { if (5 < b0) { b0 = 5; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 64) R=sin(2*t)-sin(t): R=sin(2*t)-sin(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_64(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1p+1;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = sin(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r3 = sin(u); r4 = cos(u); }
+        if (!isfinite(r3)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r2 = r2 - r3;
+        if (!isfinite(r2)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (5 < b0) { b0 = 5; e0 = MC_MATH_ERROR; } }
+        r2 = r3 * r2;
+        if (!isfinite(r2)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r2;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 65) R=sin(2*t):-1/2,1/2:: R=sin(2*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_65(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1p+1;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = sin(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 66) R=sin(4*t):-1/2,1/2:: R=sin(4*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_66(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1p+2;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = sin(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 67) R=2+cos(5*t): R=2+cos(5*t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_67(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r3 = v * 0x1.4p+2;
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r3 = cos(r3);
+        if (!isfinite(r3)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r3 = 0x1p+1 + r3;
+        if (!isfinite(r3)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r5 = sin(u); r4 = cos(u); }
+        if (!isfinite(r5)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r4 = r3 * r4;
+        if (!isfinite(r4)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r5 = r3 * r5;
+        if (!isfinite(r5)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r5;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 68) R=sin(t/2):0,4:: R=sin(t/2)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_68(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1p-1;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = sin(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 69) R=t*cos(t):-2.5,2.5:: R=t*cos(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_69(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0, r2 = 0.0, r3 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r2 = sin(u); r1 = cos(u); }
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r3 = v * r1;
+        if (!isfinite(r3)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r1 = r1 * r3;
+        if (!isfinite(r1)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } }
+        r2 = r3 * r2;
+        if (!isfinite(r2)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r1;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r2;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 70) R=sin(t*3/2):-.25,2.93:: R=sin(t*3/2)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_70(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r3 = v * 0x1.8p+1;
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r3 = 0x1p-1 * r3;
+        if (!isfinite(r3)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r3 = sin(r3);
+        if (!isfinite(r3)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r5 = sin(u); r4 = cos(u); }
+        if (!isfinite(r5)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r4 = r3 * r4;
+        if (!isfinite(r4)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r5 = r3 * r5;
+        if (!isfinite(r5)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r5;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 71) R=sin(1.5*t+pi/2):.25,1.77:: R=sin(1.5*t+pi/2)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_71(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r3 = v * 0x1.8p+0;
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r3 = 0x1.921fb54442d18p+0 + r3;
+        if (!isfinite(r3)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r3 = sin(r3);
+        if (!isfinite(r3)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r5 = sin(u); r4 = cos(u); }
+        if (!isfinite(r5)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        r4 = r3 * r4;
+        if (!isfinite(r4)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r5 = r3 * r5;
+        if (!isfinite(r5)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r5;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 72) R=cos(t/2):0,4:: R=cos(t/2)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_72(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r2 = v * 0x1p-1;
+        if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r2 = cos(r2);
+        if (!isfinite(r2)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 73) R=1/(2*cos(t)):-1,1:: R=1/(2*cos(t))
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_73(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r5 = 0x1p+1 * r3;
+        if (!isfinite(r5)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        {
+            const double q = r5;
+            r5 = 0x1p+0 / q;
+            if (q == 0.0) { if (2 < b0) { b0 = 2; e0 = MC_DIVISION_BY_ZERO; } if (2 < b1) { b1 = 2; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r5)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        }
+        r3 = r3 * r5;
+        if (!isfinite(r3)) { if (3 < b0) { b0 = 3; e0 = MC_MATH_ERROR; } }
+        r4 = r5 * r4;
+        if (!isfinite(r4)) { if (4 < b1) { b1 = 4; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 74) R=1-1.5*sin(t): R=1-1.5*sin(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_74(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r3 = 0.0, r4 = 0.0, r5 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r3 = sin(u); r4 = cos(u); }
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        r5 = 0x1.8p+0 * r3;
+        if (!isfinite(r5)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r5 = 0x1p+0 - r5;
+        if (!isfinite(r5)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        r4 = r5 * r4;
+        if (!isfinite(r4)) { if (4 < b0) { b0 = 4; e0 = MC_MATH_ERROR; } }
+        r5 = r3 * r5;
+        if (!isfinite(r5)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r4;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r5;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 75) R=1/cos(t):-1,1:: R=1/cos(t)
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_75(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        { const double u = v; r3 = sin(u); r2 = cos(u); }
+        if (!isfinite(r3)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        {
+            const double q = r2;
+            r4 = 0x1p+0 / q;
+            if (q == 0.0) { if (1 < b0) { b0 = 1; e0 = MC_DIVISION_BY_ZERO; } if (1 < b1) { b1 = 1; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        }
+        r2 = r2 * r4;
+        if (!isfinite(r2)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } }
+        r3 = r4 * r3;
+        if (!isfinite(r3)) { if (3 < b1) { b1 = 3; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r2;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r3;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 76) R=sin(t)**2+cos(t)**2: R=sin(t)**2+cos(t)**2
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_76(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r1 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        r1 = sin(v);
+        if (!isfinite(r1)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        if (!e0) e0 = 1;
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : v;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (!e1) e1 = 1;
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : v;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+/* 77) R=1/t:1/4,3:: R=1/t
+ * saída 0: X, saída 1: Y */
+MC_LINKAGE void preset_77(const double *in, double *const *out,
+                          uint8_t *const *status, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const double v = in[i];
+        double r2 = 0.0, r3 = 0.0, r4 = 0.0;
+        int e0 = 0, e1 = 0;
+        int b0 = 0x7fffffff;
+        int b1 = 0x7fffffff;
+
+        {
+            const double q = v;
+            r2 = 0x1p+0 / q;
+            if (q == 0.0) { if (0 < b0) { b0 = 0; e0 = MC_DIVISION_BY_ZERO; } if (0 < b1) { b1 = 0; e1 = MC_DIVISION_BY_ZERO; } }
+            else if (!isfinite(r2)) { if (0 < b0) { b0 = 0; e0 = MC_MATH_ERROR; } if (0 < b1) { b1 = 0; e1 = MC_MATH_ERROR; } }
+        }
+        { const double u = v; r4 = sin(u); r3 = cos(u); }
+        if (!isfinite(r4)) { if (1 < b0) { b0 = 1; e0 = MC_MATH_ERROR; } if (1 < b1) { b1 = 1; e1 = MC_MATH_ERROR; } }
+        r3 = r2 * r3;
+        if (!isfinite(r3)) { if (2 < b0) { b0 = 2; e0 = MC_MATH_ERROR; } }
+        r4 = r2 * r4;
+        if (!isfinite(r4)) { if (2 < b1) { b1 = 2; e1 = MC_MATH_ERROR; } }
+        if (out[0]) {
+            out[0][i] = e0 ? 0.0 : r3;
+            status[0][i] = (uint8_t)e0;
+        }
+        if (out[1]) {
+            out[1][i] = e1 ? 0.0 : r4;
+            status[1][i] = (uint8_t)e1;
+        }
+    }
+}
+
+const PlotPreset plot_presets[] = {
+    { "1", "Função constante", "Y=5",
+      PLOT_CARTESIAN, "5", NULL, 0x0p+0, 0x0p+0, 0, preset_1 },
+    { "2", "Função valor absoluto", "Y=abs(x)",
+      PLOT_CARTESIAN, "abs(x)", NULL, 0x0p+0, 0x0p+0, 0, preset_2 },
+    { "3", "Função linear", "Y=x/3+2",
+      PLOT_CARTESIAN, "x/3+2", NULL, 0x0p+0, 0x0p+0, 0, preset_3 },
+    { "4", "Circunferência", "R=6",
+      PLOT_POLAR_R, "6", NULL, 0x0p+0, 0x0p+0, 0, preset_4 },
+    { "5", "Elipse", "R=6/(2-sin(t))",
+      PLOT_POLAR_R, "6/(2-sin(t))", NULL, 0x0p+0, 0x0p+0, 0, preset_5 },
+    { "6", "Parábola", "Y=x*x:-2,2:",
+      PLOT_CARTESIAN, "x*x", NULL, -0x1p+1, 0x1p+1, 1, preset_6 },
+    { "7", "Função fracionária", "Y=1/(x*x):-3,3:",
+      PLOT_CARTESIAN, "1/(x*x)", NULL, -0x1.8p+1, 0x1.8p+1, 1, preset_7 },
+    { "8", "Parábola cúbica", "Y=x*x*x:-1.5,1.5:",
+      PLOT_CARTESIAN, "x*x*x", NULL, -0x1.8p+0, 0x1.8p+0, 1, preset_8 },
+    { "9", "Parábola semicúbica ou de Neil", "Y=(x*x)**(1/3)",
+      PLOT_CARTESIAN, "(x*x)**(1/3)", NULL, 0x0p+0, 0x0p+0, 0, preset_9 },
+    { "10", "Hipérbole", "R=4/(2-3*cos(t))",
+      PLOT_POLAR_R, "4/(2-3*cos(t))", NULL, 0x0p+0, 0x0p+0, 0, preset_10 },
+    { "11", "Hipérbole equilátera", "Y=1/x:-4,4:",
+      PLOT_CARTESIAN, "1/x", NULL, -0x1p+2, 0x1p+2, 1, preset_11 },
+    { "12", "Curva exponencial", "Y=1.3**x",
+      PLOT_CARTESIAN, "1.3**x", NULL, 0x0p+0, 0x0p+0, 0, preset_12 },
+    { "13", "Curva logarítmica", "Y=ln(x):.2,2:",
+      PLOT_CARTESIAN, "ln(x)", NULL, 0x1.999999999999ap-3, 0x1p+1, 1, preset_13 },
+    { "14", "Curva de probabilidade ou de Gauss", "Y=exp(1)**(-x*x):-2,2:",
+      PLOT_CARTESIAN, "exp(1)**(-x*x)", NULL, -0x1p+1, 0x1p+1, 1, preset_14 },
+    { "15", "Senóide", "Y=sin(x):-pi,pi:",
+      PLOT_CARTESIAN, "sin(x)", NULL, -0x1.921fb54442d18p+1, 0x1.921fb54442d18p+1, 1, preset_15 },
+    { "16", "Co-senóide", "Y=cos(x):-pi,pi:",
+      PLOT_CARTESIAN, "cos(x)", NULL, -0x1.921fb54442d18p+1, 0x1.921fb54442d18p+1, 1, preset_16 },
+    { "17", "Tangentóide", "Y=tan(x):-4.7,4.7:",
+      PLOT_CARTESIAN, "tan(x)", NULL, -0x1.2cccccccccccdp+2, 0x1.2cccccccccccdp+2, 1, preset_17 },
+    { "18", "Secantóide", "Y=1/cos(x):-4.7,4.7:",
+      PLOT_CARTESIAN, "1/cos(x)", NULL, -0x1.2cccccccccccdp+2, 0x1.2cccccccccccdp+2, 1, preset_18 },
+    { "19", "Inversa da senóide", "Y=asin(x):-1,1:",
+      PLOT_CARTESIAN, "asin(x)", NULL, -0x1p+0, 0x1p+0, 1, preset_19 },
+    { "20", "Inversa da co-senóide", "Y=acos(x):-1,1:",
+      PLOT_CARTESIAN, "acos(x)", NULL, -0x1p+0, 0x1p+0, 1, preset_20 },
+    { "21", "Inversa da tangentóide", "Y=atan(x)",
+      PLOT_CARTESIAN, "atan(x)", NULL, 0x0p+0, 0x0p+0, 0, preset_21 },
+    { "22", "Ciclóide de cúspide na origem", "X=t-sin(t);Y=1-cos(t):-2,2:",
+      PLOT_PARAMETRIC, "t-sin(t)", "1-cos(t)", -0x1p+1, 0x1p+1, 1, preset_22 },
+    { "23", "Ciclóide de vértice na origem", "X=t+sin(t);Y=1-cos(t):-2,2:",
+      PLOT_PARAMETRIC, "t+sin(t)", "1-cos(t)", -0x1p+1, 0x1p+1, 1, preset_23 },
+    { "24", "Ciclóide alongada", "X=3*t-5*sin(t);Y=3-5*cos(t):-3,3:",
+      PLOT_PARAMETRIC, "3*t-5*sin(t)", "3-5*cos(t)", -0x1.8p+1, 0x1.8p+1, 1, preset_24 },
+    { "25", "Ciclóide encurtada", "X=4*t-3*sin(t);Y=4-3*cos(t):-3,3:",
+      PLOT_PARAMETRIC, "4*t-3*sin(t)", "4-3*cos(t)", -0x1.8p+1, 0x1.8p+1, 1, preset_25 },
+    { "26", "Catenária", "Y=(exp(1)**x+exp(1)**-x)/2:-2,2:",
+      PLOT_CARTESIAN, "(exp(1)**x+exp(1)**-x)/2", NULL, -0x1p+1, 0x1p+1, 1, preset_26 },
+    { "27", "Epiciclóide de 4 cúspides", "X=5*cos(t)-cos(5*t);Y=5*sin(t)-sin(5*t)",
+      PLOT_PARAMETRIC, "5*cos(t)-cos(5*t)", "5*sin(t)-sin(5*t)", 0x0p+0, 0x0p+0, 0, preset_27 },
+    { "28", "Deltóide ou hipociclóide tricúspide", "X=2*cos(t)+cos(2*t);Y=2*sin(t)-sin(2*t)",
+      PLOT_PARAMETRIC, "2*cos(t)+cos(2*t)", "2*sin(t)-sin(2*t)", 0x0p+0, 0x0p+0, 0, preset_28 },
+    { "29", "Astróide ou hipociclóide de 4 cúspides", "X=cos(t)*cos(t)*cos(t);Y=sin(t)*sin(t)*sin(t)",
+      PLOT_PARAMETRIC, "cos(t)*cos(t)*cos(t)", "sin(t)*sin(t)*sin(t)", 0x0p+0, 0x0p+0, 0, preset_29 },
+    { "30", "Evolvente da circunferência", "X=5*cos(t)+5*t*sin(t);Y=5*sin(t)-5*t*cos(t)",
+      PLOT_PARAMETRIC, "5*cos(t)+5*t*sin(t)", "5*sin(t)-5*t*cos(t)", 0x0p+0, 0x0p+0, 0, preset_30 },
+    { "31", "Concóide de reta ou de Nicodemes", "R=(2/cos(t))+3:-1.4,1.4:",
+      PLOT_POLAR_R, "(2/cos(t))+3", NULL, -0x1.6666666666666p+0, 0x1.6666666666666p+0, 1, preset_31 },
+    { "32", "Cissóide de diocles", "R=2*tan(t)*sin(t):0,1:",
+      PLOT_POLAR_R, "2*tan(t)*sin(t)", NULL, 0x0p+0, 0x1p+0, 1, preset_32 },
+    { "33", "Estrofóide", "R=-3*cos(2*t)/(cos(t)):.1,1.4:",
+      PLOT_POLAR_R, "-3*cos(2*t)/(cos(t))", NULL, 0x1.999999999999ap-4, 0x1.6666666666666p+0, 1, preset_33 },
+    { "34", "Ofiuróide", "R=4*sin(t)-(2*sin(t)*sin(t)/cos(t)):0,1:",
+      PLOT_POLAR_R, "4*sin(t)-(2*sin(t)*sin(t)/cos(t))", NULL, 0x0p+0, 0x1p+0, 1, preset_34 },
+    { "35", "Folium de Descartes", "R=(6*sin(t)*cos(t))/(sin(t)*sin(t)*sin(t)+cos(t)*cos(t)*cos(t))",
+      PLOT_POLAR_R, "(6*sin(t)*cos(t))/(sin(t)*sin(t)*sin(t)+cos(t)*cos(t)*cos(t))", NULL, 0x0p+0, 0x0p+0, 0, preset_35 },
+    { "36", "Trissectriz de Maclaurin", "R=4*sin(3*t)/sin(2*t):.1,1.5:",
+      PLOT_POLAR_R, "4*sin(3*t)/sin(2*t)", NULL, 0x1.999999999999ap-4, 0x1.8p+0, 1, preset_36 },
+    { "37", "Quadratriz de Hípias ou de Dinóstrato", "R=(2*t)/(pi*sin(t)):-.2,.5:",
+      PLOT_POLAR_R, "(2*t)/(pi*sin(t))", NULL, -0x1.999999999999ap-3, 0x1p-1, 1, preset_37 },
+    { "38", "Cruciforme", "R=2/sin(2*t):.1,1.5:",
+      PLOT_POLAR_R, "2/sin(2*t)", NULL, 0x1.999999999999ap-4, 0x1.8p+0, 1, preset_38 },
+    { "39", "Curva de Gutschoven", "R=1/tan(t):.1,1.5:",
+      PLOT_POLAR_R, "1/tan(t)", NULL, 0x1.999999999999ap-4, 0x1.8p+0, 1, preset_39 },
+    { "40", "Cúbica de Agnesi ou \"versiera\"", "Y=8/(4+x*x):-5,5:",
+      PLOT_CARTESIAN, "8/(4+x*x)", NULL, -0x1.4p+2, 0x1.4p+2, 1, preset_40 },
+    { "41", "Bifolium", "R=5*sin(t)*cos(t)*cos(t)",
+      PLOT_POLAR_R, "5*sin(t)*cos(t)*cos(t)", NULL, 0x0p+0, 0x0p+0, 0, preset_41 },
+    { "42", "Lemniscata de Bernoulli", "R**2=cos(2*t)",
+      PLOT_POLAR_R2, "cos(2*t)", NULL, 0x0p+0, 0x0p+0, 0, preset_42 },
+    { "43", "Lemniscata", "R**2=sin(2*t)",
+      PLOT_POLAR_R2, "sin(2*t)", NULL, 0x0p+0, 0x0p+0, 0, preset_43 },
+    { "44", "Rosácea de 3 folhas", "R=sin(3*t)",
+      PLOT_POLAR_R, "sin(3*t)", NULL, 0x0p+0, 0x0p+0, 0, preset_44 },
+    { "45", "Rosácea de 4 folhas", "R=cos(2*t)",
+      PLOT_POLAR_R, "cos(2*t)", NULL, 0x0p+0, 0x0p+0, 0, preset_45 },
+    { "46", "Rosácea de 5 folhas", "R=sin(5*t)",
+      PLOT_POLAR_R, "sin(5*t)", NULL, 0x0p+0, 0x0p+0, 0, preset_46 },
+    { "47", "Rosácea de 8 folhas", "R=sin(4*t)",
+      PLOT_POLAR_R, "sin(4*t)", NULL, 0x0p+0, 0x0p+0, 0, preset_47 },
+    { "48", "Caracol de Pascal", "R=4*cos(t)+2",
+      PLOT_POLAR_R, "4*cos(t)+2", NULL, 0x0p+0, 0x0p+0, 0, preset_48 },
+    { "49", "Cardióide", "R=4*cos(t)+4",
+      PLOT_POLAR_R, "4*cos(t)+4", NULL, 0x0p+0, 0x0p+0, 0, preset_49 },
+    { "50", "Coclóide", "R=3*sin(t)/t:-2,2:",
+      PLOT_POLAR_R, "3*sin(t)/t", NULL, -0x1p+1, 0x1p+1, 1, preset_50 },
+    { "51", "Nefróide de Freeth", "R=1+2*sin(t/2):-2,2:",
+      PLOT_POLAR_R, "1+2*sin(t/2)", NULL, -0x1p+1, 0x1p+1, 1, preset_51 },
+    { "52", "Nefróide de Proctor ou Epiciclóide de Huygens", "X=5*(3*cos(t)-cos(3*t));Y=5*(3*sin(t)-sin(3*t))",
+      PLOT_PARAMETRIC, "5*(3*cos(t)-cos(3*t))", "5*(3*sin(t)-sin(3*t))", 0x0p+0, 0x0p+0, 0, preset_52 },
+    { "53a", "Curva de Bowditch ou de Lissajous (a)", "X=sin(3*t);Y=sin(t)",
+      PLOT_PARAMETRIC, "sin(3*t)", "sin(t)", 0x0p+0, 0x0p+0, 0, preset_53a },
+    { "53b", "Curva de Bowditch ou de Lissajous (b)", "X=sin(t/2+pi/8);Y=sin(t):0,4:",
+      PLOT_PARAMETRIC, "sin(t/2+pi/8)", "sin(t)", 0x0p+0, 0x1p+2, 1, preset_53b },
+    { "53c", "Curva de Bowditch ou de Lissajous (c)", "X=sin(3/2*t);Y=sin(t)",
+      PLOT_PARAMETRIC, "sin(3/2*t)", "sin(t)", 0x0p+0, 0x0p+0, 0, preset_53c },
+    { "53d", "Curva de Bowditch ou de Lissajous (d)", "X=sin(2*t);Y=sin(t)",
+      PLOT_PARAMETRIC, "sin(2*t)", "sin(t)", 0x0p+0, 0x0p+0, 0, preset_53d },
+    { "53e", "Curva de Bowditch ou de Lissajous (e)", "X=sin(3*t+pi/2);Y=sin(t)",
+      PLOT_PARAMETRIC, "sin(3*t+pi/2)", "sin(t)", 0x0p+0, 0x0p+0, 0, preset_53e },
+    { "53f", "Curva de Bowditch ou de Lissajous (f)", "X=sin(3*t+pi/4);Y=sin(t)",
+      PLOT_PARAMETRIC, "sin(3*t+pi/4)", "sin(t)", 0x0p+0, 0x0p+0, 0, preset_53f },
+    { "53g", "Curva de Bowditch ou de Lissajous (g)", "X=sin(t/2+pi/16);Y=sin(t):0,4:",
+      PLOT_PARAMETRIC, "sin(t/2+pi/16)", "sin(t)", 0x0p+0, 0x1p+2, 1, preset_53g },
+    { "54", "Espiral de Arquimedes", "R=t:0,3:",
+      PLOT_POLAR_R, "t", NULL, 0x0p+0, 0x1.8p+1, 1, preset_54 },
+    { "55", "Espiral parabólica", "R**2=4*t:0,3:",
+      PLOT_POLAR_R2, "4*t", NULL, 0x0p+0, 0x1.8p+1, 1, preset_55 },
+    { "56", "Espiral logarítmica", "R=e**(t/5):-5/10,3:",
+      PLOT_POLAR_R, "e**(t/5)", NULL, -0x1p-1, 0x1.8p+1, 1, preset_56 },
+    { "57", "Espiral hiperbólica ou recíproca", "R=2*pi/t:1/10,3:",
+      PLOT_POLAR_R, "2*pi/t", NULL, 0x1.999999999999ap-4, 0x1.8p+1, 1, preset_57 },
+    { "58", "Lituus", "R**2=pi/t:1/10,4:",
+      PLOT_POLAR_R2, "pi/t", NULL, 0x1.999999999999ap-4, 0x1p+2, 1, preset_58 },
+    { "59", "R=1/4+sin(t)", "R=1/4+sin(t)",
+      PLOT_POLAR_R, "1/4+sin(t)", NULL, 0x0p+0, 0x0p+0, 0, preset_59 },
+    { "60", "R=sin(t/3):0,3:", "R=sin(t/3):0,3:",
+      PLOT_POLAR_R, "sin(t/3)", NULL, 0x0p+0, 0x1.8p+1, 1, preset_60 },
+    { "61", "R=1-ln(t):1/10,4:", "R=1-ln(t):1/10,4:",
+      PLOT_POLAR_R, "1-ln(t)", NULL, 0x1.999999999999ap-4, 0x1p+2, 1, preset_61 },
+    { "62", "R=1-sin(3/2*t)", "R=1-sin(3/2*t)",
+      PLOT_POLAR_R, "1-sin(3/2*t)", NULL, 0x0p+0, 0x0p+0, 0, preset_62 },
+    { "63", "R=sin(t)*cos(2*t)", "R=sin(t)*cos(2*t)",
+      PLOT_POLAR_R, "sin(t)*cos(2*t)", NULL, 0x0p+0, 0x0p+0, 0, preset_63 },
+    { "64", "R=sin(2*t)-sin(t)", "R=sin(2*t)-sin(t)",
+      PLOT_POLAR_R, "sin(2*t)-sin(t)", NULL, 0x0p+0, 0x0p+0, 0, preset_64 },
+    { "65", "R=sin(2*t):-1/2,1/2:", "R=sin(2*t):-1/2,1/2:",
+      PLOT_POLAR_R, "sin(2*t)", NULL, -0x1p-1, 0x1p-1, 1, preset_65 },
+    { "66", "R=sin(4*t):-1/2,1/2:", "R=sin(4*t):-1/2,1/2:",
+      PLOT_POLAR_R, "sin(4*t)", NULL, -0x1p-1, 0x1p-1, 1, preset_66 },
+    { "67", "R=2+cos(5*t)", "R=2+cos(5*t)",
+      PLOT_POLAR_R, "2+cos(5*t)", NULL, 0x0p+0, 0x0p+0, 0, preset_67 },
+    { "68", "R=sin(t/2):0,4:", "R=sin(t/2):0,4:",
+      PLOT_POLAR_R, "sin(t/2)", NULL, 0x0p+0, 0x1p+2, 1, preset_68 },
+    { "69", "R=t*cos(t):-2.5,2.5:", "R=t*cos(t):-2.5,2.5:",
+      PLOT_POLAR_R, "t*cos(t)", NULL, -0x1.4p+1, 0x1.4p+1, 1, preset_69 },
+    { "70", "R=sin(t*3/2):-.25,2.93:", "R=sin(t*3/2):-.25,2.93:",
+      PLOT_POLAR_R, "sin(t*3/2)", NULL, -0x1p-2, 0x1.770a3d70a3d71p+1, 1, preset_70 },
+    { "71", "R=sin(1.5*t+pi/2):.25,1.77:", "R=sin(1.5*t+pi/2):.25,1.77:",
+      PLOT_POLAR_R, "sin(1.5*t+pi/2)", NULL, 0x1p-2, 0x1.c51eb851eb852p+0, 1, preset_71 },
+    { "72", "R=cos(t/2):0,4:", "R=cos(t/2):0,4:",
+      PLOT_POLAR_R, "cos(t/2)", NULL, 0x0p+0, 0x1p+2, 1, preset_72 },
+    { "73", "R=1/(2*cos(t)):-1,1:", "R=1/(2*cos(t)):-1,1:",
+      PLOT_POLAR_R, "1/(2*cos(t))", NULL, -0x1p+0, 0x1p+0, 1, preset_73 },
+    { "74", "R=1-1.5*sin(t)", "R=1-1.5*sin(t)",
+      PLOT_POLAR_R, "1-1.5*sin(t)", NULL, 0x0p+0, 0x0p+0, 0, preset_74 },
+    { "75", "R=1/cos(t):-1,1:", "R=1/cos(t):-1,1:",
+      PLOT_POLAR_R, "1/cos(t)", NULL, -0x1p+0, 0x1p+0, 1, preset_75 },
+    { "76", "R=sin(t)**2+cos(t)**2", "R=sin(t)**2+cos(t)**2",
+      PLOT_POLAR_R, "sin(t)**2+cos(t)**2", NULL, 0x0p+0, 0x0p+0, 0, preset_76 },
+    { "77", "R=1/t:1/4,3:", "R=1/t:1/4,3:",
+      PLOT_POLAR_R, "1/t", NULL, 0x1p-2, 0x1.8p+1, 1, preset_77 },
+};
+
+const int plot_presets_count = (int)(sizeof(plot_presets) / sizeof(plot_presets[0]));
@@ -0,0 +1,511 @@
+/* Máquina virtual de registradores: compilador RPN → DAG → três endereços e interpretador */
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include "regvm.h"
+#include "kernels.h"
+
+/* Amostras por bloco na avaliação em lote */
+#define REGVM_BATCH_BLOCK 64
+
+/* Registradores com colunas na pilha em regvm_eval_batch */
+#define REGVM_LOCAL_REGS 64
+
+/* Nó do DAG. Operandos < nleaves são registradores fixos (variável/constantes);
+ * os demais são nleaves + índice do nó que produz o valor. */
+typedef struct {
+    uint8_t op;
+    int a, b;
+    int last_use;       /* último nó que lê o valor (INT_MAX: resultado de uma saída) */
+    int partner;        /* sin/cos do mesmo argumento fundido com este nó (-1 se nenhum) */
+    int fused_into;     /* >= 0: o valor é produzido pelo SINCOS desse nó (sem instrução) */
+} DagNode;
+
+/* Procura (ou adiciona) uma constante no pool, deduplicando por valor exato */
+static int const_register(double *pool, int *count, double value) {
+    for (int i = 0; i < *count; i++) {
+        if (memcmp(&pool[i], &value, sizeof(double)) == 0) return 1 + i;
+    }
+    pool[*count] = value;
+    return 1 + (*count)++;
+}
+
+/* Valor de um token que ocupa um registrador de constante */
+static int token_constant(const TokenBuffer *rpn, Token token, double *value) {
+    if (token.type == TOKEN_NUMBER) {
+        *value = rpn->values[token.value_index];
+        return 1;
+    }
+    if (token.type == TOKEN_CONST_PI || token.type == TOKEN_CONST_E) {
+        *value = evaluator_constant(token.type);
+        return 1;
+    }
+    return 0;
+}
+
+static int is_binary(TokenType type) {
+    return (type == TOKEN_PLUS || type == TOKEN_MINUS || type == TOKEN_MULT ||
+            type == TOKEN_DIV || type == TOKEN_POW);
+}
+
+/* Tabela hash (op, a, b) → nó, para numeração de valores */
+static unsigned dag_hash(uint8_t op, int a, int b, unsigned mask) {
+    unsigned h = op * 2654435761u;
+    h ^= (unsigned)a * 40503u + (h << 6) + (h >> 2);
+    h ^= (unsigned)b * 2246822519u + (h << 6) + (h >> 2);
+    return h & mask;
+}
+
+/* Posição de (op, a, b) na tabela: o nó existente ou a vaga onde inseri-lo */
+static unsigned dag_slot(const DagNode *nodes, const int *table, unsigned mask,
+                         uint8_t op, int a, int b) {
+    unsigned h = dag_hash(op, a, b, mask);
+    while (table[h] >= 0) {
+        const DagNode *n = &nodes[table[h]];
+        if (n->op == op && n->a == a && n->b == b) break;
+        h = (h + 1) & mask;
+    }
+    return h;
+}
+
+/* Devolve o nó (op, a, b), criando-o se ainda não existe */
+static int dag_node(DagNode *nodes, int *count, int *table, unsigned mask,
+                    uint8_t op, int a, int b) {
+    /* + e * são comutativos em IEEE 754: normaliza a ordem dos operandos */
+    if ((op == TOKEN_PLUS || op == TOKEN_MULT) && b < a) {
+        int t = a; a = b; b = t;
+    }
+
+    unsigned h = dag_slot(nodes, table, mask, op, a, b);
+    if (table[h] >= 0) return table[h];
+
+    int id = (*count)++;
+    nodes[id].op = op;
+    nodes[id].a = a;
+    nodes[id].b = b;
+    nodes[id].last_use = -1;
+    nodes[id].partner = -1;
+    nodes[id].fused_into = -1;
+    table[h] = id;
+    return id;
+}
+
+/* Funde pares sin/cos do mesmo operando: o primeiro dos dois vira SINCOS
+ * (o argumento já está calculado nesse ponto) e o segundo deixa de gerar
+ * instrução. Devolve o número de pares fundidos. */
+static int fuse_sincos(DagNode *nodes, int nnodes, const int *table, unsigned mask) {
+    int fused = 0;
+    for (int i = 0; i < nnodes; i++) {
+        DagNode *n = &nodes[i];
+        if ((n->op != TOKEN_SIN && n->op != TOKEN_COS) || n->partner >= 0 || n->fused_into >= 0) {
+            continue;
+        }
+        uint8_t other = (n->op == TOKEN_SIN) ? TOKEN_COS : TOKEN_SIN;
+        int j = table[dag_slot(nodes, table, mask, other, n->a, 0)];
+        if (j > i) {
+            n->partner = j;
+            nodes[j].fused_into = i;
+            fused++;
+        }
+    }
+    return fused;
+}
+
+RegProgram *regvm_compile(const TokenBuffer *rpn) {
+    return regvm_compile_multi(&rpn, 1);
+}
+
+RegProgram *regvm_compile_multi(const TokenBuffer *const *rpns, int count) {
+    if (count < 1 || count > EVAL_MAX_OUTPUTS) return NULL;
+
+    RegProgram *prog = calloc(1, sizeof(RegProgram));
+    if (!prog) return NULL;
+    prog->noutputs = count;
+
+    /* Validação estrutural: cada saída executa apenas o prefixo válido */
+    int stop[EVAL_MAX_OUTPUTS];
+    int total = 0;
+    for (int k = 0; k < count; k++) {
+        const TokenBuffer *rpn = rpns[k];
+        stop[k] = 0;
+        prog->stop_error[k] = EVAL_STACK_ERROR;
+        if (rpn && rpn->tokens && rpn->size > 0) {
+            stop[k] = evaluator_validate_rpn(rpn, &prog->stop_error[k]);
+        }
+        total += stop[k];
+    }
+
+    unsigned table_size = 16;
+    while (table_size < 2u * (unsigned)total) table_size *= 2;
+
+    DagNode *nodes = malloc((total > 0 ? total : 1) * sizeof(DagNode));
+    int *table = malloc(table_size * sizeof(int));
+    int *reg_of = malloc((total > 0 ? total : 1) * sizeof(int));
+    prog->consts = malloc((total > 0 ? total : 1) * sizeof(double));
+    if (!nodes || !table || !reg_of || !prog->consts) goto fail;
+    memset(table, -1, table_size * sizeof(int));
+
+    /* Passo 1: pool de constantes (define onde começam os temporários) */
+    for (int k = 0; k < count; k++) {
+        for (int i = 0; i < stop[k]; i++) {
+            double value;
+            if (token_constant(rpns[k], rpns[k]->tokens[i], &value)) {
+                const_register(prog->consts, &prog->nconsts, value);
+            }
+        }
+    }
+    int nleaves = 1 + prog->nconsts;
+
+    /* Passo 2: DAG com numeração de valores, simulando a pilha de cada saída */
+    int nnodes = 0;
+    int root[EVAL_MAX_OUTPUTS];
+    int *first_seen = malloc((total > 0 ? total : 1) * count * sizeof(int));
+    if (!first_seen) goto fail;
+    for (int i = 0; i < total * count; i++) first_seen[i] = -1;
+
+    for (int k = 0; k < count; k++) {
+        const TokenBuffer *rpn = rpns[k];
+        int stack[MAX_EVAL_STACK_SIZE];
+        int depth = 0;
+        int order = 0;
+
+        for (int i = 0; i < stop[k]; i++) {
+            Token token = rpn->tokens[i];
+            TokenType type = token.type;
+            double value;
+
+            if (token_constant(rpn, token, &value)) {
+                stack[depth++] = const_register(prog->consts, &prog->nconsts, value);
+            } else if (type == TOKEN_VARIABLE_X || type == TOKEN_VARIABLE_THETA ||
+                       type == TOKEN_VARIABLE_T) {
+                stack[depth++] = REGVM_REG_VAR;
+            } else {
+                int b = is_binary(type) ? stack[--depth] : 0;
+                int a = stack[--depth];
+                int id = dag_node(nodes, &nnodes, table, table_size - 1, (uint8_t)type, a, b);
+                /* Ordem da primeira ocorrência = ordem em que a saída isolada avaliaria */
+                if (first_seen[k * total + id] < 0) first_seen[k * total + id] = order++;
+                stack[depth++] = nleaves + id;
+            }
+        }
+
+        root[k] = (prog->stop_error[k] == EVAL_OK) ? stack[0] : -1;
+    }
+
+    /* Passo 3: sin/cos fundidos e tempo de vida de cada valor */
+    fuse_sincos(nodes, nnodes, table, table_size - 1);
+    for (int i = 0; i < nnodes; i++) {
+        DagNode *n = &nodes[i];
+        if (n->fused_into >= 0) continue;
+        if (n->a >= nleaves) nodes[n->a - nleaves].last_use = i;
+        if (is_binary((TokenType)n->op) && n->b >= nleaves) nodes[n->b - nleaves].last_use = i;
+    }
+    for (int k = 0; k < count; k++) {
+        if (root[k] >= nleaves) nodes[root[k] - nleaves].last_use = INT_MAX;
+    }
+
+    /* Passo 4: alocação linear de registradores (reaproveita os que morreram) */
+    int free_regs[REGVM_MAX_REGS];
+    int nfree = 0;
+    int next_reg = nleaves;
+    int *instr_of = malloc((total > 0 ? total : 1) * sizeof(int));
+
+    prog->code = malloc((nnodes > 0 ? nnodes : 1) * sizeof(RegInstr));
+    if (!instr_of || !prog->code || nleaves > REGVM_MAX_REGS || nnodes >= REGVM_NO_RANK) {
+        free(instr_of);
+        free(first_seen);
+        goto fail;
+    }
+
+    int size = 0;
+    for (int i = 0; i < nnodes; i++) {
+        DagNode *n = &nodes[i];
+        if (n->fused_into >= 0) {
+            instr_of[i] = instr_of[n->fused_into];
+            continue;
+        }
+
+        int binary = is_binary((TokenType)n->op);
+        int ra = (n->a >= nleaves) ? reg_of[n->a - nleaves] : n->a;
+        int rb = !binary ? 0 : (n->b >= nleaves) ? reg_of[n->b - nleaves] : n->b;
+
+        /* Operandos que morrem aqui liberam o registrador antes do destino */
+        if (n->a >= nleaves && nodes[n->a - nleaves].last_use == i) {
+            free_regs[nfree++] = ra;
+        }
+        if (binary && n->b >= nleaves && n->b != n->a && nodes[n->b - nleaves].last_use == i) {
+            free_regs[nfree++] = rb;
+        }
+
+        /* Um destino, ou dois para SINCOS (o do parceiro) */
+        int outs[2] = { i, n->partner };
+        int dsts[2] = { 0, 0 };
+        for (int d = 0; d < 2 && outs[d] >= 0; d++) {
+            if (nfree > 0) {
+                dsts[d] = free_regs[--nfree];
+            } else {
+                if (next_reg >= REGVM_MAX_REGS) {
+                    free(instr_of);
+                    free(first_seen);
+                    goto fail;
+                }
+                dsts[d] = next_reg++;
+            }
+            reg_of[outs[d]] = dsts[d];
+        }
+        /* Valor sem uso (prefixo de programa inválido): o registrador volta já */
+        for (int d = 0; d < 2 && outs[d] >= 0; d++) {
+            if (nodes[outs[d]].last_use < 0) free_regs[nfree++] = dsts[d];
+        }
+
+        RegInstr *in = &prog->code[size];
+        instr_of[i] = size++;
+        in->a = (uint8_t)ra;
+        if (n->partner >= 0) {
+            /* dst = sin, b = cos */
+            int sin_first = (n->op == TOKEN_SIN);
+            in->op = REGVM_OP_SINCOS;
+            in->dst = (uint8_t)(sin_first ? dsts[0] : dsts[1]);
+            in->b = (uint8_t)(sin_first ? dsts[1] : dsts[0]);
+        } else {
+            in->op = n->op;
+            in->dst = (uint8_t)dsts[0];
+            in->b = (uint8_t)rb;
+        }
+    }
+    prog->size = size;
+    prog->nregs = next_reg;
+
+    for (int k = 0; k < count; k++) {
+        if (root[k] < 0) prog->result[k] = 0;
+        else if (root[k] < nleaves) prog->result[k] = (uint8_t)root[k];
+        else prog->result[k] = (uint8_t)reg_of[root[k] - nleaves];
+    }
+
+    /* Posição de cada instrução na ordem original de cada saída (o SINCOS
+     * fica com a menor posição entre o sin e o cos que substitui) */
+    prog->rank = malloc((size > 0 ? size : 1) * count * sizeof(uint16_t));
+    if (!prog->rank) {
+        free(instr_of);
+        free(first_seen);
+        goto fail;
+    }
+    for (int i = 0; i < size * count; i++) prog->rank[i] = REGVM_NO_RANK;
+    for (int k = 0; k < count; k++) {
+        for (int i = 0; i < nnodes; i++) {
+            int r = first_seen[k * total + i];
+            uint16_t *slot = &prog->rank[k * size + instr_of[i]];
+            if (r >= 0 && r < *slot) *slot = (uint16_t)r;
+        }
+    }
+
+    free(instr_of);
+    free(first_seen);
+    free(nodes);
+    free(table);
+    free(reg_of);
+    return prog;
+
+fail:
+    free(nodes);
+    free(table);
+    free(reg_of);
+    regvm_free(prog);
+    return NULL;
+}
+
+/* Registra a falha da instrução i nas saídas que dependem dela, mantendo a
+ * de menor posição na ordem original de cada saída */
+static void record_error(const RegProgram *prog, int i, EvalError error,
+                         int *best, EvalResult *results) {
+    for (int k = 0; k < prog->noutputs; k++) {
+        int r = prog->rank[k * prog->size + i];
+        if (r != REGVM_NO_RANK && r < best[k]) {
+            best[k] = r;
+            results[k].error = error;
+        }
+    }
+}
+
+void regvm_eval_multi(const RegProgram *prog, double var_value, EvalResult *results) {
+    double regs[REGVM_MAX_REGS];
+    int best[EVAL_MAX_OUTPUTS];
+
+    for (int k = 0; k < prog->noutputs; k++) {
+        results[k].error = EVAL_OK;
+        results[k].value = 0.0;
+        best[k] = INT_MAX;
+    }
+
+    regs[REGVM_REG_VAR] = var_value;
+    memcpy(&regs[1], prog->consts, prog->nconsts * sizeof(double));
+
+    for (int i = 0; i < prog->size; i++) {
+        const RegInstr *in = &prog->code[i];
+        double a = regs[in->a];
+        double b = regs[in->b];
+        double r;
+        EvalError error = EVAL_OK;
+
+        switch (in->op) {
+            case TOKEN_PLUS:  r = a + b; break;
+            case TOKEN_MINUS: r = a - b; break;
+            case TOKEN_MULT:  r = a * b; break;
+            case TOKEN_DIV:
+                if (b == 0.0) error = EVAL_DIVISION_BY_ZERO;
+                r = a / b;
+                break;
+            case TOKEN_POW:
+                r = pow(a, b);
+                if (isnan(r)) error = EVAL_DOMAIN_ERROR;
+                break;
+            case TOKEN_NEG:
+                regs[in->dst] = -a;
+                continue;
+            case REGVM_OP_SINCOS: {
+                uint8_t st = EVAL_OK;
+                double c;
+                kernels_scalar_sincos(&a, &r, &c, &st, 1);
+                error = (EvalError)st;
+                regs[in->b] = c;
+                break;
+            }
+            default: {
+                EvalResult f = evaluator_apply_function((TokenType)in->op, a);
+                error = f.error;
+                r = f.value;
+                break;
+            }
+        }
+
+        /* Verifica NaN/Inf como em apply_operator */
+        if (error == EVAL_OK && (isnan(r) || isinf(r))) error = EVAL_MATH_ERROR;
+
+        if (error != EVAL_OK) {
+            /* Uma saída: a ordem do código é a ordem original, retorno antecipado */
+            if (prog->noutputs == 1) {
+                results[0].error = error;
+                return;
+            }
+            record_error(prog, i, error, best, results);
+        }
+
+        regs[in->dst] = r;
+    }
+
+    for (int k = 0; k < prog->noutputs; k++) {
+        if (results[k].error != EVAL_OK) continue;
+        if (prog->stop_error[k] != EVAL_OK) {
+            results[k].error = prog->stop_error[k];
+        } else {
+            results[k].value = regs[prog->result[k]];
+        }
+    }
+}
+
+EvalResult regvm_eval(const RegProgram *prog, double var_value) {
+    EvalResult results[EVAL_MAX_OUTPUTS];
+    regvm_eval_multi(prog, var_value, results);
+    return results[0];
+}
+
+void regvm_eval_batch(const RegProgram *prog, const double *in,
+                      double *const *out, uint8_t *const *status, size_t n) {
+    /* Colunas: constantes preenchidas uma vez por chamada, temporários por bloco.
+     * A coluna da variável aponta diretamente para `in` (sem cópia). Até
+     * REGVM_LOCAL_REGS registradores as colunas ficam na pilha (32 KB, como a
+     * pilha de colunas do avaliador); só programas maiores usam malloc. */
+    double locais[REGVM_LOCAL_REGS][REGVM_BATCH_BLOCK];
+    double (*cols)[REGVM_BATCH_BLOCK] = locais;
+    if (prog->nregs - 1 > REGVM_LOCAL_REGS) {
+        cols = malloc((prog->nregs - 1) * sizeof(*cols));
+    }
+    if (!cols) {
+        for (int k = 0; k < prog->noutputs; k++) {
+            if (!out[k]) continue;
+            for (size_t j = 0; j < n; j++) {
+                if (status) status[k][j] = EVAL_MATH_ERROR;
+                out[k][j] = 0.0;
+            }
+        }
+        return;
+    }
+
+    for (int c = 0; c < prog->nconsts; c++) {
+        for (int j = 0; j < REGVM_BATCH_BLOCK; j++) cols[c][j] = prog->consts[c];
+    }
+
+    const double *col[REGVM_MAX_REGS];
+    for (int r = 1; r < prog->nregs; r++) col[r] = cols[r - 1];
+
+    const Kernels *k = kernels_active();
+    uint8_t st[REGVM_BATCH_BLOCK];
+    uint8_t *kst = status ? st : NULL;     /* NULL: kernels sem verificação */
+
+    for (size_t base = 0; base < n; base += REGVM_BATCH_BLOCK) {
+        int len = (n - base < REGVM_BATCH_BLOCK) ? (int)(n - base) : REGVM_BATCH_BLOCK;
+        col[REGVM_REG_VAR] = in + base;
+
+        for (int j = 0; j < len; j++) st[j] = EVAL_OK;
+
+        for (int i = 0; i < prog->size; i++) {
+            const RegInstr *ins = &prog->code[i];
+            double *dst = cols[ins->dst - 1];
+            if (is_binary((TokenType)ins->op)) {
+                k->binary((TokenType)ins->op, col[ins->a], col[ins->b], dst, kst, len);
+            } else if (ins->op == REGVM_OP_SINCOS) {
+                k->sincos(col[ins->a], dst, cols[ins->b - 1], kst, len);
+            } else {
+                k->unary((TokenType)ins->op, col[ins->a], dst, kst, len);
+            }
+        }
+
+        if (!status) {
+            for (int o = 0; o < prog->noutputs; o++) {
+                if (!out[o]) continue;
+                memcpy(out[o] + base, col[prog->result[o]], len * sizeof(double));
+            }
+            continue;
+        }
+
+        for (int j = 0; j < len; j++) {
+            if (st[j] != EVAL_OK && prog->noutputs > 1) {
+                /* Amostra com erro em alguma instrução: a avaliação escalar
+                 * separa o erro de cada saída (raro; fora do laço quente) */
+                EvalResult r[EVAL_MAX_OUTPUTS];
+                regvm_eval_multi(prog, in[base + j], r);
+                for (int o = 0; o < prog->noutputs; o++) {
+                    if (!out[o]) continue;
+                    out[o][base + j] = (r[o].error == EVAL_OK) ? r[o].value : 0.0;
+                    status[o][base + j] = (uint8_t)r[o].error;
+                }
+                continue;
+            }
+
+            for (int o = 0; o < prog->noutputs; o++) {
+                if (!out[o]) continue;
+                if (st[j] != EVAL_OK) {
+                    status[o][base + j] = st[j];
+                    out[o][base + j] = 0.0;
+                } else if (prog->stop_error[o] != EVAL_OK) {
+                    status[o][base + j] = (uint8_t)prog->stop_error[o];
+                    out[o][base + j] = 0.0;
+                } else {
+                    status[o][base + j] = EVAL_OK;
+                    out[o][base + j] = col[prog->result[o]][j];
+                }
+            }
+        }
+    }
+
+    if (cols != locais) free(cols);
+}
+
+void regvm_free(RegProgram *prog) {
+    if (!prog) return;
+    free(prog->code);
+    free(prog->consts);
+    free(prog->rank);
+    free(prog);
+}
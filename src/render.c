@@ -1,6 +1,13 @@
-/* Renderizadores simples: CSV e SVG */
+/* Renderizadores simples: CSV e SVG (num OutSink; as versões com FILE* são
+ * atalhos para o sink de arquivo) */
+#define _POSIX_C_SOURCE 200809L  /* fileno */
 #include "../include/render.h"
+#include "../include/outbuf.h"
+#include "../include/plotbin.h"
+#include "../include/decimate.h"
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
 // Cores configuráveis
 #define COLOR_BACKGROUND "#ffffff"
@@ -9,16 +16,177 @@
 #define COLOR_AXES       "#808080"
 #define COLOR_CURVE      "#0066cc"
 
-void render_csv(const PlotData *data) {
+double render_simplify_tolerance = 0.0;
+
+void render_csv_sink(OutSink *out, const PlotData *data) {
     if (!data) return;
     
-    printf("x,y\n");
+    // Mesmo texto de printf("%.6f,%.6f\n"), sem o printf por ponto
+    OutBuf ob;
+    outbuf_init_sink(&ob, out);
+    outbuf_puts(&ob, "x,y\n");
     for (int i = 0; i < data->count; i++) {
-        printf("%.6f,%.6f\n", data->x[i], data->y[i]);
+        outbuf_fixed(&ob, plot_data_x(data, i), 6);
+        outbuf_putc(&ob, ',');
+        outbuf_fixed(&ob, plot_data_y(data, i), 6);
+        outbuf_putc(&ob, '\n');
     }
+    outbuf_flush(&ob);
 }
 
-void render_svg(const PlotData *data, const char *title, int canvas_w, int canvas_h) {
+void render_csv_file(FILE *out, const PlotData *data) {
+    OutSink sink;
+    outsink_file(&sink, out);
+    render_csv_sink(&sink, data);
+}
+
+void render_csv(const PlotData *data) {
+    render_csv_file(stdout, data);
+}
+
+int render_bin(const PlotData *data, const Plot *plot) {
+    if (!data) return 0;
+    fflush(stdout);
+    return plotbin_write(stdout, plot, data);
+}
+
+int render_csv_stream(PlotSampler *sampler) {
+    if (!sampler) return 0;
+    
+    // Mesmo texto de render_csv, um bloco de amostras por vez; para de
+    // amostrar quando a escrita falha
+    OutBuf ob;
+    outbuf_init(&ob, stdout);
+    outbuf_puts(&ob, "x,y\n");
+    PlotChunk chunk;
+    while (!ob.sink->error && plot_sampler_next(sampler, &chunk)) {
+        for (int i = 0; i < chunk.n; i++) {
+            if (chunk.status[i]) continue;
+            outbuf_fixed(&ob, chunk.x[i], 6);
+            outbuf_putc(&ob, ',');
+            outbuf_fixed(&ob, chunk.y[i], 6);
+            outbuf_putc(&ob, '\n');
+        }
+    }
+    outbuf_flush(&ob);
+    return outsink_finish(ob.sink) && !ferror(stdout);
+}
+
+int render_bin_stream(PlotSampler *sampler, const Plot *plot) {
+    if (!sampler) return 0;
+    fflush(stdout);
+    return plotbin_write_stream(fileno(stdout), plot, sampler);
+}
+
+/* Linha da grade: <line x1="%.2f" y1="%.2f" x2="%.2f" y2="%.2f"/> */
+static void emitir_linha(OutBuf *ob, double x1, double y1, double x2, double y2) {
+    outbuf_puts(ob, "    <line x1=\"");
+    outbuf_fixed(ob, x1, 2);
+    outbuf_puts(ob, "\" y1=\"");
+    outbuf_fixed(ob, y1, 2);
+    outbuf_puts(ob, "\" x2=\"");
+    outbuf_fixed(ob, x2, 2);
+    outbuf_puts(ob, "\" y2=\"");
+    outbuf_fixed(ob, y2, 2);
+    outbuf_puts(ob, "\"/>\n");
+}
+
+/* Ponto da poligonal: "%.2f,%.2f " */
+static void emitir_ponto(OutBuf *ob, double px, double py) {
+    outbuf_fixed(ob, px, 2);
+    outbuf_putc(ob, ',');
+    outbuf_fixed(ob, py, 2);
+    outbuf_putc(ob, ' ');
+}
+
+/* Distância de p ao segmento a-b (ao ponto a se o segmento é degenerado,
+ * como nas curvas fechadas) */
+static double dist_segmento(double px, double py, double ax, double ay,
+                            double bx, double by) {
+    double vx = bx - ax, vy = by - ay;
+    double len2 = vx * vx + vy * vy;
+    double u = len2 > 0 ? ((px - ax) * vx + (py - ay) * vy) / len2 : 0.0;
+    if (u < 0) u = 0;
+    if (u > 1) u = 1;
+    return hypot(px - (ax + u * vx), py - (ay + u * vy));
+}
+
+int render_simplify(const double *px, const double *py, int n, double tolerance,
+                    unsigned char *keep) {
+    if (n <= 2 || !(tolerance > 0)) {
+        memset(keep, 1, n > 0 ? n : 0);
+        return n > 0 ? n : 0;
+    }
+    
+    // Pilha explícita de trechos [a, b] (a recursão poderia ter profundidade n)
+    int *pilha = malloc(2 * n * sizeof(int));
+    if (!pilha) {
+        memset(keep, 1, n);
+        return -1;
+    }
+    memset(keep, 0, n);
+    keep[0] = keep[n - 1] = 1;
+    int mantidos = 2;
+    int topo = 0;
+    pilha[topo++] = 0;
+    pilha[topo++] = n - 1;
+    
+    while (topo > 0) {
+        int b = pilha[--topo];
+        int a = pilha[--topo];
+        
+        // Ponto mais distante da corda a-b
+        double pior = -1.0;
+        int k = -1;
+        for (int i = a + 1; i < b; i++) {
+            double d = dist_segmento(px[i], py[i], px[a], py[a], px[b], py[b]);
+            if (d > pior) {
+                pior = d;
+                k = i;
+            }
+        }
+        if (k < 0 || pior <= tolerance) continue;
+        
+        keep[k] = 1;
+        mantidos++;
+        pilha[topo++] = a;
+        pilha[topo++] = k;
+        pilha[topo++] = k;
+        pilha[topo++] = b;
+    }
+    
+    free(pilha);
+    return mantidos;
+}
+
+/* Emite a poligonal simplificada. inicio[i] marca o primeiro ponto de cada
+ * trecho (depois de uma amostra inválida ou de um ponto fora dos limites):
+ * os trechos são simplificados separadamente, então as extremidades de cada
+ * quebra continuam na saída. Retorna 0 se faltar memória. */
+static int emitir_simplificada(OutBuf *ob, const double *px, const double *py,
+                               const unsigned char *inicio, int n, double tolerance) {
+    unsigned char *keep = malloc(n > 0 ? n : 1);
+    if (!keep) return 0;
+    
+    for (int a = 0; a < n; ) {
+        int b = a + 1;
+        while (b < n && !inicio[b]) b++;
+        if (render_simplify(px + a, py + a, b - a, tolerance, keep + a) < 0) {
+            free(keep);
+            return 0;
+        }
+        a = b;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        if (keep[i]) emitir_ponto(ob, px[i], py[i]);
+    }
+    free(keep);
+    return 1;
+}
+
+void render_svg_sink(OutSink *out, const PlotData *data, const char *title,
+                     int canvas_w, int canvas_h) {
     if (!data || data->count == 0) return;
     
     // Dimensões do canvas e área de plotagem (20% margem, 10% cada lado)
@@ -31,11 +199,11 @@ void render_svg(const PlotData *data, const char *title, int canvas_w, int canva
     
     // Calcula bounding box dos dados (com limite para evitar valores extremos)
     #define MAX_COORD 1e6  // Limite razoável para coordenadas
-    double minx = data->x[0], maxx = data->x[0];
-    double miny = data->y[0], maxy = data->y[0];
+    double minx = plot_data_x(data, 0), maxx = minx;
+    double miny = plot_data_y(data, 0), maxy = miny;
     for (int i = 1; i < data->count; i++) {
-        double x = data->x[i];
-        double y = data->y[i];
+        double x = plot_data_x(data, i);
+        double y = plot_data_y(data, i);
         
         // Ignora valores infinitos ou muito grandes (divisão por zero, etc)
         if (!isfinite(x) || fabs(x) > MAX_COORD) continue;
@@ -60,19 +228,21 @@ void render_svg(const PlotData *data, const char *title, int canvas_w, int canva
     #define TO_PX(x) (MARGIN_X + ((x) - minx) * PLOT_W / rangex)
     #define TO_PY(y) ((CANVAS_H - MARGIN_Y) - ((y) - miny) * PLOT_H / rangey)
     
-    // Header SVG
-    printf("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
-    printf("<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\">\n", canvas_w, canvas_h);
+    // Header SVG (todo o texto passa pelo OutBuf)
+    OutBuf ob;
+    outbuf_init_sink(&ob, out);
+    outbuf_printf(&ob, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    outbuf_printf(&ob, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\">\n", canvas_w, canvas_h);
     
     if (title) {
-        printf("  <title>%s</title>\n", title);
+        outbuf_printf(&ob, "  <title>%s</title>\n", title);
     }
     
     // Fundo branco
-    printf("  <rect width=\"%d\" height=\"%d\" fill=\"%s\"/>\n", canvas_w, canvas_h, COLOR_BACKGROUND);
+    outbuf_printf(&ob, "  <rect width=\"%d\" height=\"%d\" fill=\"%s\"/>\n", canvas_w, canvas_h, COLOR_BACKGROUND);
     
     // Grade principal (1.0 em 1.0)
-    printf("  <g stroke=\"%s\" stroke-width=\"1\">\n", COLOR_GRID_MAJOR);
+    outbuf_printf(&ob, "  <g stroke=\"%s\" stroke-width=\"1\">\n", COLOR_GRID_MAJOR);
     
     // Linhas verticais (X)
     int x_start = (int)floor(minx);
@@ -82,8 +252,7 @@ void render_svg(const PlotData *data, const char *title, int canvas_w, int canva
         double px = TO_PX(x);
         double py_bottom = TO_PY(miny);
         double py_top = TO_PY(maxy);
-        printf("    <line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\"/>\n",
-               px, py_bottom, px, py_top);
+        emitir_linha(&ob, px, py_bottom, px, py_top);
     }
     
     // Linhas horizontais (Y)
@@ -94,14 +263,13 @@ void render_svg(const PlotData *data, const char *title, int canvas_w, int canva
         double py = TO_PY(y);
         double px_left = TO_PX(minx);
         double px_right = TO_PX(maxx);
-        printf("    <line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\"/>\n",
-               px_left, py, px_right, py);
+        emitir_linha(&ob, px_left, py, px_right, py);
     }
     
-    printf("  </g>\n");
+    outbuf_printf(&ob, "  </g>\n");
     
     // Tics menores (0.2 em 0.2)
-    printf("  <g stroke=\"%s\" stroke-width=\"0.5\">\n", COLOR_GRID_MINOR);
+    outbuf_printf(&ob, "  <g stroke=\"%s\" stroke-width=\"0.5\">\n", COLOR_GRID_MINOR);
     
     // Tics verticais
     double x_tic_start = ceil(minx / 0.2) * 0.2;
@@ -111,8 +279,7 @@ void render_svg(const PlotData *data, const char *title, int canvas_w, int canva
         double px = TO_PX(xt);
         double py_bottom = TO_PY(miny);
         double py_top = TO_PY(maxy);
-        printf("    <line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\"/>\n",
-               px, py_bottom, px, py_top);
+        emitir_linha(&ob, px, py_bottom, px, py_top);
     }
     
     // Tics horizontais
@@ -123,26 +290,24 @@ void render_svg(const PlotData *data, const char *title, int canvas_w, int canva
         double py = TO_PY(yt);
         double px_left = TO_PX(minx);
         double px_right = TO_PX(maxx);
-        printf("    <line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\"/>\n",
-               px_left, py, px_right, py);
+        emitir_linha(&ob, px_left, py, px_right, py);
     }
     
-    printf("  </g>\n");
+    outbuf_printf(&ob, "  </g>\n");
     
     // Eixos em X=0 e Y=0 (destacados)
     int x_zero_visible = (minx <= 0 && maxx >= 0);
     int y_zero_visible = (miny <= 0 && maxy >= 0);
     
     if (x_zero_visible || y_zero_visible) {
-        printf("  <g stroke=\"%s\" stroke-width=\"2\">\n", COLOR_AXES);
+        outbuf_printf(&ob, "  <g stroke=\"%s\" stroke-width=\"2\">\n", COLOR_AXES);
         
         if (y_zero_visible) {
             // Eixo Y (vertical em X=0)
             double px = TO_PX(0);
             double py_bottom = TO_PY(miny);
             double py_top = TO_PY(maxy);
-            printf("    <line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\"/>\n",
-                   px, py_bottom, px, py_top);
+            emitir_linha(&ob, px, py_bottom, px, py_top);
         }
         
         if (x_zero_visible) {
@@ -150,31 +315,105 @@ void render_svg(const PlotData *data, const char *title, int canvas_w, int canva
             double py = TO_PY(0);
             double px_left = TO_PX(minx);
             double px_right = TO_PX(maxx);
-            printf("    <line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\"/>\n",
-                   px_left, py, px_right, py);
+            emitir_linha(&ob, px_left, py, px_right, py);
         }
         
-        printf("  </g>\n");
+        outbuf_printf(&ob, "  </g>\n");
     }
     
     // Curva (filtra pontos com valores extremos)
-    printf("  <polyline fill=\"none\" stroke=\"%s\" stroke-width=\"2\" points=\"", COLOR_CURVE);
-    for (int i = 0; i < data->count; i++) {
-        double x = data->x[i];
-        double y = data->y[i];
+    outbuf_printf(&ob, "  <polyline fill=\"none\" stroke=\"%s\" stroke-width=\"2\" points=\"", COLOR_CURVE);
+    
+    // Simplificação opcional em pixels (ver render_simplify_tolerance)
+    double *spx = NULL, *spy = NULL;
+    unsigned char *inicio = NULL;
+    int simplificada = 0;
+    if (render_simplify_tolerance > 0) {
+        spx = malloc(data->count * sizeof(double));
+        spy = malloc(data->count * sizeof(double));
+        inicio = malloc(data->count);
+        if (spx && spy && inicio) {
+            // Um trecho começa em cada trecho de amostras válidas do
+            // PlotData e depois de um ponto filtrado
+            int n = 0;
+            PlotSegment seg = {0};
+            while (plot_data_next_segment(data, &seg)) {
+                int quebra = 1;
+                for (int i = seg.first; i < seg.first + seg.len; i++) {
+                    double x = plot_data_x(data, i);
+                    double y = plot_data_y(data, i);
+                    if (!isfinite(x) || !isfinite(y) ||
+                        x < minx || x > maxx || y < miny || y > maxy) {
+                        quebra = 1;
+                        continue;
+                    }
+                    spx[n] = TO_PX(x);
+                    spy[n] = TO_PY(y);
+                    inicio[n] = (unsigned char)quebra;
+                    quebra = 0;
+                    n++;
+                }
+            }
+            simplificada = emitir_simplificada(&ob, spx, spy, inicio, n,
+                                               render_simplify_tolerance);
+        }
+        free(spx);
+        free(spy);
+        free(inicio);
+    }
+    
+    for (int i = 0; i < data->count && !simplificada; i++) {
+        double x = plot_data_x(data, i);
+        double y = plot_data_y(data, i);
         
         // Pula pontos com valores extremos
         if (!isfinite(x) || !isfinite(y)) continue;
         if (x < minx || x > maxx || y < miny || y > maxy) continue;
         
-        double px = TO_PX(x);
-        double py = TO_PY(y);
-        printf("%.2f,%.2f ", px, py);
+        emitir_ponto(&ob, TO_PX(x), TO_PY(y));
     }
-    printf("\"/>\n");
+    outbuf_printf(&ob, "\"/>\n");
     
-    printf("</svg>\n");
+    outbuf_printf(&ob, "</svg>\n");
+    outbuf_flush(&ob);
     
     #undef TO_PX
     #undef TO_PY
 }
+
+void render_svg(const PlotData *data, const char *title, int canvas_w, int canvas_h) {
+    render_svg_file(stdout, data, title, canvas_w, canvas_h);
+}
+
+void render_svg_file(FILE *out, const PlotData *data, const char *title,
+                     int canvas_w, int canvas_h) {
+    OutSink sink;
+    outsink_file(&sink, out);
+    render_svg_sink(&sink, data, title, canvas_w, canvas_h);
+}
+
+int render_plot_sink(OutSink *out, const Plot *plot, const PlotData *data, const char *title,
+                     const char *format, int canvas_w, int canvas_h) {
+    if (!data) return 0;
+    if (strcmp(format, "csv") == 0) {
+        render_csv_sink(out, data);
+    } else if (strcmp(format, "bin") == 0) {
+        if (!plotbin_write_sink(out, plot, data)) return 0;
+    } else if (plot->type == PLOT_CARTESIAN && data->count > 4 * canvas_w) {
+        // SVG cartesiano com mais pontos que colunas de pixel: decimação M4
+        PlotData *decimado = decimate_plot(data, canvas_w);
+        render_svg_sink(out, decimado ? decimado : data, title, canvas_w, canvas_h);
+        plot_data_free(decimado);
+    } else {
+        render_svg_sink(out, data, title, canvas_w, canvas_h);
+    }
+    return !out->error;
+}
+
+int render_plot(FILE *out, const Plot *plot, const PlotData *data, const char *title,
+                const char *format, int canvas_w, int canvas_h) {
+    OutSink sink;
+    outsink_file(&sink, out);
+    int ok = render_plot_sink(&sink, plot, data, title, format, canvas_w, canvas_h);
+    return outsink_finish(&sink) && ok && !ferror(out);
+}
@@ -0,0 +1,456 @@
+/* Modo servidor: fila de conexões atendida por workers persistentes, pedidos
+ * renderizados num sink em memória e respondidos com o tamanho na frente
+ * (cabeçalho e payload num só writev). Cada conexão tem uma arena para Plot,
+ * PlotData e o payload, zerada a cada pedido. */
+#define _POSIX_C_SOURCE 200809L  /* getline, fdopen, clock_gettime */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "serve.h"
+#include "batch.h"
+#include "exprcache.h"
+#include "multicurvas_plot.h"
+#include "render.h"
+#include "threadpool.h"
+
+#define SERVE_MAX_CAMPOS 8
+
+/* Conexões aceitas esperando um worker (além disso são recusadas) */
+#define SERVE_QUEUE 64
+
+struct Server {
+    int workers;
+    pthread_t *threads;
+    int parar;                  /* lido/escrito com __atomic (server_stop vem de sinais) */
+    int listen_fd;              /* idem */
+
+    pthread_mutex_t lock;
+    pthread_cond_t cv;
+    int fila[SERVE_QUEUE];      /* conexões aceitas (circular) */
+    int fila_ini;
+    int fila_n;
+    int *ativos;                /* conexão de cada worker (-1: livre) */
+
+    pthread_mutex_t stats_lock;
+    double latencias[SERVE_LATENCY_WINDOW];   /* ms, circular */
+    uint64_t requests;
+    uint64_t errors;
+    double max_ms;
+};
+
+typedef struct {
+    Server *server;
+    int id;
+} Worker;
+
+Server *server_create(int workers) {
+    if (workers <= 0) workers = threadpool_default_threads();
+    Server *s = calloc(1, sizeof(Server));
+    if (!s) return NULL;
+    s->ativos = malloc(workers * sizeof(int));
+    if (!s->ativos) {
+        free(s);
+        return NULL;
+    }
+    for (int i = 0; i < workers; i++) s->ativos[i] = -1;
+    s->workers = workers;
+    s->listen_fd = -1;
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->cv, NULL);
+    pthread_mutex_init(&s->stats_lock, NULL);
+    return s;
+}
+
+void server_destroy(Server *s) {
+    if (!s) return;
+    pthread_mutex_destroy(&s->lock);
+    pthread_cond_destroy(&s->cv);
+    pthread_mutex_destroy(&s->stats_lock);
+    free(s->ativos);
+    free(s);
+}
+
+static int parado(Server *s) {
+    return __atomic_load_n(&s->parar, __ATOMIC_SEQ_CST);
+}
+
+void server_stop(Server *s) {
+    __atomic_store_n(&s->parar, 1, __ATOMIC_SEQ_CST);
+    int fd = __atomic_load_n(&s->listen_fd, __ATOMIC_SEQ_CST);
+    if (fd >= 0) shutdown(fd, SHUT_RDWR);
+}
+
+/* ========================================================================
+ * Estatísticas
+ * ======================================================================== */
+
+static double ms_desde(const struct timespec *t0) {
+    struct timespec t1;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    return (t1.tv_sec - t0->tv_sec) * 1e3 + (t1.tv_nsec - t0->tv_nsec) / 1e6;
+}
+
+static void registrar(Server *s, double ms, int ok) {
+    pthread_mutex_lock(&s->stats_lock);
+    s->latencias[s->requests % SERVE_LATENCY_WINDOW] = ms;
+    s->requests++;
+    if (!ok) s->errors++;
+    if (ms > s->max_ms) s->max_ms = ms;
+    pthread_mutex_unlock(&s->stats_lock);
+}
+
+static int comparar_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+ServerStats server_stats(Server *s) {
+    ServerStats st = {0};
+    double janela[SERVE_LATENCY_WINDOW];
+    pthread_mutex_lock(&s->stats_lock);
+    st.requests = s->requests;
+    st.errors = s->errors;
+    st.max_ms = s->max_ms;
+    int n = s->requests < SERVE_LATENCY_WINDOW ? (int)s->requests : SERVE_LATENCY_WINDOW;
+    memcpy(janela, s->latencias, n * sizeof(double));
+    pthread_mutex_unlock(&s->stats_lock);
+
+    if (n > 0) {
+        qsort(janela, n, sizeof(double), comparar_double);
+        st.p50_ms = janela[(n - 1) * 50 / 100];
+        st.p99_ms = janela[(n - 1) * 99 / 100];
+    }
+    return st;
+}
+
+/* ========================================================================
+ * Pedidos
+ * ======================================================================== */
+
+static void responder(OutSink *out, const char *payload, size_t len) {
+    char cabecalho[32];
+    int n = snprintf(cabecalho, sizeof(cabecalho), "OK %zu\n", len);
+    struct iovec v[2] = { { cabecalho, (size_t)n }, { (void *)payload, len } };
+    outsink_writev(out, v, 2);
+}
+
+static void responder_erro(OutSink *out, const char *msg) {
+    if (!msg) msg = "memória insuficiente";
+    struct iovec v[3] = { { "ERR ", 4 }, { (void *)msg, strlen(msg) }, { "\n", 1 } };
+    outsink_writev(out, v, 3);
+}
+
+static void responder_stats(Server *s, OutSink *out) {
+    ServerStats st = server_stats(s);
+    char texto[512];
+    int n = snprintf(texto, sizeof(texto),
+                     "pedidos %llu\nerros %llu\np50_ms %.3f\np99_ms %.3f\nmax_ms %.3f\n",
+                     (unsigned long long)st.requests, (unsigned long long)st.errors,
+                     st.p50_ms, st.p99_ms, st.max_ms);
+    ExprCache *cache = plot_program_cache();
+    if (cache) {
+        ExprCacheStats cs = exprcache_stats(cache);
+        n += snprintf(texto + n, sizeof(texto) - n, "cache_acertos %llu\ncache_faltas %llu\n",
+                      (unsigned long long)cs.hits, (unsigned long long)cs.misses);
+    }
+    n += snprintf(texto + n, sizeof(texto) - n, "workers %d\n", s->workers);
+    responder(out, texto, n);
+}
+
+/* Erro "formato: campo" alocado */
+static char *erro_campo(const char *formato, const char *campo) {
+    char msg[160];
+    snprintf(msg, sizeof(msg), formato, campo);
+    return strdup(msg);
+}
+
+/* Gera a curva pedida (memória em `arena`, se não for NULL) e renderiza o
+ * payload em `mem`. Retorna 0 em caso de erro (mensagem em errmsg). */
+static int atender(char **campos, int n, OutSink *mem, Arena *arena, char **errmsg) {
+    const char *formato = "svg";
+    const char *intervalo = NULL;
+    int dims[2] = { 800, 600 }, ndims = 0;
+    long amostras = 0;
+    double tolerancia = 0;
+
+    // <expressão> [formato] [largura altura] [samples=N] [interval=C,D] [adaptive=TOL]
+    for (int i = 1; i < n; i++) {
+        char *campo = campos[i], *fim;
+        char *valor = strchr(campo, '=');
+        if (valor) {
+            *valor++ = '\0';
+            if (strcmp(campo, "samples") == 0) {
+                amostras = strtol(valor, &fim, 10);
+                if (*fim || amostras < 2 || amostras > SERVE_MAX_SAMPLES) {
+                    *errmsg = erro_campo("número de amostras inválido: %s", valor);
+                    return 0;
+                }
+            } else if (strcmp(campo, "interval") == 0) {
+                intervalo = valor;
+            } else if (strcmp(campo, "adaptive") == 0) {
+                tolerancia = strtod(valor, &fim);
+                if (*fim || !(tolerancia > 0)) {
+                    *errmsg = erro_campo("tolerância inválida: %s", valor);
+                    return 0;
+                }
+            } else {
+                *errmsg = erro_campo("opção desconhecida: %s", campo);
+                return 0;
+            }
+        } else if (strcmp(campo, "csv") == 0 || strcmp(campo, "svg") == 0 ||
+                   strcmp(campo, "bin") == 0) {
+            formato = campo;
+        } else {
+            long v = strtol(campo, &fim, 10);
+            if (*fim || v <= 0 || v > 100000 || ndims == 2) {
+                *errmsg = erro_campo("campo inválido: %s", campo);
+                return 0;
+            }
+            dims[ndims++] = (int)v;
+        }
+    }
+    if (ndims == 1) {
+        *errmsg = strdup("falta a altura do canvas");
+        return 0;
+    }
+
+    // interval=C,D vira o sufixo :C,D: da expressão
+    char *expressao = campos[0];
+    char *com_intervalo = NULL;
+    if (intervalo) {
+        if (strchr(expressao, ':')) {
+            *errmsg = strdup("intervalo na expressão e em interval=");
+            return 0;
+        }
+        size_t len = strlen(expressao) + strlen(intervalo) + 3;
+        com_intervalo = arena ? arena_alloc(arena, len) : malloc(len);
+        if (!com_intervalo) return 0;
+        snprintf(com_intervalo, len, "%s:%s:", expressao, intervalo);
+        expressao = com_intervalo;
+    }
+
+    Plot *plot = plot_parse_text_arena(expressao, arena, errmsg);
+    if (!arena) free(com_intervalo);
+    if (!plot) return 0;
+    if (amostras > 0) plot->samples = (int)amostras;
+    if (tolerancia > 0) plot_set_adaptive(plot, tolerancia, dims[0], dims[1]);
+    PlotData *data = plot_generate_samples_arena(plot, arena, errmsg);
+    if (!data) {
+        plot_free(plot);
+        return 0;
+    }
+
+    int ok = render_plot_sink(mem, plot, data, campos[0], formato, dims[0], dims[1]);
+    if (!ok) *errmsg = strdup("memória insuficiente ao renderizar");
+    plot_data_free(data);
+    plot_free(plot);
+    return ok;
+}
+
+/* server_handle_line com a arena da conexão */
+static int tratar_linha(Server *s, const char *line, OutSink *out, Arena *arena) {
+    struct timespec t0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    char *campos[SERVE_MAX_CAMPOS];
+    const char *erro = NULL;
+    int n = batch_split_fields(line, campos, SERVE_MAX_CAMPOS, &erro);
+    if (n == 0) return 1;
+    if (n < 0) {
+        registrar(s, ms_desde(&t0), 0);
+        responder_erro(out, erro);
+        return 1;
+    }
+
+    int continuar = 1;
+    if (n == 1 && strcmp(campos[0], "stats") == 0) {
+        responder_stats(s, out);
+    } else if (n == 1 && strcmp(campos[0], "quit") == 0) {
+        continuar = 0;
+    } else if (n == 1 && strcmp(campos[0], "shutdown") == 0) {
+        responder(out, NULL, 0);
+        server_stop(s);
+        continuar = 0;
+    } else {
+        // O payload só aloca na arena ao renderizar, depois de Plot e
+        // PlotData: é a última alocação e cresce no lugar
+        char *errmsg = NULL;
+        OutSink mem;
+        outsink_memory(&mem, arena);
+        int ok = atender(campos, n, &mem, arena, &errmsg);
+        // Contado antes de responder: um `stats` enviado depois da resposta
+        // já inclui este pedido
+        registrar(s, ms_desde(&t0), ok);
+        if (ok) {
+            responder(out, mem.data, mem.len);
+        } else {
+            responder_erro(out, errmsg);
+        }
+        free(errmsg);
+        outsink_free(&mem);
+        if (arena) arena_reset(arena);
+    }
+    for (int i = 0; i < n; i++) free(campos[i]);
+    return continuar;
+}
+
+int server_handle_line(Server *s, const char *line, FILE *out) {
+    OutSink sink;
+    outsink_file(&sink, out);
+    return tratar_linha(s, line, &sink, NULL);
+}
+
+void server_serve_fd(Server *s, int in_fd, int out_fd) {
+    int fd_in = dup(in_fd);
+    FILE *in = fd_in >= 0 ? fdopen(fd_in, "r") : NULL;
+    if (!in) {
+        if (fd_in >= 0) close(fd_in);
+        return;
+    }
+    // Respostas direto no fd, sem o buffer do stdio
+    OutSink out;
+    outsink_fd(&out, out_fd);
+
+    // Sem memória para a arena, os pedidos usam malloc
+    Arena *arena = arena_create(0);
+    char *line = NULL;
+    size_t cap = 0;
+    while (!parado(s) && getline(&line, &cap, in) != -1) {
+        int continuar = tratar_linha(s, line, &out, arena);
+        if (out.error || !continuar) break;
+    }
+    free(line);
+    arena_destroy(arena);
+    fclose(in);
+}
+
+/* ========================================================================
+ * Socket
+ * ======================================================================== */
+
+static void *worker_main(void *arg) {
+    Worker *w = arg;
+    Server *s = w->server;
+    for (;;) {
+        pthread_mutex_lock(&s->lock);
+        while (!parado(s) && s->fila_n == 0) pthread_cond_wait(&s->cv, &s->lock);
+        if (parado(s)) {
+            pthread_mutex_unlock(&s->lock);
+            break;
+        }
+        int fd = s->fila[s->fila_ini];
+        s->fila_ini = (s->fila_ini + 1) % SERVE_QUEUE;
+        s->fila_n--;
+        s->ativos[w->id] = fd;
+        pthread_mutex_unlock(&s->lock);
+
+        server_serve_fd(s, fd, fd);
+
+        pthread_mutex_lock(&s->lock);
+        s->ativos[w->id] = -1;
+        pthread_mutex_unlock(&s->lock);
+        close(fd);
+    }
+    return NULL;
+}
+
+static char *erro_socket(const char *etapa, const char *path) {
+    char detalhe[128], msg[512];
+    strerror_r(errno, detalhe, sizeof(detalhe));
+    snprintf(msg, sizeof(msg), "%s '%s': %s", etapa, path, detalhe);
+    return strdup(msg);
+}
+
+int server_listen(Server *s, const char *path, char **errmsg) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        if (errmsg) *errmsg = strdup("caminho do socket longo demais");
+        return 0;
+    }
+    strcpy(addr.sun_path, path);
+
+    // Socket antigo (servidor anterior encerrado sem remover) é substituído
+    struct stat st;
+    if (lstat(path, &st) == 0 && S_ISSOCK(st.st_mode)) unlink(path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(fd, SERVE_QUEUE) != 0) {
+        if (errmsg) *errmsg = erro_socket("não foi possível escutar em", path);
+        if (fd >= 0) close(fd);
+        return 0;
+    }
+
+    Worker *workers = malloc(s->workers * sizeof(Worker));
+    s->threads = malloc(s->workers * sizeof(pthread_t));
+    int iniciados = 0;
+    __atomic_store_n(&s->listen_fd, fd, __ATOMIC_SEQ_CST);
+    for (int i = 0; workers && s->threads && i < s->workers; i++) {
+        workers[i].server = s;
+        workers[i].id = i;
+        if (pthread_create(&s->threads[i], NULL, worker_main, &workers[i]) != 0) break;
+        iniciados++;
+    }
+    if (iniciados == 0) server_stop(s);
+
+    while (!parado(s)) {
+        int c = accept(fd, NULL, NULL);
+        if (c < 0) {
+            if (parado(s)) break;
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno == EMFILE || errno == ENFILE) {
+                struct timespec espera = { 0, 10000000 };
+                nanosleep(&espera, NULL);
+                continue;
+            }
+            break;
+        }
+        pthread_mutex_lock(&s->lock);
+        if (s->fila_n == SERVE_QUEUE) {
+            pthread_mutex_unlock(&s->lock);
+            static const char ocupado[] = "ERR servidor ocupado\n";
+            if (write(c, ocupado, sizeof(ocupado) - 1) < 0) { /* cliente já saiu */ }
+            close(c);
+            continue;
+        }
+        s->fila[(s->fila_ini + s->fila_n) % SERVE_QUEUE] = c;
+        s->fila_n++;
+        pthread_cond_signal(&s->cv);
+        pthread_mutex_unlock(&s->lock);
+    }
+
+    // Encerramento: conexões abertas terminam o pedido em andamento
+    pthread_mutex_lock(&s->lock);
+    __atomic_store_n(&s->parar, 1, __ATOMIC_SEQ_CST);
+    for (int i = 0; i < s->workers; i++) {
+        if (s->ativos[i] >= 0) shutdown(s->ativos[i], SHUT_RD);
+    }
+    pthread_cond_broadcast(&s->cv);
+    pthread_mutex_unlock(&s->lock);
+    for (int i = 0; i < iniciados; i++) pthread_join(s->threads[i], NULL);
+    while (s->fila_n > 0) {
+        close(s->fila[s->fila_ini]);
+        s->fila_ini = (s->fila_ini + 1) % SERVE_QUEUE;
+        s->fila_n--;
+    }
+    __atomic_store_n(&s->listen_fd, -1, __ATOMIC_SEQ_CST);
+    close(fd);
+    unlink(path);
+    free(workers);
+    free(s->threads);
+    s->threads = NULL;
+    if (iniciados == 0) {
+        if (errmsg) *errmsg = strdup("não foi possível criar os workers");
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,294 @@
+/* Motor de código encadeado: computed goto (GCC/Clang) ou tabela de handlers */
+#include <stdlib.h>
+#include <math.h>
+#include "threaded.h"
+
+#if defined(__GNUC__) && !defined(THREADED_NO_COMPUTED_GOTO)
+#define THREADED_COMPUTED_GOTO 1
+#else
+#define THREADED_COMPUTED_GOTO 0
+#endif
+
+/* Funções unárias: (nome, domínio inválido, expressão sobre `a`) */
+#define THREADED_FUNCTIONS(X) \
+    X(SIN,   0,                      sin(a))       \
+    X(COS,   0,                      cos(a))       \
+    X(TAN,   0,                      tan(a))       \
+    X(ABS,   0,                      fabs(a))      \
+    X(SQRT,  a < 0.0,                sqrt(a))      \
+    X(EXP,   0,                      exp(a))       \
+    X(LOG,   a <= 0.0,               log(a))       \
+    X(LOG10, a <= 0.0,               log10(a))     \
+    X(SINH,  0,                      sinh(a))      \
+    X(COSH,  0,                      cosh(a))      \
+    X(TANH,  0,                      tanh(a))      \
+    X(ASIN,  a < -1.0 || a > 1.0,    asin(a))      \
+    X(ACOS,  a < -1.0 || a > 1.0,    acos(a))      \
+    X(ATAN,  0,                      atan(a))      \
+    X(ASINH, 0,                      asinh(a))     \
+    X(ACOSH, a < 1.0,                acosh(a))     \
+    X(ATANH, a <= -1.0 || a >= 1.0,  atanh(a))     \
+    X(CEIL,  0,                      ceil(a))      \
+    X(FLOOR, 0,                      floor(a))     \
+    X(FRAC,  0,                      a - floor(a))
+
+/* Opcodes internos do código encadeado */
+typedef enum {
+    TOP_PUSH,       /* empilha operando (número ou constante) */
+    TOP_VAR,        /* empilha a variável */
+    TOP_ADD, TOP_SUB, TOP_MUL, TOP_DIV, TOP_POW,
+    TOP_NEG,
+#define X(name, invalid, expr) TOP_##name,
+    THREADED_FUNCTIONS(X)
+#undef X
+    TOP_END,        /* resultado = topo da pilha */
+    TOP_FAIL,       /* erro estrutural detectado na tradução */
+    TOP_COUNT
+} ThreadedOpcode;
+
+typedef struct ThreadedState ThreadedState;
+typedef struct ThreadedOp ThreadedOp;
+
+/* Handler da variante com ponteiros para função: retorna 0 para continuar */
+typedef int (*ThreadedHandler)(ThreadedState *st, const ThreadedOp *op);
+
+struct ThreadedOp {
+    union {
+        const void *label;          /* computed goto */
+        ThreadedHandler fn;         /* tabela de handlers */
+    } h;
+    double operand;                 /* TOP_PUSH */
+    EvalError error;                /* TOP_FAIL */
+};
+
+struct ThreadedProgram {
+    ThreadedOp *ops;
+    int size;
+};
+
+/* Corpo de cada operação. `sp` aponta para a próxima posição livre da pilha;
+ * FAIL(err) encerra com erro e NEXT segue para o próximo handler. */
+#define CHECK_FINITE(r) if (isnan(r) || isinf(r)) { FAIL(EVAL_MATH_ERROR); }
+
+#define BODY_PUSH   { *sp++ = ip->operand; }
+#define BODY_VAR    { *sp++ = var; }
+#define BODY_ADD    { sp--; double r = sp[-1] + sp[0]; CHECK_FINITE(r); sp[-1] = r; }
+#define BODY_SUB    { sp--; double r = sp[-1] - sp[0]; CHECK_FINITE(r); sp[-1] = r; }
+#define BODY_MUL    { sp--; double r = sp[-1] * sp[0]; CHECK_FINITE(r); sp[-1] = r; }
+#define BODY_DIV    { sp--; if (sp[0] == 0.0) { FAIL(EVAL_DIVISION_BY_ZERO); } \
+                      double r = sp[-1] / sp[0]; CHECK_FINITE(r); sp[-1] = r; }
+#define BODY_POW    { sp--; double r = pow(sp[-1], sp[0]); \
+                      if (isnan(r)) { FAIL(EVAL_DOMAIN_ERROR); } CHECK_FINITE(r); sp[-1] = r; }
+#define BODY_NEG    { sp[-1] = -sp[-1]; }
+#define BODY_FUNC(invalid, expr) \
+                    { double a = sp[-1]; if (invalid) { FAIL(EVAL_DOMAIN_ERROR); } \
+                      double r = (expr); CHECK_FINITE(r); sp[-1] = r; }
+
+#if THREADED_COMPUTED_GOTO
+
+/* Executa o código encadeado. Com `table` != NULL apenas exporta a tabela de
+ * rótulos (os endereços só são acessíveis dentro desta função). */
+static EvalResult threaded_run(const ThreadedOp *ip, double var, const void *const **table) {
+    static const void *const labels[TOP_COUNT] = {
+        [TOP_PUSH] = &&op_PUSH, [TOP_VAR] = &&op_VAR,
+        [TOP_ADD] = &&op_ADD, [TOP_SUB] = &&op_SUB, [TOP_MUL] = &&op_MUL,
+        [TOP_DIV] = &&op_DIV, [TOP_POW] = &&op_POW, [TOP_NEG] = &&op_NEG,
+#define X(name, invalid, expr) [TOP_##name] = &&op_##name,
+        THREADED_FUNCTIONS(X)
+#undef X
+        [TOP_END] = &&op_END, [TOP_FAIL] = &&op_FAIL
+    };
+
+    EvalResult result = {EVAL_OK, 0.0};
+    if (table) {
+        *table = labels;
+        return result;
+    }
+
+    double stack[MAX_EVAL_STACK_SIZE];
+    double *sp = stack;
+
+#define FAIL(err) do { result.error = (err); return result; } while (0)
+#define NEXT      goto *(++ip)->h.label
+
+    goto *ip->h.label;
+
+op_PUSH: BODY_PUSH NEXT;
+op_VAR:  BODY_VAR  NEXT;
+op_ADD:  BODY_ADD  NEXT;
+op_SUB:  BODY_SUB  NEXT;
+op_MUL:  BODY_MUL  NEXT;
+op_DIV:  BODY_DIV  NEXT;
+op_POW:  BODY_POW  NEXT;
+op_NEG:  BODY_NEG  NEXT;
+#define X(name, invalid, expr) op_##name: BODY_FUNC(invalid, expr) NEXT;
+    THREADED_FUNCTIONS(X)
+#undef X
+op_END:
+    result.value = stack[0];
+    return result;
+op_FAIL:
+    result.error = ip->error;
+    return result;
+
+#undef FAIL
+#undef NEXT
+}
+
+#else /* !THREADED_COMPUTED_GOTO */
+
+struct ThreadedState {
+    double *sp;
+    double var;
+    EvalResult result;
+};
+
+#define FAIL(err) do { st->result.error = (err); return 1; } while (0)
+#define HANDLER(name, body) \
+    static int h_##name(ThreadedState *st, const ThreadedOp *ip) { \
+        double *sp = st->sp; \
+        double var = st->var; \
+        (void)ip; (void)var; \
+        body \
+        st->sp = sp; \
+        return 0; \
+    }
+
+HANDLER(PUSH, BODY_PUSH)
+HANDLER(VAR,  BODY_VAR)
+HANDLER(ADD,  BODY_ADD)
+HANDLER(SUB,  BODY_SUB)
+HANDLER(MUL,  BODY_MUL)
+HANDLER(DIV,  BODY_DIV)
+HANDLER(POW,  BODY_POW)
+HANDLER(NEG,  BODY_NEG)
+#define X(name, invalid, expr) HANDLER(name, BODY_FUNC(invalid, expr))
+THREADED_FUNCTIONS(X)
+#undef X
+
+static int h_END(ThreadedState *st, const ThreadedOp *ip) {
+    (void)ip;
+    st->result.value = st->sp[-1];
+    return 1;
+}
+
+static int h_FAIL(ThreadedState *st, const ThreadedOp *ip) {
+    st->result.error = ip->error;
+    return 1;
+}
+
+#undef FAIL
+#undef HANDLER
+
+static const ThreadedHandler handlers[TOP_COUNT] = {
+    [TOP_PUSH] = h_PUSH, [TOP_VAR] = h_VAR,
+    [TOP_ADD] = h_ADD, [TOP_SUB] = h_SUB, [TOP_MUL] = h_MUL,
+    [TOP_DIV] = h_DIV, [TOP_POW] = h_POW, [TOP_NEG] = h_NEG,
+#define X(name, invalid, expr) [TOP_##name] = h_##name,
+    THREADED_FUNCTIONS(X)
+#undef X
+    [TOP_END] = h_END, [TOP_FAIL] = h_FAIL
+};
+
+#endif /* THREADED_COMPUTED_GOTO */
+
+/* Converte um token RPN no opcode interno */
+static ThreadedOpcode token_to_opcode(TokenType type) {
+    switch (type) {
+        case TOKEN_NUMBER:
+        case TOKEN_CONST_PI:
+        case TOKEN_CONST_E:         return TOP_PUSH;
+        case TOKEN_VARIABLE_X:
+        case TOKEN_VARIABLE_THETA:
+        case TOKEN_VARIABLE_T:      return TOP_VAR;
+        case TOKEN_PLUS:            return TOP_ADD;
+        case TOKEN_MINUS:           return TOP_SUB;
+        case TOKEN_MULT:            return TOP_MUL;
+        case TOKEN_DIV:             return TOP_DIV;
+        case TOKEN_POW:             return TOP_POW;
+        case TOKEN_NEG:             return TOP_NEG;
+#define X(name, invalid, expr) case TOKEN_##name: return TOP_##name;
+        THREADED_FUNCTIONS(X)
+#undef X
+        default:                    return TOP_FAIL;
+    }
+}
+
+ThreadedProgram *threaded_compile(const TokenBuffer *rpn) {
+    ThreadedProgram *prog = malloc(sizeof(ThreadedProgram));
+    if (!prog) return NULL;
+
+    /* Programa vazio: apenas o erro de pilha do interpretador de referência */
+    EvalError stop_error = EVAL_STACK_ERROR;
+    int stop = 0;
+    if (rpn && rpn->tokens && rpn->size > 0) {
+        stop = evaluator_validate_rpn(rpn, &stop_error);
+    }
+
+    prog->size = stop + 1;
+    prog->ops = malloc(prog->size * sizeof(ThreadedOp));
+    if (!prog->ops) {
+        free(prog);
+        return NULL;
+    }
+
+#if THREADED_COMPUTED_GOTO
+    const void *const *table;
+    threaded_run(NULL, 0.0, &table);
+#define OP_ADDRESS(op) (table[op])
+#else
+#define OP_ADDRESS(op) (handlers[op])
+#endif
+
+    for (int i = 0; i < stop; i++) {
+        Token token = rpn->tokens[i];
+        ThreadedOp *op = &prog->ops[i];
+        ThreadedOpcode code = token_to_opcode(token.type);
+
+        op->operand = 0.0;
+        op->error = EVAL_OK;
+        if (token.type == TOKEN_NUMBER) {
+            op->operand = rpn->values[token.value_index];
+        } else if (code == TOP_PUSH) {
+            op->operand = evaluator_constant(token.type);
+        }
+#if THREADED_COMPUTED_GOTO
+        op->h.label = OP_ADDRESS(code);
+#else
+        op->h.fn = OP_ADDRESS(code);
+#endif
+    }
+
+    /* Último op: fim normal ou o erro estrutural previsto pela validação */
+    ThreadedOp *last = &prog->ops[stop];
+    ThreadedOpcode last_code = (stop_error == EVAL_OK) ? TOP_END : TOP_FAIL;
+    last->operand = 0.0;
+    last->error = stop_error;
+#if THREADED_COMPUTED_GOTO
+    last->h.label = OP_ADDRESS(last_code);
+#else
+    last->h.fn = OP_ADDRESS(last_code);
+#endif
+
+#undef OP_ADDRESS
+
+    return prog;
+}
+
+EvalResult threaded_eval(const ThreadedProgram *prog, double var_value) {
+#if THREADED_COMPUTED_GOTO
+    return threaded_run(prog->ops, var_value, NULL);
+#else
+    double stack[MAX_EVAL_STACK_SIZE];
+    ThreadedState st = { stack, var_value, {EVAL_OK, 0.0} };
+    const ThreadedOp *ip = prog->ops;
+    while (!ip->h.fn(&st, ip)) ip++;
+    return st.result;
+#endif
+}
+
+void threaded_free(ThreadedProgram *prog) {
+    if (!prog) return;
+    free(prog->ops);
+    free(prog);
+}
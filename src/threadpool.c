@@ -0,0 +1,184 @@
+/* Pool de threads persistente: um contador de tarefas protegido por mutex e
+ * uma geração que acorda os workers a cada threadpool_run() */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "threadpool.h"
+
+struct ThreadPool {
+    pthread_t *workers;
+    int nworkers;
+
+    pthread_mutex_t lock;
+    pthread_cond_t work_cv;         /* nova geração ou encerramento */
+    pthread_cond_t done_cv;         /* último worker saiu da geração */
+    pthread_mutex_t run_lock;       /* serializa threadpool_run() */
+
+    /* Trabalho atual (protegido por lock) */
+    ThreadTask fn;
+    void *ctx;
+    int ntasks;
+    int next;                       /* próxima tarefa a distribuir */
+    int busy;                       /* workers ainda na geração atual */
+    unsigned generation;
+    int shutdown;
+};
+
+/* Pega e executa tarefas até acabar. Chamado com lock; retorna com lock. */
+static void drain_tasks(ThreadPool *pool) {
+    while (pool->next < pool->ntasks) {
+        int task = pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+        pool->fn(pool->ctx, task);
+        pthread_mutex_lock(&pool->lock);
+    }
+}
+
+static void *worker_main(void *arg) {
+    ThreadPool *pool = arg;
+    unsigned seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->work_cv, &pool->lock);
+        }
+        if (pool->shutdown) break;
+        seen = pool->generation;
+
+        drain_tasks(pool);
+        if (--pool->busy == 0) pthread_cond_signal(&pool->done_cv);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+ThreadPool *threadpool_create(int nthreads) {
+    if (nthreads < 1) nthreads = 1;
+
+    ThreadPool *pool = calloc(1, sizeof(ThreadPool));
+    if (!pool) return NULL;
+    pool->workers = calloc(nthreads, sizeof(pthread_t));
+    if (!pool->workers) {
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_mutex_init(&pool->run_lock, NULL);
+    pthread_cond_init(&pool->work_cv, NULL);
+    pthread_cond_init(&pool->done_cv, NULL);
+
+    for (int i = 0; i < nthreads - 1; i++) {
+        if (pthread_create(&pool->workers[i], NULL, worker_main, pool) != 0) {
+            threadpool_destroy(pool);
+            return NULL;
+        }
+        pool->nworkers++;
+    }
+    return pool;
+}
+
+int threadpool_threads(const ThreadPool *pool) {
+    return pool ? pool->nworkers + 1 : 1;
+}
+
+void threadpool_run(ThreadPool *pool, ThreadTask fn, void *ctx, int ntasks) {
+    if (!pool || pool->nworkers == 0 || ntasks <= 1) {
+        for (int t = 0; t < ntasks; t++) fn(ctx, t);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->run_lock);
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->ctx = ctx;
+    pool->ntasks = ntasks;
+    pool->next = 0;
+    pool->busy = pool->nworkers;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_cv);
+
+    /* A chamadora também trabalha */
+    drain_tasks(pool);
+    while (pool->busy > 0) pthread_cond_wait(&pool->done_cv, &pool->lock);
+
+    pool->fn = NULL;
+    pool->ctx = NULL;
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->run_lock);
+}
+
+void threadpool_destroy(ThreadPool *pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work_cv);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->nworkers; i++) pthread_join(pool->workers[i], NULL);
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->run_lock);
+    pthread_cond_destroy(&pool->work_cv);
+    pthread_cond_destroy(&pool->done_cv);
+    free(pool->workers);
+    free(pool);
+}
+
+int threadpool_cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+/* ========================================================================
+ * Pool compartilhado
+ * ======================================================================== */
+
+static int default_threads = 0;
+static ThreadPool *default_pool = NULL;
+static int default_created = 0;
+static int default_atexit = 0;
+static pthread_mutex_t default_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void destroy_default_pool(void) {
+    pthread_mutex_lock(&default_lock);
+    threadpool_destroy(default_pool);
+    default_pool = NULL;
+    default_created = 0;
+    pthread_mutex_unlock(&default_lock);
+}
+
+void threadpool_set_default_threads(int nthreads) {
+    if (nthreads < 0) nthreads = 0;
+    pthread_mutex_lock(&default_lock);
+    if (nthreads != default_threads) {
+        /* Recriado com o novo tamanho no próximo uso */
+        threadpool_destroy(default_pool);
+        default_pool = NULL;
+        default_created = 0;
+        default_threads = nthreads;
+    }
+    pthread_mutex_unlock(&default_lock);
+}
+
+int threadpool_default_threads(void) {
+    return default_threads > 0 ? default_threads : threadpool_cpu_count();
+}
+
+ThreadPool *threadpool_default(void) {
+    pthread_mutex_lock(&default_lock);
+    if (!default_created) {
+        int n = threadpool_default_threads();
+        default_pool = (n > 1) ? threadpool_create(n) : NULL;
+        default_created = 1;
+        if (default_pool && !default_atexit) {
+            atexit(destroy_default_pool);
+            default_atexit = 1;
+        }
+    }
+    ThreadPool *pool = default_pool;
+    pthread_mutex_unlock(&default_lock);
+    return pool;
+}
@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "multicurvas_plot.h"
+#include "kernels.h"
+#include "assert.h"
+
+/* Referência uniforme do tamanho de PLOT_DEFAULT_SAMPLES, mas na grade
+ * diádica (2^9 + 1) para que seus pontos também sejam pontos da curva densa */
+enum { LARGURA = 800, ALTURA = 600, UNIFORME = (1 << 9) + 1 };
+
+typedef struct {
+    const char *expr;
+    int max_samples;    /* teto de avaliações esperado com tolerância 0.5 px */
+} Caso;
+
+static Plot *parse(const char *expr) {
+    Plot *plot = plot_parse_text(expr, NULL);
+    assert(plot);
+    return plot;
+}
+
+/* Distância em pixels de p ao segmento a-b */
+static double dist_segmento(double px, double py, double ax, double ay,
+                            double bx, double by) {
+    double vx = bx - ax, vy = by - ay;
+    double len2 = vx * vx + vy * vy;
+    double u = len2 > 0 ? ((px - ax) * vx + (py - ay) * vy) / len2 : 0.0;
+    if (u < 0) u = 0;
+    if (u > 1) u = 1;
+    return hypot(px - (ax + u * vx), py - (ay + u * vy));
+}
+
+/* Maior distância (pixels) entre a curva densa e a poligonal amostrada.
+ * As amostras de `poli` são pontos de `denso` (mesma grade de parâmetros),
+ * então casam em ordem. Segmentos que atravessam amostras inválidas também
+ * contam (render_svg liga os pontos válidos em uma só poligonal). */
+static double desvio_max(const PlotData *poli, const PlotData *denso) {
+    double minx = denso->x[0], maxx = minx, miny = denso->y[0], maxy = miny;
+    for (int i = 1; i < denso->count; i++) {
+        if (denso->x[i] < minx) minx = denso->x[i];
+        if (denso->x[i] > maxx) maxx = denso->x[i];
+        if (denso->y[i] < miny) miny = denso->y[i];
+        if (denso->y[i] > maxy) maxy = denso->y[i];
+    }
+    double sx = LARGURA * 0.8 / (maxx - minx), sy = ALTURA * 0.8 / (maxy - miny);
+
+    double pior = 0.0;
+    int d = 0;
+    for (int j = 0; j + 1 < poli->count; j++) {
+        while (d < denso->count &&
+               (denso->x[d] != poli->x[j] || denso->y[d] != poli->y[j])) d++;
+        assert(d < denso->count);
+        int inicio = d;
+        int fim = d + 1;
+        while (fim < denso->count &&
+               (denso->x[fim] != poli->x[j + 1] || denso->y[fim] != poli->y[j + 1])) fim++;
+        assert(fim < denso->count);
+        for (int i = inicio + 1; i < fim; i++) {
+            double e = dist_segmento(denso->x[i] * sx, denso->y[i] * sy,
+                                     poli->x[j] * sx, poli->y[j] * sy,
+                                     poli->x[j + 1] * sx, poli->y[j + 1] * sy);
+            if (e > pior) pior = e;
+        }
+        d = fim;
+    }
+    return pior;
+}
+
+static void check_curva(const Caso *c) {
+    Plot *plot = parse(c->expr);
+    plot->samples = (1 << PLOT_ADAPTIVE_MAX_DEPTH) + 1;
+    PlotData *denso = plot_generate_samples(plot, NULL);
+    plot->samples = UNIFORME;
+    PlotData *uniforme = plot_generate_samples(plot, NULL);
+    plot_set_adaptive(plot, 0.5, LARGURA, ALTURA);
+    PlotData *adapt = plot_generate_samples(plot, NULL);
+    assert(denso && uniforme && adapt);
+
+    assert(uniforme->samples == UNIFORME);
+    assert(adapt->samples == adapt->capacity);
+    assert(adapt->samples >= (1 << PLOT_ADAPTIVE_MIN_DEPTH) + 1);
+    assert(adapt->samples <= c->max_samples);
+
+    double e_adapt = desvio_max(adapt, denso);
+    double e_unif = desvio_max(uniforme, denso);
+    printf("  %-50s adaptativa %5d amostras %.3f px | uniforme %d amostras %.3f px\n",
+           c->expr, adapt->samples, e_adapt, uniforme->samples, e_unif);
+    assert(e_adapt <= 0.5);
+
+    plot_data_free(denso);
+    plot_data_free(uniforme);
+    plot_data_free(adapt);
+    plot_free(plot);
+}
+
+/* Reta: só a grade inicial e um nível de pontos médios (todos sobre a corda) */
+static void check_reta(void) {
+    Plot *plot = parse("Y=x/3+2");
+    plot_set_adaptive(plot, 0.5, LARGURA, ALTURA);
+    PlotData *data = plot_generate_samples(plot, NULL);
+    assert(data);
+    assert(data->samples == 2 * (1 << PLOT_ADAPTIVE_MIN_DEPTH) + 1);
+    assert(data->count == data->samples);
+    for (int i = 1; i < data->count; i++) assert(data->x[i] > data->x[i - 1]);
+    assert(data->x[0] == -10.0 && data->x[data->count - 1] == 10.0);
+    plot_data_free(data);
+    plot_free(plot);
+}
+
+/* Fronteira de domínio: a subdivisão vai até a grade mais fina em volta dela */
+static void check_fronteira(void) {
+    Plot *plot = parse("Y=sqrt(x)");
+    plot_set_adaptive(plot, 0.5, LARGURA, ALTURA);
+    PlotData *data = plot_generate_samples(plot, NULL);
+    assert(data && data->count > 0);
+    double passo = 20.0 / (1 << PLOT_ADAPTIVE_MAX_DEPTH);
+    assert(data->x[0] >= 0.0 && data->x[0] <= passo);
+    int invalidas = 0;
+    for (int i = 0; i < data->samples; i++) invalidas += !plot_data_sample_ok(data, i);
+    assert(invalidas == data->samples - data->count);
+    plot_data_free(data);
+    plot_free(plot);
+}
+
+/* Tolerância maior nunca pede mais amostras */
+static void check_tolerancia(void) {
+    Plot *plot = parse("R=6/(2-sin(t))");
+    int anterior = 0;
+    for (double tol = 4.0; tol >= 0.125; tol /= 2) {
+        plot_set_adaptive(plot, tol, LARGURA, ALTURA);
+        PlotData *data = plot_generate_samples(plot, NULL);
+        assert(data && data->samples >= anterior);
+        anterior = data->samples;
+        plot_data_free(data);
+    }
+    plot_free(plot);
+}
+
+int main(void) {
+    kernels_set_level(KERNELS_SCALAR);
+
+    static const Caso casos[] = {
+        { "Y=sin(x)", 500 },
+        { "Y=x*x*x/50", 400 },
+        { "R=6", 400 },
+        { "R=6/(2-sin(t))", 400 },
+        { "R**2=36*cos(2*t)", 2000 },
+        { "X=5*cos(t)-cos(5*t);Y=5*sin(t)-sin(5*t):0,6.3:", 500 },
+        { "X=sin(2*t);Y=sin(3*t):0,6.3:", 1000 },
+    };
+
+    check_reta();
+    check_fronteira();
+    check_tolerancia();
+    for (size_t i = 0; i < sizeof(casos) / sizeof(casos[0]); i++) check_curva(&casos[i]);
+
+    printf("adaptive: OK\n");
+    return 0;
+}
@@ -0,0 +1,245 @@
+#define _POSIX_C_SOURCE 200809L  /* clock_gettime */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <time.h>
+#include "arena.h"
+#include "parser.h"
+#include "multicurvas_plot.h"
+#include "corpus.h"
+#include "assert.h"
+
+/* Contagem de malloc/free do processo (glibc: as funções do programa
+ * substituem as da libc, que continuam acessíveis como __libc_*). Com
+ * AddressSanitizer o alocador é o dele, e a contagem fica de fora. */
+#ifdef __SANITIZE_ADDRESS__
+#define COM_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define COM_ASAN 1
+#endif
+#endif
+
+#if defined(__GLIBC__) && !defined(COM_ASAN)
+#define CONTA_MALLOC 1
+extern void *__libc_malloc(size_t);
+extern void *__libc_calloc(size_t, size_t);
+extern void *__libc_realloc(void *, size_t);
+extern void *__libc_memalign(size_t, size_t);
+extern void __libc_free(void *);
+
+static uint64_t n_malloc, n_free;
+
+void *malloc(size_t n) {
+    __atomic_add_fetch(&n_malloc, 1, __ATOMIC_RELAXED);
+    return __libc_malloc(n);
+}
+
+void *calloc(size_t n, size_t size) {
+    __atomic_add_fetch(&n_malloc, 1, __ATOMIC_RELAXED);
+    return __libc_calloc(n, size);
+}
+
+void *realloc(void *p, size_t n) {
+    if (!p) __atomic_add_fetch(&n_malloc, 1, __ATOMIC_RELAXED);
+    return __libc_realloc(p, n);
+}
+
+/* Blocos da arena e de PlotData */
+int posix_memalign(void **p, size_t alinhamento, size_t n) {
+    __atomic_add_fetch(&n_malloc, 1, __ATOMIC_RELAXED);
+    void *mem = __libc_memalign(alinhamento, n);
+    if (!mem) return ENOMEM;
+    *p = mem;
+    return 0;
+}
+
+void free(void *p) {
+    if (p) __atomic_add_fetch(&n_free, 1, __ATOMIC_RELAXED);
+    __libc_free(p);
+}
+#endif
+
+static void check_arena(void) {
+    Arena *a = arena_create(256);
+    char *s = arena_strdup(a, "sin(x)");
+    assert(strcmp(s, "sin(x)") == 0);
+    for (int i = 1; i < 40; i++) {
+        void *p = arena_alloc(a, i);
+        assert(((uintptr_t)p % ARENA_ALIGNMENT) == 0);
+    }
+
+    // A última alocação cresce no lugar; uma anterior é copiada
+    int *v = arena_alloc(a, 4 * sizeof(int));
+    for (int i = 0; i < 4; i++) v[i] = i;
+    assert(arena_realloc(a, v, 4 * sizeof(int), 8 * sizeof(int)) == v);
+    arena_alloc(a, 1);
+    int *w = arena_realloc(a, v, 8 * sizeof(int), 16 * sizeof(int));
+    assert(w != v && w[3] == 3);
+
+    double *z = arena_calloc(a, 100, sizeof(double));
+    assert(z[0] == 0.0 && z[99] == 0.0);
+
+    // Vários blocos viram um só no reset, com a capacidade total
+    ArenaStats st = arena_stats(a);
+    assert(st.blocks > 1 && st.used > 0);
+    arena_reset(a);
+    ArenaStats r = arena_stats(a);
+    assert(r.blocks == 1 && r.used == 0 && r.capacity == st.capacity);
+    assert(r.mallocs == st.mallocs + 1);
+
+    // O mesmo uso depois do reset não aloca
+    arena_strdup(a, "sin(x)");
+    for (int i = 1; i < 40; i++) arena_alloc(a, i);
+    arena_alloc(a, 100 * sizeof(double));
+    assert(arena_stats(a).mallocs == r.mallocs);
+    arena_destroy(a);
+    printf("✓ Arena: alinhamento, realloc no lugar, reset em um bloco (%zu bytes)\n",
+           r.capacity);
+}
+
+static int buffers_iguais(const TokenBuffer *a, const TokenBuffer *b) {
+    if (a->size != b->size || a->values_size != b->values_size) return 0;
+    for (int i = 0; i < a->size; i++) {
+        if (a->tokens[i].type != b->tokens[i].type) return 0;
+        if (a->tokens[i].value_index != b->tokens[i].value_index) return 0;
+    }
+    return memcmp(a->values, b->values, a->values_size * sizeof(double)) == 0;
+}
+
+/* Tokens e RPN na arena iguais aos do heap; parser_to_rpn não vaza */
+static void check_parser(void) {
+    Arena *arena = arena_create(0);
+    const char *exprs[] = { "sin(x)+2*3.14", "1+2+3+4+5+6+7+8+9+10+11+12+13+14+15+16+17+18",
+                            "-(x^2)^0.5/(1-cos(t))", "log(" };
+    for (int e = 0; e < 4; e++) {
+        TokenBuffer t1, t2, r1, r2;
+        ParserError e1 = parser_tokenize(exprs[e], &t1);
+        ParserError e2 = parser_tokenize_arena(exprs[e], &t2, arena);
+        assert(e1 == e2);
+        if (e1 != PARSER_OK) continue;
+        assert(buffers_iguais(&t1, &t2));
+        assert(parser_to_rpn(&t1, &r1) == PARSER_OK);
+        assert(parser_to_rpn_arena(&t2, &r2, arena) == PARSER_OK);
+        assert(buffers_iguais(&r1, &r2) && r2.arena == arena);
+        parser_free_buffer(&t1);
+        parser_free_buffer(&r1);
+        parser_free_buffer(&t2);
+        parser_free_buffer(&r2);
+    }
+
+#ifdef CONTA_MALLOC
+    TokenBuffer t, r;
+    uint64_t m0 = n_malloc, f0 = n_free;
+    assert(parser_tokenize("sin(x)*2.5+1", &t) == PARSER_OK);
+    assert(parser_to_rpn(&t, &r) == PARSER_OK);
+    parser_free_buffer(&t);
+    parser_free_buffer(&r);
+    assert(n_malloc - m0 == n_free - f0);
+#endif
+    arena_destroy(arena);
+    printf("✓ Tokens e RPN na arena idênticos aos do heap\n");
+}
+
+/* Corpus: mesmos pontos com e sem arena, uniforme e adaptativa */
+static void check_corpus(void) {
+    Arena *arena = arena_create(0);
+    for (int adaptativa = 0; adaptativa < 2; adaptativa++) {
+        for (int c = 0; c < CORPUS_SIZE; c++) {
+            Plot *p1 = plot_parse_text(corpus_curves[c].spec, NULL);
+            Plot *p2 = plot_parse_text_arena(corpus_curves[c].spec, arena, NULL);
+            assert(p1 && p2 && p2->arena == arena && p1->type == p2->type);
+            assert(strcmp(p1->expr1, p2->expr1) == 0);
+            if (adaptativa) {
+                plot_set_adaptive(p1, 0, 800, 600);
+                plot_set_adaptive(p2, 0, 800, 600);
+            }
+            PlotData *a = plot_generate_samples(p1, NULL);
+            PlotData *b = plot_generate_samples_arena(p2, arena, NULL);
+            assert(a && b && b->arena == arena);
+            assert(a->count == b->count && a->samples == b->samples);
+            assert(memcmp(a->x, b->x, a->count * sizeof(double)) == 0);
+            assert(memcmp(a->y, b->y, a->count * sizeof(double)) == 0);
+            assert(memcmp(a->valid, b->valid, (a->samples + 63) / 64 * sizeof(uint64_t)) == 0);
+            plot_data_free(a);
+            plot_data_free(b);      /* não faz nada: memória da arena */
+            plot_free(p1);
+            plot_free(p2);
+            arena_reset(arena);
+        }
+    }
+
+    char *errmsg = NULL;
+    assert(plot_parse_text_arena("", arena, &errmsg) == NULL && errmsg);
+    free(errmsg);
+    Plot *p = plot_parse_text_arena("Y=log(", arena, NULL);
+    assert(p && plot_generate_samples_arena(p, arena, &errmsg) == NULL && errmsg);
+    free(errmsg);
+    arena_destroy(arena);
+    printf("✓ Corpus com e sem arena idêntico (uniforme e adaptativa)\n");
+}
+
+static double agora(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/* Pedido típico do servidor: parse + amostragem com o programa no cache */
+#define RODADAS 20
+
+static void check_sem_malloc(void) {
+    Arena *arena = arena_create(0);
+    for (int c = 0; c < CORPUS_SIZE; c++) {     /* aquecimento */
+        Plot *p = plot_parse_text_arena(corpus_curves[c].spec, arena, NULL);
+        plot_generate_samples_arena(p, arena, NULL);
+        arena_reset(arena);
+    }
+
+    uint64_t blocos = arena_stats(arena).mallocs;
+#ifdef CONTA_MALLOC
+    uint64_t m0 = n_malloc;
+#endif
+    double t0 = agora();
+    for (int r = 0; r < RODADAS; r++) {
+        for (int c = 0; c < CORPUS_SIZE; c++) {
+            Plot *p = plot_parse_text_arena(corpus_curves[c].spec, arena, NULL);
+            PlotData *d = plot_generate_samples_arena(p, arena, NULL);
+            assert(d);
+            arena_reset(arena);
+        }
+    }
+    double us_arena = (agora() - t0) * 1e6 / (RODADAS * CORPUS_SIZE);
+    assert(arena_stats(arena).mallocs == blocos);
+#ifdef CONTA_MALLOC
+    assert(n_malloc == m0);
+#endif
+
+    t0 = agora();
+    for (int r = 0; r < RODADAS; r++) {
+        for (int c = 0; c < CORPUS_SIZE; c++) {
+            Plot *p = plot_parse_text(corpus_curves[c].spec, NULL);
+            plot_data_free(plot_generate_samples(p, NULL));
+            plot_free(p);
+        }
+    }
+    double us_heap = (agora() - t0) * 1e6 / (RODADAS * CORPUS_SIZE);
+    ArenaStats st = arena_stats(arena);
+    arena_destroy(arena);
+    printf("✓ %d pedidos sem malloc depois do aquecimento (%.1f µs com arena, "
+           "%.1f µs com malloc, arena de %zu KB)\n",
+           RODADAS * CORPUS_SIZE, us_arena, us_heap, st.capacity / 1024);
+}
+
+int main(void) {
+    check_arena();
+    check_parser();
+    check_corpus();
+    check_sem_malloc();
+
+    printf("\nTodos os testes da arena passaram.\n");
+    return 0;
+}
@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include "parser.h"
+#include "evaluator.h"
+#include "kernels.h"
+#include "assert.h"
+
+#define N_SAMPLES 301
+
+/* Compara valores: exatos nos kernels escalares, ~ulps nos vetoriais */
+static int same_value(double got, double ref, int exact) {
+    if (exact) return got == ref;
+    return fabs(got - ref) <= 1e-13 * fmax(1.0, fabs(ref));
+}
+
+/* Compara avaliador em lote com o escalar amostra por amostra (valor e código de erro) */
+static void check_expression_level(const char *expr, double a, double b, KernelLevel level) {
+    TokenBuffer tokens, rpn;
+    ParserError err = parser_tokenize(expr, &tokens);
+    assert(err == PARSER_OK);
+    err = parser_to_rpn(&tokens, &rpn);
+    assert(err == PARSER_OK);
+
+    double in[N_SAMPLES], out[N_SAMPLES];
+    uint8_t status[N_SAMPLES];
+    for (int i = 0; i < N_SAMPLES; i++) {
+        in[i] = a + i * (b - a) / (N_SAMPLES - 1);
+    }
+
+    kernels_set_level(level);
+    evaluator_eval_rpn_batch(&rpn, in, out, status, N_SAMPLES);
+
+    /* Motor de registradores: mesmos kernels + SINCOS fundido */
+    double reg_out[N_SAMPLES];
+    uint8_t reg_status[N_SAMPLES];
+    EvalProgram *prog = evaluator_compile(&rpn, EVAL_ENGINE_REGISTER);
+    assert(prog != NULL);
+    evaluator_program_eval_batch(prog, in, reg_out, reg_status, N_SAMPLES);
+    evaluator_program_free(prog);
+
+    int errors = 0;
+    for (int i = 0; i < N_SAMPLES; i++) {
+        EvalResult ref = evaluator_eval_rpn(&rpn, in[i]);
+        assert(status[i] == ref.error);
+        assert(reg_status[i] == ref.error);
+        if (ref.error == EVAL_OK) {
+            assert(same_value(out[i], ref.value, level == KERNELS_SCALAR));
+            assert(same_value(reg_out[i], ref.value, level == KERNELS_SCALAR));
+        } else {
+            errors++;
+        }
+    }
+    printf("✓ %-8s %-28s [%g, %g]  %d amostras com erro\n",
+           kernels_active()->name, expr, a, b, errors);
+
+    parser_free_buffer(&tokens);
+    parser_free_buffer(&rpn);
+}
+
+/* Testa a expressão com todos os níveis de kernel suportados pela CPU */
+static void check_expression(const char *expr, double a, double b) {
+    KernelLevel max = kernels_detect();
+    for (KernelLevel level = KERNELS_SCALAR; level <= max; level++) {
+        check_expression_level(expr, a, b, level);
+    }
+}
+
+/* ---- Erro dos kernels vetoriais contra a libm (limites de kernels.h) ---- */
+
+#define ULP_BLOCO   1024
+#define ULP_BLOCOS  200
+
+static double ulp_de(double v) {
+    v = fabs(v);
+    return v == 0 ? 4.9406564584124654e-324 : nextafter(v, INFINITY) - v;
+}
+
+static uint64_t ulp_semente = 88172645463325252ULL;
+
+static double aleatorio(void) {
+    ulp_semente ^= ulp_semente << 13;
+    ulp_semente ^= ulp_semente >> 7;
+    ulp_semente ^= ulp_semente << 17;
+    return (ulp_semente >> 11) * 0x1p-53;
+}
+
+typedef struct {
+    TokenType type;         /* TOKEN_ERROR: sin e cos do kernel sincos */
+    const char *nome;
+    double (*libm)(double);
+    double lo, hi;          /* faixa uniforme (expoentes de 2 se `expoentes`) */
+    int expoentes;
+    int multiplos;          /* também perto de k * pi/2 (zeros e polos) */
+    int ulps;
+} FuncaoUlp;
+
+/* Entradas: uniformes na faixa e, se pedido, a poucos ulps de k * pi/2 */
+static void entradas_ulp(const FuncaoUlp *f, int bloco, double *in) {
+    for (int i = 0; i < ULP_BLOCO; i++) {
+        if (f->expoentes) {
+            int e = (int)(f->lo + aleatorio() * (f->hi - f->lo));
+            in[i] = ldexp(1 + aleatorio(), e);
+            continue;
+        }
+        if (!f->multiplos || bloco % 2 == 0) {
+            in[i] = f->lo + aleatorio() * (f->hi - f->lo);
+            continue;
+        }
+        double kmax = bloco % 6 == 1 ? 50 : bloco % 6 == 3 ? 1e4 : 6e8;
+        double x = floor(aleatorio() * kmax) * 1.57079632679489661923;
+        int passos = (int)(aleatorio() * 64) - 32;
+        for (; passos != 0; passos += passos > 0 ? -1 : 1) {
+            x = nextafter(x, passos > 0 ? INFINITY : -INFINITY);
+        }
+        in[i] = aleatorio() < 0.5 ? x : -x;
+    }
+}
+
+/* Maior erro em ulps além do termo absoluto; falha se passar de f->ulps */
+static double check_funcao_ulp(const Kernels *k, const FuncaoUlp *f) {
+    double in[ULP_BLOCO], out[ULP_BLOCO], outro[ULP_BLOCO];
+    double pior = 0;
+    for (int b = 0; b < ULP_BLOCOS; b++) {
+        entradas_ulp(f, b, in);
+        if (f->type == TOKEN_ERROR) {
+            k->sincos(in, out, outro, NULL, ULP_BLOCO);
+        } else {
+            k->unary(f->type, in, out, NULL, ULP_BLOCO);
+        }
+        for (int i = 0; i < ULP_BLOCO; i++) {
+            for (int c = 0; c < (f->type == TOKEN_ERROR ? 2 : 1); c++) {
+                double ref = c ? cos(in[i]) : f->libm(in[i]);
+                double erro = fabs((c ? outro[i] : out[i]) - ref);
+                double absoluto = 0;
+                if (f->multiplos) {
+                    absoluto = 0x1p-100 * fabs(in[i]);
+                    if (f->type == TOKEN_TAN) absoluto *= 1 + ref * ref;
+                }
+                if (!(erro <= f->ulps * ulp_de(ref) + absoluto)) {
+                    printf("  %s %s(%.17g) = %.17g, libm %.17g\n",
+                           k->name, f->nome, in[i], c ? outro[i] : out[i], ref);
+                }
+                assert(erro <= f->ulps * ulp_de(ref) + absoluto);
+                pior = fmax(pior, (erro - absoluto) / ulp_de(ref));
+            }
+        }
+    }
+    return pior;
+}
+
+static void check_ulps(void) {
+    static const FuncaoUlp funcoes[] = {
+        { TOKEN_SIN, "sin", sin, -1e3, 1e3, 0, 1, KERNELS_ULP_SINCOS },
+        { TOKEN_COS, "cos", cos, -1.07e9, 1.07e9, 0, 1, KERNELS_ULP_SINCOS },
+        { TOKEN_ERROR, "sincos", sin, -1e3, 1e3, 0, 1, KERNELS_ULP_SINCOS },
+        { TOKEN_TAN, "tan", tan, -1e3, 1e3, 0, 1, KERNELS_ULP_TAN },
+        { TOKEN_EXP, "exp", exp, -700, 700, 0, 0, KERNELS_ULP_EXP },
+        { TOKEN_COSH, "cosh", cosh, -700, 700, 0, 0, KERNELS_ULP_EXP },
+        { TOKEN_LOG, "log", log, -1022, 1023, 1, 0, KERNELS_ULP_LOG },
+        { TOKEN_LOG, "log", log, 0.25, 4, 0, 0, KERNELS_ULP_LOG },
+    };
+    int nfuncoes = (int)(sizeof(funcoes) / sizeof(funcoes[0]));
+    KernelLevel max = kernels_detect();
+    for (KernelLevel level = KERNELS_SSE2; level <= max; level++) {
+        kernels_set_level(level);
+        const Kernels *k = kernels_active();
+        printf("✓ %-8s ulps da libm:", k->name);
+        for (int f = 0; f < nfuncoes; f++) {
+            printf(" %s %.0f", funcoes[f].nome, check_funcao_ulp(k, &funcoes[f]));
+        }
+        printf("\n");
+    }
+}
+
+int main(void) {
+    printf("╔═══════════════════════════════════════════════════════════╗\n");
+    printf("║        MULTICURVAS - Avaliador em lote vs escalar         ║\n");
+    printf("╚═══════════════════════════════════════════════════════════╝\n\n");
+    parser_set_locale(LOCALE_POINT);
+
+    check_expression("sin(x)*2+x", -10, 10);
+    check_expression("1/x", -3, 3);                    /* divisão por zero em x=0 */
+    check_expression("sqrt(x)", -2, 2);                /* domínio */
+    check_expression("log(x)+1/(x-1)", -1, 2);         /* domínio antes da divisão */
+    check_expression("asin(x)*acos(x/2)", -3, 3);
+    check_expression("tan(x)", -6, 6);
+    check_expression("sin(x)*cos(x)+cos(x/2)", -10, 10);  /* sincos fundido */
+    check_expression("sin(x)-cos(x)", -1e10, 1e10);      /* fora da faixa rápida */
+    check_expression("(x*x)^(1/3)", -2, 2);
+    check_expression("exp(x*x*x)", -10, 10);           /* overflow */
+    check_expression("atanh(x)+acosh(x+2)", -2, 2);
+    check_expression("frac(x)-floor(x)+ceil(x)", -5, 5);
+    check_expression("---x", -1, 1);
+    check_expression("2*e^(-t/2)", 0, 6);
+    check_expression("6/(2-sin(t))", 0, 6.3);
+    check_expression("cos(x)*sin(x)+cosh(x/3)", -1e3, 1e3);
+    check_expression("sin(x)+log(x)", -1e10, 1e10);     /* faixa de fallback da libm */
+    check_expression("exp(x)*log10(x)", -800, 800);
+
+    /* Programa estruturalmente inválido: sobra mais de um valor na pilha */
+    check_expression("1/x 2", -1, 1);
+
+    check_ulps();
+
+    printf("\nTodos os testes do avaliador em lote passaram.\n");
+    return 0;
+}
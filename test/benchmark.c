@@ -1,9 +1,17 @@
+#define _POSIX_C_SOURCE 200809L  /* clock_gettime */
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 #include <math.h>
+#include <unistd.h>
 #include "parser.h"
 #include "evaluator.h"
+#include "kernels.h"
+#include "multicurvas_plot.h"
+#include "presets.h"
+#include "threadpool.h"
+#include "render.h"
+#include "corpus.h"
 
 /* Função hardcoded: f(x) = x * e^x */
 static double hardcoded_function(double x) {
@@ -48,6 +56,31 @@ static double integrate_parsed(const TokenBuffer *rpn, double a, double b, int n
     return sum * h;
 }
 
+/* Integração usando o avaliador em lote (dispatch pago uma vez por bloco) */
+static double integrate_batch(const TokenBuffer *rpn, double a, double b, int n_steps) {
+    enum { CHUNK = 1024 };
+    double xs[CHUNK], ys[CHUNK];
+    uint8_t status[CHUNK];
+    double h = (b - a) / n_steps;
+    double sum = 0.0;
+    
+    /* Pontos 0..n_steps; extremos com peso 0.5 */
+    for (int base = 0; base <= n_steps; base += CHUNK) {
+        int len = (n_steps + 1 - base < CHUNK) ? n_steps + 1 - base : CHUNK;
+        for (int j = 0; j < len; j++) {
+            xs[j] = a + (base + j) * h;
+        }
+        evaluator_eval_rpn_batch(rpn, xs, ys, status, len);
+        for (int j = 0; j < len; j++) {
+            if (status[j] != EVAL_OK) return 0.0;
+            int i = base + j;
+            sum += (i == 0 || i == n_steps) ? 0.5 * ys[j] : ys[j];
+        }
+    }
+    
+    return sum * h;
+}
+
 /* Calcula tempo em segundos */
 static double get_time_diff(clock_t start, clock_t end) {
     return ((double)(end - start)) / CLOCKS_PER_SEC;
@@ -106,11 +139,23 @@ void run_benchmark(void) {
     printf("Resultado: %.10f\n", result_parsed);
     printf("Tempo: %.6f segundos\n\n", parsed_time);
     
+    /* FASE 4: Integração com avaliador em lote */
+    printf("--- FASE 4: Integração (avaliador em lote) ---\n");
+    clock_t batch_start = clock();
+    double result_batch = integrate_batch(&rpn, a, b, n_steps);
+    clock_t batch_end = clock();
+    double batch_time = get_time_diff(batch_start, batch_end);
+    
+    printf("Resultado: %.10f\n", result_batch);
+    printf("Tempo: %.6f segundos\n\n", batch_time);
+    
     /* ANÁLISE */
     printf("=== ANÁLISE ===\n");
     printf("Diferença de resultados: %.2e (erro relativo)\n", 
            fabs(result_hardcoded - result_parsed) / fabs(result_hardcoded));
     printf("Overhead da avaliação parseada: %.2fx\n", parsed_time / hardcoded_time);
+    printf("Overhead da avaliação em lote: %.2fx\n", batch_time / hardcoded_time);
+    printf("Speedup lote vs escalar: %.2fx\n", parsed_time / batch_time);
     printf("Custo do parsing: %.2f%% do tempo total parseado\n", 
            (parse_time / (parse_time + parsed_time)) * 100);
     printf("\nValor esperado (analítico): %.10f\n", 1.0);  /* Integral de x*e^x de 0 a 1 = 1 */
@@ -120,6 +165,392 @@ void run_benchmark(void) {
     parser_free_buffer(&rpn);
 }
 
+/* Compara os níveis de kernel (escalar, SSE2, AVX2, AVX-512) numa varredura
+ * dominada por funções transcendentais */
+static void run_kernel_benchmark(void) {
+    const char *expression = "6/(2-sin(x))+exp(-x*x)*cos(3*x)+log(x*x+1)";
+    enum { N = 1 << 18, ROUNDS = 4 };
+    static double xs[N], ys[N];
+    static uint8_t status[N];
+    
+    printf("\n=== BENCHMARK: Kernels SIMD (%d amostras x %d) ===\n", N, ROUNDS);
+    printf("Expressão: %s\n", expression);
+    KernelLevel max = kernels_detect();
+    kernels_set_level(max);
+    printf("CPU suporta até: %s\n\n", kernels_active()->name);
+    
+    TokenBuffer tokens, rpn;
+    if (parser_tokenize(expression, &tokens) != PARSER_OK) return;
+    if (parser_to_rpn(&tokens, &rpn) != PARSER_OK) {
+        parser_free_buffer(&tokens);
+        return;
+    }
+    
+    for (int i = 0; i < N; i++) {
+        xs[i] = -50.0 + 100.0 * i / N;
+    }
+    
+    double scalar_time = 0.0;
+    for (KernelLevel level = KERNELS_SCALAR; level <= max; level++) {
+        kernels_set_level(level);
+        clock_t start = clock();
+        for (int r = 0; r < ROUNDS; r++) {
+            evaluator_eval_rpn_batch(&rpn, xs, ys, status, N);
+        }
+        double elapsed = get_time_diff(start, clock());
+        if (level == KERNELS_SCALAR) scalar_time = elapsed;
+        printf("  %-8s %.6f segundos  (%.1f Mamostras/s, %.2fx)\n",
+               kernels_active()->name, elapsed, ROUNDS * (N / 1e6) / elapsed,
+               scalar_time / elapsed);
+    }
+    kernels_set_level(max);
+    
+    parser_free_buffer(&tokens);
+    parser_free_buffer(&rpn);
+}
+/* Compila as expressões do corpus para um motor. Retorna o número de programas. */
+static int compile_corpus(EvalEngine engine, EvalProgram **progs, int max) {
+    int count = 0;
+    for (int c = 0; c < CORPUS_SIZE; c++) {
+        Plot *plot = plot_parse_text(corpus_curves[c].spec, NULL);
+        if (!plot) continue;
+        const char *exprs[2] = { plot->expr1, plot->expr2 };
+        for (int k = 0; k < 2 && exprs[k] && count < max; k++) {
+            TokenBuffer tokens, rpn;
+            if (parser_tokenize(exprs[k], &tokens) != PARSER_OK) continue;
+            if (parser_to_rpn(&tokens, &rpn) == PARSER_OK) {
+                progs[count] = evaluator_compile(&rpn, engine);
+                if (progs[count]) count++;
+                parser_free_buffer(&rpn);
+            }
+            parser_free_buffer(&tokens);
+        }
+        plot_free(plot);
+    }
+    return count;
+}
+
+/* Compara os motores de avaliação escalar (uma chamada por amostra) no corpus
+ * das 77 curvas: o custo de dispatch por token domina expressões curtas */
+static void run_engine_benchmark(void) {
+    enum { MAX_PROGS = 2 * CORPUS_SIZE, SAMPLES = 20000 };
+    static const EvalEngine engines[] = { EVAL_ENGINE_SWITCH, EVAL_ENGINE_THREADED,
+                                            EVAL_ENGINE_REGISTER, EVAL_ENGINE_JIT };
+    EvalProgram *progs[MAX_PROGS];
+    
+    printf("\n=== BENCHMARK: Motores de avaliação (corpus 77 curvas, %d amostras/expr) ===\n\n",
+           SAMPLES);
+    
+    double base_time = 0.0;
+    for (int e = 0; e < (int)(sizeof(engines) / sizeof(engines[0])); e++) {
+        int count = compile_corpus(engines[e], progs, MAX_PROGS);
+        double checksum = 0.0;
+        
+        clock_t start = clock();
+        for (int p = 0; p < count; p++) {
+            for (int i = 0; i < SAMPLES; i++) {
+                EvalResult r = evaluator_program_eval(progs[p], -7.0 + 14.0 * i / SAMPLES);
+                if (r.error == EVAL_OK) checksum += r.value;
+            }
+        }
+        double elapsed = get_time_diff(start, clock());
+        if (e == 0) base_time = elapsed;
+        
+        printf("  %-10s %3d expr  %.6f segundos  (%.1f Mavaliações/s, %.2fx)  soma=%.6g\n",
+               evaluator_engine_name(engines[e]), count, elapsed,
+               count * (SAMPLES / 1e6) / elapsed, base_time / elapsed, checksum);
+        
+        for (int p = 0; p < count; p++) evaluator_program_free(progs[p]);
+    }
+}
+
+/* Curvas paramétricas: X e Y como dois programas vs um programa com duas
+ * saídas (subexpressões comuns avaliadas uma vez), avaliação em lote */
+static void run_fused_benchmark(void) {
+    enum { N = 4096, ROUNDS = 20 };
+    static double in[N], vx[N], vy[N];
+    static uint8_t sx[N], sy[N];
+    double *outs[2] = { vx, vy };
+    uint8_t *stats[2] = { sx, sy };
+    
+    printf("\n=== BENCHMARK: Paramétricas X/Y separadas vs fundidas (%d amostras x %d) ===\n\n",
+           N, ROUNDS);
+    for (int i = 0; i < N; i++) in[i] = 14.0 * i / N - 7.0;
+    
+    double separate_time = 0.0, fused_time = 0.0;
+    int pairs = 0;
+    for (int c = 0; c < CORPUS_SIZE; c++) {
+        Plot *plot = plot_parse_text(corpus_curves[c].spec, NULL);
+        if (!plot || plot->type != PLOT_PARAMETRIC || !plot->expr2) {
+            plot_free(plot);
+            continue;
+        }
+        TokenBuffer tokens, rpn[2];
+        const char *exprs[2] = { plot->expr1, plot->expr2 };
+        for (int k = 0; k < 2; k++) {
+            parser_tokenize(exprs[k], &tokens);
+            parser_to_rpn(&tokens, &rpn[k]);
+            parser_free_buffer(&tokens);
+        }
+        const TokenBuffer *progs[2] = { &rpn[0], &rpn[1] };
+        EvalProgram *px = evaluator_compile(&rpn[0], EVAL_ENGINE_REGISTER);
+        EvalProgram *py = evaluator_compile(&rpn[1], EVAL_ENGINE_REGISTER);
+        EvalProgram *pxy = evaluator_compile_multi(progs, 2, EVAL_ENGINE_REGISTER);
+        
+        clock_t start = clock();
+        for (int r = 0; r < ROUNDS; r++) {
+            evaluator_program_eval_batch(px, in, vx, sx, N);
+            evaluator_program_eval_batch(py, in, vy, sy, N);
+        }
+        separate_time += get_time_diff(start, clock());
+        
+        start = clock();
+        for (int r = 0; r < ROUNDS; r++) {
+            evaluator_program_eval_batch_multi(pxy, in, outs, stats, N);
+        }
+        fused_time += get_time_diff(start, clock());
+        
+        evaluator_program_free(px);
+        evaluator_program_free(py);
+        evaluator_program_free(pxy);
+        parser_free_buffer(&rpn[0]);
+        parser_free_buffer(&rpn[1]);
+        plot_free(plot);
+        pairs++;
+    }
+    
+    printf("  separadas  %2d pares  %.6f segundos\n", pairs, separate_time);
+    printf("  fundidas   %2d pares  %.6f segundos  (%.2fx)\n", pairs, fused_time,
+           separate_time / fused_time);
+}
+
+/* Preset nativo (--emit-c) vs a mesma curva pelo motor padrão e vs código
+ * escrito à mão: Y=x*x (curva 6) em lote */
+static void run_preset_benchmark(void) {
+    enum { N = 4096, ROUNDS = 500 };
+    static double in[N], out[N];
+    static uint8_t status[N];
+    double *outs[2] = { out, NULL };
+    uint8_t *stats[2] = { status, NULL };
+    
+    printf("\n=== BENCHMARK: Preset nativo vs motor vs hardcoded (Y=x*x, %d amostras x %d) ===\n\n",
+           N, ROUNDS);
+    for (int i = 0; i < N; i++) in[i] = 4.0 * i / N - 2.0;
+    
+    const PlotPreset *preset = plot_preset_find("6");
+    Plot *plot = plot_from_preset(preset);
+    TokenBuffer rpn[2];
+    int count = plot_build_programs(plot, rpn, NULL);
+    const TokenBuffer *progs[2] = { &rpn[0], &rpn[1] };
+    EvalProgram *prog = evaluator_compile_multi(progs, count, evaluator_engine);
+    
+    double checksum = 0.0;
+    clock_t start = clock();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < N; i++) {
+            out[i] = in[i] * in[i];
+            status[i] = isfinite(out[i]) ? EVAL_OK : EVAL_MATH_ERROR;
+        }
+        checksum += out[N / 3];
+    }
+    double hard_time = get_time_diff(start, clock());
+    
+    start = clock();
+    for (int r = 0; r < ROUNDS; r++) {
+        preset->eval(in, outs, stats, N);
+        checksum += out[N / 3];
+    }
+    double preset_time = get_time_diff(start, clock());
+    
+    start = clock();
+    for (int r = 0; r < ROUNDS; r++) {
+        evaluator_program_eval_batch_multi(prog, in, outs, stats, N);
+        checksum += out[N / 3];
+    }
+    double engine_time = get_time_diff(start, clock());
+    
+    printf("  hardcoded  %.6f segundos\n", hard_time);
+    printf("  preset     %.6f segundos  (%.2fx do hardcoded)\n", preset_time, preset_time / hard_time);
+    printf("  %-10s %.6f segundos  (%.2fx do hardcoded)  soma=%.6g\n",
+           evaluator_engine_name(evaluator_engine), engine_time, engine_time / hard_time, checksum);
+    
+    evaluator_program_free(prog);
+    for (int k = 0; k < count; k++) parser_free_buffer(&rpn[k]);
+    plot_free(plot);
+}
+
+/* plot_generate_samples com 2M amostras: 1 thread vs pool */
+static void run_threads_benchmark(void) {
+    const int counts[] = { 1, 2, 4, threadpool_cpu_count() };
+    Plot *plot = plot_parse_text("X=5*(3*cos(t)-cos(3*t));Y=5*(3*sin(t)-sin(3*t))", NULL);
+    plot->samples = 2000000;
+    
+    printf("\n=== BENCHMARK: Amostragem paralela (%d amostras, %d CPUs) ===\n\n",
+           plot->samples, threadpool_cpu_count());
+    double base = 0.0;
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++) {
+        threadpool_set_default_threads(counts[i]);
+        threadpool_default();   /* cria o pool fora da medição */
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        PlotData *data = plot_generate_samples(plot, NULL);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double elapsed = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+        if (i == 0) base = elapsed;
+        printf("  %2d threads  %.6f segundos  (%.2fx)  pontos=%d\n",
+               counts[i], elapsed, base / elapsed, data->count);
+        plot_data_free(data);
+    }
+    threadpool_set_default_threads(0);
+    plot_free(plot);
+}
+
+/* Executa `f` com stdout em `arquivo`; devolve o tempo (segundos) */
+static double medir_com_stdout(FILE *arquivo, void (*f)(const PlotData *), const PlotData *data) {
+    struct timespec t0, t1;
+    fflush(stdout);
+    int salvo = dup(fileno(stdout));
+    dup2(fileno(arquivo), fileno(stdout));
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    f(data);
+    fflush(stdout);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    dup2(salvo, fileno(stdout));
+    close(salvo);
+    return (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+}
+
+/* Texto antigo dos renderizadores: um printf por ponto */
+static void csv_printf(const PlotData *data) {
+    printf("x,y\n");
+    for (int i = 0; i < data->count; i++) printf("%.6f,%.6f\n", data->x[i], data->y[i]);
+}
+
+static void csv_outbuf(const PlotData *data) {
+    render_csv(data);
+}
+
+static void svg_outbuf(const PlotData *data) {
+    render_svg(data, "benchmark", 800, 600);
+}
+
+/* render_csv / render_svg com 2M pontos, em MB/s (saída em /dev/null) */
+static void run_render_benchmark(void) {
+    Plot *plot = plot_parse_text("Y=sin(x)*3:-3,3:", NULL);
+    plot->samples = 2000000;
+    PlotData *data = plot_generate_samples(plot, NULL);
+    FILE *nulo = fopen("/dev/null", "w");
+    if (!data || !nulo) {
+        printf("\n(benchmark de renderização indisponível)\n");
+        if (nulo) fclose(nulo);
+        plot_data_free(data);
+        plot_free(plot);
+        return;
+    }
+    
+    printf("\n=== BENCHMARK: Renderizadores (%d pontos, saída em /dev/null) ===\n\n",
+           data->count);
+    struct {
+        const char *nome;
+        void (*f)(const PlotData *);
+    } casos[] = {
+        { "csv printf", csv_printf },   /* texto idêntico ao de render_csv */
+        { "csv",        csv_outbuf },
+        { "svg",        svg_outbuf },
+    };
+    double base = 0.0;
+    for (int i = 0; i < (int)(sizeof(casos) / sizeof(casos[0])); i++) {
+        // Tamanho do texto num arquivo temporário, tempo em /dev/null
+        FILE *tmp = tmpfile();
+        if (!tmp) break;
+        medir_com_stdout(tmp, casos[i].f, data);
+        double mb = lseek(fileno(tmp), 0, SEEK_END) / 1e6;
+        fclose(tmp);
+        double elapsed = medir_com_stdout(nulo, casos[i].f, data);
+        if (i == 0) base = elapsed;
+        printf("  %-10s %8.2f MB  %.6f segundos  (%.1f MB/s", casos[i].nome, mb, elapsed,
+               mb / elapsed);
+        if (i == 1) printf(", %.2fx do printf", base / elapsed);
+        printf(")\n");
+    }
+    fclose(nulo);
+    plot_data_free(data);
+    plot_free(plot);
+}
+
+/* Compilação do corpus: parser_tokenize + parser_to_rpn vs parser_compile
+ * (uma passada), em compilações/s */
+static void run_compile_benchmark(void) {
+    enum { MAX_EXPRS = 2 * CORPUS_SIZE, ROUNDS = 2000 };
+    const char *exprs[MAX_EXPRS];
+    Plot *plots[CORPUS_SIZE];
+    int n = 0;
+    for (int c = 0; c < CORPUS_SIZE; c++) {
+        plots[c] = plot_parse_text(corpus_curves[c].spec, NULL);
+        if (!plots[c]) continue;
+        exprs[n++] = plots[c]->expr1;
+        if (plots[c]->expr2) exprs[n++] = plots[c]->expr2;
+    }
+    
+    printf("\n=== BENCHMARK: Compilação (corpus, %d expressões x %d) ===\n\n", n, ROUNDS);
+    double base = 0.0;
+    for (int caminho = 0; caminho < 2; caminho++) {
+        int tokens_rpn = 0;
+        clock_t start = clock();
+        for (int r = 0; r < ROUNDS; r++) {
+            for (int k = 0; k < n; k++) {
+                TokenBuffer tokens, rpn;
+                if (caminho == 0) {
+                    if (parser_tokenize(exprs[k], &tokens) != PARSER_OK) continue;
+                    if (parser_to_rpn(&tokens, &rpn) == PARSER_OK) {
+                        tokens_rpn += rpn.size;
+                        parser_free_buffer(&rpn);
+                    }
+                    parser_free_buffer(&tokens);
+                } else if (parser_compile(exprs[k], &rpn) == PARSER_OK) {
+                    tokens_rpn += rpn.size;
+                    parser_free_buffer(&rpn);
+                }
+            }
+        }
+        double elapsed = get_time_diff(start, clock());
+        if (caminho == 0) base = elapsed;
+        printf("  %-18s %.6f segundos  (%.0f compilações/s, %.2fx)  tokens=%d\n",
+               caminho == 0 ? "tokenize + to_rpn" : "parser_compile", elapsed,
+               (double)n * ROUNDS / elapsed, base / elapsed, tokens_rpn);
+    }
+    for (int c = 0; c < CORPUS_SIZE; c++) plot_free(plots[c]);
+}
+
+/* Tokenizador sozinho: tokens por segundo no corpus */
+static void run_tokenize_benchmark(void) {
+    enum { MAX_EXPRS = 2 * CORPUS_SIZE, ROUNDS = 5000 };
+    const char *exprs[MAX_EXPRS];
+    Plot *plots[CORPUS_SIZE];
+    int n = 0;
+    for (int c = 0; c < CORPUS_SIZE; c++) {
+        plots[c] = plot_parse_text(corpus_curves[c].spec, NULL);
+        if (!plots[c]) continue;
+        exprs[n++] = plots[c]->expr1;
+        if (plots[c]->expr2) exprs[n++] = plots[c]->expr2;
+    }
+
+    printf("\n=== BENCHMARK: Tokenizador (corpus, %d expressões x %d) ===\n\n", n, ROUNDS);
+    long long total = 0;
+    clock_t start = clock();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int k = 0; k < n; k++) {
+            TokenBuffer tokens;
+            if (parser_tokenize(exprs[k], &tokens) != PARSER_OK) continue;
+            total += tokens.size;
+            parser_free_buffer(&tokens);
+        }
+    }
+    double elapsed = get_time_diff(start, clock());
+    printf("  parser_tokenize    %.6f segundos  (%.1f M tokens/s)  tokens=%lld\n",
+           elapsed, total / elapsed / 1e6, total);
+    for (int c = 0; c < CORPUS_SIZE; c++) plot_free(plots[c]);
+}
 
 int main(void) {
     printf("╔═══════════════════════════════════════════════════════════╗\n");
@@ -127,6 +558,14 @@ int main(void) {
     printf("╚═══════════════════════════════════════════════════════════╝\n\n");
     parser_set_locale(LOCALE_POINT);
     run_benchmark();
+    run_tokenize_benchmark();
+    run_compile_benchmark();
+    run_kernel_benchmark();
+    run_engine_benchmark();
+    run_fused_benchmark();
+    run_preset_benchmark();
+    run_threads_benchmark();
+    run_render_benchmark();
     printf("\n╔═══════════════════════════════════════════════════════════╗\n");
     printf("║                  Benchmark Completo                       ║\n");
     printf("╚═══════════════════════════════════════════════════════════╝\n");
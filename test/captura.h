@@ -0,0 +1,20 @@
+/* Saída dos renderizadores como texto, para os testes que inspecionam o SVG.
+ * Compartilhado por test/render.c e test/decimate.c. */
+#ifndef TEST_CAPTURA_H
+#define TEST_CAPTURA_H
+
+#include "multicurvas_plot.h"
+#include "outbuf.h"
+#include "render.h"
+#include "assert.h"
+
+/* render_svg num sink de memória; devolve o texto terminado em '\0' (liberar) */
+static inline char *capturar_svg(const PlotData *data, int canvas_w) {
+    OutSink sink;
+    outsink_memory(&sink, NULL);
+    render_svg_sink(&sink, data, "teste", canvas_w, 600);
+    assert(outsink_write(&sink, "", 1) && outsink_finish(&sink));
+    return sink.data;
+}
+
+#endif /* TEST_CAPTURA_H */
@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parser.h"
+#include "multicurvas_plot.h"
+#include "corpus.h"
+#include "assert.h"
+
+/* parser_tokenize + parser_to_rpn (caminho em quatro passadas) */
+static ParserError compilar_antigo(const char *expr, TokenBuffer *rpn) {
+    TokenBuffer tokens;
+    ParserError err = parser_tokenize(expr, &tokens);
+    if (err != PARSER_OK) return err;
+    err = parser_to_rpn(&tokens, rpn);
+    parser_free_buffer(&tokens);
+    return err;
+}
+
+static int rpn_iguais(const TokenBuffer *a, const TokenBuffer *b) {
+    if (a->size != b->size || a->values_size != b->values_size) return 0;
+    for (int i = 0; i < a->size; i++) {
+        if (a->tokens[i].type != b->tokens[i].type) return 0;
+        if (a->tokens[i].type == TOKEN_NUMBER &&
+            a->values[a->tokens[i].value_index] != b->values[b->tokens[i].value_index]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Mesmo resultado nos dois caminhos; retorna o erro */
+static ParserError check_igual(const char *expr) {
+    TokenBuffer r1, r2;
+    ParserError e1 = compilar_antigo(expr, &r1);
+    ParserError e2 = parser_compile(expr, &r2);
+    if (e1 != e2) {
+        printf("  divergência em \"%s\": %d != %d\n", expr, e1, e2);
+    }
+    assert(e1 == e2);
+    if (e1 == PARSER_OK) {
+        assert(rpn_iguais(&r1, &r2));
+        parser_free_buffer(&r1);
+        parser_free_buffer(&r2);
+    }
+    return e1;
+}
+
+static void check_casos(void) {
+    assert(check_igual("sin(x)+2*3.14") == PARSER_OK);
+    assert(check_igual("-x^2") == PARSER_OK);
+    assert(check_igual("+x-+-x") == PARSER_OK);
+    assert(check_igual("2^3^-x") == PARSER_OK);
+    assert(check_igual("sin x") == PARSER_OK);
+    assert(check_igual("") == PARSER_OK);
+    assert(check_igual("(((((((((((x)))))))))))") == PARSER_OK);
+    assert(check_igual("foo(x)") == PARSER_UNKNOWN_FUNCTION);
+    assert(check_igual("x+t") == PARSER_MIXED_VARIABLES);
+    assert(check_igual("x+t+$") == PARSER_SYNTAX_ERROR);     /* caractere antes das variáveis */
+    assert(check_igual("x+t+foo") == PARSER_UNKNOWN_FUNCTION);
+    assert(check_igual("(x+t") == PARSER_MIXED_VARIABLES);   /* variáveis antes dos parênteses */
+    assert(check_igual("(x") == PARSER_SYNTAX_ERROR);
+    assert(check_igual(")x(") == PARSER_SYNTAX_ERROR);
+    assert(check_igual("x#") == PARSER_SYNTAX_ERROR);
+
+    // Expressão longa: pilha de operadores além da pilha local
+    char longa[4096];
+    int n = 0;
+    for (int i = 0; i < 600; i++) n += snprintf(longa + n, sizeof(longa) - n, "(x^");
+    n += snprintf(longa + n, sizeof(longa) - n, "2");
+    for (int i = 0; i < 600; i++) longa[n++] = ')';
+    longa[n] = '\0';
+    assert(check_igual(longa) == PARSER_OK);
+
+    parser_set_locale(LOCALE_COMMA);
+    assert(check_igual("1,5*x+,25") == PARSER_OK);
+    parser_set_locale(LOCALE_POINT);
+    printf("✓ Casos escolhidos: mesmo RPN e mesmos erros\n");
+}
+
+static void check_corpus(void) {
+    int n = 0;
+    for (int c = 0; c < CORPUS_SIZE; c++) {
+        Plot *plot = plot_parse_text(corpus_curves[c].spec, NULL);
+        assert(plot);
+        check_igual(plot->expr1);
+        if (plot->expr2) check_igual(plot->expr2);
+        n += 1 + (plot->expr2 != NULL);
+        plot_free(plot);
+    }
+    printf("✓ Corpus: %d expressões idênticas\n", n);
+}
+
+/* Strings aleatórias com os símbolos da gramática (e alguns inválidos) */
+#define ALEATORIAS 100000
+
+static void check_aleatorias(void) {
+    static const char *pedacos[] = {
+        "x", "t", "theta", "pi", "e", "2", "3.5", ".5", "1,5", "+", "-", "*", "/", "^",
+        "(", ")", "sin", "cos", "sqrt", "log10", "ln", " ", "abs(", "zz", "$"
+    };
+    int npedacos = (int)(sizeof(pedacos) / sizeof(pedacos[0]));
+    unsigned semente = 2024u;
+    int contagem[PARSER_MEMORY_ERROR + 1] = {0};
+    char expr[128];
+    for (int k = 0; k < ALEATORIAS; k++) {
+        semente = semente * 1103515245u + 12345u;
+        int partes = 1 + (semente >> 16) % 12;
+        int n = 0;
+        for (int p = 0; p < partes; p++) {
+            semente = semente * 1103515245u + 12345u;
+            n += snprintf(expr + n, sizeof(expr) - n, "%s", pedacos[(semente >> 16) % npedacos]);
+        }
+        if (k % 2) parser_set_locale(LOCALE_COMMA);
+        contagem[check_igual(expr)]++;
+        parser_set_locale(LOCALE_POINT);
+    }
+    printf("✓ %d expressões aleatórias: %d ok, %d função, %d variáveis, %d sintaxe\n",
+           ALEATORIAS, contagem[PARSER_OK], contagem[PARSER_UNKNOWN_FUNCTION],
+           contagem[PARSER_MIXED_VARIABLES], contagem[PARSER_SYNTAX_ERROR]);
+}
+
+static void check_arena(void) {
+    Arena *arena = arena_create(0);
+    TokenBuffer r1, r2;
+    assert(parser_compile("sqrt(1-x*x)*3", &r1) == PARSER_OK);
+    assert(parser_compile_arena("sqrt(1-x*x)*3", &r2, arena) == PARSER_OK);
+    assert(r2.arena == arena && rpn_iguais(&r1, &r2));
+    assert(parser_compile_arena("sqrt(", &r2, arena) == PARSER_SYNTAX_ERROR);
+    parser_free_buffer(&r1);
+    arena_destroy(arena);
+    printf("✓ Compilação na arena\n");
+}
+
+int main(void) {
+    check_casos();
+    check_corpus();
+    check_aleatorias();
+    check_arena();
+
+    printf("\nTodos os testes do compilador em uma passada passaram.\n");
+    return 0;
+}
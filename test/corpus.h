@@ -0,0 +1,100 @@
+/* Corpus das 77 curvas do programa original ZX81 (ver gerar_77_curvas.sh).
+ * Compartilhado pelos testes e benchmarks que precisam de expressões reais. */
+#ifndef TEST_CORPUS_H
+#define TEST_CORPUS_H
+
+typedef struct {
+    const char *id;     /* Número da curva no programa original */
+    const char *spec;   /* Entrada aceita por plot_parse_text() */
+    const char *name;   /* Nome da curva */
+} CorpusCurve;
+
+static const CorpusCurve corpus_curves[] = {
+    { "1", "Y=5",                                                             "Função constante" },
+    { "2", "Y=abs(x)",                                                        "Função valor absoluto" },
+    { "3", "Y=x/3+2",                                                         "Função linear" },
+    { "4", "R=6",                                                             "Circunferência" },
+    { "5", "R=6/(2-sin(t))",                                                  "Elipse" },
+    { "6", "Y=x*x:-2,2:",                                                     "Parábola" },
+    { "7", "Y=1/(x*x):-3,3:",                                                 "Função fracionária" },
+    { "8", "Y=x*x*x:-1.5,1.5:",                                               "Parábola cúbica" },
+    { "9", "Y=(x*x)**(1/3)",                                                  "Parábola semicúbica" },
+    { "10", "R=4/(2-3*cos(t))",                                                "Hipérbole" },
+    { "11", "Y=1/x:-4,4:",                                                     "Hipérbole equilátera" },
+    { "12", "Y=1.3**x",                                                        "Curva exponencial" },
+    { "13", "Y=ln(x):.2,2:",                                                   "Curva logarítmica" },
+    { "14", "Y=exp(1)**(-x*x):-2,2:",                                          "Curva de Gauss" },
+    { "15", "Y=sin(x):-pi,pi:",                                                "Senóide" },
+    { "16", "Y=cos(x):-pi,pi:",                                                "Co-senóide" },
+    { "17", "Y=tan(x):-4.7,4.7:",                                              "Tangentóide" },
+    { "18", "Y=1/cos(x):-4.7,4.7:",                                            "Secantóide" },
+    { "19", "Y=asin(x):-1,1:",                                                 "Inversa da senóide" },
+    { "20", "Y=acos(x):-1,1:",                                                 "Inversa da co-senóide" },
+    { "21", "Y=atan(x)",                                                       "Inversa da tangentóide" },
+    { "22", "X=t-sin(t);Y=1-cos(t):-2,2:",                                     "Ciclóide de cúspide" },
+    { "23", "X=t+sin(t);Y=1-cos(t):-2,2:",                                     "Ciclóide de vértice" },
+    { "24", "X=3*t-5*sin(t);Y=3-5*cos(t):-3,3:",                               "Ciclóide alongada" },
+    { "25", "X=4*t-3*sin(t);Y=4-3*cos(t):-3,3:",                               "Ciclóide encurtada" },
+    { "26", "Y=(exp(1)**x+exp(1)**-x)/2:-2,2:",                                "Catenária" },
+    { "27", "X=5*cos(t)-cos(5*t);Y=5*sin(t)-sin(5*t)",                         "Epiciclóide de 4 cúspides" },
+    { "28", "X=2*cos(t)+cos(2*t);Y=2*sin(t)-sin(2*t)",                         "Deltóide" },
+    { "29", "X=cos(t)*cos(t)*cos(t);Y=sin(t)*sin(t)*sin(t)",                   "Astróide" },
+    { "30", "X=5*cos(t)+5*t*sin(t);Y=5*sin(t)-5*t*cos(t)",                     "Evolvente da circunferência" },
+    { "31", "R=(2/cos(t))+3:-1.4,1.4:",                                        "Concóide de reta" },
+    { "32", "R=2*tan(t)*sin(t):0,1:",                                          "Cissóide de diocles" },
+    { "33", "R=-3*cos(2*t)/(cos(t)):.1,1.4:",                                  "Estrofóide" },
+    { "34", "R=4*sin(t)-(2*sin(t)*sin(t)/cos(t)):0,1:",                        "Ofiuróide" },
+    { "35", "R=(6*sin(t)*cos(t))/(sin(t)*sin(t)*sin(t)+cos(t)*cos(t)*cos(t))", "Folium de Descartes" },
+    { "36", "R=4*sin(3*t)/sin(2*t):.1,1.5:",                                   "Trissectriz de Maclaurin" },
+    { "37", "R=(2*t)/(pi*sin(t)):-.2,.5:",                                     "Quadratriz de Hípias" },
+    { "38", "R=2/sin(2*t):.1,1.5:",                                            "Cruciforme" },
+    { "39", "R=1/tan(t):.1,1.5:",                                              "Curva de Gutschoven" },
+    { "40", "Y=8/(4+x*x):-5,5:",                                               "Cúbica de Agnesi" },
+    { "41", "R=5*sin(t)*cos(t)*cos(t)",                                        "Bifolium" },
+    { "42", "R**2=cos(2*t)",                                                   "Lemniscata de Bernoulli" },
+    { "43", "R**2=sin(2*t)",                                                   "Lemniscata" },
+    { "44", "R=sin(3*t)",                                                      "Rosácea de 3 folhas" },
+    { "45", "R=cos(2*t)",                                                      "Rosácea de 4 folhas" },
+    { "46", "R=sin(5*t)",                                                      "Rosácea de 5 folhas" },
+    { "47", "R=sin(4*t)",                                                      "Rosácea de 8 folhas" },
+    { "48", "R=4*cos(t)+2",                                                    "Caracol de Pascal" },
+    { "49", "R=4*cos(t)+4",                                                    "Cardióide" },
+    { "50", "R=3*sin(t)/t:-2,2:",                                              "Coclóide" },
+    { "51", "R=1+2*sin(t/2):-2,2:",                                            "Nefróide de Freeth" },
+    { "52", "X=5*(3*cos(t)-cos(3*t));Y=5*(3*sin(t)-sin(3*t))",                 "Nefróide de Proctor" },
+    { "53a", "X=sin(3*t);Y=sin(t)",                                             "Lissajous (a)" },
+    { "53b", "X=sin(t/2+pi/8);Y=sin(t):0,4:",                                   "Lissajous (b)" },
+    { "53c", "X=sin(3/2*t);Y=sin(t)",                                           "Lissajous (c)" },
+    { "53d", "X=sin(2*t);Y=sin(t)",                                             "Lissajous (d)" },
+    { "53e", "X=sin(3*t+pi/2);Y=sin(t)",                                        "Lissajous (e)" },
+    { "53f", "X=sin(3*t+pi/4);Y=sin(t)",                                        "Lissajous (f)" },
+    { "53g", "X=sin(t/2+pi/16);Y=sin(t):0,4:",                                  "Lissajous (g)" },
+    { "54", "R=t:0,3:",                                                        "Espiral de Arquimedes" },
+    { "55", "R**2=4*t:0,3:",                                                   "Espiral parabólica" },
+    { "56", "R=e**(t/5):-5/10,3:",                                             "Espiral logarítmica" },
+    { "57", "R=2*pi/t:1/10,3:",                                                "Espiral hiperbólica" },
+    { "58", "R**2=pi/t:1/10,4:",                                               "Lituus" },
+    { "59", "R=1/4+sin(t)",                                                    "Curva 59" },
+    { "60", "R=sin(t/3):0,3:",                                                 "Curva 60" },
+    { "61", "R=1-ln(t):1/10,4:",                                               "Curva 61" },
+    { "62", "R=1-sin(3/2*t)",                                                  "Curva 62" },
+    { "63", "R=sin(t)*cos(2*t)",                                               "Curva 63" },
+    { "64", "R=sin(2*t)-sin(t)",                                               "Curva 64" },
+    { "65", "R=sin(2*t):-1/2,1/2:",                                            "Curva 65" },
+    { "66", "R=sin(4*t):-1/2,1/2:",                                            "Curva 66" },
+    { "67", "R=2+cos(5*t)",                                                    "Curva 67" },
+    { "68", "R=sin(t/2):0,4:",                                                 "Curva 68" },
+    { "69", "R=t*cos(t):-2.5,2.5:",                                            "Curva 69" },
+    { "70", "R=sin(t*3/2):-.25,2.93:",                                         "Curva 70" },
+    { "71", "R=sin(1.5*t+pi/2):.25,1.77:",                                     "Curva 71" },
+    { "72", "R=cos(t/2):0,4:",                                                 "Curva 72" },
+    { "73", "R=1/(2*cos(t)):-1,1:",                                            "Curva 73" },
+    { "74", "R=1-1.5*sin(t)",                                                  "Curva 74" },
+    { "75", "R=1/cos(t):-1,1:",                                                "Curva 75" },
+    { "76", "R=sin(t)**2+cos(t)**2",                                           "Curva 76" },
+    { "77", "R=1/t:1/4,3:",                                                    "Curva 77" },
+};
+
+#define CORPUS_SIZE ((int)(sizeof(corpus_curves) / sizeof(corpus_curves[0])))
+
+#endif /* TEST_CORPUS_H */
@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parser.h"
+#include "evaluator.h"
+#include "regvm.h"
+#include "optimizer.h"
+#include "multicurvas_plot.h"
+#include "corpus.h"
+#include "assert.h"
+
+/* Tokeniza, converte e otimiza (como plot_generate_samples) */
+static void build(const char *expr, TokenBuffer *out) {
+    TokenBuffer tokens, rpn;
+    assert(parser_tokenize(expr, &tokens) == PARSER_OK);
+    assert(parser_to_rpn(&tokens, &rpn) == PARSER_OK);
+    assert(optimizer_run(&rpn, out, NULL));
+    parser_free_buffer(&tokens);
+    parser_free_buffer(&rpn);
+}
+
+/* Número de instruções do programa de registradores (1 ou 2 saídas) */
+static int instructions(const char *ex, const char *ey) {
+    TokenBuffer rpn[2];
+    build(ex, &rpn[0]);
+    if (ey) build(ey, &rpn[1]);
+    const TokenBuffer *progs[2] = { &rpn[0], &rpn[1] };
+    RegProgram *prog = regvm_compile_multi(progs, ey ? 2 : 1);
+    assert(prog != NULL);
+    int size = prog->size;
+    regvm_free(prog);
+    parser_free_buffer(&rpn[0]);
+    if (ey) parser_free_buffer(&rpn[1]);
+    return size;
+}
+
+static void check_single(const char *expr, int expected) {
+    int got = instructions(expr, NULL);
+    assert(got == expected);
+    printf("✓ %-28s %d instruções\n", expr, got);
+}
+
+static void check_pair(const char *ex, const char *ey, int expected) {
+    int separate = instructions(ex, NULL) + instructions(ey, NULL);
+    int fused = instructions(ex, ey);
+    assert(fused == expected);
+    printf("✓ %-14s ; %-18s %d → %d instruções\n", ex, ey, separate, fused);
+}
+
+int main(void) {
+    printf("╔═══════════════════════════════════════════════════════════╗\n");
+    printf("║   MULTICURVAS - Subexpressões comuns (motor registradores)║\n");
+    printf("╚═══════════════════════════════════════════════════════════╝\n\n");
+    parser_set_locale(LOCALE_POINT);
+
+    /* Dentro de uma expressão */
+    check_single("x*x+1", 2);
+    check_single("cos(2*t)*cos(2*t)", 3);
+    check_single("t*2+2*t", 2);
+    check_single("sin(t/2)-sin(t/2)^2", 4);
+    check_single("t-2-(t-2)", 2);
+
+    /* sin/cos do mesmo operando: um SINCOS */
+    check_single("sin(t)*cos(t)", 2);
+    check_single("sin(3*t)^2+cos(3*t)^2", 5);
+    check_single("cos(t)-sin(t/2)+sin(t)", 5);
+
+    /* Entre X e Y (subexpressões comuns e sincos) */
+    check_pair("cos(t)", "sin(t)*cos(t)", 2);
+    check_pair("t-sin(t)", "1-cos(t)", 3);
+    check_pair("2*cos(t)+cos(2*t)", "2*sin(t)-sin(2*t)", 7);
+    check_pair("t", "t*t", 1);
+
+    /* Corpus: pares paramétricos fundidos vs compilados separadamente */
+    int separate = 0, fused = 0, pairs = 0;
+    for (int c = 0; c < CORPUS_SIZE; c++) {
+        Plot *plot = plot_parse_text(corpus_curves[c].spec, NULL);
+        if (plot->type == PLOT_PARAMETRIC && plot->expr2) {
+            separate += instructions(plot->expr1, NULL) + instructions(plot->expr2, NULL);
+            fused += instructions(plot->expr1, plot->expr2);
+            pairs++;
+        }
+        plot_free(plot);
+    }
+    assert(fused <= separate);
+    printf("\n✓ Corpus: %d pares X/Y, %d → %d instruções por amostra\n", pairs, separate, fused);
+
+    return 0;
+}
@@ -0,0 +1,210 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "multicurvas_plot.h"
+#include "decimate.h"
+#include "render.h"
+#include "captura.h"
+#include "assert.h"
+
+#define CANVAS_W 800
+#define COLUNAS 640     /* área de plotagem de render_svg: 80% de CANVAS_W */
+
+static int invalida(const PlotData *data, int s) {
+    return !plot_data_sample_ok(data, s);
+}
+
+static PlotData *amostrar(const char *spec, int samples) {
+    Plot *plot = plot_parse_text(spec, NULL);
+    assert(plot);
+    plot->samples = samples;
+    PlotData *data = plot_generate_samples(plot, NULL);
+    assert(data);
+    plot_free(plot);
+    return data;
+}
+
+static int fora(double x, double y) {
+    return !isfinite(x) || !isfinite(y) || fabs(x) > 1e6 || fabs(y) > 1e6;
+}
+
+/* Mínimo e máximo de y por coluna (mesma conta do decimador) e quantos
+ * pontos caem fora das colunas */
+static int extremos_por_coluna(const PlotData *data, double minx, double range,
+                               double *lo, double *hi) {
+    int fora_das_colunas = 0;
+    for (int c = 0; c <= COLUNAS; c++) {
+        lo[c] = INFINITY;
+        hi[c] = -INFINITY;
+    }
+    for (int i = 0; i < data->count; i++) {
+        if (fora(data->x[i], data->y[i])) {
+            fora_das_colunas++;
+            continue;
+        }
+        long c = (long)floor((data->x[i] - minx) * COLUNAS / range);
+        assert(c >= 0 && c <= COLUNAS);
+        lo[c] = fmin(lo[c], data->y[i]);
+        hi[c] = fmax(hi[c], data->y[i]);
+    }
+    return fora_das_colunas;
+}
+
+/* Decimação de `spec`: mesma faixa vertical em cada coluna, mesma moldura
+ * do SVG (bounding box, grade e eixos) e no máximo 4 pontos por coluna.
+ * Com polos a grade do SVG tem uma linha por unidade até 1e6: sem `svg`, a
+ * comparação do SVG é pulada. */
+static void check_curva(const char *spec, int samples, int svg) {
+    PlotData *data = amostrar(spec, samples);
+    PlotData *m4 = decimate_plot(data, CANVAS_W);
+    assert(m4);
+
+    double minx = data->x[0], maxx = data->x[0];
+    for (int i = 1; i < data->count; i++) {
+        if (fora(data->x[i], data->y[i])) continue;
+        minx = fmin(minx, data->x[i]);
+        maxx = fmax(maxx, data->x[i]);
+    }
+    double range = maxx - minx < 0.01 ? 1.0 : maxx - minx;
+
+    double *lo_a = malloc((COLUNAS + 1) * sizeof(double));
+    double *hi_a = malloc((COLUNAS + 1) * sizeof(double));
+    double *lo_b = malloc((COLUNAS + 1) * sizeof(double));
+    double *hi_b = malloc((COLUNAS + 1) * sizeof(double));
+    int fora_a = extremos_por_coluna(data, minx, range, lo_a, hi_a);
+    int fora_b = extremos_por_coluna(m4, minx, range, lo_b, hi_b);
+    assert(fora_a == fora_b);
+    for (int c = 0; c <= COLUNAS; c++) {
+        assert(lo_a[c] == lo_b[c] && hi_a[c] == hi_b[c]);
+    }
+
+    // Primeiro e último ponto preservados, ordem de x mantida
+    assert(m4->x[0] == data->x[0] && m4->y[0] == data->y[0]);
+    assert(m4->x[m4->count - 1] == data->x[data->count - 1]);
+    for (int i = 1; i < m4->count; i++) assert(m4->x[i] > m4->x[i - 1]);
+
+    // Limite de 4 pontos por coluna (mais os pontos fora dos limites)
+    assert(m4->count - fora_b <= 4 * (COLUNAS + 1));
+    assert(m4->count - fora_b <= 4 * CANVAS_W);
+
+    // Tudo antes da poligonal (bounding box, grade, eixos) é idêntico
+    if (svg) {
+        char *svg_a = capturar_svg(data, CANVAS_W);
+        char *svg_b = capturar_svg(m4, CANVAS_W);
+        size_t moldura = strstr(svg_a, "points=\"") - svg_a;
+        assert(strncmp(svg_a, svg_b, moldura) == 0);
+        printf("✓ M4 %s: %d → %d pontos, SVG %zu → %zu bytes\n",
+               spec, data->count, m4->count, strlen(svg_a), strlen(svg_b));
+        free(svg_a);
+        free(svg_b);
+    } else {
+        printf("✓ M4 %s: %d → %d pontos (%d fora dos limites)\n",
+               spec, data->count, m4->count, fora_b);
+    }
+
+    free(lo_a);
+    free(hi_a);
+    free(lo_b);
+    free(hi_b);
+    plot_data_free(m4);
+    plot_data_free(data);
+}
+
+/* Amostras inválidas viram quebras; os pontos dos dois lados de cada quebra
+ * continuam na saída */
+static void check_quebras(void) {
+    PlotData *data = amostrar("Y=sqrt(sin(x)):-10,10:", 400001);
+    PlotData *m4 = decimate_plot(data, CANVAS_W);
+    assert(m4);
+
+    int trechos_a = 0, trechos_b = 0;
+    for (int s = 0; s < data->samples; s++) {
+        trechos_a += !invalida(data, s) && (s == 0 || invalida(data, s - 1));
+    }
+    for (int s = 0; s < m4->samples; s++) {
+        trechos_b += !invalida(m4, s) && (s == 0 || invalida(m4, s - 1));
+        if (s > 0) assert(!(invalida(m4, s) && invalida(m4, s - 1)));
+    }
+    assert(trechos_a == trechos_b && trechos_a > 3);
+
+    // Extremidades de cada trecho: mesmos pontos nas duas sequências
+    int i = 0, j = 0;
+    for (int s = 0; s < data->samples; s++) {
+        if (invalida(data, s)) continue;
+        int comeco = s == 0 || invalida(data, s - 1);
+        int fim = s == data->samples - 1 || invalida(data, s + 1);
+        if (comeco || fim) {
+            while (j < m4->count && m4->x[j] != data->x[i]) j++;
+            assert(j < m4->count);
+            assert(m4->y[j] == data->y[i]);
+        }
+        i++;
+    }
+    printf("✓ Quebras preservadas (%d trechos, %d → %d pontos)\n",
+           trechos_a, data->count, m4->count);
+    plot_data_free(m4);
+    plot_data_free(data);
+}
+
+/* Incremental: alimentado amostra a amostra, produz a mesma sequência que
+ * decimate_plot, com estado constante */
+static void check_incremental(void) {
+    PlotData *data = amostrar("Y=sin(40*x)+log(x*x):-3,3:", 200001);
+    PlotData *m4 = decimate_plot(data, CANVAS_W);
+    assert(m4);
+
+    double minx = data->x[0], maxx = data->x[data->count - 1];
+    Decimator d;
+    DecimatedPoint out[DECIMATE_MAX_OUT];
+    decimator_init(&d, minx, maxx, COLUNAS);
+    int s_out = 0, i_out = 0;
+    for (int s = 0, i = 0; s <= data->samples; s++) {
+        int n;
+        if (s == data->samples) {
+            n = decimator_finish(&d, out);
+        } else if (invalida(data, s)) {
+            n = decimator_push(&d, 0.0, 0.0, 1, out);
+        } else {
+            n = decimator_push(&d, data->x[i], data->y[i], 0, out);
+            i++;
+        }
+        assert(n >= 0 && n <= DECIMATE_MAX_OUT);
+        for (int k = 0; k < n; k++, s_out++) {
+            assert(out[k].status == invalida(m4, s_out));
+            if (out[k].status) continue;
+            assert(out[k].x == m4->x[i_out] && out[k].y == m4->y[i_out]);
+            i_out++;
+        }
+    }
+    assert(s_out == m4->samples && i_out == m4->count);
+    printf("✓ Decimação incremental igual à de PlotData (%d pontos)\n", m4->count);
+    plot_data_free(m4);
+    plot_data_free(data);
+}
+
+/* Poucas amostras: nada a decimar */
+static void check_poucos_pontos(void) {
+    PlotData *data = amostrar("Y=x*x:-2,2:", 300);
+    PlotData *m4 = decimate_plot(data, CANVAS_W);
+    assert(m4 && m4->count == data->count);
+    assert(memcmp(m4->x, data->x, data->count * sizeof(double)) == 0);
+    assert(memcmp(m4->y, data->y, data->count * sizeof(double)) == 0);
+    plot_data_free(m4);
+    plot_data_free(data);
+    printf("✓ Curva com menos amostras que colunas fica intacta\n");
+}
+
+int main(void) {
+    check_curva("Y=sin(x):-pi,pi:", 1000000, 1);
+    check_curva("Y=sin(1/x)*x:-1,1:", 1000001, 1);
+    check_curva("Y=1/x:-0.01,0.01:", 2000000, 0);
+    check_quebras();
+    check_incremental();
+    check_poucos_pontos();
+
+    printf("\nTodos os testes de decimação passaram.\n");
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parser.h"
+#include "evaluator.h"
+#include "multicurvas_plot.h"
+#include "kernels.h"
+#include "corpus.h"
+#include "assert.h"
+
+#define N_SAMPLES 257
+
+static const EvalEngine engines[] = { EVAL_ENGINE_THREADED, EVAL_ENGINE_REGISTER,
+                                      EVAL_ENGINE_JIT };
+#define N_ENGINES ((int)(sizeof(engines) / sizeof(engines[0])))
+
+/* Compara cada motor com o interpretador de referência (resultado idêntico) */
+static int check_expression(const char *expr, double a, double b) {
+    TokenBuffer tokens, rpn;
+    if (parser_tokenize(expr, &tokens) != PARSER_OK) return 0;
+    if (parser_to_rpn(&tokens, &rpn) != PARSER_OK) {
+        parser_free_buffer(&tokens);
+        return 0;
+    }
+
+    for (int e = 0; e < N_ENGINES; e++) {
+        EvalProgram *prog = evaluator_compile(&rpn, engines[e]);
+        assert(prog != NULL);
+        for (int i = 0; i < N_SAMPLES; i++) {
+            double v = a + i * (b - a) / (N_SAMPLES - 1);
+            EvalResult ref = evaluator_eval_rpn(&rpn, v);
+            EvalResult got = evaluator_program_eval(prog, v);
+            assert(got.error == ref.error);
+            assert(ref.error != EVAL_OK || got.value == ref.value);
+        }
+
+        /* Lote (kernels escalares): idêntico ao lote de referência */
+        double in[N_SAMPLES], ref_out[N_SAMPLES], got_out[N_SAMPLES];
+        uint8_t ref_st[N_SAMPLES], got_st[N_SAMPLES];
+        for (int i = 0; i < N_SAMPLES; i++) in[i] = a + i * (b - a) / (N_SAMPLES - 1);
+        evaluator_eval_rpn_batch(&rpn, in, ref_out, ref_st, N_SAMPLES);
+        evaluator_program_eval_batch(prog, in, got_out, got_st, N_SAMPLES);
+        for (int i = 0; i < N_SAMPLES; i++) {
+            assert(got_st[i] == ref_st[i]);
+            assert(ref_st[i] != EVAL_OK || got_out[i] == ref_out[i]);
+        }
+
+        evaluator_program_free(prog);
+    }
+
+    parser_free_buffer(&tokens);
+    parser_free_buffer(&rpn);
+    return 1;
+}
+
+/* Programa com duas saídas (DAG compartilhado) vs cada expressão isolada */
+static int check_pair(const char *ex, const char *ey, double a, double b) {
+    TokenBuffer tokens, rpn[2];
+    const char *exprs[2] = { ex, ey };
+    for (int k = 0; k < 2; k++) {
+        if (parser_tokenize(exprs[k], &tokens) != PARSER_OK) return 0;
+        assert(parser_to_rpn(&tokens, &rpn[k]) == PARSER_OK);
+        parser_free_buffer(&tokens);
+    }
+
+    const TokenBuffer *progs[2] = { &rpn[0], &rpn[1] };
+    for (int e = 0; e < N_ENGINES; e++) {
+        EvalProgram *prog = evaluator_compile_multi(progs, 2, engines[e]);
+        assert(prog != NULL && evaluator_program_outputs(prog) == 2);
+
+        double in[N_SAMPLES], v[2][N_SAMPLES];
+        uint8_t st[2][N_SAMPLES];
+        double *outs[2] = { v[0], v[1] };
+        uint8_t *stats[2] = { st[0], st[1] };
+        for (int i = 0; i < N_SAMPLES; i++) in[i] = a + i * (b - a) / (N_SAMPLES - 1);
+        evaluator_program_eval_batch_multi(prog, in, outs, stats, N_SAMPLES);
+
+        for (int i = 0; i < N_SAMPLES; i++) {
+            EvalResult got[EVAL_MAX_OUTPUTS];
+            evaluator_program_eval_multi(prog, in[i], got);
+            for (int k = 0; k < 2; k++) {
+                EvalResult ref = evaluator_eval_rpn(&rpn[k], in[i]);
+                assert(got[k].error == ref.error);
+                assert(ref.error != EVAL_OK || got[k].value == ref.value);
+                assert(st[k][i] == ref.error);
+                assert(ref.error != EVAL_OK || v[k][i] == ref.value);
+            }
+        }
+        evaluator_program_free(prog);
+    }
+
+    parser_free_buffer(&rpn[0]);
+    parser_free_buffer(&rpn[1]);
+    return 1;
+}
+
+int main(void) {
+    printf("╔═══════════════════════════════════════════════════════════╗\n");
+    printf("║     MULTICURVAS - Motores de avaliação vs referência      ║\n");
+    printf("╚═══════════════════════════════════════════════════════════╝\n\n");
+    parser_set_locale(LOCALE_POINT);
+    /* Motores escalares usam libm; compara lotes com os kernels de referência */
+    kernels_set_level(KERNELS_SCALAR);
+
+    /* Corpus das 77 curvas */
+    int checked = 0;
+    for (int c = 0; c < CORPUS_SIZE; c++) {
+        Plot *plot = plot_parse_text(corpus_curves[c].spec, NULL);
+        assert(plot != NULL);
+        checked += check_expression(plot->expr1, -7.0, 7.0);
+        if (plot->expr2) checked += check_expression(plot->expr2, -7.0, 7.0);
+        plot_free(plot);
+    }
+    printf("✓ Corpus: %d expressões idênticas em todos os motores\n", checked);
+
+    /* Curvas paramétricas compiladas com duas saídas */
+    int pairs = 0;
+    for (int c = 0; c < CORPUS_SIZE; c++) {
+        Plot *plot = plot_parse_text(corpus_curves[c].spec, NULL);
+        if (plot->type == PLOT_PARAMETRIC && plot->expr2) {
+            pairs += check_pair(plot->expr1, plot->expr2, -7.0, 7.0);
+        }
+        plot_free(plot);
+    }
+    printf("✓ Corpus: %d pares X/Y idênticos com saídas fundidas\n", pairs);
+
+    /* Erros diferentes por saída: cada uma reporta o da sua ordem original */
+    const char *edge_pairs[][2] = {
+        { "sqrt(t)", "1/(t+1)+sqrt(t)" },
+        { "log(t)*cos(t)", "cos(t)/t" },
+        { "cos(t)+sin(t)", "sin(t)*cos(t)" },
+        { "t", "3" },
+        { "1/t 2", "asin(t)+1/t" },
+        { "acosh(t)+atanh(t)", "atanh(t)+acosh(t)" }
+    };
+    for (int i = 0; i < (int)(sizeof(edge_pairs) / sizeof(edge_pairs[0])); i++) {
+        check_pair(edge_pairs[i][0], edge_pairs[i][1], -3.0, 3.0);
+        printf("✓ %s ; %s\n", edge_pairs[i][0], edge_pairs[i][1]);
+    }
+
+    /* Casos de erro e programas malformados */
+    const char *edge[] = {
+        "1/x", "sqrt(x)", "log(x)+1/(x-1)", "asin(x)*acos(x/2)", "exp(x*x*x)",
+        "atanh(x)+acosh(x+2)", "---x", "1/x 2", "sin()", "x^0.5", "(x*x)**(1/3)",
+        "1.3**x", "tan(x)*frac(x)-ceil(x)"
+    };
+    for (int i = 0; i < (int)(sizeof(edge) / sizeof(edge[0])); i++) {
+        check_expression(edge[i], -3.0, 3.0);
+        printf("✓ %s\n", edge[i]);
+    }
+
+    printf("\nTodos os motores concordam com o interpretador de referência.\n");
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "exprcache.h"
+#include "multicurvas_plot.h"
+#include "evaluator.h"
+#include "corpus.h"
+#include "assert.h"
+
+static int liberados = 0;
+static pthread_mutex_t liberados_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void contar_free(void *valor) {
+    pthread_mutex_lock(&liberados_lock);
+    liberados++;
+    pthread_mutex_unlock(&liberados_lock);
+    free(valor);
+}
+
+static int *inteiro(int v) {
+    int *p = malloc(sizeof(int));
+    *p = v;
+    return p;
+}
+
+static void check_normalize(const char *expr, const char *esperado) {
+    char out[64];
+    size_t n = exprcache_normalize(expr, out, sizeof(out));
+    assert(strcmp(out, esperado) == 0 && n == strlen(esperado));
+}
+
+static void check_normalizacao(void) {
+    check_normalize("sin(x)", "sin(x)");
+    check_normalize("  sin ( x ) * 2 ", "sin(x)*2");
+    check_normalize("1 2", "1 2");          /* dois números: o espaço separa */
+    check_normalize("x\t \tpi", "x pi");
+    check_normalize("2 .5+ 1,5", "2 .5+1,5");
+    check_normalize("", "");
+
+    char curto[4];
+    assert(exprcache_normalize("sin( x )", curto, sizeof(curto)) == 6);
+    assert(strcmp(curto, "sin") == 0);
+    assert(exprcache_normalize("a b", NULL, 0) == 3);
+    printf("✓ Normalização das chaves\n");
+}
+
+static void check_lru(void) {
+    liberados = 0;
+    ExprCache *c = exprcache_create(2, contar_free);
+    assert(exprcache_get(c, "a") == NULL);
+    ExprCacheEntry *a = exprcache_put(c, "a", inteiro(1));
+    ExprCacheEntry *b = exprcache_put(c, "b", inteiro(2));
+    exprcache_release(c, a);
+    exprcache_release(c, b);
+
+    // "a" passa a ser a mais recente: "b" sai quando "c" entra
+    a = exprcache_get(c, "a");
+    assert(a && *(const int *)exprcache_value(a) == 1);
+    exprcache_release(c, a);
+    exprcache_release(c, exprcache_put(c, "c", inteiro(3)));
+    assert(liberados == 1);
+    assert(exprcache_get(c, "b") == NULL);
+    a = exprcache_get(c, "a");
+    assert(a);
+
+    // Removida enquanto adquirida: só é liberada no release
+    exprcache_release(c, exprcache_put(c, "d", inteiro(4)));
+    exprcache_release(c, exprcache_put(c, "e", inteiro(5)));
+    assert(liberados == 2 && *(const int *)exprcache_value(a) == 1);
+    exprcache_release(c, a);
+    assert(liberados == 3);
+
+    // Mesma chave inserida duas vezes: vale a primeira, o valor novo é liberado
+    ExprCacheEntry *e = exprcache_put(c, "e", inteiro(50));
+    assert(*(const int *)exprcache_value(e) == 5 && liberados == 4);
+    exprcache_release(c, e);
+
+    ExprCacheStats st = exprcache_stats(c);
+    assert(st.hits == 2 && st.misses == 2 && st.evictions == 3);
+    assert(st.entries == 2 && st.capacity == 2);
+    exprcache_clear(c);
+    assert(exprcache_stats(c).entries == 0 && liberados == 6);
+    exprcache_destroy(c);
+    printf("✓ LRU: %llu acertos, %llu faltas, %llu remoções\n",
+           (unsigned long long)st.hits, (unsigned long long)st.misses,
+           (unsigned long long)st.evictions);
+}
+
+/* Várias threads lendo e inserindo chaves de um conjunto maior que o cache */
+#define THREADS 8
+#define ROUNDS 20000
+
+static ExprCache *compartilhado;
+static int criados[THREADS];
+
+static void *leitora(void *arg) {
+    int id = (int)(size_t)arg;
+    unsigned semente = 12345u + id;
+    char chave[16];
+    for (int r = 0; r < ROUNDS; r++) {
+        semente = semente * 1103515245u + 12345u;
+        int k = (semente >> 16) % 24;
+        snprintf(chave, sizeof(chave), "k%d", k);
+        ExprCacheEntry *e = exprcache_get(compartilhado, chave);
+        if (!e) {
+            criados[id]++;
+            e = exprcache_put(compartilhado, chave, inteiro(k));
+        }
+        assert(e && *(const int *)exprcache_value(e) == k);
+        exprcache_release(compartilhado, e);
+    }
+    return NULL;
+}
+
+static void check_threads(void) {
+    liberados = 0;
+    compartilhado = exprcache_create(16, contar_free);
+    pthread_t th[THREADS];
+    for (int i = 0; i < THREADS; i++) pthread_create(&th[i], NULL, leitora, (void *)(size_t)i);
+    for (int i = 0; i < THREADS; i++) pthread_join(th[i], NULL);
+
+    ExprCacheStats st = exprcache_stats(compartilhado);
+    int total = 0;
+    for (int i = 0; i < THREADS; i++) total += criados[i];
+    assert(st.hits + st.misses == THREADS * ROUNDS && st.misses == (uint64_t)total);
+    exprcache_destroy(compartilhado);
+    assert(liberados == total);
+    printf("✓ %d threads: %llu acertos, %llu faltas, todos os valores liberados\n",
+           THREADS, (unsigned long long)st.hits, (unsigned long long)st.misses);
+}
+
+/* plot_generate_samples com e sem cache: mesmos pontos */
+static void check_plot(void) {
+    ExprCache *cache = plot_program_cache();
+    exprcache_clear(cache);
+    ExprCacheStats antes = exprcache_stats(cache);
+
+    for (int rodada = 0; rodada < 2; rodada++) {
+        for (int c = 0; c < CORPUS_SIZE; c++) {
+            Plot *plot = plot_parse_text(corpus_curves[c].spec, NULL);
+            plot_cache_enabled = 1;
+            PlotData *a = plot_generate_samples(plot, NULL);
+            plot_cache_enabled = 0;
+            PlotData *b = plot_generate_samples(plot, NULL);
+            plot_cache_enabled = 1;
+            assert(a && b && a->count == b->count && a->samples == b->samples);
+            assert(memcmp(a->x, b->x, a->count * sizeof(double)) == 0);
+            assert(memcmp(a->y, b->y, a->count * sizeof(double)) == 0);
+            assert(memcmp(a->valid, b->valid, (a->samples + 63) / 64 * sizeof(uint64_t)) == 0);
+            plot_data_free(a);
+            plot_data_free(b);
+            plot_free(plot);
+        }
+    }
+    ExprCacheStats st = exprcache_stats(cache);
+    uint64_t faltas = st.misses - antes.misses;
+    assert(faltas <= CORPUS_SIZE && st.hits - antes.hits == 2 * CORPUS_SIZE - faltas);
+
+    // Espaços não mudam a chave; motor e locale mudam
+    Plot *p1 = plot_parse_text("Y=sin( x )*2", NULL);
+    Plot *p2 = plot_parse_text("Y=sin(x) * 2", NULL);
+    antes = exprcache_stats(cache);
+    plot_data_free(plot_generate_samples(p1, NULL));
+    plot_data_free(plot_generate_samples(p2, NULL));
+    EvalEngine motor = evaluator_engine;
+    evaluator_set_engine(EVAL_ENGINE_SWITCH);
+    plot_data_free(plot_generate_samples(p2, NULL));
+    evaluator_set_engine(motor);
+    parser_set_locale(LOCALE_COMMA);
+    plot_data_free(plot_generate_samples(p2, NULL));
+    parser_set_locale(LOCALE_POINT);
+    st = exprcache_stats(cache);
+    assert(st.misses - antes.misses == 3 && st.hits - antes.hits == 1);
+    plot_free(p1);
+    plot_free(p2);
+    printf("✓ Corpus com e sem cache idêntico (%llu faltas, %llu acertos)\n",
+           (unsigned long long)faltas, (unsigned long long)(2 * CORPUS_SIZE - faltas));
+}
+
+int main(void) {
+    check_normalizacao();
+    check_lru();
+    check_threads();
+    check_plot();
+
+    printf("\nTodos os testes do cache de expressões passaram.\n");
+    return 0;
+}
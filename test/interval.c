@@ -0,0 +1,187 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "parser.h"
+#include "evaluator.h"
+#include "interval.h"
+#include "kernels.h"
+#include "multicurvas_plot.h"
+#include "presets.h"
+#include "corpus.h"
+#include "assert.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static Interval faixa(double lo, double hi) {
+    Interval v = { lo, hi };
+    return v;
+}
+
+static IntervalResult avaliar(const char *expr, double lo, double hi) {
+    TokenBuffer tokens, rpn;
+    assert(parser_tokenize(expr, &tokens) == PARSER_OK);
+    assert(parser_to_rpn(&tokens, &rpn) == PARSER_OK);
+    IntervalResult r = interval_eval_rpn(&rpn, faixa(lo, hi));
+    parser_free_buffer(&tokens);
+    parser_free_buffer(&rpn);
+    return r;
+}
+
+static void check_status(const char *expr, double lo, double hi, IntervalStatus esperado) {
+    IntervalResult r = avaliar(expr, lo, hi);
+    if (r.status != esperado) {
+        printf("  %s em [%g, %g]: status %d, esperado %d\n", expr, lo, hi, r.status, esperado);
+    }
+    assert(r.status == esperado);
+}
+
+/* Provas de domínio, polos e divisão por zero */
+static void check_provas(void) {
+    check_status("sqrt(x)", -2, -1, INTERVAL_FAILS);
+    check_status("sqrt(x)", -1, 1, INTERVAL_MAYBE);
+    check_status("sqrt(x)", 0, 1, INTERVAL_SAFE);
+    check_status("sqrt(1-x*x)", -0.5, 0.5, INTERVAL_SAFE);
+    check_status("log(x)", -3, 0, INTERVAL_FAILS);
+    check_status("log(x)", 0, 1, INTERVAL_MAYBE);
+    check_status("asin(x)", 1.5, 2, INTERVAL_FAILS);
+    check_status("acosh(x)", 1, 9, INTERVAL_SAFE);
+    check_status("atanh(x)", -1, 0, INTERVAL_MAYBE);
+    check_status("tan(x)", -1, 1, INTERVAL_SAFE);
+    check_status("tan(x)", 1, 2, INTERVAL_MAYBE);
+    check_status("tan(x)", 2, 4, INTERVAL_SAFE);
+    check_status("1/cos(x)", 1, 2, INTERVAL_MAYBE);
+    check_status("1/x", -1, 1, INTERVAL_MAYBE);
+    check_status("1/x", 0.5, 4, INTERVAL_SAFE);
+    check_status("x/0", -1, 1, INTERVAL_FAILS);
+    check_status("1/floor(x)", 0.2, 0.8, INTERVAL_FAILS);
+    check_status("(-2)^x", 0.5, 0.5, INTERVAL_FAILS);
+    check_status("x^0.5", -3, -2, INTERVAL_FAILS);
+    check_status("x^2", -3, 2, INTERVAL_SAFE);
+    check_status("x^-1", -3, 2, INTERVAL_MAYBE);
+    check_status("exp(x)", 0, 800, INTERVAL_MAYBE);
+    check_status("6/(2-sin(x))", -100, 100, INTERVAL_SAFE);
+    check_status("sqrt(x)+log(-x)", -1, 1, INTERVAL_MAYBE);
+    check_status("sqrt(x)+log(x-5)", -1, 1, INTERVAL_FAILS);
+
+    /* x*x é um quadrado, não o produto de dois intervalos independentes */
+    IntervalResult q = avaliar("x*x", -2, 1);
+    assert(q.status == INTERVAL_SAFE && q.value.lo >= 0.0 && q.value.hi >= 4.0);
+    check_status("sqrt(x*x)", -2, 1, INTERVAL_SAFE);
+
+    /* Extremos de sin/cos dentro da faixa */
+    IntervalResult s = avaliar("sin(x)", 0, 2);
+    assert(s.value.hi >= 1.0 && s.value.lo <= 0.0 && s.value.lo > -0.01);
+    IntervalResult c = avaliar("cos(x)", 3, 3.5);
+    assert(c.value.lo <= -1.0 && c.value.hi < -0.9);
+    printf("✓ Provas de domínio, polos e divisão por zero\n");
+}
+
+/* Em faixas aleatórias das curvas do corpus, a prova vale amostra a amostra:
+ * SAFE → nenhuma falha e valores dentro do intervalo; FAILS → todas falham */
+static void check_corpus(void) {
+    enum { FAIXAS = 200, PONTOS = 64 };
+    srand(12345);
+    int seguras = 0, falhas = 0;
+
+    for (int c = 0; c < CORPUS_SIZE; c++) {
+        Plot *plot = plot_parse_text(corpus_curves[c].spec, NULL);
+        TokenBuffer rpn[2];
+        int n = plot_build_programs(plot, rpn, NULL);
+        assert(n > 0);
+        for (int k = 0; k < n; k++) {
+            for (int f = 0; f < FAIXAS; f++) {
+                double centro = -12.0 + 24.0 * rand() / (double)RAND_MAX;
+                double largura = pow(10.0, -4.0 + 4.0 * rand() / (double)RAND_MAX);
+                Interval t = faixa(centro, centro + largura);
+                IntervalResult r = interval_eval_rpn(&rpn[k], t);
+                seguras += (r.status == INTERVAL_SAFE);
+                falhas += (r.status == INTERVAL_FAILS);
+                for (int j = 0; j < PONTOS; j++) {
+                    double v = t.lo + largura * j / (PONTOS - 1);
+                    EvalResult e = evaluator_eval_rpn(&rpn[k], v);
+                    if (r.status == INTERVAL_SAFE) {
+                        assert(e.error == EVAL_OK);
+                        assert(e.value >= r.value.lo && e.value <= r.value.hi);
+                    } else if (r.status == INTERVAL_FAILS) {
+                        assert(e.error != EVAL_OK);
+                    }
+                }
+            }
+            parser_free_buffer(&rpn[k]);
+        }
+        plot_free(plot);
+    }
+    assert(seguras > 0 && falhas > 0);
+    printf("✓ Provas válidas em faixas do corpus (%d seguras, %d sem domínio)\n",
+           seguras, falhas);
+}
+
+/* Com e sem a análise por intervalos: mesmos pontos e mesmos status */
+static void check_plot(Plot *plot) {
+    plot->samples = 20001;
+    interval_enabled = 0;
+    PlotData *a = plot_generate_samples(plot, NULL);
+    interval_enabled = 1;
+    PlotData *b = plot_generate_samples(plot, NULL);
+    assert(a && b && a->count == b->count);
+    assert(memcmp(a->x, b->x, a->count * sizeof(double)) == 0);
+    assert(memcmp(a->y, b->y, a->count * sizeof(double)) == 0);
+    assert(memcmp(a->valid, b->valid, (plot->samples + 63) / 64 * sizeof(uint64_t)) == 0);
+    plot_data_free(a);
+    plot_data_free(b);
+}
+
+static void check_plots(void) {
+    static const KernelLevel niveis[] = { KERNELS_SCALAR, KERNELS_SSE2, KERNELS_AVX2,
+                                          KERNELS_AVX512 };
+    for (size_t n = 0; n < sizeof(niveis) / sizeof(niveis[0]); n++) {
+        if (kernels_set_level(niveis[n]) != niveis[n]) continue;
+        for (int c = 0; c < CORPUS_SIZE; c++) {
+            Plot *plot = plot_parse_text(corpus_curves[c].spec, NULL);
+            check_plot(plot);
+            plot_free(plot);
+        }
+        for (int p = 0; p < plot_presets_count; p += 5) {
+            Plot *plot = plot_from_preset(&plot_presets[p]);
+            check_plot(plot);
+            plot_free(plot);
+        }
+        printf("✓ Amostragem idêntica com e sem intervalos (%s)\n", kernels_active()->name);
+    }
+    kernels_set_level(KERNELS_SCALAR);
+}
+
+/* Adaptativa: a subdivisão chega à grade mais fina em volta dos polos de tan
+ * sem subdividir o resto da curva */
+static void check_polos_adaptativo(void) {
+    Plot *plot = plot_parse_text("Y=tan(x):-4.7,4.7:", NULL);
+    plot_set_adaptive(plot, 0.5, 800, 600);
+    PlotData *data = plot_generate_samples(plot, NULL);
+    assert(data);
+    double passo = 9.4 / (1 << PLOT_ADAPTIVE_MAX_DEPTH);
+    double polos[] = { -M_PI / 2, M_PI / 2 };
+    for (int p = 0; p < 2; p++) {
+        double perto = INFINITY;
+        for (int i = 0; i < data->count; i++) {
+            perto = fmin(perto, fabs(data->x[i] - polos[p]));
+        }
+        assert(perto <= passo);
+    }
+    assert(data->samples < 2000);
+    printf("✓ Polos de tan localizados com %d amostras\n", data->samples);
+    plot_data_free(data);
+    plot_free(plot);
+}
+
+int main(void) {
+    check_provas();
+    check_corpus();
+    check_plots();
+    check_polos_adaptativo();
+
+    printf("\nTodos os testes de intervalos passaram.\n");
+    return 0;
+}
@@ -0,0 +1,148 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "multicurvas_plot.h"
+#include "render.h"
+#include "batch.h"
+#include "assert.h"
+
+static void check_linha(const char *linha, int esperado, const char *expr,
+                        const char *formato, int w, int h, const char *saida) {
+    BatchJob job;
+    char *errmsg = NULL;
+    int r = batch_parse_line(linha, &job, &errmsg);
+    assert(r == esperado);
+    if (r < 0) {
+        assert(errmsg);
+        printf("  inválida: %-28s %s\n", linha, errmsg);
+        free(errmsg);
+        return;
+    }
+    if (r == 0) return;
+    assert(strcmp(job.expr, expr) == 0 && strcmp(job.output, saida) == 0);
+    assert(strcmp(job.format, formato) == 0 && job.canvas_w == w && job.canvas_h == h);
+    free(job.expr);
+    free(job.output);
+}
+
+static void check_parse(void) {
+    check_linha("Y=x a.svg", 1, "Y=x", "svg", 800, 600, "a.svg");
+    check_linha("  Y=x*x\tcsv  b.txt\n", 1, "Y=x*x", "csv", 800, 600, "b.txt");
+    check_linha("R=6 1024 768 c.bin\r\n", 1, "R=6", "bin", 1024, 768, "c.bin");
+    check_linha("\"X=cos(t); Y=sin(t)\" svg 400 300 \"d e.svg\"", 1,
+                "X=cos(t); Y=sin(t)", "svg", 400, 300, "d e.svg");
+    check_linha("Y=x saida", 1, "Y=x", "svg", 800, 600, "saida");
+    check_linha("", 0, NULL, NULL, 0, 0, NULL);
+    check_linha("   # comentário", 0, NULL, NULL, 0, 0, NULL);
+    check_linha("Y=x", -1, NULL, NULL, 0, 0, NULL);
+    check_linha("Y=x png a.png", -1, NULL, NULL, 0, 0, NULL);
+    check_linha("Y=x 800 a.svg", -1, NULL, NULL, 0, 0, NULL);
+    check_linha("Y=x svg 0 600 a.svg", -1, NULL, NULL, 0, 0, NULL);
+    check_linha("Y=x svg 800 600 a.svg extra", -1, NULL, NULL, 0, 0, NULL);
+    check_linha("\"Y=x a.svg", -1, NULL, NULL, 0, 0, NULL);
+    check_linha("Y=x ../a.svg", -1, NULL, NULL, 0, 0, NULL);
+    printf("✓ Linhas de especificação\n");
+}
+
+/* Conteúdo de outdir/nome (NULL se não existir) */
+static char *ler(const char *outdir, const char *nome, long *tam) {
+    char caminho[512];
+    snprintf(caminho, sizeof(caminho), "%s/%s", outdir, nome);
+    FILE *f = fopen(caminho, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    *tam = ftell(f);
+    rewind(f);
+    char *texto = malloc(*tam + 1);
+    assert(fread(texto, 1, *tam, f) == (size_t)*tam);
+    fclose(f);
+    return texto;
+}
+
+/* O arquivo do lote é o mesmo texto de render_plot para a mesma curva */
+static void check_igual(const char *outdir, const char *nome, const char *expr,
+                        const char *formato, int w, int h) {
+    Plot *plot = plot_parse_text(expr, NULL);
+    PlotData *data = plot_generate_samples(plot, NULL);
+    FILE *esperado = tmpfile();
+    assert(render_plot(esperado, plot, data, expr, formato, w, h));
+    long te = ftell(esperado);
+    rewind(esperado);
+    char *e = malloc(te);
+    assert(fread(e, 1, te, esperado) == (size_t)te);
+
+    long tl;
+    char *l = ler(outdir, nome, &tl);
+    assert(l && tl == te && memcmp(l, e, te) == 0);
+    free(l);
+    free(e);
+    fclose(esperado);
+    plot_data_free(data);
+    plot_free(plot);
+}
+
+static void check_lote(int workers) {
+    char outdir[] = "/tmp/multicurvas_batch_XXXXXX";
+    assert(mkdtemp(outdir));
+
+    const char *specs =
+        "# curvas de teste\n"
+        "Y=sin(x) seno.svg\n"
+        "Y=log( quebrada.svg\n"
+        "R=6/(2-sin(t)) csv elipse.csv\n"
+        "Y=x png x.png\n"
+        "\n"
+        "\"X=cos(t)/t;Y=sin(t)/t:-1,1:\" 640 480 espiral.bin\n"
+        "Y=tan(x) svg 400 300 tangente.svg\n";
+    FILE *in = tmpfile();
+    fputs(specs, in);
+    rewind(in);
+    Batch *batch = batch_read(in);
+    fclose(in);
+    assert(batch && batch->count == 6);
+
+    BatchOptions opts = { workers, 0, 0, 0 };
+    int falhas = batch_run(batch, outdir, &opts);
+    assert(falhas == 2);
+
+    // Falhas ficam no próprio trabalho, com a linha do arquivo
+    assert(!batch->jobs[1].ok && batch->jobs[1].line == 3 && batch->jobs[1].errmsg);
+    assert(!batch->jobs[3].ok && batch->jobs[3].line == 5 && batch->jobs[3].errmsg);
+    assert(batch->jobs[4].line == 7 && strcmp(batch->jobs[4].format, "bin") == 0);
+    for (int i = 0; i < batch->count; i++) {
+        if (batch->jobs[i].ok) assert(batch->jobs[i].count > 0 && !batch->jobs[i].errmsg);
+    }
+
+    check_igual(outdir, "seno.svg", "Y=sin(x)", "svg", 800, 600);
+    check_igual(outdir, "elipse.csv", "R=6/(2-sin(t))", "csv", 800, 600);
+    check_igual(outdir, "espiral.bin", "X=cos(t)/t;Y=sin(t)/t:-1,1:", "bin", 640, 480);
+    check_igual(outdir, "tangente.svg", "Y=tan(x)", "svg", 400, 300);
+    long t;
+    assert(ler(outdir, "quebrada.svg", &t) == NULL);
+
+    const char *nomes[] = { "seno.svg", "elipse.csv", "espiral.bin", "tangente.svg" };
+    char caminho[512];
+    for (int i = 0; i < 4; i++) {
+        snprintf(caminho, sizeof(caminho), "%s/%s", outdir, nomes[i]);
+        unlink(caminho);
+    }
+    rmdir(outdir);
+
+    // Diretório inexistente: cada trabalho falha sozinho
+    falhas = batch_run(batch, "/tmp/multicurvas_batch_inexistente/x", &opts);
+    assert(falhas == batch->count);
+    printf("✓ Lote com %d em paralelo: 4 gravadas, 2 falhas registradas\n", workers);
+    batch_free(batch);
+}
+
+int main(void) {
+    check_parse();
+    check_lote(1);
+    check_lote(4);
+
+    printf("\nTodos os testes do modo lote passaram.\n");
+    return 0;
+}
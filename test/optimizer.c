@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "parser.h"
+#include "evaluator.h"
+#include "optimizer.h"
+#include "multicurvas_plot.h"
+#include "corpus.h"
+#include "assert.h"
+
+#define N_SAMPLES 257
+
+/* Compila e otimiza; retorna 0 se a expressão não compila */
+static int build(const char *expr, TokenBuffer *rpn, TokenBuffer *opt, OptimizerStats *st) {
+    TokenBuffer tokens;
+    if (parser_tokenize(expr, &tokens) != PARSER_OK) return 0;
+    if (parser_to_rpn(&tokens, rpn) != PARSER_OK) {
+        parser_free_buffer(&tokens);
+        return 0;
+    }
+    parser_free_buffer(&tokens);
+    assert(optimizer_run(rpn, opt, st));
+    return 1;
+}
+
+/* Mesmos erros em todas as amostras; valores iguais até poucos ulp
+ * (tolerância absoluta para cancelamentos como x/3 - 2) */
+static void check_same(const TokenBuffer *rpn, const TokenBuffer *opt, double a, double b) {
+    for (int i = 0; i < N_SAMPLES; i++) {
+        double v = a + i * (b - a) / (N_SAMPLES - 1);
+        EvalResult ref = evaluator_eval_rpn(rpn, v);
+        EvalResult got = evaluator_eval_rpn(opt, v);
+        assert(got.error == ref.error);
+        if (ref.error == EVAL_OK) {
+            assert(fabs(got.value - ref.value) <= 1e-14 * (1.0 + fabs(ref.value)));
+        }
+    }
+}
+
+/* Verifica o tamanho do programa otimizado (incluindo TOKEN_END) e a equivalência */
+static void check_case(const char *expr, int expected_size) {
+    TokenBuffer rpn, opt;
+    OptimizerStats st;
+    assert(build(expr, &rpn, &opt, &st));
+    assert(opt.size == expected_size);
+    assert(st.tokens_before == rpn.size && st.tokens_after == opt.size);
+    check_same(&rpn, &opt, -3.0, 3.0);
+    printf("✓ %-22s %2d → %2d tokens\n", expr, rpn.size, opt.size);
+    parser_free_buffer(&rpn);
+    parser_free_buffer(&opt);
+}
+
+/* Subárvore constante com erro não pode ser dobrada */
+static void check_error(const char *expr, EvalError expected) {
+    TokenBuffer rpn, opt;
+    assert(build(expr, &rpn, &opt, NULL));
+    EvalResult r = evaluator_eval_rpn(&opt, 0.5);
+    assert(r.error == expected);
+    check_same(&rpn, &opt, -3.0, 3.0);
+    printf("✓ %-22s erro %d preservado\n", expr, expected);
+    parser_free_buffer(&rpn);
+    parser_free_buffer(&opt);
+}
+
+int main(void) {
+    printf("╔═══════════════════════════════════════════════════════════╗\n");
+    printf("║         MULTICURVAS - Otimizador de RPN                   ║\n");
+    printf("╚═══════════════════════════════════════════════════════════╝\n\n");
+    parser_set_locale(LOCALE_POINT);
+
+    /* Dobra de constantes */
+    check_case("2*pi/3", 2);
+    check_case("sin(pi/6)+e^2", 2);
+    check_case("x*(2*pi/3)", 4);
+    check_case("-(-(3))", 2);
+
+    /* Potências inteiras */
+    check_case("x^2", 4);
+    check_case("x^3", 6);
+    check_case("x^(1+1)", 4);
+    check_case("x^5", 4);
+    check_case("sin(x)^2", 5);
+
+    /* Recíproco e NEG duplo */
+    check_case("x/4", 4);
+    check_case("x/(2*pi)", 4);
+    check_case("--x", 2);
+    check_case("---x", 3);
+
+    /* Erros em subárvores constantes */
+    check_error("log(-1)", EVAL_DOMAIN_ERROR);
+    check_error("x+1/0", EVAL_DIVISION_BY_ZERO);
+    check_error("x/(1-1)", EVAL_DIVISION_BY_ZERO);
+    check_error("sqrt(-2)*x", EVAL_DOMAIN_ERROR);
+    check_error("(-8)^(1/3)", EVAL_DOMAIN_ERROR);
+    check_error("exp(1000)-x", EVAL_MATH_ERROR);
+
+    /* Programas inválidos são copiados sem alteração */
+    {
+        TokenBuffer rpn, opt;
+        OptimizerStats st;
+        assert(build("1/x 2", &rpn, &opt, &st));
+        assert(opt.size == rpn.size && optimizer_saved(&st) == 0);
+        check_same(&rpn, &opt, -3.0, 3.0);
+        printf("✓ programa inválido preservado\n");
+        parser_free_buffer(&rpn);
+        parser_free_buffer(&opt);
+    }
+
+    /* Corpus das 77 curvas */
+    int before = 0, after = 0, count = 0;
+    for (int c = 0; c < CORPUS_SIZE; c++) {
+        Plot *plot = plot_parse_text(corpus_curves[c].spec, NULL);
+        assert(plot != NULL);
+        const char *exprs[2] = { plot->expr1, plot->expr2 };
+        for (int k = 0; k < 2 && exprs[k]; k++) {
+            TokenBuffer rpn, opt;
+            OptimizerStats st;
+            if (!build(exprs[k], &rpn, &opt, &st)) continue;
+            check_same(&rpn, &opt, -7.0, 7.0);
+            before += st.tokens_before;
+            after += st.tokens_after;
+            count++;
+            parser_free_buffer(&rpn);
+            parser_free_buffer(&opt);
+        }
+        plot_free(plot);
+    }
+    printf("\n✓ Corpus: %d expressões equivalentes, %d → %d tokens (%d economizados)\n",
+           count, before, after, before - after);
+
+    return 0;
+}
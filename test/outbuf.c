@@ -0,0 +1,152 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "multicurvas_plot.h"
+#include "outbuf.h"
+#include "render.h"
+#include "assert.h"
+
+/* format_fixed(v, d) == snprintf("%.*f", d, v) */
+static void check_valor(double v, int d) {
+    char esperado[FORMAT_FIXED_MAX_LEN + 1];
+    char obtido[FORMAT_FIXED_MAX_LEN + 1];
+    int n = snprintf(esperado, sizeof(esperado), "%.*f", d, v);
+    int m = format_fixed(obtido, v, d);
+    obtido[m] = '\0';
+    if (n != m || strcmp(esperado, obtido) != 0) {
+        printf("  %.17g com %d casas: \"%s\", esperado \"%s\"\n", v, d, obtido, esperado);
+    }
+    assert(n == m && strcmp(esperado, obtido) == 0);
+}
+
+static double aleatorio_bits(void) {
+    uint64_t u = 0;
+    for (int i = 0; i < 4; i++) u = (u << 16) ^ (uint64_t)(rand() & 0xffff);
+    double v;
+    memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+static void check_formatacao(void) {
+    // Casos de borda: empates, zero com sinal, arredondamento que propaga
+    static const double casos[] = {
+        0.0, -0.0, 0.5, 1.5, 2.5, -2.5, 0.125, 0.375, 0.005, 0.015, 0.025,
+        1.005, 2.675, 9.995, 99.995, 0.9999995, -0.004, -0.0000001, 1e-300,
+        5e-7, 4.9999999e-7, 123456.7890125, 4503599627370495.5,
+        9007199254740991.0, 9007199254740992.0, 1e300, -1e22, 0.1, 0.2, 0.3,
+        3.141592653589793, 479.995, 540.005, 80.0, 720.0
+    };
+    for (size_t i = 0; i < sizeof(casos) / sizeof(casos[0]); i++) {
+        for (int d = 0; d <= FORMAT_FIXED_MAX_DECIMALS; d++) check_valor(casos[i], d);
+    }
+    for (int d = 0; d <= FORMAT_FIXED_MAX_DECIMALS; d++) {
+        check_valor(NAN, d);
+        check_valor(-NAN, d);
+        check_valor(INFINITY, d);
+        check_valor(-INFINITY, d);
+    }
+
+    // Aleatórios: magnitudes típicas de coordenadas, múltiplos exatos de
+    // 10^-d +- meio (empates e vizinhos) e padrões de bits quaisquer
+    srand(2024);
+    int testados = 0;
+    for (int i = 0; i < 200000; i++) {
+        int d = i % (FORMAT_FIXED_MAX_DECIMALS + 1);
+        double v = (rand() / (double)RAND_MAX - 0.5) * pow(10.0, rand() % 16 - 6);
+        check_valor(v, d);
+        double k = floor(rand() / (double)RAND_MAX * 1e6);
+        double empate = (k + 0.5) / pow(10.0, d % 4);
+        check_valor(empate, d % 4);
+        check_valor(nextafter(empate, 0.0), d % 4);
+        check_valor(nextafter(empate, 1e9), d % 4);
+        double bits = aleatorio_bits();
+        if (!isnan(bits)) check_valor(bits, d);
+        testados += 5;
+    }
+    printf("✓ format_fixed igual a printf(\"%%.*f\") (%d valores, 0..%d casas)\n",
+           testados, FORMAT_FIXED_MAX_DECIMALS);
+}
+
+/* OutBuf: textos maiores que o buffer e printf que cruza a fronteira */
+static void check_outbuf(void) {
+    FILE *tmp = tmpfile();
+    assert(tmp);
+    static OutBuf ob;
+    outbuf_init(&ob, tmp);
+    char *grande = malloc(OUTBUF_SIZE * 2);
+    memset(grande, 'a', OUTBUF_SIZE * 2);
+    size_t total = 0;
+    for (int i = 0; i < 5000; i++) {
+        outbuf_printf(&ob, "%d:%s;", i, "linha");
+        outbuf_fixed(&ob, i * 0.37, 3);
+        outbuf_putc(&ob, '\n');
+        total += snprintf(NULL, 0, "%d:%s;%.3f\n", i, "linha", i * 0.37);
+    }
+    outbuf_write(&ob, grande, OUTBUF_SIZE * 2);
+    outbuf_printf(&ob, "%.*s", OUTBUF_SIZE + 10, grande);
+    total += OUTBUF_SIZE * 3 + 10;
+    outbuf_flush(&ob);
+    assert((size_t)ftell(tmp) == total);
+
+    rewind(tmp);
+    char linha[64], esperado[64];
+    for (int i = 0; i < 5000; i++) {
+        assert(fgets(linha, sizeof(linha), tmp));
+        snprintf(esperado, sizeof(esperado), "%d:%s;%.3f\n", i, "linha", i * 0.37);
+        assert(strcmp(linha, esperado) == 0);
+    }
+    free(grande);
+    fclose(tmp);
+    printf("✓ OutBuf: ordem e conteúdo preservados através das descargas\n");
+}
+
+/* render_csv com stdout redirecionado, comparado ao printf por ponto */
+static void check_csv(void) {
+    Plot *plot = plot_parse_text("Y=tan(x)*100000:-4.7,4.7:", NULL);
+    plot->samples = 100001;
+    PlotData *data = plot_generate_samples(plot, NULL);
+    assert(data);
+
+    FILE *a = tmpfile(), *b = tmpfile();
+    assert(a && b);
+    fflush(stdout);
+    int salvo = dup(fileno(stdout));
+    dup2(fileno(a), fileno(stdout));
+    render_csv(data);
+    fflush(stdout);
+    dup2(salvo, fileno(stdout));
+    close(salvo);
+
+    fprintf(b, "x,y\n");
+    for (int i = 0; i < data->count; i++) fprintf(b, "%.6f,%.6f\n", data->x[i], data->y[i]);
+
+    long ta = ftell(a), tb = ftell(b);
+    assert(ta == tb);
+    rewind(a);
+    rewind(b);
+    char *ca = malloc(ta), *cb = malloc(tb);
+    assert(fread(ca, 1, ta, a) == (size_t)ta && fread(cb, 1, tb, b) == (size_t)tb);
+    assert(memcmp(ca, cb, ta) == 0);
+    printf("✓ render_csv idêntico ao printf (%ld bytes)\n", ta);
+
+    free(ca);
+    free(cb);
+    fclose(a);
+    fclose(b);
+    plot_data_free(data);
+    plot_free(plot);
+}
+
+int main(void) {
+    check_formatacao();
+    check_outbuf();
+    check_csv();
+
+    printf("\nTodos os testes de formatação passaram.\n");
+    return 0;
+}
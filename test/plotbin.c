@@ -0,0 +1,196 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include "multicurvas_plot.h"
+#include "plotbin.h"
+#include "assert.h"
+
+static char caminho[] = "/tmp/multicurvas_plotbin_XXXXXX";
+
+static int invalida(const PlotData *data, int s) {
+    return !plot_data_sample_ok(data, s);
+}
+
+/* Grava `data` num arquivo temporário (caminho em `caminho`) */
+static void gravar(const Plot *plot, const PlotData *data) {
+    FILE *out = fopen(caminho, "wb");
+    assert(out);
+    assert(plotbin_write(out, plot, data));
+    fclose(out);
+}
+
+/* Grava, mapeia e compara coluna a coluna com o PlotData original */
+static void check_ida_e_volta(const char *spec, int adaptativa) {
+    Plot *plot = plot_parse_text(spec, NULL);
+    assert(plot);
+    plot->samples = 10001;
+    if (adaptativa) plot_set_adaptive(plot, 0.5, 800, 600);
+    PlotData *data = plot_generate_samples(plot, NULL);
+    assert(data);
+    gravar(plot, data);
+
+    PlotBinFile *f = plotbin_open(caminho, NULL);
+    assert(f);
+    double C, D;
+    plot_get_interval(plot, &C, &D);
+    assert(f->type == plot->type && f->C == C && f->D == D);
+    assert(f->samples == (uint64_t)data->samples && f->count == (uint64_t)data->count);
+
+    // Colunas alinhadas, usadas direto do mapeamento
+    assert((uintptr_t)f->x % PLOTBIN_ALIGN == 0);
+    assert((uintptr_t)f->y % PLOTBIN_ALIGN == 0);
+    assert((uintptr_t)f->status % PLOTBIN_ALIGN == 0);
+    int invalidas = 0;
+    for (int s = 0, i = 0; s < data->samples; s++) {
+        assert(f->status[s] == invalida(data, s));
+        if (invalida(data, s)) {
+            assert(isnan(f->x[s]) && isnan(f->y[s]));
+            invalidas++;
+            continue;
+        }
+        assert(memcmp(&f->x[s], &data->x[i], sizeof(double)) == 0);
+        assert(memcmp(&f->y[s], &data->y[i], sizeof(double)) == 0);
+        i++;
+    }
+
+    // De volta a PlotData: idêntico ao original
+    PlotData *lido = plotbin_to_plotdata(f);
+    assert(lido && lido->count == data->count && lido->samples == data->samples);
+    assert(memcmp(lido->x, data->x, data->count * sizeof(double)) == 0);
+    assert(memcmp(lido->y, data->y, data->count * sizeof(double)) == 0);
+    for (int s = 0; s < data->samples; s++) assert(invalida(lido, s) == invalida(data, s));
+
+    printf("✓ %s%s: %d amostras (%d inválidas) ida e volta\n", spec,
+           adaptativa ? " (adaptativa)" : "", data->samples, invalidas);
+    plot_data_free(lido);
+    plotbin_close(f);
+    plot_data_free(data);
+    plot_free(plot);
+}
+
+/* Cabeçalho little-endian nos offsets documentados */
+static void check_cabecalho(void) {
+    Plot *plot = plot_parse_text("R**2=cos(2*t)", NULL);
+    PlotData *data = plot_generate_samples(plot, NULL);
+    assert(data);
+    gravar(plot, data);
+
+    FILE *in = fopen(caminho, "rb");
+    unsigned char h[PLOTBIN_HEADER_SIZE];
+    assert(fread(h, 1, sizeof(h), in) == sizeof(h));
+    fclose(in);
+    assert(memcmp(h, "MCURVAS\0", 8) == 0);
+    assert(h[8] == PLOTBIN_VERSION && h[9] == 0 && h[12] == PLOTBIN_HEADER_SIZE);
+    assert(h[16] == PLOT_POLAR_R2);
+    uint64_t samples = 0, x_offset = 0;
+    for (int i = 7; i >= 0; i--) {
+        samples = (samples << 8) | h[40 + i];
+        x_offset = (x_offset << 8) | h[56 + i];
+    }
+    assert(samples == (uint64_t)data->samples && x_offset == PLOTBIN_HEADER_SIZE);
+    for (int i = 80; i < PLOTBIN_HEADER_SIZE; i++) assert(h[i] == 0);
+    plot_data_free(data);
+    plot_free(plot);
+    printf("✓ Cabeçalho little-endian versionado\n");
+}
+
+/* Arquivos inválidos são rejeitados com mensagem */
+static void check_rejeita(const unsigned char *bytes, size_t n, const char *motivo) {
+    FILE *out = fopen(caminho, "wb");
+    assert(out && fwrite(bytes, 1, n, out) == n);
+    fclose(out);
+    char *errmsg = NULL;
+    assert(plotbin_open(caminho, &errmsg) == NULL);
+    assert(errmsg != NULL);
+    printf("  %s: %s\n", motivo, errmsg);
+    free(errmsg);
+}
+
+static void check_invalidos(void) {
+    Plot *plot = plot_parse_text("Y=x", NULL);
+    PlotData *data = plot_generate_samples(plot, NULL);
+    gravar(plot, data);
+    FILE *in = fopen(caminho, "rb");
+    fseek(in, 0, SEEK_END);
+    size_t n = ftell(in);
+    rewind(in);
+    unsigned char *bytes = malloc(n);
+    assert(fread(bytes, 1, n, in) == n);
+    fclose(in);
+
+    check_rejeita(bytes, 64, "truncado no cabeçalho");
+    check_rejeita(bytes, n - 1, "truncado na coluna de status");
+    bytes[0] = 'X';
+    check_rejeita(bytes, n, "magic");
+    bytes[0] = 'M';
+    bytes[8] = 9;
+    check_rejeita(bytes, n, "versão");
+    bytes[8] = PLOTBIN_VERSION;
+    bytes[47] = 0x40;   /* samples enorme */
+    check_rejeita(bytes, n, "contagem");
+    bytes[47] = 0;
+    char *errmsg = NULL;
+    assert(plotbin_open("/tmp/multicurvas_plotbin_inexistente", &errmsg) == NULL && errmsg);
+    free(errmsg);
+
+    free(bytes);
+    plot_data_free(data);
+    plot_free(plot);
+    printf("✓ Arquivos inválidos rejeitados\n");
+}
+
+/* Mais amostras que PLOTBIN_MAX_PLOTDATA (arquivo esparso): plotbin_open
+ * aceita, plotbin_to_plotdata recusa */
+static void check_grande_demais(void) {
+    Plot *plot = plot_parse_text("Y=x", NULL);
+    PlotData *data = plot_generate_samples(plot, NULL);
+    gravar(plot, data);
+
+    uint64_t samples = (uint64_t)PLOTBIN_MAX_PLOTDATA + 1;
+    uint64_t y = (PLOTBIN_HEADER_SIZE + 8 * samples + 63) / 64 * 64;
+    uint64_t status = (y + 8 * samples + 63) / 64 * 64;
+    uint64_t campos[4][2] = { { 40, samples }, { 56, PLOTBIN_HEADER_SIZE },
+                              { 64, y }, { 72, status } };
+    unsigned char h[PLOTBIN_HEADER_SIZE];
+    FILE *io = fopen(caminho, "r+b");
+    assert(io && fread(h, 1, sizeof(h), io) == sizeof(h));
+    for (int c = 0; c < 4; c++) {
+        for (int i = 0; i < 8; i++) h[campos[c][0] + i] = (unsigned char)(campos[c][1] >> (8 * i));
+    }
+    rewind(io);
+    assert(fwrite(h, 1, sizeof(h), io) == sizeof(h) && fflush(io) == 0);
+    assert(ftruncate(fileno(io), (off_t)(status + samples)) == 0);
+    fclose(io);
+
+    char *errmsg = NULL;
+    PlotBinFile *f = plotbin_open(caminho, &errmsg);
+    assert(f && f->samples == samples);
+    assert(plotbin_to_plotdata(f) == NULL);
+    plotbin_close(f);
+    plot_data_free(data);
+    plot_free(plot);
+    printf("✓ %llu amostras: legível por plotbin_open, recusado por plotbin_to_plotdata\n",
+           (unsigned long long)samples);
+}
+
+int main(void) {
+    int fd = mkstemp(caminho);
+    assert(fd >= 0);
+    close(fd);
+
+    check_ida_e_volta("Y=sqrt(sin(x)):-10,10:", 0);
+    check_ida_e_volta("Y=tan(x):-4.7,4.7:", 1);
+    check_ida_e_volta("R=6/(2-sin(t))", 0);
+    check_ida_e_volta("X=cos(t)/t;Y=sin(t)/t:-1,1:", 0);
+    check_cabecalho();
+    check_invalidos();
+    check_grande_demais();
+
+    unlink(caminho);
+    printf("\nTodos os testes do formato binário passaram.\n");
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "multicurvas_plot.h"
+#include "decimate.h"
+#include "render.h"
+#include "corpus.h"
+#include "assert.h"
+
+static int alinhado(const void *p) {
+    return ((uintptr_t)p % PLOT_DATA_ALIGN) == 0;
+}
+
+/* Colunas alinhadas, no heap e na arena; bytes por amostra */
+static void check_layout(void) {
+    Arena *arena = arena_create(0);
+    for (int p = 0; p < 2; p++) {
+        PlotPrecision precisao = p ? PLOT_FLOAT32 : PLOT_FLOAT64;
+        for (int n = 1; n < 300; n += 37) {
+            PlotData *h = plot_data_create(n, precisao, NULL);
+            arena_alloc(arena, 1);      /* desalinha a próxima alocação da arena */
+            PlotData *a = plot_data_create(n, precisao, arena);
+            assert(h && a && a->arena == arena && h->capacity == n);
+            PlotData *d[2] = { h, a };
+            for (int k = 0; k < 2; k++) {
+                assert(d[k]->count == 0 && d[k]->samples == 0 && d[k]->precision == precisao);
+                assert(p ? (d[k]->xf && d[k]->yf && !d[k]->x && !d[k]->y)
+                         : (d[k]->x && d[k]->y && !d[k]->xf && !d[k]->yf));
+                assert(alinhado(p ? (void *)d[k]->xf : (void *)d[k]->x));
+                assert(alinhado(p ? (void *)d[k]->yf : (void *)d[k]->y));
+                assert(alinhado(d[k]->valid));
+            }
+            plot_data_free(h);
+        }
+    }
+    arena_destroy(arena);
+
+    double b64 = (double)plot_data_size(1000000, PLOT_FLOAT64) / 1000000;
+    double b32 = (double)plot_data_size(1000000, PLOT_FLOAT32) / 1000000;
+    assert(b64 < 16.2 && b32 < 8.2);
+    printf("✓ Colunas alinhadas a %d bytes; %.3f bytes/amostra (double), %.3f (float)\n",
+           PLOT_DATA_ALIGN, b64, b32);
+}
+
+/* Trechos de plot_data_next_segment == trechos contados amostra a amostra */
+static void check_trechos(void) {
+    unsigned semente = 99u;
+    int total = 0;
+    for (int caso = 0; caso < 2000; caso++) {
+        semente = semente * 1103515245u + 12345u;
+        int n = (semente >> 16) % 400;
+        semente = semente * 1103515245u + 12345u;
+        unsigned limiar = (semente >> 16) % 100;    /* % de amostras válidas */
+        PlotData *d = plot_data_create(n, caso % 2 ? PLOT_FLOAT32 : PLOT_FLOAT64, NULL);
+        for (int s = 0; s < n; s++) {
+            semente = semente * 1103515245u + 12345u;
+            int ok = (semente >> 16) % 100 < limiar;
+            assert(plot_data_append(d, ok, s, -s));
+        }
+        assert(!plot_data_append(d, 1, 0, 0) || n == 0);
+
+        PlotSegment seg = {0};
+        int s = 0, i = 0;
+        while (plot_data_next_segment(d, &seg)) {
+            while (!plot_data_sample_ok(d, s)) s++;
+            assert(seg.sample == s && seg.first == i && seg.len > 0);
+            for (int k = 0; k < seg.len; k++, s++, i++) {
+                assert(plot_data_sample_ok(d, s));
+                assert(plot_data_x(d, i) == s && plot_data_y(d, i) == -s);
+            }
+            assert(s == d->samples || !plot_data_sample_ok(d, s));
+            total++;
+        }
+        assert(i == d->count);
+        while (s < d->samples) assert(!plot_data_sample_ok(d, s++));
+        plot_data_free(d);
+    }
+
+    // Sem bitset (PlotData montado à mão): um trecho com todos os pontos
+    double x[3] = { 1, 2, 3 }, y[3] = { 4, 5, 6 };
+    PlotData manual = { 0 };
+    manual.x = x;
+    manual.y = y;
+    manual.count = manual.samples = 3;
+    PlotSegment seg = {0};
+    assert(plot_data_next_segment(&manual, &seg) && seg.first == 0 && seg.len == 3);
+    assert(!plot_data_next_segment(&manual, &seg));
+    printf("✓ %d trechos de amostras válidas iguais aos da varredura\n", total);
+}
+
+/* PLOT_FLOAT32: mesmas amostras válidas e os pontos de PLOT_FLOAT64
+ * arredondados para float (uniforme e adaptativa) */
+static void check_float32(void) {
+    for (int adaptativa = 0; adaptativa < 2; adaptativa++) {
+        for (int c = 0; c < CORPUS_SIZE; c++) {
+            Plot *plot = plot_parse_text(corpus_curves[c].spec, NULL);
+            assert(plot);
+            if (adaptativa) plot_set_adaptive(plot, 0, 800, 600);
+            PlotData *d64 = plot_generate_samples(plot, NULL);
+            plot->precision = PLOT_FLOAT32;
+            PlotData *d32 = plot_generate_samples(plot, NULL);
+            assert(d64 && d32 && d32->precision == PLOT_FLOAT32);
+            assert(d64->count == d32->count && d64->samples == d32->samples);
+            assert(memcmp(d64->valid, d32->valid, (d64->samples + 63) / 64 * 8) == 0);
+            for (int i = 0; i < d64->count; i++) {
+                float x = (float)d64->x[i], y = (float)d64->y[i];
+                assert(memcmp(&x, &d32->xf[i], sizeof(float)) == 0);
+                assert(memcmp(&y, &d32->yf[i], sizeof(float)) == 0);
+            }
+            plot_data_free(d64);
+            plot_data_free(d32);
+            plot_free(plot);
+        }
+    }
+
+    // M4 mantém a precisão; o SVG sai com os mesmos pontos (x, y em float)
+    Plot *plot = plot_parse_text("Y=sin(x)*exp(x/5):-10,10:", NULL);
+    plot->samples = 200001;
+    plot->precision = PLOT_FLOAT32;
+    PlotData *data = plot_generate_samples(plot, NULL);
+    PlotData *m4 = decimate_plot(data, 800);
+    assert(m4 && m4->precision == PLOT_FLOAT32 && m4->count < data->count / 10);
+    FILE *out = tmpfile();
+    assert(render_plot(out, plot, data, "float32", "svg", 800, 600));
+    assert(ftell(out) > 1000);
+    fclose(out);
+    printf("✓ float32: corpus com os mesmos pontos arredondados; M4 de %d → %d pontos\n",
+           data->count, m4->count);
+    plot_data_free(m4);
+    plot_data_free(data);
+    plot_free(plot);
+}
+
+int main(void) {
+    check_layout();
+    check_trechos();
+    check_float32();
+
+    printf("\nTodos os testes do PlotData passaram.\n");
+    return 0;
+}
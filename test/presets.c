@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parser.h"
+#include "evaluator.h"
+#include "kernels.h"
+#include "multicurvas_plot.h"
+#include "presets.h"
+#include "codegen.h"
+#include "corpus.h"
+#include "assert.h"
+
+/* O preset gera os mesmos pontos que a entrada equivalente */
+static void check_plot(const PlotPreset *preset) {
+    Plot *parsed = plot_parse_text(preset->spec, NULL);
+    Plot *native = plot_from_preset(preset);
+    assert(parsed && native && native->native);
+    assert(parsed->type == native->type);
+    assert(parsed->has_interval == native->has_interval);
+    assert(parsed->C == native->C && parsed->D == native->D);
+
+    PlotData *a = plot_generate_samples(parsed, NULL);
+    PlotData *b = plot_generate_samples(native, NULL);
+    assert(a && b && a->count == b->count);
+    for (int i = 0; i < a->count; i++) {
+        assert(memcmp(&a->x[i], &b->x[i], sizeof(double)) == 0);
+        assert(memcmp(&a->y[i], &b->y[i], sizeof(double)) == 0);
+    }
+    assert(memcmp(a->valid, b->valid, (a->samples + 63) / 64 * sizeof(uint64_t)) == 0);
+
+    plot_data_free(a);
+    plot_data_free(b);
+    plot_free(parsed);
+    plot_free(native);
+}
+
+/* Fora do intervalo do plot (polos, domínio, overflow): mesmos valores e
+ * mesmos EvalError do motor de registradores */
+static void check_errors(const PlotPreset *preset) {
+    enum { N = 4001 };
+    static double in[N], v[2][N], r[2][N];
+    static uint8_t sv[2][N], sr[2][N];
+    for (int i = 0; i < N; i++) in[i] = -200.0 + 400.0 * i / (N - 1);
+
+    Plot *plot = plot_from_preset(preset);
+    TokenBuffer rpn[2];
+    int count = plot_build_programs(plot, rpn, NULL);
+    assert(count > 0);
+    const TokenBuffer *progs[2] = { &rpn[0], &rpn[1] };
+    EvalProgram *prog = evaluator_compile_multi(progs, count, EVAL_ENGINE_REGISTER);
+    assert(prog != NULL);
+
+    double *out_ref[2] = { r[0], r[1] }, *out_nat[2] = { v[0], v[1] };
+    uint8_t *st_ref[2] = { sr[0], sr[1] }, *st_nat[2] = { sv[0], sv[1] };
+    if (count == 1) out_ref[1] = out_nat[1] = NULL, st_ref[1] = st_nat[1] = NULL;
+    evaluator_program_eval_batch_multi(prog, in, out_ref, st_ref, N);
+    preset->eval(in, out_nat, st_nat, N);
+
+    for (int k = 0; k < count; k++) {
+        assert(memcmp(sr[k], sv[k], N) == 0);
+        assert(memcmp(r[k], v[k], N * sizeof(double)) == 0);
+    }
+
+    evaluator_program_free(prog);
+    for (int k = 0; k < count; k++) parser_free_buffer(&rpn[k]);
+    plot_free(plot);
+}
+
+/* --emit-c: unidade autônoma com a função pedida; erro de parse é reportado */
+static void check_emit(void) {
+    FILE *f = tmpfile();
+    assert(f != NULL);
+    Plot *plot = plot_parse_text("R**2=pi/t:1/10,4:", NULL);
+    assert(codegen_emit_plot(f, plot, "lituus", NULL) == 1);
+    plot_free(plot);
+
+    long size = ftell(f);
+    char *text = calloc(size + 1, 1);
+    rewind(f);
+    assert(fread(text, 1, size, f) == (size_t)size);
+    assert(strstr(text, "#include <math.h>") != NULL);
+    assert(strstr(text, "void lituus(const double *in") != NULL);
+    assert(strstr(text, "MC_DOMAIN_ERROR") != NULL);     /* sqrt do R**2 */
+    assert(strstr(text, "sin(u)") != NULL);              /* sincos do ângulo */
+    free(text);
+    fclose(f);
+
+    f = tmpfile();
+    char *errmsg = NULL;
+    plot = plot_parse_text("Y=sin(", NULL);
+    assert(codegen_emit_plot(f, plot, "f", &errmsg) == 0);
+    assert(errmsg != NULL);
+    free(errmsg);
+    plot_free(plot);
+    fclose(f);
+    printf("✓ --emit-c\n");
+}
+
+int main(void) {
+    /* Os presets usam a libm escalar, como o kernel escalar */
+    kernels_set_level(KERNELS_SCALAR);
+
+    assert(plot_presets_count == CORPUS_SIZE);
+    for (int c = 0; c < CORPUS_SIZE; c++) {
+        const PlotPreset *preset = plot_preset_find(corpus_curves[c].id);
+        assert(preset != NULL);
+        assert(strcmp(preset->spec, corpus_curves[c].spec) == 0);
+        check_plot(preset);
+        check_errors(preset);
+    }
+    printf("✓ %d presets idênticos ao avaliador\n", plot_presets_count);
+
+    assert(plot_preset_find("78") == NULL);
+    assert(plot_preset_find(NULL) == NULL);
+    assert(strcmp(plot_preset_find("49")->name, "Cardióide") == 0);
+
+    check_emit();
+    printf("\nTodos os testes de presets passaram.\n");
+    return 0;
+}
@@ -0,0 +1,154 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "multicurvas_plot.h"
+#include "render.h"
+#include "captura.h"
+#include "assert.h"
+
+/* Distância de p ao segmento a-b */
+static double dist_segmento(double px, double py, double ax, double ay,
+                            double bx, double by) {
+    double vx = bx - ax, vy = by - ay;
+    double len2 = vx * vx + vy * vy;
+    double u = len2 > 0 ? ((px - ax) * vx + (py - ay) * vy) / len2 : 0.0;
+    if (u < 0) u = 0;
+    if (u > 1) u = 1;
+    return hypot(px - (ax + u * vx), py - (ay + u * vy));
+}
+
+/* Todo ponto removido fica a até `tol` do segmento mantido que o cobre */
+static void check_desvio(const double *px, const double *py, int n, double tol,
+                         const unsigned char *keep) {
+    assert(keep[0] && keep[n - 1]);
+    int a = 0;
+    for (int b = 1; b < n; b++) {
+        if (!keep[b]) continue;
+        for (int i = a + 1; i < b; i++) {
+            assert(dist_segmento(px[i], py[i], px[a], py[a], px[b], py[b]) <= tol);
+        }
+        a = b;
+    }
+}
+
+static void check_simplify(void) {
+    enum { N = 10001 };
+    double *px = malloc(N * sizeof(double));
+    double *py = malloc(N * sizeof(double));
+    unsigned char *keep = malloc(N);
+
+    /* Reta: só as extremidades */
+    for (int i = 0; i < N; i++) {
+        px[i] = 10.0 + 0.07 * i;
+        py[i] = 500.0 - 0.03 * i;
+    }
+    assert(render_simplify(px, py, N, 0.1, keep) == 2);
+    check_desvio(px, py, N, 0.1, keep);
+
+    /* Canto: o vértice é mantido */
+    for (int i = 0; i < N; i++) {
+        px[i] = i < N / 2 ? i * 0.1 : (N / 2) * 0.1;
+        py[i] = i < N / 2 ? 0.0 : (i - N / 2) * 0.1;
+    }
+    assert(render_simplify(px, py, N, 0.1, keep) == 3);
+    assert(keep[N / 2]);
+
+    /* Circunferência fechada (primeiro == último) */
+    for (int i = 0; i < N; i++) {
+        double t = 2 * 3.14159265358979323846 * i / (N - 1);
+        px[i] = 400 + 240 * cos(t);
+        py[i] = 300 + 240 * sin(t);
+    }
+    int mantidos = render_simplify(px, py, N, 0.25, keep);
+    assert(mantidos > 8 && mantidos < N / 20);
+    check_desvio(px, py, N, 0.25, keep);
+
+    /* Tolerância 0 ou poucos pontos: nada é removido */
+    assert(render_simplify(px, py, N, 0.0, keep) == N);
+    assert(render_simplify(px, py, 2, 5.0, keep) == 2 && keep[0] && keep[1]);
+
+    free(px);
+    free(py);
+    free(keep);
+    printf("✓ Ramer-Douglas-Peucker: desvio dentro da tolerância (círculo: %d de %d pontos)\n",
+           mantidos, N);
+}
+
+/* Número de pontos da poligonal e se (px, py) está entre eles */
+static int pontos_poligonal(const char *svg, const char *ponto, int *achou) {
+    const char *p = strstr(svg, "points=\"");
+    assert(p);
+    p += 8;
+    const char *fim = strchr(p, '"');
+    int n = 0;
+    for (const char *c = p; c < fim; c++) n += (*c == ' ');
+    if (achou) {
+        const char *q = strstr(p, ponto);
+        *achou = (q != NULL && q < fim);
+    }
+    return n;
+}
+
+/* Curva suave com muitas amostras: SVG uma ordem de grandeza menor */
+static void check_svg_suave(void) {
+    Plot *plot = plot_parse_text("Y=sin(x):-pi,pi:", NULL);
+    plot->samples = 100000;
+    PlotData *data = plot_generate_samples(plot, NULL);
+    assert(data);
+
+    render_simplify_tolerance = 0.0;
+    char *cheio = capturar_svg(data, 800);
+    render_simplify_tolerance = 0.25;
+    char *simples = capturar_svg(data, 800);
+    render_simplify_tolerance = 0.0;
+
+    int n_cheio = pontos_poligonal(cheio, "", NULL);
+    int n_simples = pontos_poligonal(simples, "", NULL);
+    assert(n_cheio == data->count);
+    assert(n_simples * 10 < n_cheio);
+    assert(strlen(simples) * 10 < strlen(cheio));
+    printf("✓ SVG de sin(x) com %d amostras: %zu → %zu bytes (%d → %d pontos)\n",
+           plot->samples, strlen(cheio), strlen(simples), n_cheio, n_simples);
+
+    free(cheio);
+    free(simples);
+    plot_data_free(data);
+    plot_free(plot);
+}
+
+/* Amostra inválida no meio de uma reta: os pontos dos dois lados da quebra
+ * continuam na poligonal */
+static void check_quebras(void) {
+    enum { N = 101 };
+    PlotData *data = plot_data_create(N, PLOT_FLOAT64, NULL);
+    assert(data);
+    for (int i = 0; i < N; i++) assert(plot_data_append(data, i != 50, i, i));
+    assert(data->count == N - 1 && data->samples == N);
+
+    render_simplify_tolerance = 0.5;
+    char *svg = capturar_svg(data, 800);
+    render_simplify_tolerance = 0.0;
+    int antes, depois;
+    /* Pixels de x = 49 e x = 51 (bounding box 0..100 em 640 x 480) */
+    char ponto[64];
+    snprintf(ponto, sizeof(ponto), "%.2f,%.2f ", 80 + 49 * 6.4, 540 - 49 * 4.8);
+    assert(pontos_poligonal(svg, ponto, &antes) == 4);
+    snprintf(ponto, sizeof(ponto), "%.2f,%.2f ", 80 + 51 * 6.4, 540 - 51 * 4.8);
+    pontos_poligonal(svg, ponto, &depois);
+    assert(antes && depois);
+    free(svg);
+    plot_data_free(data);
+    printf("✓ Quebras preservadas (amostra inválida)\n");
+}
+
+int main(void) {
+    check_simplify();
+    check_svg_suave();
+    check_quebras();
+
+    printf("\nTodos os testes de renderização passaram.\n");
+    return 0;
+}
@@ -0,0 +1,186 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "multicurvas_plot.h"
+#include "interval.h"
+#include "plotbin.h"
+#include "render.h"
+#include "corpus.h"
+#include "assert.h"
+
+/* Blocos do sampler == plot_generate_samples (mesmos bits, mesmos status) */
+static void check_igual(Plot *plot, int samples) {
+    plot->samples = samples;
+    PlotData *data = plot_generate_samples(plot, NULL);
+    PlotSampler *s = plot_sampler_open(plot, 0, NULL);
+    assert(data && s && plot_sampler_samples(s) == (uint64_t)samples);
+
+    PlotChunk chunk;
+    uint64_t proxima = 0;
+    int j = 0, blocos = 0;
+    while (plot_sampler_next(s, &chunk)) {
+        assert(chunk.first == proxima && chunk.n > 0 && chunk.n <= PLOT_SAMPLER_CHUNK);
+        int validas = 0;
+        for (int i = 0; i < chunk.n; i++) {
+            int st = !plot_data_sample_ok(data, (int)chunk.first + i);
+            assert(chunk.status[i] == st);
+            if (st) {
+                assert(isnan(chunk.x[i]) && isnan(chunk.y[i]));
+                continue;
+            }
+            assert(memcmp(&chunk.x[i], &data->x[j], sizeof(double)) == 0);
+            assert(memcmp(&chunk.y[i], &data->y[j], sizeof(double)) == 0);
+            j++;
+            validas++;
+        }
+        assert(chunk.count == validas);
+        proxima += chunk.n;
+        blocos++;
+    }
+    assert(proxima == (uint64_t)samples && j == data->count);
+    assert(blocos == (samples + PLOT_SAMPLER_CHUNK - 1) / PLOT_SAMPLER_CHUNK);
+    assert(!plot_sampler_next(s, &chunk));
+    plot_sampler_close(s);
+    plot_data_free(data);
+}
+
+static void check_corpus(void) {
+    for (int iv = 0; iv <= 1; iv++) {
+        interval_enabled = iv;
+        for (int c = 0; c < CORPUS_SIZE; c++) {
+            Plot *plot = plot_parse_text(corpus_curves[c].spec, NULL);
+            check_igual(plot, c % 7 == 0 ? 2 * PLOT_SAMPLER_CHUNK + 12345 : 20001);
+            plot_free(plot);
+        }
+    }
+    interval_enabled = 1;
+    printf("✓ Blocos idênticos a plot_generate_samples (corpus, com e sem intervalos)\n");
+}
+
+/* Contagem de 64 bits: mais amostras que INT_MAX, sem alocar a curva */
+static void check_64_bits(void) {
+    Plot *plot = plot_parse_text("Y=x:0,1:", NULL);
+    uint64_t n = 5000000001ULL;
+    PlotSampler *s = plot_sampler_open(plot, n, NULL);
+    assert(s && plot_sampler_samples(s) == n);
+    PlotChunk chunk;
+    assert(plot_sampler_next(s, &chunk));
+    assert(chunk.first == 0 && chunk.n == PLOT_SAMPLER_CHUNK && chunk.count == chunk.n);
+    assert(chunk.x[0] == 0.0 && fabs(chunk.x[1] - 1.0 / (n - 1)) < 1e-24);
+    plot_sampler_close(s);
+
+    char *errmsg = NULL;
+    assert(plot_sampler_open(plot, 1, &errmsg) == NULL && errmsg);
+    free(errmsg);
+    plot_set_adaptive(plot, 0.5, 800, 600);
+    assert(plot_sampler_open(plot, 0, &errmsg) == NULL && errmsg);
+    free(errmsg);
+    plot_free(plot);
+    printf("✓ Contagem de 64 bits (%llu amostras) e erros de abertura\n",
+           (unsigned long long)n);
+}
+
+static char *ler_arquivo(FILE *f, long *tam) {
+    fflush(f);
+    *tam = lseek(fileno(f), 0, SEEK_END);
+    char *texto = malloc(*tam + 1);
+    assert(pread(fileno(f), texto, *tam, 0) == *tam);
+    return texto;
+}
+
+/* render_csv_stream == render_csv */
+static void check_csv(void) {
+    Plot *plot = plot_parse_text("Y=log(sin(x)):-20,20:", NULL);
+    plot->samples = PLOT_SAMPLER_CHUNK + 777;
+    PlotData *data = plot_generate_samples(plot, NULL);
+    PlotSampler *s = plot_sampler_open(plot, 0, NULL);
+    assert(data && s);
+
+    FILE *a = tmpfile(), *b = tmpfile();
+    fflush(stdout);
+    int salvo = dup(fileno(stdout));
+    dup2(fileno(a), fileno(stdout));
+    render_csv(data);
+    fflush(stdout);
+    dup2(fileno(b), fileno(stdout));
+    assert(render_csv_stream(s));
+    fflush(stdout);
+
+    // Escrita que falha (disco cheio): retorna 0
+    int cheio = open("/dev/full", O_WRONLY);
+    if (cheio >= 0) {
+        PlotSampler *s2 = plot_sampler_open(plot, 0, NULL);
+        dup2(cheio, fileno(stdout));
+        assert(render_csv_stream(s2) == 0);
+        clearerr(stdout);
+        close(cheio);
+        plot_sampler_close(s2);
+    }
+    dup2(salvo, fileno(stdout));
+    close(salvo);
+
+    long ta, tb;
+    char *ca = ler_arquivo(a, &ta), *cb = ler_arquivo(b, &tb);
+    assert(ta == tb && memcmp(ca, cb, ta) == 0);
+    printf("✓ CSV em streaming idêntico a render_csv (%ld bytes)\n", ta);
+    free(ca);
+    free(cb);
+    fclose(a);
+    fclose(b);
+    plot_sampler_close(s);
+    plot_data_free(data);
+    plot_free(plot);
+}
+
+/* plotbin_write_stream == plotbin_write, inclusive a partir de uma posição
+ * diferente de zero; pipe recusado sem escrever nada */
+static void check_bin(void) {
+    Plot *plot = plot_parse_text("X=cos(t)/t;Y=sin(t)/t:-1,1:", NULL);
+    plot->samples = 2 * PLOT_SAMPLER_CHUNK + 1;
+    PlotData *data = plot_generate_samples(plot, NULL);
+    assert(data);
+
+    FILE *a = tmpfile(), *b = tmpfile();
+    assert(plotbin_write(a, plot, data));
+    assert(write(fileno(b), "prefixo", 7) == 7);
+    PlotSampler *s = plot_sampler_open(plot, 0, NULL);
+    assert(plotbin_write_stream(fileno(b), plot, s) == 1);
+    plot_sampler_close(s);
+
+    long ta, tb;
+    char *ca = ler_arquivo(a, &ta), *cb = ler_arquivo(b, &tb);
+    assert(tb == ta + 7 && memcmp(cb, "prefixo", 7) == 0);
+    assert(memcmp(ca, cb + 7, ta) == 0);
+    assert(lseek(fileno(b), 0, SEEK_CUR) == tb);
+
+    int tubo[2];
+    assert(pipe(tubo) == 0);
+    s = plot_sampler_open(plot, 0, NULL);
+    assert(plotbin_write_stream(tubo[1], plot, s) == -1);
+    plot_sampler_close(s);
+    close(tubo[0]);
+    close(tubo[1]);
+
+    printf("✓ Binário em streaming idêntico a plotbin_write (%ld bytes)\n", ta);
+    free(ca);
+    free(cb);
+    fclose(a);
+    fclose(b);
+    plot_data_free(data);
+    plot_free(plot);
+}
+
+int main(void) {
+    check_corpus();
+    check_64_bits();
+    check_csv();
+    check_bin();
+
+    printf("\nTodos os testes de amostragem em streaming passaram.\n");
+    return 0;
+}
@@ -0,0 +1,183 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "multicurvas_plot.h"
+#include "render.h"
+#include "serve.h"
+#include "assert.h"
+
+/* Payload esperado: render_plot da mesma curva em memória */
+static char *esperado(const char *expr, const char *formato, int w, int h, int amostras,
+                      size_t *len) {
+    Plot *plot = plot_parse_text(expr, NULL);
+    if (amostras) plot->samples = amostras;
+    PlotData *data = plot_generate_samples(plot, NULL);
+    char *buf = NULL;
+    FILE *mem = open_memstream(&buf, len);
+    assert(render_plot(mem, plot, data, expr, formato, w, h));
+    fclose(mem);
+    plot_data_free(data);
+    plot_free(plot);
+    return buf;
+}
+
+/* Lê uma resposta: retorna o payload (len em *len) ou NULL para ERR */
+static char *ler_resposta(FILE *in, size_t *len) {
+    char cabecalho[256];
+    assert(fgets(cabecalho, sizeof(cabecalho), in));
+    if (strncmp(cabecalho, "ERR ", 4) == 0) return NULL;
+    assert(sscanf(cabecalho, "OK %zu", len) == 1);
+    char *payload = malloc(*len + 1);
+    assert(fread(payload, 1, *len, in) == *len);
+    payload[*len] = '\0';
+    return payload;
+}
+
+static void check_igual(FILE *in, const char *expr, const char *formato, int w, int h,
+                        int amostras) {
+    size_t len, elen;
+    char *payload = ler_resposta(in, &len);
+    char *e = esperado(expr, formato, w, h, amostras, &elen);
+    assert(payload && len == elen && memcmp(payload, e, len) == 0);
+    free(payload);
+    free(e);
+}
+
+/* Pedidos por stdin/stdout (aqui um arquivo temporário) */
+static void check_linhas(void) {
+    Server *s = server_create(1);
+    FILE *pedidos = tmpfile(), *respostas = tmpfile();
+    fputs("# comentário\n"
+          "Y=x*x csv samples=5\n"
+          "\n"
+          "\"R=6/(2-sin(t))\" svg 400 300\n"
+          "Y=x bin interval=0,1 samples=3\n"
+          "Y=log( svg\n"
+          "Y=x png\n"
+          "Y=x:0,1: interval=0,2\n"
+          "Y=x samples=1\n"
+          "Y=x 640\n"
+          "stats\n"
+          "quit\n"
+          "Y=x\n", pedidos);
+    rewind(pedidos);
+    server_serve_fd(s, fileno(pedidos), fileno(respostas));
+    rewind(respostas);
+
+    check_igual(respostas, "Y=x*x", "csv", 800, 600, 5);
+    check_igual(respostas, "R=6/(2-sin(t))", "svg", 400, 300, 0);
+    check_igual(respostas, "Y=x:0,1:", "bin", 800, 600, 3);
+    size_t len;
+    for (int i = 0; i < 5; i++) assert(ler_resposta(respostas, &len) == NULL);
+
+    char *stats = ler_resposta(respostas, &len);
+    assert(stats && strstr(stats, "pedidos 8\n") && strstr(stats, "erros 5\n"));
+    assert(strstr(stats, "p50_ms ") && strstr(stats, "p99_ms ") && strstr(stats, "cache_acertos "));
+    free(stats);
+
+    // quit: nada depois
+    char resto[8];
+    assert(fread(resto, 1, sizeof(resto), respostas) == 0);
+    ServerStats st = server_stats(s);
+    assert(st.requests == 8 && st.errors == 5 && st.p50_ms <= st.p99_ms && st.p99_ms <= st.max_ms);
+    fclose(pedidos);
+    fclose(respostas);
+    server_destroy(s);
+    printf("✓ Protocolo em linhas: payloads idênticos a render_plot, erros sem encerrar\n");
+}
+
+/* ========================================================================
+ * Socket: vários clientes ao mesmo tempo
+ * ======================================================================== */
+
+static char caminho[108];
+
+static void *escutar(void *arg) {
+    char *errmsg = NULL;
+    assert(server_listen(arg, caminho, &errmsg) == 1);
+    return NULL;
+}
+
+static FILE *conectar(void) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, caminho);
+    for (int tentativa = 0; tentativa < 500; tentativa++) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0) return fdopen(fd, "r+");
+        close(fd);
+        struct timespec espera = { 0, 2000000 };
+        nanosleep(&espera, NULL);
+    }
+    assert(!"servidor não respondeu");
+    return NULL;
+}
+
+#define CLIENTES 4
+#define PEDIDOS 25
+
+static const char *curvas[] = { "Y=sin(x)", "R=6", "X=cos(3*t);Y=sin(2*t)", "Y=tan(x)" };
+
+static void *cliente(void *arg) {
+    int id = (int)(size_t)arg;
+    FILE *f = conectar();
+    for (int i = 0; i < PEDIDOS; i++) {
+        const char *expr = curvas[(id + i) % 4];
+        const char *formato = i % 2 ? "csv" : "svg";
+        fprintf(f, "\"%s\" %s samples=%d\n", expr, formato, 200 + i);
+        fflush(f);
+        check_igual(f, expr, formato, 800, 600, 200 + i);
+    }
+    fputs("quit\n", f);
+    fclose(f);
+    return NULL;
+}
+
+static void check_socket(void) {
+    snprintf(caminho, sizeof(caminho), "/tmp/multicurvas_serve_%d.sock", (int)getpid());
+    Server *s = server_create(CLIENTES);
+    pthread_t servidor, th[CLIENTES];
+    pthread_create(&servidor, NULL, escutar, s);
+    for (int i = 0; i < CLIENTES; i++) pthread_create(&th[i], NULL, cliente, (void *)(size_t)i);
+    for (int i = 0; i < CLIENTES; i++) pthread_join(th[i], NULL);
+
+    // Conexão aberta parada no meio não impede o shutdown
+    FILE *ociosa = conectar();
+    FILE *f = conectar();
+    fputs("stats\n", f);
+    fflush(f);
+    size_t len;
+    char *stats = ler_resposta(f, &len);
+    assert(stats && strstr(stats, "pedidos 100\n") && strstr(stats, "erros 0\n"));
+    free(stats);
+    fputs("shutdown\n", f);
+    fflush(f);
+    char *vazio = ler_resposta(f, &len);
+    assert(vazio && len == 0);
+    free(vazio);
+    pthread_join(servidor, NULL);
+    assert(access(caminho, F_OK) != 0);   /* socket removido */
+    fclose(f);
+    fclose(ociosa);
+
+    ServerStats st = server_stats(s);
+    printf("✓ Socket: %d clientes x %d pedidos, p50 %.3f ms, p99 %.3f ms\n",
+           CLIENTES, PEDIDOS, st.p50_ms, st.p99_ms);
+    server_destroy(s);
+}
+
+int main(void) {
+    check_linhas();
+    check_socket();
+
+    printf("\nTodos os testes do modo servidor passaram.\n");
+    return 0;
+}
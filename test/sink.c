@@ -0,0 +1,317 @@
+#define _POSIX_C_SOURCE 200809L  /* mkstemp, socketpair, ftruncate */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include "multicurvas_plot.h"
+#include "outbuf.h"
+#include "render.h"
+#include "plotbin.h"
+#include "corpus.h"
+#include "assert.h"
+
+/* Conteúdo inteiro do arquivo `fd` (len em *len) */
+static char *ler_fd(int fd, size_t *len) {
+    struct stat st;
+    assert(fstat(fd, &st) == 0);
+    char *buf = malloc(st.st_size + 1);
+    assert(buf);
+    size_t n = 0;
+    while (n < (size_t)st.st_size) {
+        ssize_t r = pread(fd, buf + n, st.st_size - n, n);
+        assert(r > 0);
+        n += r;
+    }
+    *len = n;
+    return buf;
+}
+
+static int temporario(void) {
+    char nome[] = "/tmp/sink_testXXXXXX";
+    int fd = mkstemp(nome);
+    assert(fd >= 0);
+    unlink(nome);
+    return fd;
+}
+
+/* render_plot num FILE (referência) */
+static char *referencia(const Plot *plot, const PlotData *data, const char *formato,
+                        size_t *len) {
+    FILE *f = tmpfile();
+    assert(f && render_plot(f, plot, data, "t", formato, 800, 600));
+    char *buf = ler_fd(fileno(f), len);
+    fclose(f);
+    return buf;
+}
+
+/* Renderiza num sink do tipo `tipo` e compara com a referência */
+static void check_sink(OutSinkKind tipo, Arena *arena, const Plot *plot, const PlotData *data,
+                       const char *formato, const char *esperado, size_t len) {
+    OutSink sink;
+    int fd = -1;
+    if (tipo == OUTSINK_MEMORY) {
+        outsink_memory(&sink, arena);
+    } else {
+        fd = temporario();
+        if (tipo == OUTSINK_MMAP) {
+            assert(outsink_mmap(&sink, fd) && sink.kind == OUTSINK_MMAP);
+        } else {
+            outsink_fd(&sink, fd);
+        }
+    }
+    assert(render_plot_sink(&sink, plot, data, "t", formato, 800, 600));
+    assert(outsink_finish(&sink) && sink.len == len);
+
+    if (tipo == OUTSINK_MEMORY) {
+        assert(len == 0 || memcmp(sink.data, esperado, len) == 0);
+        outsink_free(&sink);
+    } else {
+        size_t n;
+        char *obtido = ler_fd(fd, &n);
+        assert(n == len && memcmp(obtido, esperado, len) == 0);
+        free(obtido);
+        close(fd);
+    }
+}
+
+/* fd, memória (heap e arena) e mmap: os mesmos bytes que o FILE */
+static void check_renderizadores(void) {
+    static const char *formatos[] = { "csv", "svg", "bin" };
+    Arena *arena = arena_create(0);
+    size_t total = 0;
+    for (int c = 0; c < CORPUS_SIZE; c++) {
+        Plot *plot = plot_parse_text(corpus_curves[c].spec, NULL);
+        assert(plot);
+        PlotData *data = plot_generate_samples(plot, NULL);
+        assert(data);
+        for (int f = 0; f < 3; f++) {
+            size_t len;
+            char *esperado = referencia(plot, data, formatos[f], &len);
+            check_sink(OUTSINK_FD, NULL, plot, data, formatos[f], esperado, len);
+            check_sink(OUTSINK_MEMORY, NULL, plot, data, formatos[f], esperado, len);
+            check_sink(OUTSINK_MEMORY, arena, plot, data, formatos[f], esperado, len);
+            check_sink(OUTSINK_MMAP, NULL, plot, data, formatos[f], esperado, len);
+            arena_reset(arena);
+            total += len;
+            free(esperado);
+        }
+        plot_data_free(data);
+        plot_free(plot);
+    }
+
+    // Saídas maiores que o mapeamento inicial e que vários buffers
+    Plot *plot = plot_parse_text("Y=sin(x)*x:-10,10:", NULL);
+    plot->samples = 300000;
+    PlotData *data = plot_generate_samples(plot, NULL);
+    for (int f = 0; f < 3; f += 2) {
+        size_t len;
+        char *esperado = referencia(plot, data, formatos[f], &len);
+        assert(len > OUTSINK_MMAP_INITIAL);
+        check_sink(OUTSINK_FD, NULL, plot, data, formatos[f], esperado, len);
+        check_sink(OUTSINK_MEMORY, arena, plot, data, formatos[f], esperado, len);
+        check_sink(OUTSINK_MMAP, NULL, plot, data, formatos[f], esperado, len);
+        total += len;
+        free(esperado);
+    }
+    plot_data_free(data);
+    plot_free(plot);
+    arena_destroy(arena);
+    printf("✓ csv, svg e bin idênticos em FILE, fd, memória, arena e mmap (%zu KB)\n",
+           total / 1024);
+}
+
+/* Sequência de escritas do OutBuf que cruza a janela de todas as formas */
+static void escrever_sequencia(OutBuf *ob) {
+    static char grande[3 * OUTBUF_SIZE];
+    memset(grande, 'g', sizeof(grande));
+    grande[sizeof(grande) - 1] = '\0';
+    for (int i = 0; i < 20000; i++) {
+        outbuf_fixed(ob, i * 0.37, i % 7);
+        outbuf_putc(ob, ' ');
+        if (i % 1000 == 0) outbuf_printf(ob, "[%d %s]", i, i % 3000 ? "x" : grande);
+        if (i % 1500 == 0) outbuf_write(ob, grande, (i / 1500) * 7000);
+        if (i % 97 == 0) outbuf_puts(ob, "linha\n");
+    }
+    outbuf_flush(ob);
+}
+
+static void check_outbuf(void) {
+    FILE *f = tmpfile();
+    static OutBuf ob;
+    outbuf_init(&ob, f);
+    escrever_sequencia(&ob);
+    assert(fflush(f) == 0);
+    size_t len;
+    char *esperado = ler_fd(fileno(f), &len);
+    fclose(f);
+
+    Arena *arena = arena_create(0);
+    for (int tipo = 0; tipo < 4; tipo++) {
+        OutSink sink;
+        int fd = -1;
+        if (tipo == 0) {
+            outsink_memory(&sink, NULL);
+        } else if (tipo == 1) {
+            arena_alloc(arena, 1);
+            outsink_memory(&sink, arena);
+        } else {
+            fd = temporario();
+            if (tipo == 2) outsink_fd(&sink, fd); else outsink_mmap(&sink, fd);
+        }
+        outbuf_init_sink(&ob, &sink);
+        escrever_sequencia(&ob);
+        assert(outsink_finish(&sink) && sink.len == len);
+        if (fd < 0) {
+            assert(len == 0 || memcmp(sink.data, esperado, len) == 0);
+            outsink_free(&sink);
+        } else {
+            size_t n;
+            char *obtido = ler_fd(fd, &n);
+            assert(n == len && memcmp(obtido, esperado, len) == 0);
+            free(obtido);
+            close(fd);
+        }
+    }
+    arena_destroy(arena);
+    free(esperado);
+    printf("✓ OutBuf: %zu bytes em escritas pequenas e grandes, iguais em todos os sinks\n",
+           len);
+}
+
+/* writev num socket com o buffer cheio: escritas parciais até o fim */
+#define PAYLOAD (8 << 20)
+
+typedef struct {
+    int fd;
+    size_t len;
+    unsigned soma;
+} Leitor;
+
+static void *ler_socket(void *arg) {
+    Leitor *l = arg;
+    char buf[4096];
+    ssize_t r;
+    while ((r = read(l->fd, buf, sizeof(buf))) > 0) {
+        for (ssize_t i = 0; i < r; i++) l->soma = l->soma * 31 + (unsigned char)buf[i];
+        l->len += r;
+    }
+    return NULL;
+}
+
+static void check_writev(void) {
+    int par[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, par) == 0);
+    Leitor leitor = { par[1], 0, 0 };
+    pthread_t th;
+    pthread_create(&th, NULL, ler_socket, &leitor);
+
+    char *payload = malloc(PAYLOAD);
+    for (int i = 0; i < PAYLOAD; i++) payload[i] = (char)(i * 7 + (i >> 13));
+    unsigned soma = 0;
+    const char *cabecalho = "OK 8388608\n";
+    struct iovec v[3] = { { (void *)cabecalho, strlen(cabecalho) }, { payload, PAYLOAD },
+                          { "fim\n", 4 } };
+    for (int k = 0; k < 3; k++) {
+        for (size_t i = 0; i < v[k].iov_len; i++) {
+            soma = soma * 31 + ((unsigned char *)v[k].iov_base)[i];
+        }
+    }
+
+    OutSink sink;
+    outsink_fd(&sink, par[0]);
+    assert(outsink_writev(&sink, v, 3));
+    assert(sink.len == strlen(cabecalho) + PAYLOAD + 4);
+    close(par[0]);
+    pthread_join(th, NULL);
+    close(par[1]);
+    assert(leitor.len == sink.len && leitor.soma == soma);
+    free(payload);
+
+    // Escrita num fd fechado: erro, e o sink descarta o resto
+    outsink_fd(&sink, par[0]);
+    assert(!outsink_write(&sink, "x", 1) && sink.error && !outsink_finish(&sink));
+    printf("✓ writev de %d MB num socket, com escritas parciais\n", PAYLOAD >> 20);
+}
+
+/* Mais pedaços que OUTSINK_IOV_MAX (alguns vazios): tudo escrito, em ordem,
+ * em todos os sinks */
+#define PEDACOS (3 * OUTSINK_IOV_MAX + 5)
+
+static void check_muitos_pedacos(void) {
+    char textos[PEDACOS][16];
+    struct iovec v[PEDACOS];
+    char esperado[PEDACOS * 16];
+    size_t len = 0;
+    for (int i = 0; i < PEDACOS; i++) {
+        int n = i % 7 == 3 ? 0 : snprintf(textos[i], sizeof(textos[i]), "[%d]", i);
+        v[i].iov_base = textos[i];
+        v[i].iov_len = n;
+        memcpy(esperado + len, textos[i], n);
+        len += n;
+    }
+
+    for (int tipo = 0; tipo < 4; tipo++) {
+        OutSink sink;
+        FILE *f = NULL;
+        int fd = -1;
+        if (tipo == 0) {
+            outsink_memory(&sink, NULL);
+        } else if (tipo == 1) {
+            f = tmpfile();
+            outsink_file(&sink, f);
+        } else {
+            fd = temporario();
+            if (tipo == 2) outsink_fd(&sink, fd); else outsink_mmap(&sink, fd);
+        }
+        assert(outsink_writev(&sink, v, PEDACOS) && sink.len == len);
+        assert(outsink_finish(&sink));
+        if (tipo == 0) {
+            assert(len == 0 || memcmp(sink.data, esperado, len) == 0);
+            outsink_free(&sink);
+            continue;
+        }
+        size_t n;
+        char *obtido = ler_fd(f ? fileno(f) : fd, &n);
+        assert(n == len && memcmp(obtido, esperado, len) == 0);
+        free(obtido);
+        if (f) fclose(f); else close(fd);
+    }
+    printf("✓ outsink_writev com %d pedaços (limite de %d por writev)\n",
+           PEDACOS, OUTSINK_IOV_MAX);
+}
+
+/* mmap: tamanho final do arquivo; pipe vira sink de fd */
+static void check_mmap(void) {
+    int fd = temporario();
+    OutSink sink;
+    assert(outsink_mmap(&sink, fd));
+    assert(outsink_write(&sink, "abc", 3) && outsink_finish(&sink));
+    struct stat st;
+    assert(fstat(fd, &st) == 0 && st.st_size == 3);
+    close(fd);
+
+    int p[2];
+    assert(pipe(p) == 0);
+    assert(!outsink_mmap(&sink, p[1]) && sink.kind == OUTSINK_FD && !sink.error);
+    assert(outsink_write(&sink, "abc", 3) && outsink_finish(&sink));
+    char buf[4];
+    assert(read(p[0], buf, sizeof(buf)) == 3 && memcmp(buf, "abc", 3) == 0);
+    close(p[0]);
+    close(p[1]);
+    printf("✓ mmap: arquivo cortado no tamanho escrito; pipe cai para write\n");
+}
+
+int main(void) {
+    check_renderizadores();
+    check_outbuf();
+    check_writev();
+    check_muitos_pedacos();
+    check_mmap();
+
+    printf("\nTodos os testes dos sinks passaram.\n");
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "threadpool.h"
+#include "multicurvas_plot.h"
+#include "presets.h"
+#include "corpus.h"
+#include "assert.h"
+
+enum { TASKS = 1000 };
+
+typedef struct {
+    int hits[TASKS];
+    pthread_mutex_t lock;
+} Contagem;
+
+static void marcar(void *ctx, int task) {
+    Contagem *c = ctx;
+    pthread_mutex_lock(&c->lock);
+    c->hits[task]++;
+    pthread_mutex_unlock(&c->lock);
+}
+
+/* Cada tarefa roda exatamente uma vez, em chamadas repetidas no mesmo pool */
+static void check_run(ThreadPool *pool, int rounds) {
+    Contagem c;
+    memset(c.hits, 0, sizeof(c.hits));
+    pthread_mutex_init(&c.lock, NULL);
+    for (int r = 0; r < rounds; r++) threadpool_run(pool, marcar, &c, TASKS);
+    for (int t = 0; t < TASKS; t++) assert(c.hits[t] == rounds);
+    threadpool_run(pool, marcar, &c, 0);
+    pthread_mutex_destroy(&c.lock);
+}
+
+/* threadpool_run de várias threads no mesmo pool é serializado */
+static void *chamadora(void *arg) {
+    check_run(arg, 20);
+    return NULL;
+}
+
+static void check_concurrent_callers(ThreadPool *pool) {
+    pthread_t th[3];
+    for (int i = 0; i < 3; i++) assert(pthread_create(&th[i], NULL, chamadora, pool) == 0);
+    for (int i = 0; i < 3; i++) pthread_join(th[i], NULL);
+}
+
+/* Amostragem com e sem threads: mesmos pontos, mesma ordem, mesmos status */
+static void check_plot(Plot *plot) {
+    plot->samples = 300001;
+
+    threadpool_set_default_threads(1);
+    PlotData *serial = plot_generate_samples(plot, NULL);
+    threadpool_set_default_threads(4);
+    PlotData *paralelo = plot_generate_samples(plot, NULL);
+    assert(threadpool_threads(threadpool_default()) == 4);
+
+    assert(serial && paralelo);
+    assert(serial->count == paralelo->count);
+    assert(memcmp(serial->x, paralelo->x, serial->count * sizeof(double)) == 0);
+    assert(memcmp(serial->y, paralelo->y, serial->count * sizeof(double)) == 0);
+    assert(memcmp(serial->valid, paralelo->valid, (plot->samples + 63) / 64 * sizeof(uint64_t)) == 0);
+
+    plot_data_free(serial);
+    plot_data_free(paralelo);
+}
+
+int main(void) {
+    check_run(NULL, 3);
+
+    ThreadPool *one = threadpool_create(1);
+    assert(one && threadpool_threads(one) == 1);
+    check_run(one, 3);
+    threadpool_destroy(one);
+
+    ThreadPool *pool = threadpool_create(4);
+    assert(pool && threadpool_threads(pool) == 4);
+    check_run(pool, 50);
+    check_concurrent_callers(pool);
+    threadpool_destroy(pool);
+    printf("✓ Pool: tarefas executadas exatamente uma vez\n");
+
+    assert(threadpool_cpu_count() >= 1);
+    threadpool_set_default_threads(1);
+    assert(threadpool_default() == NULL);
+
+    for (int c = 0; c < CORPUS_SIZE; c += 7) {
+        Plot *plot = plot_parse_text(corpus_curves[c].spec, NULL);
+        assert(plot != NULL);
+        check_plot(plot);
+        plot_free(plot);
+    }
+    Plot *preset = plot_from_preset(plot_preset_find("35"));
+    check_plot(preset);
+    plot_free(preset);
+    printf("✓ Amostragem paralela idêntica à serial\n");
+
+    printf("\nTodos os testes do pool de threads passaram.\n");
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "parser.h"
+#include "assert.h"
+
+/* Palavras-chave do parser, na ordem antiga dos CHECK_KEYWORD */
+static const struct {
+    const char *nome;
+    TokenType token;
+} palavras[] = {
+    { "sin", TOKEN_SIN }, { "cos", TOKEN_COS }, { "tan", TOKEN_TAN }, { "abs", TOKEN_ABS },
+    { "sqrt", TOKEN_SQRT }, { "exp", TOKEN_EXP }, { "log10", TOKEN_LOG10 }, { "log", TOKEN_LOG },
+    { "ln", TOKEN_LOG }, { "sinh", TOKEN_SINH }, { "cosh", TOKEN_COSH }, { "tanh", TOKEN_TANH },
+    { "asin", TOKEN_ASIN }, { "acos", TOKEN_ACOS }, { "atan", TOKEN_ATAN },
+    { "asinh", TOKEN_ASINH }, { "acosh", TOKEN_ACOSH }, { "atanh", TOKEN_ATANH },
+    { "ceil", TOKEN_CEIL }, { "floor", TOKEN_FLOOR }, { "frac", TOKEN_FRAC },
+    { "pi", TOKEN_CONST_PI }, { "e", TOKEN_CONST_E }, { "theta", TOKEN_VARIABLE_THETA },
+    { "x", TOKEN_VARIABLE_X }, { "t", TOKEN_VARIABLE_T },
+};
+#define NPALAVRAS ((int)(sizeof(palavras) / sizeof(palavras[0])))
+
+/* Token de um identificador sozinho: o tipo ou TOKEN_ERROR */
+static TokenType token_de(const char *ident) {
+    TokenBuffer buf;
+    ParserError err = parser_tokenize(ident, &buf);
+    if (err == PARSER_UNKNOWN_FUNCTION) return TOKEN_ERROR;
+    assert(err == PARSER_OK && buf.size == 2);
+    TokenType t = buf.tokens[0].type;
+    parser_free_buffer(&buf);
+    return t;
+}
+
+static void check_palavras(void) {
+    for (int i = 0; i < NPALAVRAS; i++) assert(token_de(palavras[i].nome) == palavras[i].token);
+
+    // Identificadores aleatórios: só as palavras exatas são aceitas
+    static const char letras[] = "aceghilnopqrstx1";
+    unsigned semente = 77u;
+    int aceitos = 0;
+    for (int k = 0; k < 200000; k++) {
+        char ident[8];
+        semente = semente * 1103515245u + 12345u;
+        int len = 1 + (semente >> 16) % 7;
+        for (int i = 0; i < len; i++) {
+            semente = semente * 1103515245u + 12345u;
+            ident[i] = letras[(semente >> 16) % 16];
+        }
+        ident[len] = '\0';
+        if (ident[0] == '1') continue;      /* número, não identificador */
+
+        TokenType esperado = TOKEN_ERROR;
+        for (int i = 0; i < NPALAVRAS; i++) {
+            if (strcmp(ident, palavras[i].nome) == 0) esperado = palavras[i].token;
+        }
+        assert(token_de(ident) == esperado);
+        aceitos += (esperado != TOKEN_ERROR);
+    }
+    assert(token_de("sinx") == TOKEN_ERROR && token_de("SIN") == TOKEN_ERROR);
+    assert(token_de("log1") == TOKEN_ERROR && token_de("log100") == TOKEN_ERROR);
+    assert(token_de("thetas") == TOKEN_ERROR && token_de("x1") == TOKEN_ERROR);
+    printf("✓ Hash perfeito: %d palavras, 200000 identificadores aleatórios (%d aceitos)\n",
+           NPALAVRAS, aceitos);
+}
+
+/* Valor do número sozinho na expressão */
+static double ler(const char *num) {
+    TokenBuffer buf;
+    assert(parser_tokenize(num, &buf) == PARSER_OK);
+    assert(buf.size == 2 && buf.tokens[0].type == TOKEN_NUMBER);
+    double v = buf.values[buf.tokens[0].value_index];
+    parser_free_buffer(&buf);
+    return v;
+}
+
+/* Confere bit a bit com strtod (correto na glibc), em ponto e em vírgula */
+static void check_numero(const char *num) {
+    double esperado = strtod(num, NULL);
+    double v = ler(num);
+    if (memcmp(&v, &esperado, sizeof(double)) != 0) {
+        printf("  \"%s\": %.17g != %.17g\n", num, v, esperado);
+    }
+    assert(memcmp(&v, &esperado, sizeof(double)) == 0);
+
+    char virgula[2048];
+    snprintf(virgula, sizeof(virgula), "%s", num);
+    char *p = strchr(virgula, '.');
+    if (p) *p = ',';
+    parser_set_locale(LOCALE_COMMA);
+    v = ler(virgula);
+    parser_set_locale(LOCALE_POINT);
+    assert(memcmp(&v, &esperado, sizeof(double)) == 0);
+}
+
+static void repetir(char *dst, char c, int n) {
+    memset(dst, c, n);
+    dst[n] = '\0';
+}
+
+static void check_numeros(void) {
+    const char *casos[] = {
+        "0", "0.0", "1", "3.14", ".5", "5.", "0.1", "0.3", "2.5", "123456789012345678",
+        "9007199254740993",             /* 2^53 + 1: empate, fica no par */
+        "9007199254740995",
+        "9007199254740992.5",
+        "18446744073709551615", "12345678901234567890123",
+        "0.1000000000000000055511151231257827021181583404541015625",   /* 0.1 exato */
+        "0.1000000000000000055511151231257827021181583404541015624",
+        "2.2250738585072011", "2.2250738585072014",
+        "1.7976931348623157", "4.9406564584124654",
+        "1000000000000000000000", "10000000000000000000000", "100000000000000000000000",
+        "0.000001", "0.0000000000000000000000001", "1.00000000000000011102230246251565404236316680908203125",
+    };
+    for (int i = 0; i < (int)(sizeof(casos) / sizeof(casos[0])); i++) check_numero(casos[i]);
+
+    // Magnitudes extremas sem notação científica
+    char num[2048];
+    repetir(num, '9', 309);
+    check_numero(num);                  /* perto de DBL_MAX */
+    repetir(num, '9', 310);
+    check_numero(num);                  /* inf */
+    strcpy(num, "179769313486231580793728971405303415079934132710037826936173778980444968292764750946649017977587207096330286416692887910946555547851940402630657488671505820681908902000708383676273854845817711531764475730270069855571366959622842914819860834936475292719074168444365510704342711559699508093042880177904174497792");
+    check_numero(num);                  /* 2^1024 - 2^970: ponto médio acima de DBL_MAX */
+    strcpy(num, "0.");
+    repetir(num + 2, '0', 323);
+    strcat(num, "24703282292062327");   /* metade do menor subnormal */
+    check_numero(num);
+    strcpy(num, "0.");
+    repetir(num + 2, '0', 323);
+    strcat(num, "2470328229206232720882");
+    check_numero(num);
+    strcpy(num, "0.");
+    repetir(num + 2, '0', 400);
+    strcat(num, "1");
+    check_numero(num);                  /* 0 */
+
+    // Mais de 780 dígitos: o resto decide o empate
+    strcpy(num, "9007199254740993");
+    repetir(num + 16, '0', 900);
+    num[16] = '.';
+    check_numero(num);
+    strcat(num, "1");
+    check_numero(num);
+
+    // Aleatórios: até 25 dígitos, ponto em qualquer posição
+    unsigned semente = 1234u;
+    for (int k = 0; k < 200000; k++) {
+        semente = semente * 1103515245u + 12345u;
+        int len = 1 + (semente >> 16) % 25;
+        semente = semente * 1103515245u + 12345u;
+        int ponto = (semente >> 16) % (len + 1);
+        int n = 0;
+        for (int i = 0; i < len; i++) {
+            if (i == ponto && i > 0) num[n++] = '.';
+            semente = semente * 1103515245u + 12345u;
+            num[n++] = (char)('0' + (semente >> 16) % 10);
+        }
+        num[n] = '\0';
+        check_numero(num);
+    }
+    printf("✓ Números: idênticos a strtod bit a bit (ponto e vírgula, 200000 aleatórios)\n");
+}
+
+int main(void) {
+    check_palavras();
+    check_numeros();
+
+    printf("\nTodos os testes do tokenizador passaram.\n");
+    return 0;
+}